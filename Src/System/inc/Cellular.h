@@ -58,6 +58,7 @@
 #define CELLULAR_IMEI_LENGTH                16u
 #define CELLULAR_CARRIER_LENGTH             32u
 #define CELLULAR_ICCID_LENGTH               20u
+#define CELLULAR_FIRMWARE_LENGTH            32u
 #define IP_ADDR_LEN                         16u
 #define SIM_APN_LEN                         64u
 #define PHONE_NUMBER_LEN                    12u
@@ -85,6 +86,10 @@
 #define ERR_INVALID_AT_COMMAND             (-18)
 #define ERR_SERVER_RESPONSE_PARSING_ERROR  (-19)
 #define ERR_UNABLE_TO_OPEN_DIRECT_LINK     (-20)
+
+#define CELL_SCHEDULER_DIAGNOSTIC_SIZE     20u
+#define ERR_CELL_SCHEDULER_NOT_AVAILABLE   (-330)
+
 //==============================================================================
 //  GLOBAL DATA STRUCTURES DEFINITION
 //==============================================================================
@@ -99,6 +104,7 @@ typedef enum
     CELL_SEND_SMS,
     CELL_GET_GPS_COORDINATES,
     CELL_GPS_OFF,
+    CELL_PREWARM_CONNECTION,
     
     CELL_LAST_INVALID,
 }CELL_MSG_ID_t;
@@ -132,6 +138,7 @@ typedef struct CellularDriver
     uint8_t imei[CELLULAR_IMEI_LENGTH+1];
     uint8_t carrier[CELLULAR_CARRIER_LENGTH+1];
     uint8_t iccid[CELLULAR_ICCID_LENGTH+1];
+    uint8_t firmware[CELLULAR_FIRMWARE_LENGTH+1];   //!< Module revision reported by ATI
     uint8_t ipAddr[IP_ADDR_LEN+1];
     uint32_t TCPSocket;
     
@@ -144,6 +151,7 @@ typedef struct CellularDriver
     
     BOOLEAN isCellularRegistered;
     BOOLEAN isRTCTimeUpdated;
+    uint8_t accessTechnology;       //!< +COPS <AcT>, CELL_ACT_UNKNOWN when not registered
     
     ATCOMMAND_INDEX_ENUM currentATIndex;
     PTR_COMM_EVT_t runningCommEvent;
@@ -166,6 +174,15 @@ typedef struct
     
     uint8_t *jsonHeader;
 }ReceivedDataInfo_t;
+
+typedef struct
+{
+    uint32_t interleavedSteps;      //!< GNSS work done in between socket steps of an upload
+    uint32_t interleavedPolls;      //!< NAV-PVT reads among them
+    uint32_t gnssPositionsSent;
+    uint32_t lastPositionAgeMs;     //!< GNSS fix age when the event was sent
+    uint32_t maxPositionAgeMs;
+}CellularSchedulerStats_t;
 //==============================================================================
 //  GLOBAL DATA
 //==============================================================================
@@ -194,4 +211,45 @@ extern uint8_t gps_initialized;
 //
 //------------------------------------------------------------------------------
 void CellularTask(void *arg);
+
+//------------------------------------------------------------------------------
+//  void CellularPostGNSSRequest(CELL_MSG_ID_t msgId)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function request CELL_GET_GPS_COORDINATES or CELL_GPS_OFF. The
+//!  request is served by its message or in between the socket steps of an
+//!  upload already running, repeated requests are merged.
+//
+//------------------------------------------------------------------------------
+void CellularPostGNSSRequest(CELL_MSG_ID_t msgId);
+
+//------------------------------------------------------------------------------
+//  void CellularPostAlarmCheck(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function post CELL_SEND_SMS when an alarm waiting in its lane is
+//!  past its deadline and was not sent by SMS yet, at most once per
+//!  CELL_SMS_CHECK_INTERVAL_MS. Called periodically by the system task.
+//
+//------------------------------------------------------------------------------
+void CellularPostAlarmCheck(void);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularGetSchedulerDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the GNSS scheduler record for the radio configuration
+//!  readout, big endian 32 bit: GNSS steps and NAV-PVT reads interleaved in
+//!  uploads, GNSS positions sent, last and max age in ms of those positions
+//!
+//! \return CELL_SCHEDULER_DIAGNOSTIC_SIZE or ERR_CELL_SCHEDULER_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularGetSchedulerDiagnostics(uint8_t buffer[], uint32_t bufferSize);
 #endif
@@ -65,6 +65,8 @@ typedef enum
     ATC_COPS_Q,
     ATC_CGDCONT,
     ATC_CCLK_Q,
+    ATC_CTZU,
+    ATC_CTZR,
     ATC_CGATT,
     ATC_CGACT,
     ATC_CGPADDR,
@@ -88,6 +90,7 @@ typedef enum
     ATC_CFUN_0,
     ATC_CFUN_1,
     ATC_GNNS_SUPPLY_EN,
+    ATC_GNNS_SUPPLY_OFF,
     ATC_GNNS_DATA_READY,
     ATC_UI2CO,
     ATC_UI2CW,
@@ -104,6 +107,22 @@ typedef enum
     ATC_UGGSV_DATA,
     ATC_ULOCGNSS,
     ATC_ULOC,
+    ATC_UCGED_MODE,     //AT+UCGED=2, serving cell reported in short form
+    ATC_UCGED_Q,
+    ATC_UBANDMASK_Q,
+    ATC_UBANDMASK,
+    ATC_COPS_MANUAL,
+    ATC_COPS_AUTO,
+    ATC_USECPRF_RESUME,
+    ATC_UDNSRN,         //AT+UDNSRN=0,<INET_HOST>, address of the iNet host
+    ATC_USECPRF_ECDSA_AES128,   //AT+USECPRF=0,2,99, TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256 only
+    ATC_USECPRF_RSA_AES128,     //AT+USECPRF=0,2,99, TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256 only
+    ATC_USOCO_ASYNC,    //AT+USOCO=<*socket>,<address>,<port>,1, result comes in +UUSOCO
+    ATC_CMGF,           //AT+CMGF=0, SMS in PDU mode
+    ATC_CMGS,           //AT+CMGS=<length>, waits for the PDU prompt
+    ATC_CMGS_PDU,       //SMS-SUBMIT PDU in hex ended by Ctrl-Z
+    ATC_USOCTL_SENT,    //AT+USOCTL=<socket>,2, total bytes sent on the socket
+    ATC_USOCTL_RECEIVED,//AT+USOCTL=<socket>,3, total bytes received on the socket
     
     
     ATC_LAST_POS,
@@ -140,4 +159,33 @@ extern ATCOMMAND_STRUCT CelluarATCommands[ATC_LAST_POS];
 //
 //------------------------------------------------------------------------------
 uint32_t CreateUARTTXdata(ATCOMMAND_INDEX_ENUM cmdIndex, uint8_t Buffer[], uint32_t buffSize);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularParseNetworkTimeURC(uint8_t const response[])
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function update RTC from the NITZ network time URC enabled by
+//!  AT+CTZU=1 and AT+CTZR, +CTZE: <tz>,<dst>,"<time>" or +CTZV: <tz>,"<time>"
+//!
+//! \return 0 when a complete URC was found, ERR_INCOMPLETE_DATA_RECEIVED otherwise
+//
+//------------------------------------------------------------------------------
+int32_t CellularParseNetworkTimeURC(uint8_t const response[]);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularParseSocketConnectURC(uint8_t const response[], uint32_t socket)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function look for +UUSOCO: <socket>,<socket_error>, the result of
+//!  an asynchronous connect of the socket
+//!
+//! \return 0 when connected, ERR_UNABLE_TO_OPEN_TCP_SOCK when the connect
+//!  failed, ERR_INCOMPLETE_DATA_RECEIVED while the URC is not there
+//
+//------------------------------------------------------------------------------
+int32_t CellularParseSocketConnectURC(uint8_t const response[], uint32_t socket);
 #endif
\ No newline at end of file
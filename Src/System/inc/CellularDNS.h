@@ -0,0 +1,224 @@
+//==============================================================================
+//
+//  CellularDNS.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularDNS.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used to cache the address of the iNet host. The host is resolved with
+//! AT+UDNSRN and sockets connect to the cached address, so the module does
+//! not resolve it again on every connect.
+//
+
+#ifndef CELLULARDNS_H
+#define CELLULARDNS_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+
+#include "Cellular.h"
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+/*
+Host address record in DataFlash (Sector 3):
+
+Page 775        | CellularDNSRecord_t
+*/
+#define CELL_DNS_PAGE_NUMBER                775u
+
+#define CELL_DNS_MAGIC                      0x43534E44u         //!< "DNSC"
+#define CELL_DNS_VERSION                    1u
+
+#define CELL_DNS_TTL_S                      3600u               //!< +UDNSRN gives no TTL, lookup is refreshed after this
+#define CELL_DNS_HOST_SIZE                  48u
+#define CELL_DNS_DIAGNOSTIC_SIZE            20u
+
+//---------------------- Host Address Cache Error Codes ------------------------
+
+#define ERR_CELL_DNS_RECORD_INVALID         (-260)
+#define ERR_CELL_DNS_PARSE_FAILED           (-261)
+#define ERR_CELL_DNS_NOT_AVAILABLE          (-262)
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+//! Persisted host address, fits one DataFlash page
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    char     host[CELL_DNS_HOST_SIZE];      //!< Host the address belongs to
+    char     address[IP_ADDR_LEN + 1u];     //!< Dotted IPv4, empty when none
+    uint32_t resolvedTime;                  //!< RTC time of the lookup, 0 when the RTC was not synced
+    uint32_t averageResolveMs;              //!< Lookup time, also what a connect by host name costs
+}CellularDNSRecord_t;
+
+typedef struct
+{
+    uint32_t resolves;
+    uint32_t resolveFailures;
+    uint32_t lastResolveMs;
+    uint32_t cachedConnects;                //!< Connects to the cached address
+    uint32_t cachedConnectFailures;
+    uint32_t savedMs;                       //!< Lookup time not spent by cached connects
+}CellularDNSStats_t;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  int32_t CellularDNSLoadFromFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read the cached address, called from SysTask at start up
+//
+//------------------------------------------------------------------------------
+int32_t CellularDNSLoadFromFlash(void);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularDNSSaveToFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the record snapshot taken after a lookup. Called from
+//!  SysTask which owns the DataFlash.
+//
+//------------------------------------------------------------------------------
+int32_t CellularDNSSaveToFlash(void);
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularDNSIsCached(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when sockets connect to a cached address
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularDNSIsCached(void);
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularDNSIsExpired(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when the host should be looked up again, no
+//!  address, older than CELL_DNS_TTL_S or of unknown age
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularDNSIsExpired(void);
+
+//------------------------------------------------------------------------------
+//  char const* CellularDNSGetAddress(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the cached address, or the host name when none
+//
+//------------------------------------------------------------------------------
+char const* CellularDNSGetAddress(void);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularDNSParseResolve(uint8_t const response[], uint32_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse the address from +UDNSRN: "<IP address>"
+//!
+//! \return 0, ERR_INCOMPLETE_DATA_RECEIVED until OK or
+//!         ERR_CELL_DNS_PARSE_FAILED when it is no IPv4 address
+//
+//------------------------------------------------------------------------------
+int32_t CellularDNSParseResolve(uint8_t const response[], uint32_t length);
+
+//------------------------------------------------------------------------------
+//  void CellularDNSRecordResolve(BOOLEAN isResolved, uint32_t resolveMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function cache the address parsed last and ask SysTask to persist it
+//
+//------------------------------------------------------------------------------
+void CellularDNSRecordResolve(BOOLEAN isResolved, uint32_t resolveMs);
+
+//------------------------------------------------------------------------------
+//  void CellularDNSRecordConnect(BOOLEAN isConnected)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record a connect to the cached address. A failed one drops
+//!  the address, the host may have moved.
+//
+//------------------------------------------------------------------------------
+void CellularDNSRecordConnect(BOOLEAN isConnected);
+
+//------------------------------------------------------------------------------
+//  CellularDNSStats_t const* CellularDNSGetStats(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns lookup and cached connect counts
+//
+//------------------------------------------------------------------------------
+CellularDNSStats_t const* CellularDNSGetStats(void);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularDNSGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the cached address and lookup statistics for the
+//!  radio configuration readout, big endian
+//!
+//! \return bytes written or ERR_CELL_DNS_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularDNSGetDiagnostics(uint8_t buffer[], uint32_t bufferSize);
+
+#endif
@@ -0,0 +1,142 @@
+//==============================================================================
+//
+//  CellularIdentity.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularIdentity.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used to cache the module identity. IMEI, firmware revision and the
+//! ICCID they were read with are kept in DataFlash. Only the ICCID is queried
+//! on each init, the rest is queried again after a SIM swap.
+//
+
+#ifndef CELLULARIDENTITY_H
+#define CELLULARIDENTITY_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+
+#include "Cellular.h"
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+/*
+Module identity record in DataFlash (Sector 3):
+
+Page 774        | CellularIdentityRecord_t
+*/
+#define CELL_IDENTITY_PAGE_NUMBER           774u
+
+#define CELL_IDENTITY_MAGIC                 0x4E444943u         //!< "CIDN"
+#define CELL_IDENTITY_VERSION               1u
+
+#define CELL_IDENTITY_VERIFY_INITS          32u                 //!< Full identity query every this many inits
+
+//---------------------- Module Identity Error Codes ---------------------------
+
+#define ERR_CELL_IDENTITY_RECORD_INVALID    (-250)
+#define ERR_CELL_IDENTITY_SIM_CHANGED       (-251)
+#define ERR_CELL_IDENTITY_VERIFY_DUE        (-252)
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+//! Persisted identity, written once all of it was queried successfully
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    uint8_t  imei[CELLULAR_IMEI_LENGTH + 1u];
+    uint8_t  iccid[CELLULAR_ICCID_LENGTH + 1u];
+    uint8_t  firmware[CELLULAR_FIRMWARE_LENGTH + 1u];
+}CellularIdentityRecord_t;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  int32_t CellularIdentityLoadFromFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read the cached identity, called from SysTask at start up
+//
+//------------------------------------------------------------------------------
+int32_t CellularIdentityLoadFromFlash(void);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularIdentitySaveToFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the record snapshot taken by CellularIdentityUpdate.
+//!  Called from SysTask which owns the DataFlash.
+//
+//------------------------------------------------------------------------------
+int32_t CellularIdentitySaveToFlash(void);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularIdentityRestore(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function compare the ICCID just read with the cached one and, when
+//!  it matches, fill IMEI and firmware revision of the driver from the cache
+//!
+//! \return 0, ERR_CELL_IDENTITY_RECORD_INVALID, ERR_CELL_IDENTITY_SIM_CHANGED
+//!         or ERR_CELL_IDENTITY_VERIFY_DUE when the identity must be queried
+//
+//------------------------------------------------------------------------------
+int32_t CellularIdentityRestore(void);
+
+//------------------------------------------------------------------------------
+//  void CellularIdentityUpdate(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function cache the identity queried from the module and ask SysTask
+//!  to persist it when it changed
+//
+//------------------------------------------------------------------------------
+void CellularIdentityUpdate(void);
+
+#endif
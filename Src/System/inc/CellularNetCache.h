@@ -0,0 +1,293 @@
+//==============================================================================
+//
+//  CellularNetCache.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularNetCache.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used to cache the network of the last registration. Operator and band
+//! are kept in DataFlash, the next attach is tried on that band and operator
+//! only and falls back to a full scan when it fails.
+//
+
+#ifndef CELLULARNETCACHE_H
+#define CELLULARNETCACHE_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+
+#include "main.h"
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+/*
+Network cache record in DataFlash (Sector 3):
+
+Page 773        | CellularNetCacheRecord_t
+*/
+#define CELL_NET_CACHE_PAGE_NUMBER          773u
+
+#define CELL_NET_CACHE_MAGIC                0x4341434Eu         //!< "NCAC"
+#define CELL_NET_CACHE_VERSION              1u
+
+#define CELL_NET_CACHE_ATTACH_TIMEOUT_MS    30000u              //!< Manual selection on the cached band
+#define CELL_NET_CACHE_MAX_FAILURES         3u                  //!< Cache is skipped after this many failed attaches in a row
+#define CELL_NET_CACHE_SAVE_INTERVAL_MS     3600000u            //!< Limits page erases
+#define CELL_NET_PLMN_LENGTH                6u                  //!< MCC and up to 3 MNC digits
+#define CELL_NET_CACHE_DIAGNOSTIC_SIZE      20u
+
+//! <rat> of AT+UBANDMASK
+#define CELL_BANDMASK_RAT_LTE_M             0u
+#define CELL_BANDMASK_RAT_NB_IOT            1u
+#define CELL_BANDMASK_RATS                  2u
+#define CELL_BANDMASK_RAT_NONE              0xFFu               //!< GPRS, bands are not restricted
+
+//---------------------- Network Cache Error Codes -----------------------------
+
+#define ERR_CELL_NET_CACHE_RECORD_INVALID   (-240)
+#define ERR_CELL_NET_CACHE_PARSE_FAILED     (-241)
+#define ERR_CELL_NET_CACHE_NOT_AVAILABLE    (-242)
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+typedef struct
+{
+    uint16_t attempts;
+    uint16_t successes;
+    uint32_t averageMs;             //!< Radio on to registration, successful attaches
+    uint32_t lastMs;                //!< Last attach, successful or not
+}CellularRegistrationStats_t;
+
+//! Persisted network cache, fits one DataFlash page
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    uint64_t fullMask[CELL_BANDMASK_RATS][2];   //!< +UBANDMASK bitmask1 and bitmask2 as configured in the module
+    char     plmn[CELL_NET_PLMN_LENGTH + 2u];   //!< Operator of the last registration, empty when none
+    uint8_t  bandMaskRat;           //!< CELL_BANDMASK_RAT_NONE when registered on GPRS
+    uint8_t  band;                  //!< E-UTRA band, 0 when unknown
+    uint8_t  isFullMaskValid;
+    uint8_t  consecutiveFailures;   //!< Failed cached attaches since the cache was last confirmed
+    CellularRegistrationStats_t cached;
+    CellularRegistrationStats_t fullScan;
+}CellularNetCacheRecord_t;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  int32_t CellularNetCacheLoadFromFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read the network cache, called from SysTask at start up
+//
+//------------------------------------------------------------------------------
+int32_t CellularNetCacheLoadFromFlash(void);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularNetCacheSaveToFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the record snapshot taken by
+//!  CellularNetCacheRequestSave. Called from SysTask which owns the DataFlash.
+//
+//------------------------------------------------------------------------------
+int32_t CellularNetCacheSaveToFlash(void);
+
+//------------------------------------------------------------------------------
+//  void CellularNetCacheRequestSave(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function snapshot a changed record and ask SysTask to persist it,
+//!  at most once per CELL_NET_CACHE_SAVE_INTERVAL_MS except for the first
+//
+//------------------------------------------------------------------------------
+void CellularNetCacheRequestSave(void);
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularNetCacheIsUsable(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when an operator is cached and the last
+//!  cached attaches did not keep failing
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularNetCacheIsUsable(void);
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularNetCacheIsFullMaskKnown(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true once the band masks of the module were read,
+//!  bands are never restricted before
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularNetCacheIsFullMaskKnown(void);
+
+//------------------------------------------------------------------------------
+//  void CellularNetCacheForgetOperator(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function drop the cached operator and band when the SIM card was
+//!  swapped, the next attach is a full scan
+//
+//------------------------------------------------------------------------------
+void CellularNetCacheForgetOperator(void);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularNetCacheCreateBandMaskCommand(uint8_t buffer[], uint32_t bufferSize, BOOLEAN isRestricted)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create the next AT+UBANDMASK needed to restrict the RAT of
+//!  the cache to the cached band or to restore the masks read from the
+//!  module. Call CellularNetCacheConfirmBandMask once it is accepted.
+//!
+//! \return command size, 0 when the masks are as wanted or
+//!         ERR_CELL_NET_CACHE_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularNetCacheCreateBandMaskCommand(uint8_t buffer[], uint32_t bufferSize, BOOLEAN isRestricted);
+
+//------------------------------------------------------------------------------
+//  void CellularNetCacheConfirmBandMask(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function note the AT+UBANDMASK created last as accepted by the module
+//
+//------------------------------------------------------------------------------
+void CellularNetCacheConfirmBandMask(void);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularNetCacheCreateSelectCommand(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create AT+COPS manual selection of the cached operator
+//!
+//! \return command size or ERR_CELL_NET_CACHE_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularNetCacheCreateSelectCommand(uint8_t buffer[], uint32_t bufferSize);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularNetCacheParseBandMask(uint8_t const response[], uint32_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse +UBANDMASK: <rat>,<bitmask1>[,<bitmask2>],... and
+//!  keep it as the full mask when none is held
+//!
+//! \return 0, ERR_INCOMPLETE_DATA_RECEIVED until OK or
+//!         ERR_CELL_NET_CACHE_PARSE_FAILED
+//
+//------------------------------------------------------------------------------
+int32_t CellularNetCacheParseBandMask(uint8_t const response[], uint32_t length);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularNetCacheParseCellInfo(uint8_t const response[], uint32_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse the operator and band of the serving cell from
+//!  +UCGED: 2 (<rat>,<svc>,<MCC>,<MNC> then <EARFCN>,<band>,...)
+//!
+//! \return 0, ERR_INCOMPLETE_DATA_RECEIVED until OK or
+//!         ERR_CELL_NET_CACHE_PARSE_FAILED
+//
+//------------------------------------------------------------------------------
+int32_t CellularNetCacheParseCellInfo(uint8_t const response[], uint32_t length);
+
+//------------------------------------------------------------------------------
+//  void CellularNetCacheRecordAttach(BOOLEAN isCached, BOOLEAN isRegistered, uint32_t attachMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record the registration time of a cached or full scan attach
+//
+//------------------------------------------------------------------------------
+void CellularNetCacheRecordAttach(BOOLEAN isCached, BOOLEAN isRegistered, uint32_t attachMs);
+
+//------------------------------------------------------------------------------
+//  void CellularNetCacheUpdate(uint8_t accessTechnology)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function cache the serving cell parsed last after a registration,
+//!  accessTechnology is the +COPS <AcT>
+//
+//------------------------------------------------------------------------------
+void CellularNetCacheUpdate(uint8_t accessTechnology);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularNetCacheGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the cached operator, band and the registration
+//!  statistics for the radio configuration readout, big endian
+//!
+//! \return CELL_NET_CACHE_DIAGNOSTIC_SIZE or ERR_CELL_NET_CACHE_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularNetCacheGetDiagnostics(uint8_t buffer[], uint32_t bufferSize);
+
+#endif
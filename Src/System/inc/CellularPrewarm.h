@@ -0,0 +1,200 @@
+//==============================================================================
+//
+//  CellularPrewarm.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularPrewarm.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used to warm the upload path up before an event is created. Instrument
+//! messages hinting at an upload soon switch the radio on and prepare the
+//! connection, which then stays up for CELL_PREWARM_HOLD_MS after the last hint.
+//
+
+#ifndef CELLULARPREWARM_H
+#define CELLULARPREWARM_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+
+#include "main.h"
+#include "SPI_Comm.h"
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define CELL_PREWARM_HOLD_MS                60000u      //!< Radio kept attached after the last hint
+#define CELL_PREWARM_RISING_MESSAGES        3u          //!< Instrument messages a reading moves away from normal in before it hints
+#define CELL_PREWARM_O2_NORMAL_READING      209         //!< 20.9 %VOL, normal reading of an oxygen sensor
+#define CELL_PREWARM_DIAGNOSTIC_SIZE        20u
+
+//---------------------- Pre-warm Error Codes ----------------------------------
+
+#define ERR_CELL_PREWARM_NOT_AVAILABLE      (-290)
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+typedef enum
+{
+    CELL_PREWARM_GAS_RISING = 0,        //!< A reading moves away from normal, still below alarm
+    CELL_PREWARM_LOW_ALARM,             //!< Low alarm may escalate to high alarm
+    CELL_PREWARM_PROXIMITY,             //!< Proximity alarms of a peer come in bursts
+    
+    CELL_PREWARM_REASON_COUNT,
+}CELL_PREWARM_REASON_t;
+
+typedef struct
+{
+    uint32_t hints[CELL_PREWARM_REASON_COUNT];
+    uint32_t warmups;                   //!< Hold windows the radio was attached for
+    uint32_t warmupFailures;            //!< Registration failed, the upload attaches itself
+    uint32_t hits;                      //!< Uploads that found the radio attached in a hold window
+    uint32_t misses;                    //!< Hold windows ended with no upload
+    uint32_t lastWarmupMs;              //!< Attach, lookup and token connect taken ahead
+    uint32_t savedMs;                   //!< Warm up time not spent by uploads
+}CellularPrewarmStats_t;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  void CellularPrewarmCheckSensors(InstSensorInfo_t const *sensorInfo)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function hint at an alarm coming when a sensor is in low alarm or
+//!  its reading moved away from normal for CELL_PREWARM_RISING_MESSAGES
+//!  instrument messages. Called from the SPI interrupt for each message.
+//
+//------------------------------------------------------------------------------
+void CellularPrewarmCheckSensors(InstSensorInfo_t const *sensorInfo);
+
+//------------------------------------------------------------------------------
+//  void CellularPrewarmHint(CELL_PREWARM_REASON_t reason)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function extend the hold window, the cellular task is asked to warm
+//!  up when the window opens
+//
+//------------------------------------------------------------------------------
+void CellularPrewarmHint(CELL_PREWARM_REASON_t reason);
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularPrewarmIsHeld(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true within CELL_PREWARM_HOLD_MS of the last hint
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularPrewarmIsHeld(void);
+
+//------------------------------------------------------------------------------
+//  uint32_t CellularPrewarmGetRemainingMs(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the time left in the hold window, 0 when closed
+//
+//------------------------------------------------------------------------------
+uint32_t CellularPrewarmGetRemainingMs(void);
+
+//------------------------------------------------------------------------------
+//  void CellularPrewarmRecordWarmup(BOOLEAN isAttached, uint32_t warmupMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record a warm up done by the cellular task
+//
+//------------------------------------------------------------------------------
+void CellularPrewarmRecordWarmup(BOOLEAN isAttached, uint32_t warmupMs);
+
+//------------------------------------------------------------------------------
+//  void CellularPrewarmRecordUpload(BOOLEAN isAttached)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record an upload starting, a hit when the radio is already
+//!  attached in a hold window
+//
+//------------------------------------------------------------------------------
+void CellularPrewarmRecordUpload(BOOLEAN isAttached);
+
+//------------------------------------------------------------------------------
+//  void CellularPrewarmRecordRelease(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record the radio switched off, a miss when the hold window
+//!  had no upload
+//
+//------------------------------------------------------------------------------
+void CellularPrewarmRecordRelease(void);
+
+//------------------------------------------------------------------------------
+//  CellularPrewarmStats_t const* CellularPrewarmGetStats(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the hint and warm up counts
+//
+//------------------------------------------------------------------------------
+CellularPrewarmStats_t const* CellularPrewarmGetStats(void);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularPrewarmGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the hint and warm up statistics for the radio
+//!  configuration readout, big endian
+//!
+//! \return CELL_PREWARM_DIAGNOSTIC_SIZE or ERR_CELL_PREWARM_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularPrewarmGetDiagnostics(uint8_t buffer[], uint32_t bufferSize);
+
+#endif
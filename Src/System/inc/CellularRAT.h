@@ -0,0 +1,249 @@
+//==============================================================================
+//
+//  CellularRAT.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularRAT.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used to select the radio access technology. Attach and connect time
+//! and success are measured per RAT, kept in DataFlash, and the AT+URAT
+//! preference is ordered by the expected energy of an upload.
+//
+
+#ifndef CELLULARRAT_H
+#define CELLULARRAT_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+
+#include "main.h"
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+/*
+RAT statistics record in DataFlash (Sector 3):
+
+Page 772        | CellularRATRecord_t
+*/
+#define CELL_RAT_PAGE_NUMBER                772u
+
+#define CELL_RAT_MAGIC                      0x53544152u         //!< "RATS"
+#define CELL_RAT_VERSION                    1u
+
+#define CELL_RAT_REPROBE_INTERVAL           16u                 //!< Every Nth attach the least recently measured RAT goes first
+#define CELL_RAT_EWMA_SHIFT                 2u                  //!< New sample weighs 1/4 in the averages
+#define CELL_RAT_SAVE_INTERVAL_MS           3600000u            //!< Limits page erases
+#define CELL_RAT_DIAGNOSTIC_SIZE            (CELL_RAT_COUNT * 13u)          //!< Order, then 12 bytes per RAT
+
+//! AT+COPS <AcT> values (3GPP TS 27.007)
+#define CELL_ACT_GSM                        0u
+#define CELL_ACT_EGPRS                      3u
+#define CELL_ACT_LTE                        7u
+#define CELL_ACT_EC_GSM_IOT                 8u
+#define CELL_ACT_NB_IOT                     9u
+#define CELL_ACT_UNKNOWN                    0xFFu
+
+//---------------------- Cellular RAT Error Codes ------------------------------
+
+#define ERR_CELL_RAT_RECORD_INVALID         (-230)
+#define ERR_CELL_RAT_BUFFER_TOO_SMALL       (-231)
+
+//! RATs in AT+URAT order of the module, value in the command is index + 7
+typedef enum
+{
+    CELL_RAT_LTE_M = 0,
+    CELL_RAT_NB_IOT,
+    CELL_RAT_GPRS,
+
+    CELL_RAT_COUNT,
+    CELL_RAT_UNKNOWN = CELL_RAT_COUNT,
+}CELL_RAT_t;
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+typedef struct
+{
+    uint16_t attachAttempts;        //!< Attaches with this RAT first in the order
+    uint16_t attachSuccesses;       //!< Registered on this RAT
+    uint16_t connectAttempts;       //!< Socket connects while registered on this RAT
+    uint16_t connectSuccesses;
+    uint32_t attachMs;              //!< Average time from radio on to registration
+    uint32_t connectMs;             //!< Average socket connect time
+    uint32_t lastMeasured;          //!< Attach count when the RAT was last tried
+}CellularRATStats_t;
+
+//! Persisted RAT record, fits one DataFlash page
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    uint32_t attachCount;           //!< Attaches measured, drives re-probing
+    uint8_t  order[CELL_RAT_COUNT]; //!< Preference chosen for the last attach
+    uint8_t  reserved;
+    CellularRATStats_t stats[CELL_RAT_COUNT];
+}CellularRATRecord_t;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  int32_t CellularRATLoadFromFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read the RAT record, called from SysTask at start up
+//
+//------------------------------------------------------------------------------
+int32_t CellularRATLoadFromFlash(void);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularRATSaveToFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the record snapshot taken by CellularRATRequestSave.
+//!  Called from SysTask which owns the DataFlash.
+//
+//------------------------------------------------------------------------------
+int32_t CellularRATSaveToFlash(void);
+
+//------------------------------------------------------------------------------
+//  void CellularRATRequestSave(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function snapshot a changed record and ask SysTask to persist it,
+//!  at most once per CELL_RAT_SAVE_INTERVAL_MS
+//
+//------------------------------------------------------------------------------
+void CellularRATRequestSave(void);
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularRATSelectOrder(BOOLEAN isModemReset)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function choose the RAT preference for the next attach, lowest
+//!  expected cost first or the probed RAT first every
+//!  CELL_RAT_REPROBE_INTERVAL attaches
+//!
+//! \return true when AT+URAT has to be sent
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularRATSelectOrder(BOOLEAN isModemReset);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularRATCreateCommand(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create AT+URAT with the selected order
+//!
+//! \return command size or ERR_CELL_RAT_BUFFER_TOO_SMALL
+//
+//------------------------------------------------------------------------------
+int32_t CellularRATCreateCommand(uint8_t buffer[], uint32_t bufferSize);
+
+//------------------------------------------------------------------------------
+//  void CellularRATRecordAttach(uint8_t accessTechnology, uint32_t attachMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record a registration, accessTechnology is the +COPS
+//!  <AcT>. RATs ahead of the registered one in the order count as failed.
+//
+//------------------------------------------------------------------------------
+void CellularRATRecordAttach(uint8_t accessTechnology, uint32_t attachMs);
+
+//------------------------------------------------------------------------------
+//  void CellularRATRecordAttachFailure(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record an attach that did not register on any RAT
+//
+//------------------------------------------------------------------------------
+void CellularRATRecordAttachFailure(void);
+
+//------------------------------------------------------------------------------
+//  void CellularRATRecordConnect(BOOLEAN isConnected, uint32_t connectMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record a socket connect on the RAT registered last
+//
+//------------------------------------------------------------------------------
+void CellularRATRecordConnect(BOOLEAN isConnected, uint32_t connectMs);
+
+//------------------------------------------------------------------------------
+//  uint32_t CellularRATGetCost(CELL_RAT_t rat)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the expected cost of a successful upload on a RAT,
+//!  attach and connect time weighted by radio current and divided by the
+//!  success rates
+//
+//------------------------------------------------------------------------------
+uint32_t CellularRATGetCost(CELL_RAT_t rat);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularRATGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the order and per RAT statistics for the radio
+//!  configuration readout, big endian
+//!
+//! \return CELL_RAT_DIAGNOSTIC_SIZE or ERR_CELL_RAT_BUFFER_TOO_SMALL
+//
+//------------------------------------------------------------------------------
+int32_t CellularRATGetDiagnostics(uint8_t buffer[], uint32_t bufferSize);
+
+#endif
@@ -0,0 +1,149 @@
+//==============================================================================
+//
+//  CellularSMS.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularSMS.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used to send alarms by SMS. An alarm event that iNet did not
+//! acknowledge within CELL_SMS_ALARM_DEADLINE_MS is summarized in one SMS to
+//! the configured cell numbers, while the event stays queued for iNet. The
+//! deadline is checked periodically, an upload failing checks it as well.
+//
+
+#ifndef CELLULARSMS_H
+#define CELLULARSMS_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+
+#include "main.h"
+#include "Event.h"
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define CELL_SMS_ALARM_DEADLINE_MS          45000u      //!< Alarm age after which a failed upload falls back to SMS
+#define CELL_SMS_ALARMS_CHECKED             4u          //!< Oldest alarms of the lane checked against the deadline
+#define CELL_SMS_CHECK_INTERVAL_MS          10000u      //!< Least time between two deadline checks posted
+#define CELL_SMS_MAX_TEXT_LENGTH            160u        //!< Septets of one SMS in the GSM 7 bit alphabet
+#define CELL_SMS_VALIDITY_PERIOD            0x0Bu       //!< Relative TP-VP, (11 + 1) * 5 minutes
+#define CELL_SMS_MAX_PDU_OCTETS             160u        //!< SMSC, SUBMIT header, address and 140 octets of text
+#define CELL_SMS_PDU_BUFFER_SIZE            ((2u * CELL_SMS_MAX_PDU_OCTETS) + 2u)  //!< Hex text, Ctrl-Z and null
+#define CELL_SMS_COMMAND_BUFFER_SIZE        16u         //!< "AT+CMGS=<length>\r"
+
+//---------------------- SMS Error Codes ---------------------------------------
+
+#define ERR_CELL_SMS_NO_RECIPIENT           (-280)
+#define ERR_CELL_SMS_BUFFER_TOO_SMALL       (-281)
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+typedef struct
+{
+    uint32_t alarmsSent;            //!< Alarms that reached at least one number
+    uint32_t alarmsFailed;          //!< Alarms due that reached no number
+    uint32_t messagesSent;          //!< +CMGS accepted, one per number
+    uint32_t lastAlarmAgeMs;        //!< Alarm age when its SMS was sent
+}CellularSMSStats_t;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularSMSIsAlarmDue(PTR_COMM_EVT_t commEvent)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true for an alarm event older than the deadline
+//!  that was not sent by SMS yet
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularSMSIsAlarmDue(PTR_COMM_EVT_t commEvent);
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularSMSIsDeadlinePassed(uint32_t createdTicks)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when an alarm created at createdTicks is
+//!  older than the deadline and was not sent by SMS yet
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularSMSIsDeadlinePassed(uint32_t createdTicks);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularSMSCreatePDU(PTR_COMM_EVT_t commEvent, uint8_t const number[], uint8_t cmdBuffer[], uint32_t cmdBufferSize, uint8_t pduBuffer[], uint32_t pduBufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the AT+CMGS command and the SMS-SUBMIT PDU in hex,
+//!  ended by Ctrl-Z, summarizing the alarm for the number given
+//!
+//! \return PDU text length, ERR_CELL_SMS_NO_RECIPIENT when the number holds
+//!  no digit or ERR_CELL_SMS_BUFFER_TOO_SMALL
+//
+//------------------------------------------------------------------------------
+int32_t CellularSMSCreatePDU(PTR_COMM_EVT_t commEvent, uint8_t const number[], uint8_t cmdBuffer[], uint32_t cmdBufferSize, uint8_t pduBuffer[], uint32_t pduBufferSize);
+
+//------------------------------------------------------------------------------
+//  void CellularSMSRecordAlarm(PTR_COMM_EVT_t commEvent, uint32_t messagesSent)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function count the messages sent for an alarm due, once one went
+//!  out the alarm is not due anymore
+//
+//------------------------------------------------------------------------------
+void CellularSMSRecordAlarm(PTR_COMM_EVT_t commEvent, uint32_t messagesSent);
+
+//------------------------------------------------------------------------------
+//  CellularSMSStats_t const* CellularSMSGetStats(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the SMS fallback counts
+//
+//------------------------------------------------------------------------------
+CellularSMSStats_t const* CellularSMSGetStats(void);
+
+#endif
@@ -0,0 +1,202 @@
+//==============================================================================
+//
+//  CellularTLS.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularTLS.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used to follow the TLS handshakes of the module. The security profile
+//! asks the module to resume sessions, connects that can resume one are timed
+//! apart from full handshakes. It also offers one cipher suite, the cheapest
+//! of a preference list that the firmware and the server accept.
+//
+
+#ifndef CELLULARTLS_H
+#define CELLULARTLS_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+
+#include "main.h"
+#include "CellularATCommands.h"
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define CELL_TLS_SUITE_COUNT                3u
+#define CELL_TLS_SUITE_MAX_FAILURES         2u          //!< Failed full handshakes in a row before the next suite
+#define CELL_TLS_DIAGNOSTIC_SIZE            (19u + (8u * CELL_TLS_SUITE_COUNT))
+
+//---------------------- TLS Error Codes ---------------------------------------
+
+#define ERR_CELL_TLS_NOT_AVAILABLE          (-270)
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+typedef struct
+{
+    uint32_t attempts;
+    uint32_t failures;
+    uint32_t averageMs;             //!< Socket connect including the handshake, successful ones
+    uint32_t lastMs;
+}CellularTLSHandshakeStats_t;
+
+typedef struct
+{
+    BOOLEAN isResumptionEnabled;    //!< Security profile accepted session resumption
+    uint8_t suite;                  //!< Index of the cipher suite offered, in order of preference
+    uint8_t suiteFailures;          //!< Failed full handshakes in a row with that suite
+    CellularTLSHandshakeStats_t full;
+    CellularTLSHandshakeStats_t resumable;  //!< Connects after a successful one with resumption on
+    CellularTLSHandshakeStats_t suites[CELL_TLS_SUITE_COUNT];   //!< Full handshakes per suite offered
+}CellularTLSStats_t;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  void CellularTLSReset(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function forget the session and the profile options, the module
+//!  was reset and loses both
+//
+//------------------------------------------------------------------------------
+void CellularTLSReset(void);
+
+//------------------------------------------------------------------------------
+//  void CellularTLSSetResumption(BOOLEAN isEnabled)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record whether the security profile took session
+//!  resumption, firmware without it rejects the option
+//
+//------------------------------------------------------------------------------
+void CellularTLSSetResumption(BOOLEAN isEnabled);
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularTLSIsSuitePending(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when the security profile does not hold the
+//!  cipher suite to offer yet
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularTLSIsSuitePending(void);
+
+//------------------------------------------------------------------------------
+//  ATCOMMAND_INDEX_ENUM CellularTLSGetSuiteCommand(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the AT+USECPRF op code 2 command of the suite to
+//!  offer
+//
+//------------------------------------------------------------------------------
+ATCOMMAND_INDEX_ENUM CellularTLSGetSuiteCommand(void);
+
+//------------------------------------------------------------------------------
+//  void CellularTLSSetSuiteApplied(BOOLEAN isAccepted)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record the result of the suite command, a rejected suite
+//!  is skipped and the next one becomes pending
+//
+//------------------------------------------------------------------------------
+void CellularTLSSetSuiteApplied(BOOLEAN isAccepted);
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularTLSIsResumable(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when the next connect can resume the session
+//!  of the last successful one
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularTLSIsResumable(void);
+
+//------------------------------------------------------------------------------
+//  void CellularTLSRecordHandshake(BOOLEAN isResumable, BOOLEAN isConnected, uint32_t connectMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record a secure socket connect, isResumable as returned by
+//!  CellularTLSIsResumable before it. A suite failing
+//!  CELL_TLS_SUITE_MAX_FAILURES full handshakes in a row is left for the next.
+//
+//------------------------------------------------------------------------------
+void CellularTLSRecordHandshake(BOOLEAN isResumable, BOOLEAN isConnected, uint32_t connectMs);
+
+//------------------------------------------------------------------------------
+//  CellularTLSStats_t const* CellularTLSGetStats(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the handshake statistics
+//
+//------------------------------------------------------------------------------
+CellularTLSStats_t const* CellularTLSGetStats(void);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularTLSGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the profile options, the suite offered and the
+//!  full, resumable and per suite handshake statistics for the radio
+//!  configuration readout, big endian
+//!
+//! \return bytes written or ERR_CELL_TLS_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularTLSGetDiagnostics(uint8_t buffer[], uint32_t bufferSize);
+
+#endif
@@ -0,0 +1,213 @@
+//==============================================================================
+//
+//  CellularTiming.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularTiming.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used to time the phases of each upload. A transaction is one HTTP
+//! request on a socket, from the radio switched on or from the previous
+//! request of the batch up to the direct link left.
+//
+
+#ifndef CELLULARTIMING_H
+#define CELLULARTIMING_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+
+#include "main.h"
+#include "Event.h"
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define CELL_TIMING_HISTORY                 16u         //!< Transactions the percentiles are taken over
+#define CELL_TIMING_DIAGNOSTIC_SIZE         78u
+#define CELL_TIMING_LAST_DIAGNOSTIC_SIZE    24u
+
+//---------------------- Timing Error Codes ------------------------------------
+
+#define ERR_CELL_TIMING_NOT_AVAILABLE       (-310)
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+// Each phase ends at its mark and starts at the previous mark reached
+typedef enum
+{
+    CELL_TIMING_RADIO_ON = 0,           //!< CFUN=1 answered
+    CELL_TIMING_REGISTERED,             //!< Registration reported
+    CELL_TIMING_SOCKET_CREATED,         //!< +USOCR and socket options set
+    CELL_TIMING_CONNECTED,              //!< +USOCO answered, host lookup, TCP and TLS in the module
+    CELL_TIMING_LINK_OPEN,              //!< CONNECT of +USODL, a token fetched on the second socket meanwhile included
+    CELL_TIMING_HEADER_WRITTEN,
+    CELL_TIMING_BODY_WRITTEN,
+    CELL_TIMING_FIRST_RESPONSE,         //!< First response bytes returned by the UART driver
+    CELL_TIMING_LAST_RESPONSE,          //!< Response complete
+    CELL_TIMING_CLOSED,                 //!< "+++" answered and the socket read
+    
+    CELL_TIMING_PHASE_COUNT,
+}CELL_TIMING_PHASE_t;
+
+typedef struct
+{
+    COMM_EVT_TYPE_t evtType;
+    BOOLEAN  isCompleted;               //!< Response received and the link left
+    uint32_t startTicks;
+    uint32_t markTicks[CELL_TIMING_PHASE_COUNT];
+    uint32_t phaseMs[CELL_TIMING_PHASE_COUNT];      //!< 0 for a phase not gone through, e.g. attached already
+    uint32_t totalMs;
+}CellularTimingTransaction_t;
+
+typedef struct
+{
+    uint32_t transactions;              //!< Completed
+    uint32_t failures;
+    uint32_t samples[CELL_TIMING_PHASE_COUNT];      //!< Transactions in the history that went through the phase
+    uint32_t p50Ms[CELL_TIMING_PHASE_COUNT];
+    uint32_t p90Ms[CELL_TIMING_PHASE_COUNT];
+    uint32_t maxMs[CELL_TIMING_PHASE_COUNT];
+    uint32_t totalP50Ms;
+    uint32_t totalP90Ms;
+}CellularTimingStats_t;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  void CellularTimingBegin(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function start a transaction. One open already, the attach of the
+//!  batch, is continued by its first request.
+//
+//------------------------------------------------------------------------------
+void CellularTimingBegin(void);
+
+//------------------------------------------------------------------------------
+//  void CellularTimingMark(CELL_TIMING_PHASE_t phase)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record the end of a phase. Marks of the later phases are
+//!  cleared, a request on another socket in between starts them over.
+//
+//------------------------------------------------------------------------------
+void CellularTimingMark(CELL_TIMING_PHASE_t phase);
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularTimingIsMarked(CELL_TIMING_PHASE_t phase)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when the phase ended in the open transaction
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularTimingIsMarked(CELL_TIMING_PHASE_t phase);
+
+//------------------------------------------------------------------------------
+//  void CellularTimingEnd(COMM_EVT_TYPE_t evtType, BOOLEAN isSuccess)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function close the transaction and turn its marks into phase times.
+//!  A completed one is added to the history and the percentiles updated.
+//
+//------------------------------------------------------------------------------
+void CellularTimingEnd(COMM_EVT_TYPE_t evtType, BOOLEAN isSuccess);
+
+//------------------------------------------------------------------------------
+//  void CellularTimingCancel(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function drop the open transaction, a batch that sent nothing
+//
+//------------------------------------------------------------------------------
+void CellularTimingCancel(void);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularTimingGetLastDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the transaction closed last for the radio
+//!  configuration readout: event type, completed flag, then big endian 16 bit
+//!  ms of each phase and of the whole transaction, saturating
+//!
+//! \return CELL_TIMING_LAST_DIAGNOSTIC_SIZE or ERR_CELL_TIMING_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularTimingGetLastDiagnostics(uint8_t buffer[], uint32_t bufferSize);
+
+//------------------------------------------------------------------------------
+//  CellularTimingStats_t const* CellularTimingGetStats(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the phase percentiles over the history, each taken
+//!  over the transactions that went through the phase
+//
+//------------------------------------------------------------------------------
+CellularTimingStats_t const* CellularTimingGetStats(void);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularTimingGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the timing record for the radio configuration
+//!  readout: completed and failed transactions, then of each phase the number
+//!  of transactions that went through it in one byte with p50, p90 and max in
+//!  ms, then p50 and p90 of the whole transaction. Times and counts are big
+//!  endian 16 bit, saturating.
+//!
+//! \return CELL_TIMING_DIAGNOSTIC_SIZE or ERR_CELL_TIMING_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularTimingGetDiagnostics(uint8_t buffer[], uint32_t bufferSize);
+
+#endif
@@ -0,0 +1,200 @@
+//==============================================================================
+//
+//  CellularUsage.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularUsage.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used to account the cellular bytes. UART and socket bytes are counted
+//! by category for each event type, so the cost of headers, token requests
+//! and reconnects can be told apart.
+//
+
+#ifndef CELLULARUSAGE_H
+#define CELLULARUSAGE_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+
+#include "main.h"
+#include "Event.h"
+#include "CellularATCommands.h"
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+// Handshake bytes measured by Tools/TLSBench, taken when +USOCTL reports none
+#define CELL_USAGE_TLS_FULL_SENT            420u        //!< ClientHello, key exchange and Finished
+#define CELL_USAGE_TLS_FULL_RECEIVED        5180u       //!< ServerHello, certificate chain and Finished
+#define CELL_USAGE_TLS_RESUMED_SENT         240u
+#define CELL_USAGE_TLS_RESUMED_RECEIVED     140u
+
+#define CELL_USAGE_NO_EVENT                 LAST_IINVALID_EVENT     //!< Traffic outside an upload
+#define CELL_USAGE_SLOT_COUNT               ((uint32_t)LAST_IINVALID_EVENT + 1u)
+#define CELL_USAGE_DIAGNOSTIC_SIZE          79u
+
+//---------------------- Usage Error Codes -------------------------------------
+
+#define ERR_CELL_USAGE_NOT_AVAILABLE        (-300)
+#define ERR_CELL_USAGE_PARSE_FAILED         (-301)
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+typedef enum
+{
+    CELL_USAGE_AT_SENT = 0,             //!< AT commands on the UART, not billed
+    CELL_USAGE_AT_RECEIVED,
+    CELL_USAGE_TLS_SENT,                //!< Handshake, socket bytes after the connect
+    CELL_USAGE_TLS_RECEIVED,
+    CELL_USAGE_HEADER_SENT,             //!< HTTP request header
+    CELL_USAGE_PAYLOAD_SENT,            //!< HTTP request body
+    CELL_USAGE_RESPONSE_RECEIVED,       //!< HTTP response, header and body
+    
+    CELL_USAGE_CATEGORY_COUNT,
+}CELL_USAGE_CATEGORY_t;
+
+typedef struct
+{
+    uint32_t bytes[CELL_USAGE_CATEGORY_COUNT];
+    uint32_t connects;                  //!< Sockets connected, one TLS handshake each
+    uint32_t estimatedHandshakes;       //!< Connects +USOCTL reported nothing for
+    uint32_t linkMs;                    //!< Time in direct link, socket data on the air
+}CellularUsageCounters_t;
+
+typedef struct
+{
+    CellularUsageCounters_t slots[CELL_USAGE_SLOT_COUNT];  //!< Per COMM_EVT_TYPE_t, CELL_USAGE_NO_EVENT last
+    uint32_t radioOnMs;                 //!< CFUN=1 to CFUN=0
+}CellularUsageStats_t;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  COMM_EVT_TYPE_t CellularUsageSetEvent(COMM_EVT_TYPE_t evtType)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function charge the bytes from now on to the event type given,
+//!  CELL_USAGE_NO_EVENT outside an upload
+//!
+//! \return event type charged before, to be set back
+//
+//------------------------------------------------------------------------------
+COMM_EVT_TYPE_t CellularUsageSetEvent(COMM_EVT_TYPE_t evtType);
+
+//------------------------------------------------------------------------------
+//  void CellularUsageRecordSent(ATCOMMAND_INDEX_ENUM atIndex, uint32_t count)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function count bytes written to the UART. The header and the body
+//!  go to the socket in direct link, anything else is AT control.
+//
+//------------------------------------------------------------------------------
+void CellularUsageRecordSent(ATCOMMAND_INDEX_ENUM atIndex, uint32_t count);
+
+//------------------------------------------------------------------------------
+//  void CellularUsageRecordReceived(ATCOMMAND_INDEX_ENUM atIndex, uint32_t count)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function count bytes read from the UART, the HTTP response while
+//!  the header or the body is written in direct link
+//
+//------------------------------------------------------------------------------
+void CellularUsageRecordReceived(ATCOMMAND_INDEX_ENUM atIndex, uint32_t count);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularUsageParseSocketCounter(uint8_t const response[], uint32_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse +USOCTL: <socket>,<param_id>,<param_val> for the
+//!  total bytes sent (2) or received (3)
+//!
+//! \return 0, ERR_INCOMPLETE_DATA_RECEIVED until OK or
+//!         ERR_CELL_USAGE_PARSE_FAILED
+//
+//------------------------------------------------------------------------------
+int32_t CellularUsageParseSocketCounter(uint8_t const response[], uint32_t length);
+
+//------------------------------------------------------------------------------
+//  void CellularUsageRecordHandshake(BOOLEAN isResumable)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function count a connect and its handshake, the socket bytes parsed
+//!  since the previous connect. Module firmware counting the application
+//!  bytes only reports none, the TLSBench figures of the kind are taken then.
+//
+//------------------------------------------------------------------------------
+void CellularUsageRecordHandshake(BOOLEAN isResumable);
+
+//------------------------------------------------------------------------------
+//  CellularUsageStats_t const* CellularUsageGetStats(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the byte counts per event type and category
+//
+//------------------------------------------------------------------------------
+CellularUsageStats_t const* CellularUsageGetStats(void);
+
+//------------------------------------------------------------------------------
+//  int32_t CellularUsageGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the compact usage record for the radio configuration
+//!  readout, big endian: 24 bit byte counts per category of the token,
+//!  register and upload events, AT control bytes outside events, connects
+//!  per event type and the radio on time in seconds
+//!
+//! \return CELL_USAGE_DIAGNOSTIC_SIZE or ERR_CELL_USAGE_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularUsageGetDiagnostics(uint8_t buffer[], uint32_t bufferSize);
+
+#endif
@@ -20,6 +20,11 @@
 #define GET_EVENT_FROM_COMM_QUEUE()                     GetOneEventFromQueue(eventQueueHandle)
 
 #define MAX_SENSORS_PER_INSTRUMENT              7u
+#define ALL_SENSORS_CHANGED_MASK                0xFFu
+
+#define EVENT_LATENCY_DIAGNOSTIC_SIZE           (EVENT_PRIORITY_LAST * 16u)   //!< Count, average, max and last per class
+
+#define ERR_EVENT_LATENCY_NOT_AVAILABLE         (-320)
 
 
 #define MAX_ALLOWED_INSTRUMENT_SERIAL_NUMBER    16u
@@ -122,14 +127,38 @@ typedef enum
 }COMM_EVT_TYPE_t;
 
 
+//! Upload priority class of an instrument event. Lower value is more urgent,
+//! alarm events travel on their own queue lane and bypass the batching timer
+typedef enum
+{
+    EVENT_PRIORITY_ALARM        = 0,
+    EVENT_PRIORITY_STATE_CHANGE = 1,
+    EVENT_PRIORITY_PERIODIC     = 2,
+    EVENT_PRIORITY_LAST,
+}EVENT_PRIORITY_t;
+
+//! Event creation to iNet acknowledge latency, accumulated per priority class
+typedef struct
+{
+    uint32_t eventsSent;
+    uint32_t totalLatencyTicks;
+    uint32_t maxLatencyTicks;
+    uint32_t lastLatencyTicks;
+}EventLatencyStats_t;
+
 typedef struct
 {
     Event_t evtObj;
     COMM_EVT_TYPE_t commEvtType;
+    EVENT_PRIORITY_t priority;
+    uint32_t createdTicks;
+    uint8_t changedSensorsMask;     //!< Bit per sensor slot to be uploaded, ALL_SENSORS_CHANGED_MASK for full snapshot
     uint8_t sequenceNumber;
     INSTRUMENT_STATUS_t InstrumentState;
     InstSensorInfo_t instSensorInfo;
     GPSInfo_t GPSLocationInfo;
+    uint16_t geofenceSet;           //!< Version of the fence set held, 0 for none
+    uint8_t geofenceId;             //!< Zone at event creation, GEOFENCE_ID_NONE outside
     DateTimeInfo_t dateTimeInfo;
 }ComEvent_t;
 
@@ -207,6 +236,150 @@ ComEvent_t* GetEventMessageFromPool(void);
 //------------------------------------------------------------------------------
 void ReturnEventMessageToPool(ComEvent_t* msg, BOOLEAN isEventSent);
 
+//------------------------------------------------------------------------------
+//  EVENT_PRIORITY_t GetEventPriority(INSTRUMENT_STATUS_t instrumentState, InstSensorInfo_t const *sensorInfo, BOOLEAN isPeriodic)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function classify the event priority from instrument and sensors status
+//
+//------------------------------------------------------------------------------
+EVENT_PRIORITY_t GetEventPriority(INSTRUMENT_STATUS_t instrumentState, InstSensorInfo_t const *sensorInfo, BOOLEAN isPeriodic);
+
+//------------------------------------------------------------------------------
+//  void PostEventToQueue(ComEvent_t* msg)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function post the Event to the queue lane of its priority class
+//
+//------------------------------------------------------------------------------
+void PostEventToQueue(ComEvent_t* msg);
+
+//------------------------------------------------------------------------------
+//  ComEvent_t* GetNextEventFromQueue(OS_TICK timeout)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function get the most urgent pending Event, alarm lane is served first
+//
+//------------------------------------------------------------------------------
+ComEvent_t* GetNextEventFromQueue(OS_TICK timeout);
+
+//------------------------------------------------------------------------------
+//  uint32_t GetPendingEventsCount(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the number of events waiting in all queue lanes
+//
+//------------------------------------------------------------------------------
+uint32_t GetPendingEventsCount(void);
+
+//------------------------------------------------------------------------------
+//  uint32_t GetPendingAlarmsTicks(uint32_t createdTicks[], uint32_t maxCount)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function copy the creation ticks of the alarm events waiting in
+//!  their lane, oldest first, maxCount at most
+//!
+//! \return number of alarms copied
+//
+//------------------------------------------------------------------------------
+uint32_t GetPendingAlarmsTicks(uint32_t createdTicks[], uint32_t maxCount);
+
+//------------------------------------------------------------------------------
+//  ComEvent_t* GetNextAlarmFromQueue(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function get the oldest alarm event without waiting, the caller
+//!  gives it back with ReturnEventMessageToPool
+//
+//------------------------------------------------------------------------------
+ComEvent_t* GetNextAlarmFromQueue(void);
+
+//------------------------------------------------------------------------------
+//  ComEvent_t* GetPendingPeriodicEvent(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the periodic Event still waiting in queue, if any,
+//!  so a newer periodic snapshot can be merged into it
+//
+//------------------------------------------------------------------------------
+ComEvent_t* GetPendingPeriodicEvent(void);
+
+//------------------------------------------------------------------------------
+//  uint8_t GetChangedSensorsMask(InstSensorInfo_t const *sensorInfo)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function compare sensors with the last snapshot delivered to iNet and
+//!  returns bit mask of the sensors whose status changed or reading drifted
+//
+//------------------------------------------------------------------------------
+uint8_t GetChangedSensorsMask(InstSensorInfo_t const *sensorInfo);
+
+//------------------------------------------------------------------------------
+//  BOOLEAN IsHeartbeatDue(uint32_t secondsSince1970)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when nothing is delivered to iNet for the
+//!  heartbeat interval, a longer one while the instrument stays in a
+//!  geofence zone as its position is already known to iNet
+//
+//------------------------------------------------------------------------------
+BOOLEAN IsHeartbeatDue(uint32_t secondsSince1970);
+
+//------------------------------------------------------------------------------
+//  void RecordEventLatency(ComEvent_t const* msg)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function accumulate the creation to upload latency of a sent Event
+//
+//------------------------------------------------------------------------------
+void RecordEventLatency(ComEvent_t const* msg);
+
+//------------------------------------------------------------------------------
+//  EventLatencyStats_t const* GetEventLatencyStats(EVENT_PRIORITY_t priority)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the latency statistics of a priority class
+//
+//------------------------------------------------------------------------------
+EventLatencyStats_t const* GetEventLatencyStats(EVENT_PRIORITY_t priority);
+
+//------------------------------------------------------------------------------
+//  int32_t GetEventLatencyDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the latency record for the radio configuration
+//!  readout, big endian 32 bit per priority class, alarm first: events sent,
+//!  then average, max and last creation to iNet acknowledge latency in ms
+//!
+//! \return EVENT_LATENCY_DIAGNOSTIC_SIZE or ERR_EVENT_LATENCY_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t GetEventLatencyDiagnostics(uint8_t buffer[], uint32_t bufferSize);
+
 
 
 #endif /* __EVENT_H */
\ No newline at end of file
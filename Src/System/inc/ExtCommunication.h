@@ -114,12 +114,17 @@ extern uint8_t const inetwasdev1Cert[];
 void GetCurrentTimeAndDate(DateTimeInfo_t *currentTime);
 
 //------------------------------------------------------------------------------
-//  int32_t CreateHttpHeader(uint8_t *buffer, uint32_t buffLen)
+//  int32_t CreateHttpHeader(COMM_EVT_TYPE_t evt, uint8_t *buffer, uint32_t buffLen, uint32_t contentLength)
 //
 //   Author:  Dilawar Ali
 //   Date:    2018/06/19
 //
-//!  This function Parse server response incase of Token event and update token buffer with valid received token
+//!  This function create the HTTP request header of the event type in buffer.
+//!  The header is formatted once per event type, URL and token, later
+//!  requests only write their Content-Length in place. A header that does
+//!  not fit leaves the buffer empty.
+//!
+//! \return header length or -1 when it does not fit
 //
 //------------------------------------------------------------------------------
 int32_t CreateHttpHeader(COMM_EVT_TYPE_t evt, uint8_t *buffer, uint32_t buffLen, uint32_t contentLength);
@@ -0,0 +1,217 @@
+//==============================================================================
+//
+//  GNSSAiding.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        GNSSAiding.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used to persist the last GNSS fix and UTC offset in DataFlash, inject
+//! them as UBX-MGA-INI aiding at power up and collect time to first fix.
+//
+
+#ifndef GNSSAIDING_H
+#define GNSSAIDING_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+
+#include "GPS.h"
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+/*
+Aiding record in DataFlash (Sector 3):
+
+Page 768        | GNSSAidingRecord_t
+*/
+#define GNSS_AIDING_PAGE_NUMBER             768u
+
+#define GNSS_AIDING_MAGIC                   0x44494147u         //!< "GAID"
+#define GNSS_AIDING_VERSION                 1u
+
+#define GNSS_AIDING_MAX_POSITION_AGE        (6u * 3600u)        //!< Seconds, older positions are not injected
+#define GNSS_AIDING_DRIFT_MM_PER_SECOND     2000u               //!< Assumed movement while GNSS is off
+#define GNSS_AIDING_TIME_ACCURACY_SECONDS   2u                  //!< Network time after RTC drift
+#define GNSS_AIDING_SAVE_INTERVAL_MS        3600000u            //!< Limits page erases when GNSS is duty cycled
+
+#define GNSS_TTFF_HISTOGRAM_BINS            13u                 //!< Last bin collects everything above
+#define GNSS_TTFF_BIN_WIDTH_MS              5000u
+
+//---------------------- GNSS Aiding Error Codes -------------------------------
+
+#define ERR_GNSS_AIDING_RECORD_INVALID      (-200)
+#define ERR_GNSS_AIDING_NOT_AVAILABLE       (-201)
+
+//! How the receiver was started, TTFF is kept per start type
+typedef enum
+{
+    GNSS_START_COLD = 0,
+    GNSS_START_TIME_AIDED,          //!< UTC time injected
+    GNSS_START_AIDED,               //!< UTC time and last position injected
+
+    GNSS_START_TYPES,
+}GNSS_START_TYPE_t;
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t totalMs;
+    uint32_t minMs;
+    uint32_t maxMs;
+    uint16_t histogram[GNSS_TTFF_HISTOGRAM_BINS];
+}GNSSTTFFStats_t;
+
+//! Persisted aiding record, fits one DataFlash page
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    int32_t  latitude;              //!< 1e-7 degrees
+    int32_t  longitude;             //!< 1e-7 degrees
+    int32_t  heightMSL;             //!< mm
+    uint32_t hAcc;                  //!< mm
+    uint32_t fixTime;               //!< UTC seconds since 1970 of the fix
+    int32_t  utcOffset;             //!< UTC minus network synced RTC time, seconds
+    uint8_t  isPositionValid;
+    uint8_t  isUtcOffsetValid;
+    uint16_t reserved;
+    GNSSTTFFStats_t ttff[GNSS_START_TYPES];
+}GNSSAidingRecord_t;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  int32_t GNSSAidingLoadFromFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read the aiding record, called from SysTask at start up
+//
+//------------------------------------------------------------------------------
+int32_t GNSSAidingLoadFromFlash(void);
+
+//------------------------------------------------------------------------------
+//  int32_t GNSSAidingSaveToFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the record snapshot taken by GNSSAidingRequestSave.
+//!  Called from SysTask which owns the DataFlash.
+//
+//------------------------------------------------------------------------------
+int32_t GNSSAidingSaveToFlash(void);
+
+//------------------------------------------------------------------------------
+//  void GNSSAidingRequestSave(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function snapshot a changed record and ask SysTask to persist it,
+//!  at most once per GNSS_AIDING_SAVE_INTERVAL_MS
+//
+//------------------------------------------------------------------------------
+void GNSSAidingRequestSave(void);
+
+//------------------------------------------------------------------------------
+//  int32_t GNSSAidingCreateTimeCommand(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create AT+UI2CW with UBX-MGA-INI-TIME_UTC
+//!
+//! \return command size or ERR_GNSS_AIDING_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t GNSSAidingCreateTimeCommand(uint8_t buffer[], uint32_t bufferSize);
+
+//------------------------------------------------------------------------------
+//  int32_t GNSSAidingCreatePositionCommand(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create AT+UI2CW with UBX-MGA-INI-POS_LLH, accuracy grows
+//!  with the age of the last fix
+//!
+//! \return command size or ERR_GNSS_AIDING_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t GNSSAidingCreatePositionCommand(uint8_t buffer[], uint32_t bufferSize);
+
+//------------------------------------------------------------------------------
+//  void GNSSAidingStartSession(GNSS_START_TYPE_t startType, uint32_t powerOnTicks)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function start TTFF measurement of a receiver power up
+//
+//------------------------------------------------------------------------------
+void GNSSAidingStartSession(GNSS_START_TYPE_t startType, uint32_t powerOnTicks);
+
+//------------------------------------------------------------------------------
+//  void GNSSAidingUpdateFix(UBXNavPvt_t const *navPvt)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function keep a valid fix for aiding and close the TTFF measurement
+//
+//------------------------------------------------------------------------------
+void GNSSAidingUpdateFix(UBXNavPvt_t const *navPvt);
+
+//------------------------------------------------------------------------------
+//  GNSSTTFFStats_t const* GNSSAidingGetTTFFStats(GNSS_START_TYPE_t startType)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns TTFF statistics of a start type
+//
+//------------------------------------------------------------------------------
+GNSSTTFFStats_t const* GNSSAidingGetTTFFStats(GNSS_START_TYPE_t startType);
+
+#endif
@@ -0,0 +1,133 @@
+//==============================================================================
+//
+//  GNSSDutyCycle.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        GNSSDutyCycle.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used by the GNSS duty cycle controller. The receiver is powered for a
+//! fix and powered down until the next one. The interval between fixes grows
+//! while consecutive fixes agree and shrinks on movement or instrument alarm.
+//
+
+#ifndef GNSSDUTYCYCLE_H
+#define GNSSDUTYCYCLE_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+
+#include "GPS.h"
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+//---------------------- Duty Cycle Configuration ------------------------------
+
+#define GNSS_DUTY_MIN_INTERVAL_MS           60000u      //!< Fix interval while moving or in alarm
+#define GNSS_DUTY_MAX_INTERVAL_MS           900000u     //!< Position freshness target while stationary
+#define GNSS_DUTY_POLL_INTERVAL_MS          5000u       //!< NAV-PVT poll period while acquiring
+#define GNSS_DUTY_ACQUIRE_TIMEOUT_MS        120000u     //!< Receiver powered down without fix after it
+#define GNSS_DUTY_STATIONARY_RADIUS_MM      25000u      //!< Fixes closer than this agree
+#define GNSS_DUTY_MAX_PDOP                  250u        //!< x100, fixes with worse DOP do not lengthen the interval
+
+typedef enum
+{
+    GNSS_DUTY_OFF = 0,              //!< Receiver powered down until next fix is due
+    GNSS_DUTY_ACQUIRING,            //!< Receiver powered, polling until a 3D fix
+}GNSS_DUTY_STATE_t;
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+typedef struct
+{
+    uint32_t fixes;
+    uint32_t timeouts;              //!< Power ups ended without fix
+    uint32_t movements;             //!< Fixes outside the radius of the previous one
+    uint32_t alarms;
+    uint32_t onTimeMs;              //!< Total receiver powered time
+    uint32_t intervalMs;            //!< Current fix interval
+}GNSSDutyCycleStats_t;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  void GNSSDutyCycleRun(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function run the controller, called from SysTask on every schedule
+//!  message. It request CELL_GET_GPS_COORDINATES and CELL_GPS_OFF from cellular task.
+//
+//------------------------------------------------------------------------------
+void GNSSDutyCycleRun(void);
+
+//------------------------------------------------------------------------------
+//  void GNSSDutyCycleReportFix(UBXNavPvt_t const *navPvt)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function hand a NAV-PVT read by cellular task to the controller
+//
+//------------------------------------------------------------------------------
+void GNSSDutyCycleReportFix(UBXNavPvt_t const *navPvt);
+
+//------------------------------------------------------------------------------
+//  void GNSSDutyCycleNotifyAlarm(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function request a fresh fix and the shortest interval on alarm
+//
+//------------------------------------------------------------------------------
+void GNSSDutyCycleNotifyAlarm(void);
+
+//------------------------------------------------------------------------------
+//  GNSSDutyCycleStats_t const* GNSSDutyCycleGetStats(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns fix counts and receiver on time
+//
+//------------------------------------------------------------------------------
+GNSSDutyCycleStats_t const* GNSSDutyCycleGetStats(void);
+
+#endif
@@ -49,9 +49,125 @@
 //==============================================================================
 #define FIND_MIN(X,Y)   ( (X) < (Y) ? (X) : (Y) )
 
+//---------------------------- UBX Protocol ------------------------------------
+#define UBX_SYNC_CHAR_1                 0xB5u
+#define UBX_SYNC_CHAR_2                 0x62u
+#define UBX_FRAME_OVERHEAD              8u      // Sync, class, id, length and checksum
 
+#define UBX_CLASS_NAV                   0x01u
+#define UBX_CLASS_CFG                   0x06u
+#define UBX_ID_NAV_PVT                  0x07u
+#define UBX_ID_CFG_PRT                  0x00u
+#define UBX_CLASS_MGA                   0x13u
+#define UBX_ID_MGA_INI                  0x40u
 
+#define UBX_NAV_PVT_PAYLOAD_SIZE        92u
+#define UBX_NAV_PVT_FRAME_SIZE          (UBX_NAV_PVT_PAYLOAD_SIZE + UBX_FRAME_OVERHEAD)
 
+#define UBX_FIX_TYPE_2D                 2u
+#define UBX_FIX_TYPE_3D                 3u
+#define UBX_FIX_TYPE_GNSS_DEAD_RECKONING 4u
+#define UBX_NAV_PVT_FLAG_FIX_OK         0x01u
+#define UBX_NAV_PVT_VALID_UTC           0x07u   // validDate, validTime and fullyResolved
 
+//---------------------------- GPS Error Codes ---------------------------------
+#define ERR_UBX_FRAME_NOT_FOUND         (-190)
+#define ERR_UBX_CHECKSUM_MISMATCH       (-191)
+#define ERR_UBX_BUFFER_TOO_SMALL        (-192)
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+//! Fields used from UBX-NAV-PVT
+typedef struct
+{
+    uint32_t iTOW;              //!< GPS time of week, ms
+    uint16_t year;
+    uint8_t  month;
+    uint8_t  day;
+    uint8_t  hour;
+    uint8_t  minute;
+    uint8_t  second;
+    uint8_t  valid;             //!< Date/time validity flags
+    uint8_t  fixType;           //!< 0 no fix, 2 2D, 3 3D, 4 GNSS + dead reckoning
+    uint8_t  flags;             //!< bit 0 gnssFixOK
+    uint8_t  numSV;
+    int32_t  longitude;         //!< 1e-7 degrees
+    int32_t  latitude;          //!< 1e-7 degrees
+    int32_t  heightMSL;         //!< mm
+    uint32_t hAcc;              //!< Horizontal accuracy estimate, mm
+    uint16_t pDOP;              //!< Position DOP x100
+}UBXNavPvt_t;
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  uint32_t GPSCreateUBXFrame(uint8_t msgClass, uint8_t msgId, uint8_t const payload[], uint16_t payloadSize, uint8_t frame[], uint32_t frameSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function wrap a payload in a UBX frame, returns frame size or 0
+//
+//------------------------------------------------------------------------------
+uint32_t GPSCreateUBXFrame(uint8_t msgClass, uint8_t msgId, uint8_t const payload[], uint16_t payloadSize, uint8_t frame[], uint32_t frameSize);
+
+//------------------------------------------------------------------------------
+//  int32_t GPSCreateI2CWriteCommand(uint8_t const frame[], uint32_t frameSize, uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create AT+UI2CW="<hex>",<length> for a UBX frame
+//
+//------------------------------------------------------------------------------
+int32_t GPSCreateI2CWriteCommand(uint8_t const frame[], uint32_t frameSize, uint8_t buffer[], uint32_t bufferSize);
+
+//------------------------------------------------------------------------------
+//  int32_t GPSCreateConfigPortCommand(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create AT+UI2CW with UBX-CFG-PRT setting the I2C port to UBX output only
+//
+//------------------------------------------------------------------------------
+int32_t GPSCreateConfigPortCommand(uint8_t buffer[], uint32_t bufferSize);
+
+//------------------------------------------------------------------------------
+//  int32_t GPSCreatePollNavPvtCommand(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create AT+UI2CW with the UBX-NAV-PVT poll request
+//
+//------------------------------------------------------------------------------
+int32_t GPSCreatePollNavPvtCommand(uint8_t buffer[], uint32_t bufferSize);
+
+//------------------------------------------------------------------------------
+//  int32_t GPSParseNavPvtResponse(uint8_t const response[], uint32_t length, UBXNavPvt_t *navPvt)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse the hex data of a +UI2CR response
+//
+//------------------------------------------------------------------------------
+int32_t GPSParseNavPvtResponse(uint8_t const response[], uint32_t length, UBXNavPvt_t *navPvt);
+
+//------------------------------------------------------------------------------
+//  void GPSUpdateCoordinates(UBXNavPvt_t const *navPvt)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function copy a NAV-PVT solution to the coordinates attached to events
+//
+//------------------------------------------------------------------------------
+void GPSUpdateCoordinates(UBXNavPvt_t const *navPvt);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,183 @@
+//==============================================================================
+//
+//  Geofence.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        Geofence.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used by the geofence engine. Fences are circles or polygons around a
+//! reference point, a fix is tested against them in integer arithmetic after
+//! projecting it to decimeters east and north of each reference point.
+//! The engine has no RTOS dependencies so it is built by host tools too.
+//
+
+#ifndef GEOFENCE_H
+#define GEOFENCE_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+#include <stdbool.h>
+
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define GEOFENCE_MAX_FENCES             8u
+#define GEOFENCE_MAX_VERTICES           8u
+#define GEOFENCE_MIN_POLYGON_VERTICES   3u
+#define GEOFENCE_MAX_EXTENT_DM          200000      //!< 20 km, vertices and radius from reference point
+
+#define GEOFENCE_ID_NONE                0u          //!< Outside every fence, fence ids are 1-255
+
+//---------------------- Geofence Error Codes ----------------------------------
+
+#define ERR_GEOFENCE_PARSE_FAILED       (-220)
+#define ERR_GEOFENCE_INVALID            (-221)
+
+typedef enum
+{
+    GEOFENCE_TYPE_CIRCLE = 0,       //!< Center in vertex 0 and radius
+    GEOFENCE_TYPE_POLYGON,          //!< Vertices in order, closed implicitly
+}GEOFENCE_TYPE_t;
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+//! Fence as downloaded from iNet and persisted
+typedef struct
+{
+    uint8_t  id;
+    uint8_t  type;                  //!< GEOFENCE_TYPE_t
+    uint8_t  vertexCount;
+    uint8_t  reserved;
+    uint32_t radius;                //!< Meters, circles only
+    int32_t  latitude[GEOFENCE_MAX_VERTICES];   //!< Micro-degrees
+    int32_t  longitude[GEOFENCE_MAX_VERTICES];  //!< Micro-degrees
+}GeofenceFence_t;
+
+typedef struct
+{
+    uint16_t version;               //!< Set version assigned by iNet, 0 when no set is held
+    uint8_t  count;
+    uint8_t  reserved;
+    GeofenceFence_t fences[GEOFENCE_MAX_FENCES];
+}GeofenceSet_t;
+
+//! Fence projected around its reference point by GeofencePrepare
+typedef struct
+{
+    uint8_t  id;
+    uint8_t  type;
+    uint8_t  vertexCount;
+    int32_t  referenceLatitude;     //!< Micro-degrees, circle center or first vertex
+    int32_t  referenceLongitude;
+    int32_t  eastScaleQ16;          //!< Decimeters per micro-degree of longitude, Q16
+    int32_t  radius;                //!< Decimeters
+    int32_t  minEast;               //!< Bounding box, decimeters
+    int32_t  maxEast;
+    int32_t  minNorth;
+    int32_t  maxNorth;
+    int32_t  east[GEOFENCE_MAX_VERTICES];
+    int32_t  north[GEOFENCE_MAX_VERTICES];
+}GeofenceShape_t;
+
+typedef struct
+{
+    uint8_t count;
+    GeofenceShape_t shapes[GEOFENCE_MAX_FENCES];
+}GeofenceIndex_t;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  uint32_t GeofenceCosineQ15(int32_t latitude)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns cos of latitude (micro-degrees) in Q15
+//
+//------------------------------------------------------------------------------
+uint32_t GeofenceCosineQ15(int32_t latitude);
+
+//------------------------------------------------------------------------------
+//  int32_t GeofenceParseSet(char const text[], uint32_t length, GeofenceSet_t *set)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse a fence set downloaded from iNet. Format is a JSON
+//!  array of the set version followed by one array per fence,
+//!  [id,type,radius,lat,lon,...] with coordinates in integer micro-degrees,
+//!  e.g. [3,[1,0,150,40438185,-79999422],[2,1,0,40440000,-80001000,...]]
+//!
+//! \return 0 or ERR_GEOFENCE_PARSE_FAILED
+//
+//------------------------------------------------------------------------------
+int32_t GeofenceParseSet(char const text[], uint32_t length, GeofenceSet_t *set);
+
+//------------------------------------------------------------------------------
+//  int32_t GeofencePrepare(GeofenceSet_t const *set, GeofenceIndex_t *index)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function project the fences of a set around their reference points
+//!  and compute bounding boxes, done once when a set is loaded
+//!
+//! \return 0 or ERR_GEOFENCE_INVALID when a fence is malformed or too large
+//
+//------------------------------------------------------------------------------
+int32_t GeofencePrepare(GeofenceSet_t const *set, GeofenceIndex_t *index);
+
+//------------------------------------------------------------------------------
+//  uint8_t GeofenceFindZone(GeofenceIndex_t const *index, int32_t latitude, int32_t longitude, uint8_t currentZone, uint32_t margin)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the fence holding a fix (micro-degrees). The
+//!  current zone is kept until the fix is more than margin (decimeters)
+//!  outside it, another fence is entered only when the fix is more than
+//!  margin inside it. Fixes close to a boundary therefore change nothing.
+//!
+//! \return fence id or GEOFENCE_ID_NONE
+//
+//------------------------------------------------------------------------------
+uint8_t GeofenceFindZone(GeofenceIndex_t const *index, int32_t latitude, int32_t longitude, uint8_t currentZone, uint32_t margin);
+
+#endif
@@ -0,0 +1,216 @@
+//==============================================================================
+//
+//  GeofenceMonitor.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        GeofenceMonitor.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used to monitor the geofences. The fence set comes with iNet upload
+//! responses and is kept in DataFlash. Every GNSS duty cycle fix is evaluated,
+//! entering or leaving a zone creates an event right away, while the
+//! instrument stays in one zone the heartbeat upload is stretched.
+//
+
+#ifndef GEOFENCEMONITOR_H
+#define GEOFENCEMONITOR_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+
+#include "Geofence.h"
+#include "GPS.h"
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+/*
+Fence set record in DataFlash (Sector 3):
+
+Page 769-771    | GeofenceRecord_t
+*/
+#define GEOFENCE_FIRST_PAGE_NUMBER          769u
+
+#define GEOFENCE_MAGIC                      0x4E454647u         //!< "GFEN"
+#define GEOFENCE_RECORD_VERSION             1u
+
+#define GEOFENCE_MAX_HACC_MM                50000u              //!< Fixes less accurate are not evaluated
+#define GEOFENCE_MIN_MARGIN_MM              10000u              //!< Boundary hysteresis, grows with fix accuracy
+#define GEOFENCE_MAX_FIX_AGE_MS             960000u             //!< Zone is trusted this long after a fix
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+//! Persisted fence set, spans consecutive DataFlash pages
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    GeofenceSet_t set;
+}GeofenceRecord_t;
+
+typedef struct
+{
+    uint32_t evaluations;           //!< Fixes tested against the set
+    uint32_t ignoredFixes;          //!< Fixes above GEOFENCE_MAX_HACC_MM
+    uint32_t enters;
+    uint32_t exits;
+    uint32_t setsReceived;          //!< New set versions applied
+    uint32_t setsRejected;          //!< Sets failing to parse or prepare
+}GeofenceMonitorStats_t;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  int32_t GeofenceMonitorLoadFromFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read and prepare the fence set, called from SysTask at
+//!  start up
+//
+//------------------------------------------------------------------------------
+int32_t GeofenceMonitorLoadFromFlash(void);
+
+//------------------------------------------------------------------------------
+//  int32_t GeofenceMonitorSaveToFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function apply the set staged by GeofenceMonitorStageSet and
+//!  persist it. Called from SysTask which owns the DataFlash.
+//
+//------------------------------------------------------------------------------
+int32_t GeofenceMonitorSaveToFlash(void);
+
+//------------------------------------------------------------------------------
+//  int32_t GeofenceMonitorStageSet(char const text[], uint32_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse a set received from iNet and ask SysTask to apply it
+//!  when its version differs from the one held
+//!
+//! \return 0 or ERR_GEOFENCE_PARSE_FAILED
+//
+//------------------------------------------------------------------------------
+int32_t GeofenceMonitorStageSet(char const text[], uint32_t length);
+
+//------------------------------------------------------------------------------
+//  void GeofenceMonitorEvaluateFix(UBXNavPvt_t const *navPvt)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function find the zone of a fix and flag a transition when it
+//!  changes, called from SysTask for every fix of the GNSS duty cycle
+//
+//------------------------------------------------------------------------------
+void GeofenceMonitorEvaluateFix(UBXNavPvt_t const *navPvt);
+
+//------------------------------------------------------------------------------
+//  BOOLEAN GeofenceMonitorIsTransitionPending(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when a zone was entered or left and no event
+//!  reported it yet
+//
+//------------------------------------------------------------------------------
+BOOLEAN GeofenceMonitorIsTransitionPending(void);
+
+//------------------------------------------------------------------------------
+//  void GeofenceMonitorClearTransition(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function acknowledge the transition once an event carries it
+//
+//------------------------------------------------------------------------------
+void GeofenceMonitorClearTransition(void);
+
+//------------------------------------------------------------------------------
+//  BOOLEAN GeofenceMonitorIsInsideZone(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true while a recent fix holds the instrument in
+//!  the zone already reported
+//
+//------------------------------------------------------------------------------
+BOOLEAN GeofenceMonitorIsInsideZone(void);
+
+//------------------------------------------------------------------------------
+//  uint8_t GeofenceMonitorGetZone(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the current fence id or GEOFENCE_ID_NONE
+//
+//------------------------------------------------------------------------------
+uint8_t GeofenceMonitorGetZone(void);
+
+//------------------------------------------------------------------------------
+//  uint16_t GeofenceMonitorGetSetVersion(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the version of the set held, 0 when none
+//
+//------------------------------------------------------------------------------
+uint16_t GeofenceMonitorGetSetVersion(void);
+
+//------------------------------------------------------------------------------
+//  GeofenceMonitorStats_t const* GeofenceMonitorGetStats(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns evaluation and transition counts
+//
+//------------------------------------------------------------------------------
+GeofenceMonitorStats_t const* GeofenceMonitorGetStats(void);
+
+#endif
@@ -0,0 +1,106 @@
+//==============================================================================
+//
+//  HttpHeader.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        HttpHeader.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used by the HTTP request header builder. The header is formatted once
+//! per request type, URL and authorization, later requests only write their
+//! Content-Length in place. Only standard headers are used so the builder
+//! also builds on host.
+//
+
+#ifndef HTTPHEADER_H
+#define HTTPHEADER_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+#include <stdbool.h>
+
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define HTTP_CONTENT_LENGTH_MAX_SIZE    15u         // 10 digits, blank line and terminator
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+//! Header template kept in the caller's buffer
+typedef struct
+{
+    uint8_t const *buffer;          //!< Buffer holding the template
+    uint32_t requestType;           //!< Request type the template was built for
+    uint32_t contentLengthOffset;   //!< Offset of the Content-Length value
+    bool     isValid;
+}HttpHeader_t;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  void HttpHeaderInvalidate(HttpHeader_t *header)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function drops the header template, the next request formats its
+//!  header again. Called when the authorization changes.
+//
+//------------------------------------------------------------------------------
+void HttpHeaderInvalidate(HttpHeader_t *header);
+
+//------------------------------------------------------------------------------
+//  int32_t HttpHeaderCreate(HttpHeader_t *header, uint32_t requestType, char const *url,
+//                           char const *host, char const *contentType, char const *authorization,
+//                           uint8_t buffer[], uint32_t bufferSize, uint32_t contentLength)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create the HTTP POST request header in buffer. The
+//!  Authorization field is left out when authorization is NULL. When the
+//!  header does not fit the buffer is left empty so no partial or stale
+//!  header can be written to the socket.
+//!
+//! \return header length or -1 when it does not fit
+//
+//------------------------------------------------------------------------------
+int32_t HttpHeaderCreate(HttpHeader_t *header, uint32_t requestType, char const *url,
+                         char const *host, char const *contentType, char const *authorization,
+                         uint8_t buffer[], uint32_t bufferSize, uint32_t contentLength);
+
+#endif
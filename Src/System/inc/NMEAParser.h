@@ -0,0 +1,161 @@
+//==============================================================================
+//
+//  NMEAParser.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        NMEAParser.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used by the streaming NMEA parser. Sentences are parsed one character
+//! at a time without a line buffer, the checksum is verified and positions are
+//! converted to fixed point micro-degrees with integer arithmetic only.
+//! Only standard headers are used so the parser also builds on host.
+//
+
+#ifndef NMEAPARSER_H
+#define NMEAPARSER_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+#include <stdbool.h>
+
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define NMEA_MICRO_DEGREES_PER_DEGREE   1000000
+
+//---------------------- NMEA Parser Error Codes --------------------------------
+
+#define ERR_NMEA_CHECKSUM_MISMATCH      (-180)
+#define ERR_NMEA_SENTENCE_MALFORMED     (-181)
+
+//! Result of feeding one character
+typedef enum
+{
+    NMEA_SENTENCE_NONE = 0,     //!< Sentence still in progress or not supported
+    NMEA_SENTENCE_GGA,
+    NMEA_SENTENCE_RMC,
+    NMEA_SENTENCE_GSV,
+}NMEA_SENTENCE_t;
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+//! Navigation data collected from GGA, RMC and GSV sentences
+typedef struct
+{
+    int32_t  latitude;          //!< Micro-degrees, south negative
+    int32_t  longitude;         //!< Micro-degrees, west negative
+    int32_t  altitude;          //!< Decimeters above mean sea level (GGA)
+    uint32_t utcTime;           //!< hhmmss
+    uint32_t utcDate;           //!< ddmmyy (RMC)
+    uint16_t hdop;              //!< Horizontal dilution x100 (GGA)
+    uint8_t  fixQuality;        //!< GGA fix quality, 0 is no fix
+    uint8_t  satellitesUsed;    //!< GGA
+    uint8_t  satellitesInView;  //!< GSV
+    bool     isRmcValid;        //!< RMC status 'A'
+}NMEAFix_t;
+
+//! Parser state, values of a sentence are staged and only copied to fix
+//! once its checksum is verified
+typedef struct
+{
+    NMEAFix_t fix;              //!< Last validated data
+    NMEAFix_t staged;           //!< Data of sentence being parsed
+
+    uint32_t value;             //!< Digits of current field
+    uint8_t  decimals;          //!< Digits seen after '.'
+    bool     isDecimal;
+    bool     isNegative;
+    bool     hasDigits;
+    char     firstChar;         //!< First character of current field
+
+    uint8_t  state;
+    uint8_t  sentence;          //!< NMEA_SENTENCE_t being parsed
+    uint8_t  fieldIndex;
+    uint8_t  checksum;          //!< XOR of characters between '$' and '*'
+    uint8_t  receivedChecksum;
+    uint8_t  checksumDigits;
+    char     address[3];        //!< Last three characters of talker + type, e.g. "GGA"
+    uint8_t  addressLength;
+    char     hemisphere;        //!< 'N'/'S'/'E'/'W' of the coordinate being parsed
+
+    uint32_t sentencesParsed;
+    uint32_t checksumErrors;
+}NMEAParser_t;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  void NMEAParserInit(NMEAParser_t *parser)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function reset the parser and clear the fix
+//
+//------------------------------------------------------------------------------
+void NMEAParserInit(NMEAParser_t *parser);
+
+//------------------------------------------------------------------------------
+//  int32_t NMEAParserFeed(NMEAParser_t *parser, uint8_t ch)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function process one received character.
+//!
+//! \return NMEA_SENTENCE_t of a sentence completed with valid checksum,
+//!         NMEA_SENTENCE_NONE while in progress or
+//!         ERR_NMEA_CHECKSUM_MISMATCH
+//
+//------------------------------------------------------------------------------
+int32_t NMEAParserFeed(NMEAParser_t *parser, uint8_t ch);
+
+//------------------------------------------------------------------------------
+//  uint32_t NMEAParserFeedBuffer(NMEAParser_t *parser, uint8_t const data[], uint32_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function feed a buffer and returns bit mask of completed sentences,
+//!  bit n set for NMEA_SENTENCE_t n
+//
+//------------------------------------------------------------------------------
+uint32_t NMEAParserFeedBuffer(NMEAParser_t *parser, uint8_t const data[], uint32_t length);
+
+#endif
@@ -0,0 +1,130 @@
+//==============================================================================
+//
+//  Position.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        Position.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used to choose the position attached to an event. A GNSS fix close to
+//! the event time is used when held, otherwise a CellLocate (AT+ULOC) estimate
+//! is requested if the latency budget of the event priority allows it.
+//
+
+#ifndef POSITION_H
+#define POSITION_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+
+#include "Event.h"
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+//! Time from event creation a position may take, GNSS is never waited for
+#define POSITION_BUDGET_ALARM_MS            8000u
+#define POSITION_BUDGET_STATE_CHANGE_MS     20000u
+#define POSITION_BUDGET_PERIODIC_MS         0u          //!< Only a GNSS fix already held
+
+#define POSITION_MIN_CELL_LOCATE_MS         2000u       //!< Less budget is not worth a CellLocate request
+#define POSITION_MAX_GNSS_AGE_MS            960000u     //!< Fix to event time, longest GNSS duty cycle plus margin
+#define POSITION_MAX_CELL_LOCATE_AGE_MS     60000u      //!< Estimate reused for events close together
+#define POSITION_CELL_LOCATE_ACCURACY_M     100u        //!< Requested accuracy, modem answers earlier when reached
+
+//---------------------- Position Error Codes ----------------------------------
+
+#define ERR_POSITION_PARSE_FAILED           (-210)
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+extern GPSInfo_t CellLocateCoordinates;
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  uint32_t PositionGetBudgetMs(EVENT_PRIORITY_t priority)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the position latency budget of an event priority
+//
+//------------------------------------------------------------------------------
+uint32_t PositionGetBudgetMs(EVENT_PRIORITY_t priority);
+
+//------------------------------------------------------------------------------
+//  BOOLEAN PositionSelect(GPSInfo_t *position, uint32_t eventTicks)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function replace an event position by the best one held: the GNSS
+//!  fix closest to the event time, event snapshot or latest, then the latest
+//!  CellLocate estimate, each only when close enough to the event time
+//!
+//! \return true when position is valid
+//
+//------------------------------------------------------------------------------
+BOOLEAN PositionSelect(GPSInfo_t *position, uint32_t eventTicks);
+
+//------------------------------------------------------------------------------
+//  uint32_t PositionCreateCellLocateCommand(uint8_t buffer[], uint32_t bufferSize, uint32_t timeoutMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create AT+ULOC single shot CellLocate request answered
+//!  within timeoutMs
+//
+//------------------------------------------------------------------------------
+uint32_t PositionCreateCellLocateCommand(uint8_t buffer[], uint32_t bufferSize, uint32_t timeoutMs);
+
+//------------------------------------------------------------------------------
+//  int32_t PositionParseCellLocate(uint8_t const response[], uint32_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse +UULOC into CellLocateCoordinates
+//!
+//! \return 0 when estimate is valid, ERR_INCOMPLETE_DATA_RECEIVED until the
+//!         URC is complete or ERR_POSITION_PARSE_FAILED
+//
+//------------------------------------------------------------------------------
+int32_t PositionParseCellLocate(uint8_t const response[], uint32_t length);
+
+#endif
@@ -67,6 +67,9 @@
 #define ONE_MINUTE                                              15u //Seconds
 #define PERIODIC_INET_MESSSAGE_INTERVAL                         ONE_MINUTE
 #define IS_PERIODIC_EVENT_ENABLED                               true
+#define PERIODIC_INET_HEARTBEAT_INTERVAL                        300u //Seconds, max time without any delivered event
+#define GEOFENCE_HEARTBEAT_INTERVAL                             1800u //Seconds, heartbeat while staying in one geofence zone
+#define PERIODIC_READING_DRIFT_COUNTS                           2u   //Raw reading change that makes a sensor reportable
 
 #define EventLogDebugPrint(format,...)      SYSTEM_PRINT(EVENT_LOG_TASK_DEBUG_LOG, format, ##__VA_ARGS__)
 #define EventLogDebugFlush()                SYSTEM_FLUSH(EVENT_LOG_TASK_DEBUG_LOG)
@@ -149,14 +152,19 @@ typedef enum
     SIM_APN                     = 25u,
     CELL_NUMBER_1               = 26u,
     CELL_NUMBER_2               = 27u,
-//    BATTERY_TYPE                = 28u,
-//    BATTERY_TYPE                = 29u,
-//    BATTERY_TYPE                = 30u,
-//    
-//    BATTERY_TYPE                = 31u,
-//    BATTERY_TYPE                = 32u,
+    CELL_RAT_STATISTICS         = 28u,      //Read only, AT+URAT order then attach and connect statistics per RAT
+    CELL_NETWORK_CACHE          = 29u,      //Read only, cached operator and band, cached and full scan registration statistics
+    MODULE_FIRMWARE             = 30u,      //Read only, module revision reported by ATI
+    CELL_DNS_CACHE              = 31u,      //Read only, cached iNet host address, lookup statistics and connect time saved
+    CELL_TLS_STATISTICS         = 32u,      //Read only, session resumption flag, cipher suite offered, full, resumable and per suite handshake statistics
+    CELL_PREWARM_STATISTICS     = 33u,      //Read only, hints per reason, warm ups, uploads that found the radio attached, hold windows unused and time saved
+    CELL_DATA_USAGE             = 34u,      //Read only, bytes per event type and category, AT control outside events, connects and radio on time
+    CELL_UPLOAD_TIMING          = 35u,      //Read only, completed and failed uploads, samples, p50, p90 and max of each upload phase, p50 and p90 of the whole upload
+    EVENT_LATENCY_STATISTICS    = 36u,      //Read only, events sent, average, max and last creation to iNet acknowledge latency per priority class
+    CELL_GNSS_SCHEDULER         = 37u,      //Read only, GNSS steps and NAV-PVT reads interleaved in uploads, GNSS positions sent, last and max position age
+    CELL_LAST_UPLOAD_TIMING     = 38u,      //Read only, event type, completed flag, time of each phase and of the whole of the upload closed last
     
-    NO_PARAMETER                = 33u       //Defined for our own understanding can be changes     
+    NO_PARAMETER                = 39u       //Defined for our own understanding can be changes     
 }RADIO_CONFIGURATION_PARAMETER_t;
 
 typedef enum 
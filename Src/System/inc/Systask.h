@@ -53,14 +53,23 @@
 //==============================================================================
 //  GLOBAL DATA STRUCTURES DEFINITION
 //==============================================================================
+//! Where an event position came from
+typedef enum
+{
+    POSITION_SOURCE_NONE = 0,
+    POSITION_SOURCE_GNSS,
+    POSITION_SOURCE_CELL_LOCATE,    //!< AT+ULOC cell based estimate
+}POSITION_SOURCE_t;
+
 typedef struct
 {
-    float longitude;
-    uint8_t  longitudeDir;
-    float latitude;
-    uint8_t  latitudeDir;
-    float horizantalDilution;
-    uint8_t accuracy; 
+    int32_t longitude;              //!< Micro-degrees, west negative
+    int32_t latitude;               //!< Micro-degrees, south negative
+    uint32_t uncertainty;           //!< Horizontal accuracy estimate, meters
+    uint32_t fixTicks;              //!< RTC ticks when the position was obtained
+    uint16_t horizantalDilution;    //!< HDOP x100
+    uint8_t accuracy;               //!< GGA fix quality
+    uint8_t source;                 //!< POSITION_SOURCE_t
     bool  isGpsValid;
 }GPSInfo_t;
 
@@ -90,6 +99,13 @@ typedef enum
     EVENT_MANAGEMENT_EVENT_RECEVIED = 0,
     POWER_MANAGEMENT_EVENT_RECEVIED,
     WRITE_DATA_TO_FLASH,
+    DUMP_UART_CAPTURE_TO_FLASH,
+    SAVE_GNSS_AIDING_TO_FLASH,
+    SAVE_GEOFENCES_TO_FLASH,
+    SAVE_RAT_STATS_TO_FLASH,
+    SAVE_NET_CACHE_TO_FLASH,
+    SAVE_CELL_IDENTITY_TO_FLASH,
+    SAVE_DNS_CACHE_TO_FLASH,
     
     DEVICE_SHUTDOWN_MSG,
     
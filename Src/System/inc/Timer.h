@@ -96,13 +96,55 @@ void RTCInit(void);
 uint32_t GetRTCTicks(void);
 
 //------------------------------------------------------------------------------
-//   void UpdateRTCTime(uint8_t time[])
+//   BOOLEAN UpdateRTCTime(uint8_t const cellularTime[], int32_t timeZoneQuarters)
 //
 //   Author:   Muhammad Shuaib, Ported from MORRISON
 //   Date:     2017/05/03
 //
-//!  This function Update the RTC Time from Cellular
+//!  This function Update the RTC Time from Cellular. cellularTime is the
+//!  local time "yy/MM/dd,hh:mm:ss" of +CTZE, +CTZV or +CCLK and
+//!  timeZoneQuarters its offset from UTC in quarters of an hour.
+//!
+//! \return true when the time was valid and RTC is updated
 //
 //------------------------------------------------------------------------------
-void UpdateRTCTime(uint8_t cellularTime[]);
+BOOLEAN UpdateRTCTime(uint8_t const cellularTime[], int32_t timeZoneQuarters);
+
+//------------------------------------------------------------------------------
+//   BOOLEAN DateTimeToEpoch(DateTimeInfo_t const *dateTime, uint32_t *epoch)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function convert a date and time to seconds since 1970 with integer
+//!  arithmetic only, the way Clk_DateTimeToTS_Handler of micrium clk does
+//!
+//! \return false when date or time is out of range
+//
+//------------------------------------------------------------------------------
+BOOLEAN DateTimeToEpoch(DateTimeInfo_t const *dateTime, uint32_t *epoch);
+
+//------------------------------------------------------------------------------
+//   void EpochToDateTime(uint32_t epoch, DateTimeInfo_t *dateTime)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function convert seconds since 1970 to UTC date and time with integer
+//!  arithmetic only, the way Clk_TS_ToDateTime of micrium clk does
+//
+//------------------------------------------------------------------------------
+void EpochToDateTime(uint32_t epoch, DateTimeInfo_t *dateTime);
+
+//------------------------------------------------------------------------------
+//   BOOLEAN IsRTCTimeSynced(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function tells whether the RTC was set from the network since reset,
+//!  before that it counts from the build default time
+//
+//------------------------------------------------------------------------------
+BOOLEAN IsRTCTimeSynced(void);
 #endif
\ No newline at end of file
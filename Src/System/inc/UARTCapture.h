@@ -0,0 +1,162 @@
+//==============================================================================
+//
+//  UARTCapture.h
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        UARTCapture.h
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the prototypes of global functions and declaration of global
+//! data used to capture the cellular UART transcript. Every TX/RX chunk is kept
+//! with its RTC ticks in a RAM ring which can be dumped to DataFlash and replayed
+//! on host with Tools/UARTReplay.
+//
+
+#ifndef UARTCAPTURE_H
+#define UARTCAPTURE_H
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdint.h>
+
+#include <main.h>
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define UART_CAPTURE_DEFAULT_ENABLE         true                                //!< Capture state after reset
+
+#define UART_CAPTURE_BUFFER_SIZE            3072u                               //!< RAM ring size in bytes
+#define UART_CAPTURE_MAX_RECORD_DATA        512u                                //!< Longer chunks are truncated
+
+/*
+Capture image in DataFlash (Sector 4):
+
+Page 1024       | UARTCaptureHeader_t
+Pages 1025-1279 | Records, oldest first. Each record is UARTCaptureRecord_t
+                | followed by 'length' data bytes.
+*/
+#define UART_CAPTURE_FLASH_SECTOR           4u
+#define UART_CAPTURE_HEADER_PAGE_NUMBER     1024u
+#define UART_CAPTURE_FIRST_PAGE_NUMBER      1025u
+#define UART_CAPTURE_LAST_PAGE_NUMBER       1279u
+
+#define UART_CAPTURE_MAGIC                  0x50414355u                         //!< "UCAP"
+#define UART_CAPTURE_VERSION                1u
+
+//---------------------- UART Capture Error Codes ------------------------------
+
+#define ERR_UART_CAPTURE_EMPTY              (-170)
+#define ERR_UART_CAPTURE_TOO_LARGE          (-171)
+
+typedef enum
+{
+    UART_CAPTURE_TX = 0,
+    UART_CAPTURE_RX,
+}UART_CAPTURE_DIR_t;
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+//! Record header, data bytes follow it directly
+typedef struct
+{
+    uint32_t ticks;             //!< RTC ticks when chunk was written / read
+    uint16_t length;            //!< Number of data bytes following
+    uint8_t  direction;         //!< UART_CAPTURE_DIR_t
+    uint8_t  atIndex;           //!< AT command in progress (ATCOMMAND_INDEX_ENUM)
+}UARTCaptureRecord_t;
+
+//! Header page of the DataFlash image
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordHeaderSize;
+    uint32_t ticksPerSecond;
+    uint32_t dataSize;          //!< Bytes of records following the header page
+    uint32_t recordCount;
+    uint32_t droppedRecords;    //!< Records overwritten in ring before the dump
+    uint32_t dumpTime;          //!< RTC wall clock at dump time
+}UARTCaptureHeader_t;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  void UARTCaptureEnable(BOOLEAN enable)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function start or stop the cellular UART capture
+//
+//------------------------------------------------------------------------------
+void UARTCaptureEnable(BOOLEAN enable);
+
+//------------------------------------------------------------------------------
+//  void UARTCaptureRecord(UART_CAPTURE_DIR_t direction, uint8_t atIndex, uint8_t const data[], uint32_t size)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function add a TX/RX chunk to the capture ring, oldest records are
+//!  dropped to make room. Called from cellular task only.
+//
+//------------------------------------------------------------------------------
+void UARTCaptureRecord(UART_CAPTURE_DIR_t direction, uint8_t atIndex, uint8_t const data[], uint32_t size);
+
+//------------------------------------------------------------------------------
+//  void UARTCaptureRequestDump(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function freeze the capture and ask SysTask to write it to DataFlash
+//
+//------------------------------------------------------------------------------
+void UARTCaptureRequestDump(void);
+
+//------------------------------------------------------------------------------
+//  int32_t UARTCaptureDumpToFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the frozen capture to DataFlash and resume capturing.
+//!  Called from SysTask which owns the DataFlash.
+//
+//------------------------------------------------------------------------------
+int32_t UARTCaptureDumpToFlash(void);
+
+#endif
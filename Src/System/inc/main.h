@@ -66,7 +66,7 @@
 //  GLOBAL DATA
 //==============================================================================
 
-extern OS_Q   eventMessagesQueue, eventMessagesFreeQueue;
+extern OS_Q   eventMessagesQueue, eventAlarmMessagesQueue, eventMessagesFreeQueue;
 extern OS_Q   taskMessagesFreeQueue;
 
 extern OS_TCB   CellTaskTCB;
@@ -45,14 +45,24 @@
 
 #include "main.h"
 #include "Timer.h"
+#include "UARTCapture.h"
+#include "GPS.h"
+#include "GNSSAiding.h"
+#include "GNSSDutyCycle.h"
+#include "Position.h"
+#include "CellularRAT.h"
+#include "CellularNetCache.h"
+#include "CellularIdentity.h"
+#include "CellularDNS.h"
+#include "CellularTLS.h"
+#include "CellularSMS.h"
+#include "CellularPrewarm.h"
+#include "CellularUsage.h"
+#include "CellularTiming.h"
 //==============================================================================
 //  CONSTANTS, TYPEDEFS AND MACROS 
 //==============================================================================
-const uint8_t configureI2CPortCmd[] = {0xB5,0x62, 0x06, 0x00, 0x14,0x00, 0x00,0x00, 0x3D,0x08, 0x84,0x00,0x00,0x00, 0x00,0x00,0x00,0x00, 0x03,0x00, 0x03,0x00, 0x00,0x00, 0x00,0x00, 0xE9, 0x84};
-
 uint8_t resetGNSS[] = {0xB5,0x62, 0x06, 0x04, 0x04,0x00, 0x00,0x00, 0x00, 0x00, 0x0E,0x64};
-uint8_t CFG_MSG[]  = {0xB5,0x62, 0x06, 0x01, 0x08,0x00, 0xF0,0x00, 0x02,0x00,0x00,0x00,0x00,0x00, 0x01,0x2F};
-uint8_t CFG_MSG_GET[]  = {0xB5,0x62, 0x06, 0x01, 0x02,0x00, 0xF0,0x00, 0xF9,0x11};
 
 uint8_t const CMD_GPS_CONFIG_GPS[] = {0xB5,0x62,0x06,0x3E,0x0C,0x00,0x00,0x20,0x20,0x01,0x00,0x08,0x10,0x00,0x30,0x5A,0x01,0x01,0x35,0xBC};
 //==============================================================================
@@ -92,7 +102,41 @@ uint8_t const CMD_GPS_CONFIG_GPS[] = {0xB5,0x62,0x06,0x3E,0x0C,0x00,0x00,0x20,0x
 UARTDRV_HandleData_t cellUARTHandleData = NULL;
 UARTDRV_Handle_t cellUART = &cellUARTHandleData;
 
+#define GPS_CONFIGURE_RETRIES       5u
+#define WARMUP_REGISTRATION_POLLS   25u
+#define SMS_REGISTRATION_POLLS      25u
+#define UPLOAD_REGISTRATION_POLLS   60u         // Events stay queued when it fails, recovery runs
+#define GPS_NAV_PVT_READ_ATTEMPTS   5u
+#define TOKEN_CONNECT_TIMEOUT_MS    40000u      // Same as a blocking +USOCO
+#define TOKEN_CONNECT_POLL_MS       100u
+
+// Token is requested on a second socket, its connect overlaps the one of the data socket
+typedef struct
+{
+    uint32_t socket;
+    uint32_t startTicks;
+    uint32_t connectMs;
+    BOOLEAN  isOpen;                // Created by +USOCR, the module holds it until +USOCL or the server closes it
+    BOOLEAN  isConnecting;          // Asynchronous +USOCO sent, +UUSOCO not seen yet
+    BOOLEAN  isConnected;
+    BOOLEAN  isResumable;           // TLS session could be resumed when the connect started
+}TokenSocket_t;
+
 static BOOLEAN isGPSinit = false;
+static BOOLEAN isNetworkTimeURCHandled = false;     // Response buffer is parsed again on every read
+
+// GNSS requests are served by their message or in between socket steps, whichever comes first
+static volatile BOOLEAN isGNSSPollPending = false;
+static volatile BOOLEAN isGNSSOffPending = false;
+// Alarm deadline check is served by its message or in between the events of an upload
+static volatile BOOLEAN isAlarmCheckPending = false;
+static uint32_t alarmCheckTicks = 0;
+static BOOLEAN isDirectLinkActive = false;          // UART carries socket data, no command may be sent
+static BOOLEAN isNetworkAttached = false;           // Radio on and registered since the last CFUN=0
+static uint32_t lastNavPvtTicks = 0;
+static CellularSchedulerStats_t schedulerStats;
+static TokenSocket_t tokenSocket;
+static BOOLEAN isAsyncConnectSupported = true;      // Cleared when the firmware rejects +USOCO with <async_connect>
 
 //==============================================================================
 //  LOCAL FUNCTION PROTOTYPES
@@ -104,10 +148,27 @@ static bool CellularATCMECheck(uint8_t *ResponseBuffer, int32_t length );
 static uint32_t UARTReadBlocking(UARTDRV_Handle_t uart,  uint8_t buffer[], uint32_t readSize );
 static int32_t WarmupCellularModule(void);
 static int32_t ConfigureCertificate(void);
+static void ApplyCipherSuite(void);
 static int32_t PostDataToiNet(void);
+static int32_t AttachForUpload(uint32_t registrationPolls);
+static void PrewarmConnection(void);
+static void ReleaseNetwork(void);
+static void StartTokenSocket(void);
+static void WaitTokenSocket(void);
+static void CloseTokenSocket(void);
+static void RecordSocketHandshake(BOOLEAN isResumable);
+static int32_t RequestTokenOnSocket(PTR_COMM_EVT_t commEvent);
+static uint32_t SendAlarmSMS(PTR_COMM_EVT_t commEvent);
+static void SendDueAlarmsSMS(void);
+static void CellularResolveEventPosition(PTR_COMM_EVT_t commEvent);
+static BOOLEAN CellularServiceGNSS(BOOLEAN isPollForced);
+static BOOLEAN CellularInterleaveGNSS(BOOLEAN isPositionNeeded);
+static void RecordUploadPositionAge(PTR_COMM_EVT_t commEvent);
 static int32_t PerformCellularRecovery(int32_t errorCode);
 static int32_t CellularDeviceWrite( ATCOMMAND_INDEX_ENUM at_idx );
-static void WaitForCellularGetReady(void);
+static void CellularSetBandMask(BOOLEAN isRestricted);
+static int32_t AttachToNetwork(uint32_t registrationPolls);
+static int32_t ResolveINetHost(void);
 
 static int32_t GPSConfigure(void);
 static void ClearRxBuffer(void);
@@ -294,44 +355,63 @@ static void CellularModuleReset(void)
 }
 
 //------------------------------------------------------------------------------
-//  static int CellularGetGPSData(void)
+//  static int32_t CellularGetGPSData(void)
 //
 //   Author:  Abdul Basit
 //   Date:    2018/07/10
 //
-//!  
+//!  This function poll UBX-NAV-PVT from the GNSS over the modem I2C
+//!  passthrough and update the coordinates attached to events
 //
 //------------------------------------------------------------------------------
-static int CellularGetGPSData(void)
+static int32_t CellularGetGPSData(void)
 {
-    int status=0;
-    RTOS_ERR  err;
-   
+    int32_t status = 0;
+    uint32_t loopCounter = 0;
+    UBXNavPvt_t navPvt;
+
     if(isGPSinit == false)
     {
-        CellularDeviceWrite(ATC_GNSS_ON);
-        isGPSinit = true;
-        printf("GPS ON\r\n");
+        status = GPSConfigure();
+    }
+
+    if(status >= 0)
+    {
+        status = GPSCreatePollNavPvtCommand(cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE);
+    }
+    if(status >= 0)
+    {
+        status = CellularDeviceWrite(ATC_UI2CW);
     }
 
-    if(status>=0)
+    // Receiver answers the poll within a navigation epoch, until then reads give 0xFF filler
+    if(status >= 0)
     {
-        status = CellularDeviceWrite(ATC_UGGGA_DATA);
+        status = ERR_UBX_FRAME_NOT_FOUND;
+        for(loopCounter = 0; (status == ERR_UBX_FRAME_NOT_FOUND) && (loopCounter < GPS_NAV_PVT_READ_ATTEMPTS); loopCounter++)
+        {
+            status = CellularDeviceWrite(ATC_UI2CR);
+            if(status >= 0)
+            {
+                status = GPSParseNavPvtResponse(gCellularDriver.UARTRxBuffer, cellHttpsReceiving.receivedBytes, &navPvt);
+            }
+        }
     }
-    //printf("GGA: %s\r\n",gCellularDriver.UARTRxBuffer);
-    OSTimeDly(2000, OS_OPT_TIME_DLY, &err); // delay 
-    if(status>=0)
+
+    if(status >= 0)
     {
-//        status = CellularDeviceWrite(ATC_UGGSV_ENABLE);
+        GPSUpdateCoordinates(&navPvt);
+        GNSSAidingUpdateFix(&navPvt);
+        GNSSDutyCycleReportFix(&navPvt);
     }
-//    OSTimeDly(2000, OS_OPT_TIME_DLY, &err); // delay 
-    if(status>=0)
+    else
     {
-        status = CellularDeviceWrite(ATC_UGGSV_DATA);
+        // I2C errors mean the receiver lost power or configuration
+        isGPSinit = false;
     }
-    
+    lastNavPvtTicks = GetRTCTicks();
+
     return status;
-    
 }
 
 
@@ -358,6 +438,7 @@ static int32_t CellularDeviceWrite( ATCOMMAND_INDEX_ENUM at_idx )
         ClearRxBuffer();
         cellHttpsReceiving.receivedBytes = 0;
         cellHttpsReceiving.UARTWaitCounter = 0;
+        isNetworkTimeURCHandled = false;
         gCellularDriver.currentATIndex = at_idx;
         
         inputPtr = CelluarATCommands[at_idx].cmd;
@@ -379,10 +460,16 @@ static int32_t CellularDeviceWrite( ATCOMMAND_INDEX_ENUM at_idx )
                 
                 // write the AT command or data to the cellular modem
                 ret = UARTDRV_TransmitB(gCellularDriver.cellUART, gCellularDriver.UARTTxBuffer, dataSize);
+                UARTCaptureRecord(UART_CAPTURE_TX, (uint8_t)at_idx, gCellularDriver.UARTTxBuffer, dataSize);
+                CellularUsageRecordSent(at_idx, (uint32_t)dataSize);
                 remainingSize -= dataSize;
                 writeSize += dataSize;
             }
             while(remainingSize > 0);
+            if(at_idx == ATC_USOWR)
+            {
+                CellularTimingMark(CELL_TIMING_BODY_WRITTEN);
+            }
         }
         if(CelluarATCommands[at_idx].timeout > (uint32_t) 0)
         {
@@ -469,6 +556,31 @@ static void UARTReadParser(  uint8_t Response[], size_t count )
     if(count >= 1u)
     {
 //            printf("Rx Data: %s\r\n", Response);
+        // Network time URC may come within the response of any command
+        if((isNetworkTimeURCHandled == false) && (CellularParseNetworkTimeURC(Response) == 0))
+        {
+            isNetworkTimeURCHandled = true;
+        }
+        // Token socket connect ends within the response of whatever command runs
+        if(tokenSocket.isConnecting == true)
+        {
+            switch(CellularParseSocketConnectURC(Response, tokenSocket.socket))
+            {
+            case 0:
+                tokenSocket.isConnected = true;
+                tokenSocket.isConnecting = false;
+                break;
+            case ERR_UNABLE_TO_OPEN_TCP_SOCK:
+                tokenSocket.isConnecting = false;
+                break;
+            default:
+                break;
+            }
+            if(tokenSocket.isConnecting == false)
+            {
+                tokenSocket.connectMs = RTCDRV_TicksToMsec(GetRTCTicks() - tokenSocket.startTicks);
+            }
+        }
         // Check whether the response is a CME message
         if(CellularATCMECheck(Response, (int32_t)count) == false)
         {
@@ -497,7 +609,9 @@ static void UARTReadParser(  uint8_t Response[], size_t count )
 static bool CellularATCMECheck(uint8_t *ResponseBuffer, int32_t length )
 {
     bool ret = false;
-    if(strncmp((char const*)ResponseBuffer, "+CME ERROR:", 11u) ==  0)
+    // SMS commands report +CMS ERROR instead
+    if((strncmp((char const*)ResponseBuffer, "+CME ERROR:", 11u) ==  0) ||
+       (strncmp((char const*)ResponseBuffer, "+CMS ERROR:", 11u) ==  0))
     {
         // CME Error
         cellHttpsReceiving.endReading = ERR_CELLULAR_CME_ERROR;
@@ -529,6 +643,13 @@ static uint32_t UARTReadBlocking(UARTDRV_Handle_t uart,  uint8_t buffer[], uint3
         cellHttpsReceiving.readyBytes = readSize;
         cellHttpsReceiving.UARTWaitCounter = 0;
     }
+    UARTCaptureRecord(UART_CAPTURE_RX, (uint8_t)gCellularDriver.currentATIndex, buffer, cellHttpsReceiving.readyBytes);
+    CellularUsageRecordReceived(gCellularDriver.currentATIndex, cellHttpsReceiving.readyBytes);
+    if((gCellularDriver.currentATIndex == ATC_USOWR) && (cellHttpsReceiving.readyBytes > 0u) &&
+       (CellularTimingIsMarked(CELL_TIMING_FIRST_RESPONSE) == false))
+    {
+        CellularTimingMark(CELL_TIMING_FIRST_RESPONSE);
+    }
     cellHttpsReceiving.receivedBytes += cellHttpsReceiving.readyBytes;
     buffer[cellHttpsReceiving.receivedBytes] = 0u;
     return cellHttpsReceiving.receivedBytes;
@@ -548,6 +669,8 @@ static int32_t WarmupCellularModule(void)
 {
     int32_t ret = -1;
     uint32_t loopCounter = 0;
+    uint32_t refTicks = 0;
+    int32_t identityRet = 0;
     uint8_t retryCount= 0;
     // Get necessary Cellular Data data
     for(loopCounter = 0; loopCounter < 3; loopCounter++)
@@ -577,6 +700,9 @@ static int32_t WarmupCellularModule(void)
         {
             //      printf("Verbose Error Enabled\r\n");
         }
+        // Network time and zone are reported by +CTZE URC when registering
+        CellularDeviceWrite(ATC_CTZU);
+        CellularDeviceWrite(ATC_CTZR);
         // Check the SIM card status
         for(loopCounter = 0; loopCounter < 3; loopCounter++)
         {
@@ -590,56 +716,78 @@ static int32_t WarmupCellularModule(void)
         
         if(ret >= 0)
         {
-            //Get module IMEI number
-            ret = CellularDeviceWrite(ATC_CGSN);
-            if(ret >= 0)
+            // Get SIM Card ICCID number, it tells whether the cached identity still holds
+            identityRet = CellularDeviceWrite(ATC_ICCID);
+            if(identityRet >= 0)
             {
-                //        printf("Module IMEI: %s\r\n", gCellularDriver.imei);
+                //        printf("Sim Card ICCID: %s\r\n", gCellularDriver.iccid);
+                identityRet = CellularIdentityRestore();
             }
-            // Get SIM Card ICCID number
-            ret = CellularDeviceWrite(ATC_ICCID);
-            if(ret >= 0)
+            if(identityRet == ERR_CELL_IDENTITY_SIM_CHANGED)
             {
-                //        printf("Sim Card ICCID: %s\r\n", gCellularDriver.iccid);
+                // Operator of the last registration belongs to the other SIM
+                CellularNetCacheForgetOperator();
             }
-            
-            CellularDeviceWrite(ATC_URAT);
-            // Write Sim Card APN
-            ret = CellularDeviceWrite(ATC_CGDCONT);
-            
-            do
+            if(identityRet < 0)
             {
-                // Check the Radio signal strength
-                ret = CellularDeviceWrite(ATC_CSQ);
-                if(ret >= 0)
+                //Get module IMEI number
+                identityRet = CellularDeviceWrite(ATC_CGSN);
+                if(identityRet >= 0)
                 {
-                    retryCount = 0;
-                    //          printf("Cellular Radio Signal Strength: %d\r\n", gCellularDriver.signalStrength);
+                    //        printf("Module IMEI: %s\r\n", gCellularDriver.imei);
+                    identityRet = CellularDeviceWrite(ATI);
                 }
-            }while ((ret < 0) && (++retryCount < 255));
-
-            do
-            {
-                // Check sim card network registration status
-                ret = CellularDeviceWrite(ATC_CREG_Q);
-                if(ret >= 0)
+                // Write Sim Card APN, the module keeps it with the PDP context
+                ret = CellularDeviceWrite(ATC_CGDCONT);
+                if((identityRet >= 0) && (ret >= 0))
                 {
-                    //            printf("Sim card is Registered on Network Operator\r\n");
+                    CellularIdentityUpdate();
                 }
-            }while ((ret < 0) && (++retryCount < 25));
+            }
+            
+            // RAT preference learned from earlier attaches, the modem keeps it until changed
+            (void)CellularRATSelectOrder(true);
+            if(CellularRATCreateCommand(cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE) > 0)
+            {
+                CellularDeviceWrite(ATC_URAT);
+            }
+            // Band masks are read before the network cache ever restricts them
+            if(CellularNetCacheIsFullMaskKnown() == false)
+            {
+                (void)CellularDeviceWrite(ATC_UBANDMASK_Q);
+            }
+            (void)CellularDeviceWrite(ATC_UCGED_MODE);
+            
+            // Cached band and operator first, full scan of every band when they fail
+            refTicks = GetRTCTicks();
+            ret = AttachToNetwork(WARMUP_REGISTRATION_POLLS);
             if(ret < 0)
             {
                 //        printf("Unable to Register Sim Card to Network\r\n");
+                CellularRATRecordAttachFailure();
                 ret = ERR_SIM_CARD_REGISTRATION_FAILED;
                 gCellularDriver.errorCode = ERR_SIM_CARD_REGISTRATION_FAILED;
             }
             else
             {
+                CellularRATRecordAttach(gCellularDriver.accessTechnology, RTCDRV_TicksToMsec(GetRTCTicks() - refTicks));
+                do
+                {
+                    // Check the Radio signal strength
+                    ret = CellularDeviceWrite(ATC_CSQ);
+                    if(ret >= 0)
+                    {
+                        retryCount = 0;
+                        //          printf("Cellular Radio Signal Strength: %d\r\n", gCellularDriver.signalStrength);
+                    }
+                }while ((ret < 0) && (++retryCount < 255));
+                
                 //        printf("APn is Set\r\n");
-                // Get time from cellular tower
-                ret = CellularDeviceWrite(ATC_CCLK_Q);
-                //        printf("Received Time from Cell Tower\r\n"); 
-                ret = CellularDeviceWrite(ATC_COPS_Q);
+                // Time normally came by +CTZE URC, modem clock is read once only if it was missed
+                if(gCellularDriver.isRTCTimeUpdated == false)
+                {
+                    ret = CellularDeviceWrite(ATC_CCLK_Q);
+                }
                 // Attach GPRS
                 ret = CellularDeviceWrite(ATC_CGATT);
                 for(loopCounter = 0; loopCounter < 5; loopCounter++)
@@ -693,8 +841,10 @@ static int32_t ConfigureCertificate(void)
             // Write configuration for certificate e.g encryption type, root or client certificate etc
             ret = CellularDeviceWrite(ATC_USECPRF_1);
             ret = CellularDeviceWrite(ATC_USECPRF_2);
-            ret = CellularDeviceWrite(ATC_USECPRF_3);
+            ApplyCipherSuite();
             ret = CellularDeviceWrite(ATC_USECPRF_4);
+            // Reconnects skip the certificate exchange when the session resumes
+            CellularTLSSetResumption((CellularDeviceWrite(ATC_USECPRF_RESUME) >= 0));
         }
     }
     else
@@ -706,6 +856,140 @@ static int32_t ConfigureCertificate(void)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+//  static void ApplyCipherSuite(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the cipher suite to offer to the security profile,
+//!  going down the preference list while the firmware rejects them
+//
+//------------------------------------------------------------------------------
+static void ApplyCipherSuite(void)
+{
+    while(CellularTLSIsSuitePending() == true)
+    {
+        CellularTLSSetSuiteApplied((CellularDeviceWrite(CellularTLSGetSuiteCommand()) >= 0));
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void CellularResolveEventPosition(PTR_COMM_EVT_t commEvent)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function attach the best position held to the event and, when there
+//!  is none, request CellLocate for what is left of the event position budget.
+//!  GNSS is never powered or waited for here.
+//
+//------------------------------------------------------------------------------
+static void CellularResolveEventPosition(PTR_COMM_EVT_t commEvent)
+{
+    uint32_t budgetMs = PositionGetBudgetMs(commEvent->priority);
+    uint32_t elapsedMs = RTCDRV_TicksToMsec(GetRTCTicks() - commEvent->createdTicks);
+
+    if((PositionSelect(&commEvent->GPSLocationInfo, commEvent->createdTicks) == false) &&
+       (budgetMs > elapsedMs) && ((budgetMs - elapsedMs) >= POSITION_MIN_CELL_LOCATE_MS))
+    {
+        (void)PositionCreateCellLocateCommand(cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE, (budgetMs - elapsedMs));
+        CelluarATCommands[ATC_ULOC].timeout = RTCDRV_MsecsToTicks(budgetMs - elapsedMs);
+        if(CellularDeviceWrite(ATC_ULOC) >= 0)
+        {
+            (void)PositionSelect(&commEvent->GPSLocationInfo, commEvent->createdTicks);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static BOOLEAN CellularServiceGNSS(BOOLEAN isPollForced)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function serve pending GNSS power down and NAV-PVT poll requests.
+//!  isPollForced polls a powered receiver even without request.
+//!
+//! \return true when a NAV-PVT was read
+//
+//------------------------------------------------------------------------------
+static BOOLEAN CellularServiceGNSS(BOOLEAN isPollForced)
+{
+    BOOLEAN ret = false;
+
+    if(isGNSSOffPending == true)
+    {
+        isGNSSOffPending = false;
+        (void)CellularDeviceWrite(ATC_GNNS_SUPPLY_OFF);
+        GNSSAidingRequestSave();
+        isGPSinit = false;
+    }
+    if((isGNSSPollPending == true) || ((isPollForced == true) && (isGPSinit == true)))
+    {
+        isGNSSPollPending = false;
+        ret = (CellularGetGPSData() >= 0);
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static BOOLEAN CellularInterleaveGNSS(BOOLEAN isPositionNeeded)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function run GNSS work between two socket steps of an upload, so a
+//!  poll does not wait for the whole upload. When a position is about to be
+//!  attached a powered receiver is also polled if its last read is older
+//!  than the poll interval. Nothing is sent while the direct link is open.
+//!
+//! \return true when a NAV-PVT was read
+//
+//------------------------------------------------------------------------------
+static BOOLEAN CellularInterleaveGNSS(BOOLEAN isPositionNeeded)
+{
+    BOOLEAN ret = false;
+    BOOLEAN isStale = (RTCDRV_TicksToMsec(GetRTCTicks() - lastNavPvtTicks) >= GNSS_DUTY_POLL_INTERVAL_MS);
+
+    if((isDirectLinkActive == false) && ((isGNSSOffPending == true) || (isGNSSPollPending == true) ||
+                                         ((isPositionNeeded == true) && (isGPSinit == true) && (isStale == true))))
+    {
+        schedulerStats.interleavedSteps++;
+        ret = CellularServiceGNSS(isPositionNeeded && isStale);
+        if(ret == true)
+        {
+            schedulerStats.interleavedPolls++;
+        }
+        ClearWatchDogCounter();
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static void RecordUploadPositionAge(PTR_COMM_EVT_t commEvent)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record the age of the GNSS position sent with an event
+//
+//------------------------------------------------------------------------------
+static void RecordUploadPositionAge(PTR_COMM_EVT_t commEvent)
+{
+    if((commEvent->GPSLocationInfo.isGpsValid == true) && (commEvent->GPSLocationInfo.source == POSITION_SOURCE_GNSS))
+    {
+        schedulerStats.gnssPositionsSent++;
+        schedulerStats.lastPositionAgeMs = RTCDRV_TicksToMsec(GetRTCTicks() - commEvent->GPSLocationInfo.fixTicks);
+        if(schedulerStats.lastPositionAgeMs > schedulerStats.maxPositionAgeMs)
+        {
+            schedulerStats.maxPositionAgeMs = schedulerStats.lastPositionAgeMs;
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 //  static int32_t PostDataToiNet(void)
 //
@@ -719,35 +1003,73 @@ static int32_t ConfigureCertificate(void)
 static int32_t PostDataToiNet(void)
 {
     PTR_COMM_EVT_t    commEvent = NULL;
-    OS_MSG_SIZE       eventMsgSize = 0;
-    RTOS_ERR          err;
-    void              *p_msg;
-    CPU_TS            ts;
     int32_t           ret = 0;
     uint32_t          size = 0;
+    int32_t           headerSize = 0;
     uint8_t           failCounter = 0;
-    // Totatl number of events in QUEUE
-    uint32_t numberOfEvents = eventMessagesQueue.MsgQ.NbrEntries;
+    // Totatl number of events in all QUEUE lanes
+    uint32_t numberOfEvents = GetPendingEventsCount();
     static uint32_t eventSent = 0;
+    uint32_t stepTicks = 0;
+    BOOLEAN isAddressCached = false;
+    BOOLEAN isLookupRetried = false;
+    BOOLEAN isResumable = false;
+    BOOLEAN isTokenRequest = false;
+    uint32_t connectMs = 0;
+    
+    // A failed upload leaves the direct link to recovery, which resets the modem
+    isDirectLinkActive = false;
+    // Token socket of an earlier session is left for the server to close,
+    // the one of a warm up is used while the radio stayed attached
+    if(isNetworkAttached == false)
+    {
+        tokenSocket.isOpen = false;
+        tokenSocket.isConnecting = false;
+        tokenSocket.isConnected = false;
+    }
     if(numberOfEvents > 0)
     {
         gCellularDriver.cellularState = CELLULAR_READY;
         
-        // Disable the Power saving
-        CellularDeviceWrite(ATC_CFUN_1);
-        WaitForCellularGetReady();
+        CellularPrewarmRecordUpload(isNetworkAttached);
+        CellularTimingBegin();
+        ret = AttachForUpload(UPLOAD_REGISTRATION_POLLS);
+        if(ret < 0)
+        {
+            ret = ERR_SIM_CARD_REGISTRATION_FAILED;
+            gCellularDriver.errorCode = ERR_SIM_CARD_REGISTRATION_FAILED;
+        }
         
         if(ret >= 0)
         {
-            // Send All events in the Queue
+            // Send All events in the Queue, alarm lane is checked before every event
+            // so an alarm raised during a batch is sent next
             while( (gCellularDriver.cellularState == CELLULAR_READY) &&
-                  ((p_msg = OSQPend(&eventMessagesQueue,100, OS_OPT_PEND_BLOCKING, &eventMsgSize, &ts, &err)) != NULL) )
+                  ((commEvent = GetNextEventFromQueue(100)) != NULL) )
             {
-                commEvent = (PTR_COMM_EVT_t) p_msg;
+                (void)CellularInterleaveGNSS(true);
+                CellularResolveEventPosition(commEvent);
                 cellHttpsReceiving.isEventSent = false;
                 // Try again if event is failed to upload or token expires
                 while((cellHttpsReceiving.isEventSent == false) && (ret >= 0))
                 {
+                    // First request of the batch continues the transaction of the attach
+                    CellularTimingBegin();
+                    // Token handshake runs in the module while the data socket connects
+                    if(cellHttpsReceiving.isTokenValid == false)
+                    {
+                        StartTokenSocket();
+                    }
+                    // Data socket is charged to the token only when it carries the token
+                    if((cellHttpsReceiving.isTokenValid == false) &&
+                       (tokenSocket.isConnecting == false) && (tokenSocket.isConnected == false))
+                    {
+                        (void)CellularUsageSetEvent(GET_INET_TOKEN);
+                    }
+                    else
+                    {
+                        (void)CellularUsageSetEvent(commEvent->commEvtType);
+                    }
                     
                     //Configure Cellular TCP Socket
                     ret = CellularDeviceWrite(ATC_USOCR);
@@ -760,59 +1082,93 @@ static int32_t PostDataToiNet(void)
                     
                     if(ret >= 0)
                     {
-                        // Open TCP Socket
+                        CellularTimingMark(CELL_TIMING_SOCKET_CREATED);
+                        // A suite the server kept failing is replaced before the next handshake
+                        ApplyCipherSuite();
+                        // Open TCP Socket, to the cached host address when there is one
+                        isAddressCached = CellularDNSIsCached();
+                        isResumable = CellularTLSIsResumable();
                         ret = CreateUARTTXdata(ATC_USOCO, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE);
+                        stepTicks = GetRTCTicks();
                         ret = CellularDeviceWrite(ATC_USOCO);
+                        connectMs = RTCDRV_TicksToMsec(GetRTCTicks() - stepTicks);
+                        CellularRATRecordConnect((ret >= 0), connectMs);
+                        CellularTLSRecordHandshake(isResumable, (ret >= 0), connectMs);
+                        if(isAddressCached == true)
+                        {
+                            CellularDNSRecordConnect((ret >= 0));
+                        }
                         if(ret >= 0)
                         {
+                            CellularTimingMark(CELL_TIMING_CONNECTED);
+                            RecordSocketHandshake(isResumable);
+                            // Connect may take tens of seconds, last chance for a fresher fix
+                            if(CellularInterleaveGNSS(true) == true)
+                            {
+                                (void)PositionSelect(&commEvent->GPSLocationInfo, commEvent->createdTicks);
+                            }
+                            // Data socket waits connected for the token, the data socket carries it when that fails
+                            if((cellHttpsReceiving.isTokenValid == false) &&
+                               ((tokenSocket.isConnecting == true) || (tokenSocket.isConnected == true)))
+                            {
+                                (void)RequestTokenOnSocket(commEvent);
+                            }
                             // Open Direct Link TCP Socket
                             ret = CreateUARTTXdata(AT_USODL, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE);
                             ret = CellularDeviceWrite(AT_USODL);
                             if(ret >= 0)
                             {
+                                CellularTimingMark(CELL_TIMING_LINK_OPEN);
+                                isDirectLinkActive = true;
                                 // Change Cellular State  From Ready to Busy
                                 gCellularDriver.cellularState = CELLULAR_BUSY;
                                 
                                 // If No Valid Token is available Get Token
-                                if(cellHttpsReceiving.isTokenValid == false)
+                                isTokenRequest = (cellHttpsReceiving.isTokenValid == false);
+                                if(isTokenRequest == true)
                                 {
+                                    (void)CellularUsageSetEvent(GET_INET_TOKEN);
                                     // Create JSON data
-                                    size = jsonCreatorAndParser[GET_INET_TOKEN].jCreator(httpUrlBuffer, CELLULAR_URL_BUFFER_SIZE, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE, commEvent);
+                                    headerSize = jsonCreatorAndParser[GET_INET_TOKEN].jCreator(httpUrlBuffer, CELLULAR_URL_BUFFER_SIZE, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE, commEvent);
                                     // Create HTTP Header
-                                    size = CreateHttpHeader(GET_INET_TOKEN, cellHeaderBuffer, CELLULAR_HEADER_BUFFER_SIZE, (size-1));
+                                    headerSize = (headerSize > 0) ? CreateHttpHeader(GET_INET_TOKEN, cellHeaderBuffer, CELLULAR_HEADER_BUFFER_SIZE, (uint32_t)(headerSize-1)) : ERR_JSON_CREATE_FAILED;
                                 }
                                 else
                                 {
+                                    RecordUploadPositionAge(commEvent);
                                     // Create JSON data
-                                    size = jsonCreatorAndParser[commEvent->commEvtType].jCreator(httpUrlBuffer, CELLULAR_URL_BUFFER_SIZE, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE, commEvent);
+                                    headerSize = jsonCreatorAndParser[commEvent->commEvtType].jCreator(httpUrlBuffer, CELLULAR_URL_BUFFER_SIZE, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE, commEvent);
                                     // Create HTTP Header
-                                    size = CreateHttpHeader(commEvent->commEvtType, cellHeaderBuffer, CELLULAR_HEADER_BUFFER_SIZE, (size-1));
+                                    headerSize = (headerSize > 0) ? CreateHttpHeader(commEvent->commEvtType, cellHeaderBuffer, CELLULAR_HEADER_BUFFER_SIZE, (uint32_t)(headerSize-1)) : ERR_JSON_CREATE_FAILED;
                                 }
                                 
                                 
-                                if(size > 0)
+                                // A header that does not fit is never written
+                                if(headerSize > 0)
                                 {
                                     // Write HTTP Header to TCP socket
                                     ret = CellularDeviceWrite(ATC_WRITEHEADER);
                                     if(ret >= 0)
                                     {
+                                        CellularTimingMark(CELL_TIMING_HEADER_WRITTEN);
                                         // Write HTTP Body and Read Response from server
                                         ret = CellularDeviceWrite(ATC_USOWR);
                                         if(ret >= 0)
                                         {
+                                            CellularTimingMark(CELL_TIMING_LAST_RESPONSE);
                                             eventSent++;
                                             size = strlen((char const*)cellHttpsReceiving.jsonHeader);
-                                            if(cellHttpsReceiving.isTokenValid == false)
+                                            if(isTokenRequest == true)
                                             {
                                                 ret = jsonCreatorAndParser[GET_INET_TOKEN].jParser(cellHttpsReceiving.jsonHeader, size, tokenBuffer, MAX_JSON_TOKEN_STRING_SIZE ,commEvent);
-                                                if(ret >= 0)
-                                                {
-                                                    cellHttpsReceiving.isTokenValid = true;
-                                                }
-                                                else
-                                                {
-                                                    cellHttpsReceiving.isTokenValid = true;
-                                                }
+                                                // A token that does not parse is requested again
+                                                cellHttpsReceiving.isTokenValid = (ret >= 0);
+                                                // Server closed this socket, the event goes on the next one
+                                                cellHttpsReceiving.isEventSent = false;
+                                            }
+                                            else if(cellHttpsReceiving.isTokenValid == false)
+                                            {
+                                                // 401, the event is sent again with a new token
                                                 cellHttpsReceiving.isEventSent = false;
                                             }
                                             else
@@ -854,6 +1210,15 @@ static int32_t PostDataToiNet(void)
                                 gCellularDriver.errorCode = ERR_UNABLE_TO_OPEN_DIRECT_LINK;
                             }
                         }
+                        else if((isAddressCached == true) && (isLookupRetried == false))
+                        {
+                            // Host may have moved, look it up again and retry once on a new socket
+                            isLookupRetried = true;
+                            CreateUARTTXdata(ATC_USOCL, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE);
+                            (void)CellularDeviceWrite(ATC_USOCL);
+                            (void)ResolveINetHost();
+                            ret = 0;
+                        }
                         else
                         {
                             ret = ERR_UNABLE_TO_OPEN_TCP_SOCK;
@@ -865,21 +1230,25 @@ static int32_t PostDataToiNet(void)
                         ret = ERR_TCP_SOCKET_ERROR;
                         gCellularDriver.errorCode = ERR_TCP_SOCKET_ERROR;
                     }
-                    if(ret >= 0)
+                    if((ret >= 0) && (isDirectLinkActive == true))
                     {
                         CellularDeviceWrite(ATC_USODL_CLOSE);
+                        isDirectLinkActive = false;
                         //                    OSTimeDly(5000, OS_OPT_TIME_DLY, &err);
                         CreateUARTTXdata(ATC_USORD, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE);
                         CellularDeviceWrite(ATC_USORD);
+                        CellularTimingMark(CELL_TIMING_CLOSED);
+                        (void)CellularInterleaveGNSS(false);
                         
                         //                        CreateUARTTXdata(ATC_USOCL, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE);
                         //                        CellularDeviceWrite(ATC_USOCL);
                     }
-                    
+                    CellularTimingEnd((isTokenRequest == true) ? GET_INET_TOKEN : commEvent->commEvtType, (ret >= 0));
                 }
                 // Send Data to cloud and receive corresponding response
                 if(ret >= 0)
                 {
+                    RecordEventLatency(commEvent);
                     //return the event memory back to memory pool
                     ReturnEventMessageToPool(commEvent, true);
                     //                    OSTimeDly(5000, OS_OPT_TIME_DLY, &err);
@@ -887,207 +1256,591 @@ static int32_t PostDataToiNet(void)
                 }
                 else
                 {
+                    // Alarm late already goes by SMS before recovery resets the modem, it stays queued for iNet
+                    if(CellularSMSIsAlarmDue(commEvent) == true)
+                    {
+                        CellularSMSRecordAlarm(commEvent, SendAlarmSMS(commEvent));
+                    }
                     ReturnEventMessageToPool(commEvent, false);
                     break;
                 }
+                
+                // Alarm late behind a long batch is not kept waiting for its end
+                if(isAlarmCheckPending == true)
+                {
+                    isAlarmCheckPending = false;
+                    SendDueAlarmsSMS();
+                }
+            }
+            
+            // Host is looked up after the uploads, off their critical path
+            if((ret >= 0) && (CellularDNSIsExpired() == true))
+            {
+                (void)ResolveINetHost();
             }
             
         }
+        (void)CellularUsageSetEvent(CELL_USAGE_NO_EVENT);
+        CellularTimingCancel();
     }
     return ret;
 }
 
 
 //------------------------------------------------------------------------------
-//   static int32_t PerformCellularRecovery(int32_t errorCode)
+//  static int32_t AttachForUpload(uint32_t registrationPolls)
 //
-//   Author:  Dilawar Ali
-//   Date:    2018/06/01
+//   Author:  agent
+//   Date:    2026/10/19
 //
-//!  This function Will perform cellular recovery sequence depending upon the error code
+//!  This function switch the radio on and wait for the registration, unless
+//!  attached already. A new RAT order is taken at this attach, registrationPolls
+//!  as for AttachToNetwork.
 //
 //------------------------------------------------------------------------------
-static int32_t PerformCellularRecovery(int32_t errorCode)
+static int32_t AttachForUpload(uint32_t registrationPolls)
 {
     int32_t ret = 0;
+    uint32_t startTicks = 0;
     
-    switch(errorCode)
+    if(isNetworkAttached == false)
     {
-    case ERR_UNKNOWN_ERROR:
-    case ERR_MODULE_NOT_RESPONDING:
-    case ERR_UART_RX_TIMEOUT:
-    case ERR_INVALID_SIGNAL_STRENGTH:
-    case ERR_UART_NOT_OPEN:
-    case ERR_SIM_CARD_NOT_FOUND:
-    case ERR_SIM_CARD_REGISTRATION_FAILED:
-    case ERR_CERTIFICATE_INVALID:
-        
-    case ERR_TCP_SOCKET_ERROR:
-    case ERR_UNABLE_TO_OPEN_TCP_SOCK:
-    case ERR_UNABLE_TO_OPEN_DIRECT_LINK:
-        // Re-init the module
-        CellularInit();
-        break;
-        
-    case ERR_TCP_SOCKET_WRITE_FAILED:
-    case ERR_JSON_CREATE_FAILED:
-        
-    case ERR_AT_CMD_PARSER_FUCN_UNDEFINED:
-    case ERR_CELLULAR_CME_ERROR:
-    case ERR_UART_RX_DATA_NULL:
-    case ERR_UART_TX_DATA_NULL:
-    case ERR_INCOMPLETE_DATA_RECEIVED:
-    case ERR_SERVER_RESPONSE_PARSING_ERROR:
-        gCellularDriver.cellularState = CELLULAR_READY;
-        break;
-        
-    default:
+        if((CellularRATSelectOrder(false) == true) &&
+           (CellularRATCreateCommand(cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE) > 0))
+        {
+            CellularDeviceWrite(ATC_URAT);
+        }
         
-        gCellularDriver.cellularState = CELLULAR_READY;
-        break;
+        // Disable the Power saving, the radio stays on after warmup
+        startTicks = GetRTCTicks();
+        ret = AttachToNetwork(registrationPolls);
+        CellularRATRecordAttach(gCellularDriver.accessTechnology, RTCDRV_TicksToMsec(GetRTCTicks() - startTicks));
     }
     return ret;
 }
 
-//==============================================================================
-//  GPS functions
+//------------------------------------------------------------------------------
+//  static void PrewarmConnection(void)
 //
-//==============================================================================
-static int32_t GPSConfigure(void)
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function attach, look the host up and connect the token socket
+//!  ahead of the upload a hint expects. Nothing is done when the hold window
+//!  closed meanwhile or an upload kept the radio attached.
+//
+//------------------------------------------------------------------------------
+static void PrewarmConnection(void)
 {
-    int32_t status = 0;
-    uint32_t loopCounter = 0;
-    RTOS_ERR  err;
-    uint32_t messageSize = 0;
-    // enble GNSS Power
-    for(loopCounter = 0; loopCounter < 5; loopCounter++)
-    {
-        status = CellularDeviceWrite(ATC_GNNS_SUPPLY_EN);
-        if( status >= 0)
-        {
-            printf("GNSS power supply enabled\r\n");
-            break;
-        }
-    }
-    if(status<0)
-    {
-        printf("unable to power up GNSS\r\n");
-    }
+    int32_t ret = 0;
+    uint32_t startTicks = GetRTCTicks();
     
-    if(status>=0)
+    if((CellularPrewarmIsHeld() == true) && (isNetworkAttached == false))
     {
-        for(loopCounter = 0; loopCounter < 5; loopCounter++)
+        tokenSocket.isOpen = false;
+        tokenSocket.isConnecting = false;
+        tokenSocket.isConnected = false;
+        // Bounded, an event coming meanwhile waits behind this message
+        ret = AttachForUpload(WARMUP_REGISTRATION_POLLS);
+        if(ret >= 0)
         {
-            status = CellularDeviceWrite(ATC_GNNS_DATA_READY);
-            if( status >= 0)
+            // Nothing waits for the lookup yet
+            if(CellularDNSIsExpired() == true)
             {
-                printf("GNSS data ready configured\r\n");
-                break;
+                (void)ResolveINetHost();
+            }
+            if(cellHttpsReceiving.isTokenValid == false)
+            {
+                StartTokenSocket();
+                WaitTokenSocket();
             }
         }
-        if(status<0)
+        CellularPrewarmRecordWarmup((ret >= 0), RTCDRV_TicksToMsec(GetRTCTicks() - startTicks));
+        if(ret < 0)
         {
-            printf("unable to configure data ready pin\r\n");
+            // No coverage, the upload attaches itself
+            ReleaseNetwork();
         }
     }
+}
+
+//------------------------------------------------------------------------------
+//  static void ReleaseNetwork(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function switch the radio off, the power saving mode
+//
+//------------------------------------------------------------------------------
+static void ReleaseNetwork(void)
+{
+    CellularDeviceWrite(ATC_CFUN_0);
+    isNetworkAttached = false;
+    CellularPrewarmRecordRelease();
+}
+
+//------------------------------------------------------------------------------
+//  static void StartTokenSocket(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create the token socket and start its connect in the
+//!  background, +UUSOCO reports the result while the data socket is set up
+//
+//------------------------------------------------------------------------------
+static void StartTokenSocket(void)
+{
+    int32_t ret = 0;
+    COMM_EVT_TYPE_t previousEvent = CellularUsageSetEvent(GET_INET_TOKEN);
     
-    // open i2c port  ATC_UI2CO for gps
-    if(status>=0)
+    if((isAsyncConnectSupported == true) && (tokenSocket.isConnecting == false) && (tokenSocket.isConnected == false))
     {
-        for(loopCounter = 0; loopCounter < 5; loopCounter++)
+        // +UUSOCO may have reported a failure while nothing waited for it
+        CloseTokenSocket();
+        ret = CellularDeviceWrite(ATC_USOCR);
+        if(ret >= 0)
         {
-            status = CellularDeviceWrite(ATC_UI2CO);
-            if( status >= 0)
-            {
-
-                printf("GPS i2c configured\r\n");
-                break;
-            }
+            tokenSocket.socket = gCellularDriver.TCPSocket;
+            tokenSocket.isOpen = true;
+            (void)CreateUARTTXdata(ATC_UDCONF, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE);
+            ret = CellularDeviceWrite(ATC_UDCONF);
         }
-        if(status<0)
+        if(ret >= 0)
         {
-            printf("unable to configure gps i2c\r\n");
+            (void)CreateUARTTXdata(ATC_USOSEC, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE);
+            ret = CellularDeviceWrite(ATC_USOSEC);
+        }
+        if(ret >= 0)
+        {
+            ApplyCipherSuite();
+            tokenSocket.isResumable = CellularTLSIsResumable();
+            (void)CreateUARTTXdata(ATC_USOCO_ASYNC, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE);
+            tokenSocket.startTicks = GetRTCTicks();
+            ret = CellularDeviceWrite(ATC_USOCO_ASYNC);
+            tokenSocket.isConnecting = (ret >= 0);
+            if(ret == ERR_CELLULAR_CME_ERROR)
+            {
+                // Firmware without <async_connect>, the token goes on the data socket
+                isAsyncConnectSupported = false;
+            }
+        }
+        if(ret < 0)
+        {
+            CloseTokenSocket();
         }
-        
     }
-   
+    (void)CellularUsageSetEvent(previousEvent);
+}
+
+//------------------------------------------------------------------------------
+//  static void WaitTokenSocket(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function wait for +UUSOCO of the token socket, TOKEN_CONNECT_TIMEOUT_MS
+//!  at most from the connect start. A socket that did not connect is closed.
+//
+//------------------------------------------------------------------------------
+static void WaitTokenSocket(void)
+{
+    RTOS_ERR  err;
     
-    //TURN on GPS
-    status=0;
-    if(status>=0)
+    // Plain AT keeps reading the UART, +UUSOCO is parsed from its response
+    while((tokenSocket.isConnecting == true) &&
+          (RTCDRV_TicksToMsec(GetRTCTicks() - tokenSocket.startTicks) < TOKEN_CONNECT_TIMEOUT_MS))
     {
+        OSTimeDly(TOKEN_CONNECT_POLL_MS, OS_OPT_TIME_DLY, &err);
+        (void)CellularDeviceWrite(ATC_AT);
+    }
+    if(tokenSocket.isConnecting == true)
+    {
+        tokenSocket.connectMs = RTCDRV_TicksToMsec(GetRTCTicks() - tokenSocket.startTicks);
+    }
+    if(tokenSocket.isConnected == false)
+    {
+        // Timed out or +UUSOCO reported a failure, the socket is still held by the module
+        CloseTokenSocket();
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void CloseTokenSocket(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function release the token socket with +USOCL when it is still open,
+//!  the SARA-R4 has few sockets and a leaked one is only freed by a reset
+//
+//------------------------------------------------------------------------------
+static void CloseTokenSocket(void)
+{
+    uint32_t dataSocket = gCellularDriver.TCPSocket;
+    
+    if(tokenSocket.isOpen == true)
+    {
+        gCellularDriver.TCPSocket = tokenSocket.socket;
+        (void)CreateUARTTXdata(ATC_USOCL, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE);
+        (void)CellularDeviceWrite(ATC_USOCL);
+        gCellularDriver.TCPSocket = dataSocket;
+    }
+    tokenSocket.isOpen = false;
+    tokenSocket.isConnecting = false;
+    tokenSocket.isConnected = false;
+}
+
+//------------------------------------------------------------------------------
+//  static void RecordSocketHandshake(BOOLEAN isResumable)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read the byte totals of the socket just connected, the
+//!  TLS handshake, before the direct link carries any data on it
+//
+//------------------------------------------------------------------------------
+static void RecordSocketHandshake(BOOLEAN isResumable)
+{
+    (void)CreateUARTTXdata(ATC_USOCTL_SENT, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE);
+    (void)CellularDeviceWrite(ATC_USOCTL_SENT);
+    (void)CreateUARTTXdata(ATC_USOCTL_RECEIVED, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE);
+    (void)CellularDeviceWrite(ATC_USOCTL_RECEIVED);
+    CellularUsageRecordHandshake(isResumable);
+}
+
+//------------------------------------------------------------------------------
+//  static int32_t RequestTokenOnSocket(PTR_COMM_EVT_t commEvent)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function wait for the token socket to connect and request the
+//!  token on it, the data socket stays connected meanwhile
+//!
+//! \return 0 or an error, the token socket is then closed and the token
+//!         requested on the data socket
+//
+//------------------------------------------------------------------------------
+static int32_t RequestTokenOnSocket(PTR_COMM_EVT_t commEvent)
+{
+    int32_t ret = ERR_UNABLE_TO_OPEN_TCP_SOCK;
+    uint32_t size = 0;
+    int32_t headerSize = 0;
+    uint32_t dataSocket = gCellularDriver.TCPSocket;
+    COMM_EVT_TYPE_t previousEvent = CellularUsageSetEvent(GET_INET_TOKEN);
+    
+    WaitTokenSocket();
+    CellularTLSRecordHandshake(tokenSocket.isResumable, tokenSocket.isConnected, tokenSocket.connectMs);
+    
+    if(tokenSocket.isConnected == true)
+    {
+        gCellularDriver.TCPSocket = tokenSocket.socket;
+        RecordSocketHandshake(tokenSocket.isResumable);
+        (void)CreateUARTTXdata(AT_USODL, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE);
+        ret = CellularDeviceWrite(AT_USODL);
+        if(ret >= 0)
         {
-//            if(CellularDeviceWrite(ATC_UGPRF) >= 0)
-//            {
-//                printf("GPS profile Set\r\n");
-//            }
-//            if(CellularDeviceWrite(ATC_UGIND) >= 0)
-//            {
-//                printf("Indication configured\r\n");
-//            }
+            isDirectLinkActive = true;
+            headerSize = jsonCreatorAndParser[GET_INET_TOKEN].jCreator(httpUrlBuffer, CELLULAR_URL_BUFFER_SIZE, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE, commEvent);
+            headerSize = (headerSize > 0) ? CreateHttpHeader(GET_INET_TOKEN, cellHeaderBuffer, CELLULAR_HEADER_BUFFER_SIZE, (uint32_t)(headerSize-1)) : ERR_JSON_CREATE_FAILED;
+            ret = (headerSize > 0) ? CellularDeviceWrite(ATC_WRITEHEADER) : ERR_JSON_CREATE_FAILED;
+            if(ret == ERR_JSON_CREATE_FAILED)
+            {
+                gCellularDriver.errorCode = ERR_JSON_CREATE_FAILED;
+            }
+            if(ret >= 0)
+            {
+                ret = CellularDeviceWrite(ATC_USOWR);
+            }
+            if(ret >= 0)
+            {
+                size = strlen((char const*)cellHttpsReceiving.jsonHeader);
+                ret = jsonCreatorAndParser[GET_INET_TOKEN].jParser(cellHttpsReceiving.jsonHeader, size, tokenBuffer, MAX_JSON_TOKEN_STRING_SIZE ,commEvent);
+                cellHttpsReceiving.isTokenValid = (ret >= 0);
+            }
+            // Data socket is used next, the link is left in any case
+            CellularDeviceWrite(ATC_USODL_CLOSE);
+            isDirectLinkActive = false;
+            CreateUARTTXdata(ATC_USORD, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE);
+            CellularDeviceWrite(ATC_USORD);
+        }
+        gCellularDriver.TCPSocket = dataSocket;
+    }
+    if(ret >= 0)
+    {
+        // Server closes the socket after the response
+        tokenSocket.isOpen = false;
+        tokenSocket.isConnected = false;
+    }
+    else
+    {
+        CloseTokenSocket();
+    }
+    (void)CellularUsageSetEvent(previousEvent);
+    
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static uint32_t SendAlarmSMS(PTR_COMM_EVT_t commEvent)
 //
-//            if(CellularDeviceWrite(ATC_ULOCGNSS) >= 0)
-//            {
-//            }
-            status = CellularDeviceWrite(ATC_GNSS_ON);
-            if( status >= 0)
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function send the alarm summary to cell number 1 and 2, SMS needs
+//!  registration only, neither the PDP context nor the iNet connection
+//!
+//! \return number of messages accepted by the network
+//
+//------------------------------------------------------------------------------
+static uint32_t SendAlarmSMS(PTR_COMM_EVT_t commEvent)
+{
+    uint8_t const *numbers[] = {gCellularDriver.cellNumber1, gCellularDriver.cellNumber2};
+    uint32_t index = 0, messagesSent = 0;
+    BOOLEAN isModeSet = false;
+    
+    if(isDirectLinkActive == true)
+    {
+        CellularDeviceWrite(ATC_USODL_CLOSE);
+        isDirectLinkActive = false;
+    }
+    for(index = 0; index < (sizeof(numbers) / sizeof(numbers[0])); index++)
+    {
+        if(CellularSMSCreatePDU(commEvent, numbers[index], cellHeaderBuffer, CELLULAR_HEADER_BUFFER_SIZE, cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE) > 0)
+        {
+            if(isModeSet == false)
             {
-                printf("GPS on\r\n");
-                isGPSinit = true;
-//                CellularDeviceWrite(ATC_UGGGA);
-//                CellularDeviceWrite(ATC_UGGSV_ENABLE);
-//                OSTimeDly(5000, OS_OPT_TIME_DLY, &err);
-                
-                
-                
-//                uint32_t bufferSize = (sizeof(configureI2CPortCmd) / sizeof(uint8_t ));
-//                messageSize = snprintf(cellDataBuffer, (CELLULAR_DATA_BUFFER_SIZE - messageSize), "AT+UGUBX=\"");
-//                for(uint32_t i=0; i<bufferSize; i++)
-//                {
-//                    messageSize += snprintf(&cellDataBuffer[messageSize], (CELLULAR_DATA_BUFFER_SIZE - messageSize), "%.2x", configureI2CPortCmd[i]);
-//                }
-//                messageSize += snprintf(&cellDataBuffer[messageSize], (CELLULAR_DATA_BUFFER_SIZE - messageSize), "\"\r\n");
-//                
-//                if(CellularDeviceWrite(ATC_UI2CW) >= 0)
-//                {
-//                    printf("Ready pin configured\r\n");
-//                }
-//               
-//                
-//                bufferSize = (sizeof(CFG_MSG) / sizeof(uint8_t ));
-//                messageSize = snprintf(cellDataBuffer, (CELLULAR_DATA_BUFFER_SIZE - messageSize), "AT+UGUBX=\"");
-//                for(uint32_t i=0; i<bufferSize; i++)
-//                {
-//                    messageSize += snprintf(&cellDataBuffer[messageSize], (CELLULAR_DATA_BUFFER_SIZE - messageSize), "%.2x", CFG_MSG[i]);
-//                }
-//                messageSize += snprintf(&cellDataBuffer[messageSize], (CELLULAR_DATA_BUFFER_SIZE - messageSize), "\"\r\n");
-//                
-//                CellularDeviceWrite(ATC_UI2CW);
-//                
-//                
-//                bufferSize = (sizeof(CFG_MSG_GET) / sizeof(uint8_t ));
-//                messageSize = snprintf(cellDataBuffer, (CELLULAR_DATA_BUFFER_SIZE - messageSize), "AT+UGUBX=\"");
-//                for(uint32_t i=0; i<bufferSize; i++)
-//                {
-//                    messageSize += snprintf(&cellDataBuffer[messageSize], (CELLULAR_DATA_BUFFER_SIZE - messageSize), "%.2x", CFG_MSG_GET[i]);
-//                }
-//                messageSize += snprintf(&cellDataBuffer[messageSize], (CELLULAR_DATA_BUFFER_SIZE - messageSize), "\"\r\n");
-//                
-//                CellularDeviceWrite(ATC_UI2CW);
-                                //                CellularDeviceWrite(ATC_ULOC);
-                printf("GPS ON\r\n");
-                gps_initialized=1;
+                isModeSet = (CellularDeviceWrite(ATC_CMGF) >= 0);
+            }
+            if((isModeSet == true) && (CellularDeviceWrite(ATC_CMGS) >= 0) && (CellularDeviceWrite(ATC_CMGS_PDU) >= 0))
+            {
+                messagesSent++;
             }
         }
-        if(status<0)
+    }
+    
+    return messagesSent;
+}
+
+//------------------------------------------------------------------------------
+//  static void SendDueAlarmsSMS(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function send by SMS the alarms of the lane past their deadline.
+//!  The oldest CELL_SMS_ALARMS_CHECKED alarms are taken out and given back
+//!  in their order, they stay queued for iNet. The radio is attached with a
+//!  bounded registration, the caller releases it.
+//
+//------------------------------------------------------------------------------
+static void SendDueAlarmsSMS(void)
+{
+    PTR_COMM_EVT_t alarms[CELL_SMS_ALARMS_CHECKED];
+    uint32_t count = 0, index = 0;
+    BOOLEAN isAttachTried = false;
+    
+    while((count < CELL_SMS_ALARMS_CHECKED) && ((alarms[count] = GetNextAlarmFromQueue()) != NULL))
+    {
+        count++;
+    }
+    for(index = 0; index < count; index++)
+    {
+        if(CellularSMSIsAlarmDue(alarms[index]) == true)
         {
-            printf("unable turn ON GPS\r\n");
-            gps_initialized=0;
+            // SMS needs registration only, the data path may be what failed
+            if(isAttachTried == false)
+            {
+                isAttachTried = true;
+                (void)AttachForUpload(SMS_REGISTRATION_POLLS);
+            }
+            CellularSMSRecordAlarm(alarms[index], ((isNetworkAttached == true) ? SendAlarmSMS(alarms[index]) : 0u));
+            ClearWatchDogCounter();
         }
+    }
+    // Each goes back to the head of the lane, the last taken first
+    while(count > 0u)
+    {
+        ReturnEventMessageToPool(alarms[--count], false);
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static int32_t ResolveINetHost(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function look up the iNet host and cache its address, the time it
+//!  takes is what every connect by host name spent before
+//
+//------------------------------------------------------------------------------
+static int32_t ResolveINetHost(void)
+{
+    int32_t ret = 0;
+    uint32_t refTicks = GetRTCTicks();
+
+    ret = CellularDeviceWrite(ATC_UDNSRN);
+    CellularDNSRecordResolve((ret >= 0), RTCDRV_TicksToMsec(GetRTCTicks() - refTicks));
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//   static int32_t PerformCellularRecovery(int32_t errorCode)
+//
+//   Author:  Dilawar Ali
+//   Date:    2018/06/01
+//
+//!  This function Will perform cellular recovery sequence depending upon the error code
+//
+//------------------------------------------------------------------------------
+static int32_t PerformCellularRecovery(int32_t errorCode)
+{
+    int32_t ret = 0;
+    
+    // Keep the transcript that led to this failure
+    UARTCaptureRequestDump();
+    
+    switch(errorCode)
+    {
+    case ERR_UNKNOWN_ERROR:
+    case ERR_MODULE_NOT_RESPONDING:
+    case ERR_UART_RX_TIMEOUT:
+    case ERR_INVALID_SIGNAL_STRENGTH:
+    case ERR_UART_NOT_OPEN:
+    case ERR_SIM_CARD_NOT_FOUND:
+    case ERR_SIM_CARD_REGISTRATION_FAILED:
+    case ERR_CERTIFICATE_INVALID:
+        
+    case ERR_TCP_SOCKET_ERROR:
+    case ERR_UNABLE_TO_OPEN_TCP_SOCK:
+    case ERR_UNABLE_TO_OPEN_DIRECT_LINK:
+        // Re-init the module
+        CellularInit();
+        break;
+        
+    case ERR_TCP_SOCKET_WRITE_FAILED:
+    case ERR_JSON_CREATE_FAILED:
+        
+    case ERR_AT_CMD_PARSER_FUCN_UNDEFINED:
+    case ERR_CELLULAR_CME_ERROR:
+    case ERR_UART_RX_DATA_NULL:
+    case ERR_UART_TX_DATA_NULL:
+    case ERR_INCOMPLETE_DATA_RECEIVED:
+    case ERR_SERVER_RESPONSE_PARSING_ERROR:
+        gCellularDriver.cellularState = CELLULAR_READY;
+        break;
         
+    default:
+        
+        gCellularDriver.cellularState = CELLULAR_READY;
+        break;
     }
-    OSTimeDly(2000, OS_OPT_TIME_DLY, &err); // delay 
-    return status;  
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static int32_t GPSConfigure(void)
+//
+//   Author:  Abdul Basit
+//   Date:    2018/07/10
+//
+//!  This function power the GNSS, open the modem I2C passthrough and set the
+//!  receiver I2C port to UBX output. The modem GNSS manager (AT+UGPS) is not
+//!  started so the host owns the receiver. Saved time and position are
+//!  injected as UBX-MGA-INI so the receiver can hot start.
+//
+//------------------------------------------------------------------------------
+static int32_t GPSConfigure(void)
+{
+    int32_t status = 0;
+    uint32_t loopCounter = 0;
+    uint32_t powerOnTicks = GetRTCTicks();
+    GNSS_START_TYPE_t startType = GNSS_START_COLD;
+
+    for(loopCounter = 0; loopCounter < GPS_CONFIGURE_RETRIES; loopCounter++)
+    {
+        status = CellularDeviceWrite(ATC_GNNS_SUPPLY_EN);
+        if( status >= 0)
+        {
+            break;
+        }
+    }
+
+    if(status >= 0)
+    {
+        for(loopCounter = 0; loopCounter < GPS_CONFIGURE_RETRIES; loopCounter++)
+        {
+            status = CellularDeviceWrite(ATC_GNNS_DATA_READY);
+            if( status >= 0)
+            {
+                break;
+            }
+        }
+    }
+
+    // open i2c port  ATC_UI2CO for gps
+    if(status >= 0)
+    {
+        for(loopCounter = 0; loopCounter < GPS_CONFIGURE_RETRIES; loopCounter++)
+        {
+            status = CellularDeviceWrite(ATC_UI2CO);
+            if( status >= 0)
+            {
+                break;
+            }
+        }
+    }
+
+    // Receiver NACKs the write until it has booted, retry instead of a fixed delay
+    if(status >= 0)
+    {
+        status = GPSCreateConfigPortCommand(cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE);
+        for(loopCounter = 0; (status >= 0) && (loopCounter < GPS_CONFIGURE_RETRIES); loopCounter++)
+        {
+            status = CellularDeviceWrite(ATC_UI2CW);
+            if( status >= 0)
+            {
+                break;
+            }
+        }
+    }
+
+    // Aiding is optional, the receiver falls back to a cold start without it
+    if((status >= 0) && (GNSSAidingCreateTimeCommand(cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE) > 0))
+    {
+        if(CellularDeviceWrite(ATC_UI2CW) >= 0)
+        {
+            startType = GNSS_START_TIME_AIDED;
+        }
+    }
+    if((startType == GNSS_START_TIME_AIDED) && (GNSSAidingCreatePositionCommand(cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE) > 0))
+    {
+        if(CellularDeviceWrite(ATC_UI2CW) >= 0)
+        {
+            startType = GNSS_START_AIDED;
+        }
+    }
+
+    if(status >= 0)
+    {
+        GNSSAidingStartSession(startType, powerOnTicks);
+        isGPSinit = true;
+        gps_initialized = 1;
+    }
+    else
+    {
+        // GNSS stays off, the cause is left in the driver error code
+        gCellularDriver.errorCode = status;
+        isGPSinit = false;
+        gps_initialized = 0;
+    }
+
+    return status;
 }
 
 //------------------------------------------------------------------------------
@@ -1117,6 +1870,11 @@ static int32_t CellularInit(void)
     ClearWatchDogCounter();
     gCellularDriver.cellularState = CELLULAR_IDLE;
     gCellularDriver.cellUART = cellUART;
+    isNetworkAttached = false;
+    CellularTLSReset();
+    tokenSocket.isOpen = false;
+    tokenSocket.isConnecting = false;
+    tokenSocket.isConnected = false;
     
     ret = WarmupCellularModule();
     ClearWatchDogCounter();
@@ -1138,17 +1896,100 @@ static int32_t CellularInit(void)
 }
 
 //------------------------------------------------------------------------------
-//  static void WaitForCellularGetReady(void)
+//  static void CellularSetBandMask(BOOLEAN isRestricted)
 //
-//   Author:  Dilawar Ali
-//   Date:    2018/10/24
+//   Author:  agent
+//   Date:    2026/10/19
 //
-//!  This function wait for cellular to get register to network
+//!  This function restrict the band mask to the cached band or restore the
+//!  masks of the module, one AT+UBANDMASK per RAT to change. Radio is off.
 //
 //------------------------------------------------------------------------------
-static void WaitForCellularGetReady(void)
+static void CellularSetBandMask(BOOLEAN isRestricted)
 {
-    while(CellularDeviceWrite(ATC_CREG_Q) < 0);
+    uint8_t loopCounter = 0;
+
+    for(loopCounter = 0; (loopCounter < CELL_BANDMASK_RATS) &&
+        (CellularNetCacheCreateBandMaskCommand(cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE, isRestricted) > 0); loopCounter++)
+    {
+        if(CellularDeviceWrite(ATC_UBANDMASK) >= 0)
+        {
+            CellularNetCacheConfirmBandMask();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static int32_t AttachToNetwork(uint32_t registrationPolls)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function switch the radio on and wait for registration. The cached
+//!  band and operator are tried first, a full scan of every band with
+//!  automatic operator selection follows when they fail. registrationPolls
+//!  bounds the full scan, 0 waits for ever. Serving cell is cached after.
+//
+//------------------------------------------------------------------------------
+static int32_t AttachToNetwork(uint32_t registrationPolls)
+{
+    int32_t ret = -1;
+    uint32_t startTicks = 0, pollCount = 0;
+    BOOLEAN isCached = CellularNetCacheIsUsable();
+
+    // Band mask and RAT order are taken when the radio is switched on
+    isNetworkAttached = false;
+    (void)CellularDeviceWrite(ATC_CFUN_0);
+    CellularSetBandMask(isCached);
+    if(isCached == true)
+    {
+        startTicks = GetRTCTicks();
+        (void)CellularDeviceWrite(ATC_CFUN_1);
+        CellularTimingMark(CELL_TIMING_RADIO_ON);
+        (void)CellularNetCacheCreateSelectCommand(cellDataBuffer, CELLULAR_DATA_BUFFER_SIZE);
+        CelluarATCommands[ATC_COPS_MANUAL].timeout = RTCDRV_MsecsToTicks(CELL_NET_CACHE_ATTACH_TIMEOUT_MS);
+        ret = CellularDeviceWrite(ATC_COPS_MANUAL);
+        if(ret >= 0)
+        {
+            ret = CellularDeviceWrite(ATC_CREG_Q);
+        }
+        CellularNetCacheRecordAttach(true, (ret >= 0), RTCDRV_TicksToMsec(GetRTCTicks() - startTicks));
+        if(ret < 0)
+        {
+            (void)CellularDeviceWrite(ATC_CFUN_0);
+            CellularSetBandMask(false);
+        }
+    }
+    if(ret < 0)
+    {
+        startTicks = GetRTCTicks();
+        (void)CellularDeviceWrite(ATC_CFUN_1);
+        CellularTimingMark(CELL_TIMING_RADIO_ON);
+        if(isCached == true)
+        {
+            (void)CellularDeviceWrite(ATC_COPS_AUTO);
+        }
+        do
+        {
+            ret = CellularDeviceWrite(ATC_CREG_Q);
+        }while((ret < 0) && ((registrationPolls == 0u) || (++pollCount < registrationPolls)));
+        CellularNetCacheRecordAttach(false, (ret >= 0), RTCDRV_TicksToMsec(GetRTCTicks() - startTicks));
+    }
+    if(ret >= 0)
+    {
+        CellularTimingMark(CELL_TIMING_REGISTERED);
+        isNetworkAttached = true;
+        if(CellularDeviceWrite(ATC_COPS_Q) < 0)
+        {
+            gCellularDriver.accessTechnology = CELL_ACT_UNKNOWN;
+        }
+        if(CellularDeviceWrite(ATC_UCGED_Q) >= 0)
+        {
+            CellularNetCacheUpdate(gCellularDriver.accessTechnology);
+        }
+    }
+
+    return ret;
 }
 
 //==============================================================================
@@ -1171,16 +2012,29 @@ void CellularTask(void *arg)
     OS_MSG_SIZE   msg_size;
     CPU_TS        ts;
     CellMsg_t *msg;
+    uint32_t holdMs = 0;
     
     
 //    uint32_t bufferSize = 0,messageSize = 0;
     
     while(1)
     {
+        // Radio kept attached by a warm up is switched off when its hold window closes
+        holdMs = CellularPrewarmGetRemainingMs();
+        if((isNetworkAttached == true) && (holdMs == 0u))
+        {
+            ReleaseNetwork();
+        }
+        
         isCellularReadyToSleep = true;
-        p_msg =  OSTaskQPend(WAIT_FOREVER, OS_OPT_PEND_BLOCKING, &msg_size, &ts, &err);
+        p_msg =  OSTaskQPend(((isNetworkAttached == true) ? holdMs : WAIT_FOREVER), OS_OPT_PEND_BLOCKING, &msg_size, &ts, &err);
         msg = (CellMsg_t*)p_msg;
         isCellularReadyToSleep = false;
+        if(msg == NULL)
+        {
+            // Hold window timed out, or extended by a hint meanwhile
+            continue;
+        }
         
         switch(msg->msgId)
         {
@@ -1191,12 +2045,12 @@ void CellularTask(void *arg)
             break;
             
         case CELL_GPS_CONFIGURE:
-//            GPSConfigure();
+            GPSConfigure();
             ClearWatchDogCounter();
             break;
             
         case CELL_GPS_OFF:
-//            CellularDeviceWrite(ATC_GNSS_OFF);
+            (void)CellularServiceGNSS(false);
             ClearWatchDogCounter();
             
             
@@ -1211,17 +2065,22 @@ void CellularTask(void *arg)
 //            CellularDeviceWrite(ATC_UI2CW);
             
 //            printf("GPS Off\r\n");
-            isGPSinit = false;
             break;
             
         case CELL_GET_GPS_COORDINATES: 
-//            CellularGetGPSData();
+            // Nothing left when served in between socket steps
+            (void)CellularServiceGNSS(false);
             ClearWatchDogCounter();
             break;
             
         case CELL_CONNECTION_TEST:
             break;
             
+        case CELL_PREWARM_CONNECTION:
+            PrewarmConnection();
+            ClearWatchDogCounter();
+            break;
+            
         case CELL_SEND_EVENT_TO_INET:
             //WakeUpCellularModuleFromPowerSaving();
             if(PostDataToiNet() < 0)
@@ -1233,12 +2092,28 @@ void CellularTask(void *arg)
             {
                 gCellularDriver.cellularState = CELLULAR_READY;
             }
-            // Enable the Power Saving Mode
-            CellularDeviceWrite(ATC_CFUN_0);
+            // Enable the Power Saving Mode, the radio stays attached in a hold window
+            if((isNetworkAttached == false) || (CellularPrewarmIsHeld() == false))
+            {
+                ReleaseNetwork();
+            }
+            CellularRATRequestSave();
+            CellularNetCacheRequestSave();
             // SetCellularToPowerSavingMode();
             break;
             
         case CELL_SEND_SMS:
+            // Alarm lane is past its deadline, posted by CellularPostAlarmCheck
+            if(isAlarmCheckPending == true)
+            {
+                isAlarmCheckPending = false;
+                SendDueAlarmsSMS();
+                if((isNetworkAttached == false) || (CellularPrewarmIsHeld() == false))
+                {
+                    ReleaseNetwork();
+                }
+            }
+            ClearWatchDogCounter();
             break;
             
         default:
@@ -1247,4 +2122,130 @@ void CellularTask(void *arg)
         
         ReturnTaskMessageToPool((SysMsg_t*)msg);
     }
-}
\ No newline at end of file
+}
+
+//------------------------------------------------------------------------------
+//  void CellularPostGNSSRequest(CELL_MSG_ID_t msgId)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function request CELL_GET_GPS_COORDINATES or CELL_GPS_OFF. The
+//!  request is served by its message or in between the socket steps of an
+//!  upload already running, repeated requests are merged.
+//
+//------------------------------------------------------------------------------
+void CellularPostGNSSRequest(CELL_MSG_ID_t msgId)
+{
+    RTOS_ERR  err;
+    CellMsg_t *msg = NULL;
+    BOOLEAN isMessageQueued = false;
+
+    if(msgId == CELL_GPS_OFF)
+    {
+        // Power down ends the acquisition the pending poll belongs to
+        isGNSSPollPending = false;
+        isMessageQueued = isGNSSOffPending;
+        isGNSSOffPending = true;
+    }
+    else
+    {
+        isMessageQueued = isGNSSPollPending;
+        isGNSSPollPending = true;
+    }
+
+    if(isMessageQueued == false)
+    {
+        msg = (CellMsg_t*)GetTaskMessageFromPool();
+        if(msg != NULL)
+        {
+            msg->msgId = msgId;
+            msg->msgInfo = 1;
+            msg->ptrData = NULL;
+            OSTaskQPost(&CellTaskTCB, (void *)msg, sizeof(SysMsg_t), OS_OPT_POST_FIFO, &err);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  void CellularPostAlarmCheck(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function post CELL_SEND_SMS when an alarm waiting in its lane is
+//!  past its deadline and was not sent by SMS yet, at most once per
+//!  CELL_SMS_CHECK_INTERVAL_MS. Called periodically by the system task.
+//
+//------------------------------------------------------------------------------
+void CellularPostAlarmCheck(void)
+{
+    RTOS_ERR  err;
+    CellMsg_t *msg = NULL;
+    uint32_t createdTicks[CELL_SMS_ALARMS_CHECKED];
+    uint32_t count = 0, index = 0;
+    BOOLEAN isDue = false;
+
+    if((isAlarmCheckPending == false) &&
+       (RTCDRV_TicksToMsec(GetRTCTicks() - alarmCheckTicks) >= CELL_SMS_CHECK_INTERVAL_MS))
+    {
+        count = GetPendingAlarmsTicks(createdTicks, CELL_SMS_ALARMS_CHECKED);
+        for(index = 0; (index < count) && (isDue == false); index++)
+        {
+            isDue = CellularSMSIsDeadlinePassed(createdTicks[index]);
+        }
+    }
+
+    if(isDue == true)
+    {
+        msg = (CellMsg_t*)GetTaskMessageFromPool();
+        if(msg != NULL)
+        {
+            isAlarmCheckPending = true;
+            alarmCheckTicks = GetRTCTicks();
+            msg->msgId = CELL_SEND_SMS;
+            msg->msgInfo = 1;
+            msg->ptrData = NULL;
+            OSTaskQPost(&CellTaskTCB, (void *)msg, sizeof(SysMsg_t), OS_OPT_POST_FIFO, &err);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularGetSchedulerDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the GNSS scheduler record for the radio configuration
+//!  readout, big endian 32 bit: GNSS steps and NAV-PVT reads interleaved in
+//!  uploads, GNSS positions sent, last and max age in ms of those positions
+//!
+//! \return CELL_SCHEDULER_DIAGNOSTIC_SIZE or ERR_CELL_SCHEDULER_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularGetSchedulerDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+{
+    int32_t ret = ERR_CELL_SCHEDULER_NOT_AVAILABLE;
+    uint32_t values[CELL_SCHEDULER_DIAGNOSTIC_SIZE / 4u];
+    uint32_t index = 0;
+    
+    if(bufferSize >= CELL_SCHEDULER_DIAGNOSTIC_SIZE)
+    {
+        values[0] = schedulerStats.interleavedSteps;
+        values[1] = schedulerStats.interleavedPolls;
+        values[2] = schedulerStats.gnssPositionsSent;
+        values[3] = schedulerStats.lastPositionAgeMs;
+        values[4] = schedulerStats.maxPositionAgeMs;
+        for(index = 0; index < (CELL_SCHEDULER_DIAGNOSTIC_SIZE / 4u); index++)
+        {
+            buffer[(index * 4u)] = (uint8_t)(values[index] >> 24);
+            buffer[(index * 4u) + 1u] = (uint8_t)(values[index] >> 16);
+            buffer[(index * 4u) + 2u] = (uint8_t)(values[index] >> 8);
+            buffer[(index * 4u) + 3u] = (uint8_t)values[index];
+        }
+        ret = CELL_SCHEDULER_DIAGNOSTIC_SIZE;
+    }
+    
+    return ret;
+}
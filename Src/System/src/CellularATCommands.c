@@ -47,9 +47,19 @@
 #include "Cellular.h"
 #include "Timer.h"
 #include "Event.h"
+#include "NMEAParser.h"
+#include "Position.h"
+#include "CellularRAT.h"
+#include "CellularNetCache.h"
+#include "CellularDNS.h"
+#include "CellularUsage.h"
 //==============================================================================
 //  CONSTANTS, TYPEDEFS AND MACROS 
 //==============================================================================
+#define GNSS_UERE_METERS            5u      // Range error assumed to turn HDOP into meters
+#define CCLK_TIME_ZONE_OFFSET       17u     // "yy/MM/dd,hh:mm:ss+zz"
+#define NETWORK_TIME_LENGTH         17u
+#define NETWORK_TIME_URC_PREFIX     7u      // "+CTZE: " and "+CTZV: "
 
 //==============================================================================
 //  LOCAL DATA DECLARATIONS
@@ -62,6 +72,7 @@ static int32_t OKMsgCmpFun                (uint8_t response[],  int32_t response
 static int32_t CPINCmpFun                 (uint8_t response[],  int32_t response_buf_length);
 static int32_t IMEICmpFun                 (uint8_t response[],  int32_t response_buf_length);
 static int32_t ICCIDCmpFun                (uint8_t response[],  int32_t response_buf_length);
+static int32_t FirmwareCmpFun             (uint8_t response[],  int32_t response_buf_length);
 static int32_t SignalStrengthCmpFun       (uint8_t response[],  int32_t response_buf_length);
 static int32_t CREGQouteCmpFun            (uint8_t response[],  int32_t response_buf_length);
 static int32_t OperatorQryCmpFun          (uint8_t response[],  int32_t response_buf_length);
@@ -76,9 +87,14 @@ static int32_t SocketDataReadWriteCmpFun  (uint8_t response[],  int32_t response
 static int32_t DirectLinkDownCmpFun       (uint8_t response[],  int32_t response_buf_length);
 static int32_t GPSParserCmpFun            (uint8_t response[],  int32_t response_buf_length);
 static int32_t GPSSetParserCmpFun         (uint8_t response[],  int32_t response_buf_length);
+static int32_t CellLocateCmpFun           (uint8_t response[],  int32_t response_buf_length);
+static int32_t CellInfoCmpFun             (uint8_t response[],  int32_t response_buf_length);
+static int32_t BandMaskQryCmpFun          (uint8_t response[],  int32_t response_buf_length);
+static int32_t DNSResolveCmpFun           (uint8_t response[],  int32_t response_buf_length);
+static int32_t SMSSentCmpFun              (uint8_t response[],  int32_t response_buf_length);
+static int32_t SocketCounterCmpFun        (uint8_t response[],  int32_t response_buf_length);
 
 static void ParseGPSReceivedData(uint8_t GPSData[], uint32_t Length);
-static uint8_t TokenizeString(uint8_t *srcString, uint8_t dstToken[][25], uint8_t c_Delimiter, uint8_t messageLength);
 //==============================================================================
 //  GLOBAL DATA DECLARATIONS
 //==============================================================================
@@ -95,6 +111,8 @@ ATC_CREG_Q,
 ATC_COPS_Q,
 ATC_CGDCONT,
 ATC_CCLK_Q,
+ATC_CTZU,
+ATC_CTZR,
 ATC_CGATT,
 ATC_CGACT,
 ATC_CGPADDR,
@@ -167,13 +185,13 @@ ATCOMMAND_STRUCT CelluarATCommands[ATC_LAST_POS]=
     {//ATI
         "ATI\r\n",
         1000u,
-        OKMsgCmpFun,
+        FirmwareCmpFun,
         CELL_MAX_RESPONSE_BYTES,
         0u,
     },
     
     {//ATC_URAT
-        "AT+URAT=7,8,9\r\n",
+        cellDataBuffer,     // Order created by CellularRATCreateCommand
         1000u,
         OKMsgCmpFun,
         CELL_MAX_RESPONSE_BYTES,
@@ -215,6 +233,20 @@ ATCOMMAND_STRUCT CelluarATCommands[ATC_LAST_POS]=
         CELL_MAX_RESPONSE_BYTES,
         0u,
     },
+    {//ATC_CTZU
+        "AT+CTZU=1\r\n",
+        1000,
+        OKMsgCmpFun,
+        6u,
+        0u,
+    },
+    {//ATC_CTZR
+        "AT+CTZR=2\r\n",
+        1000,
+        OKMsgCmpFun,
+        6u,
+        0u,
+    },
     {//ATC_CGATT
         "AT+CGATT=1\r\n",
         2000,
@@ -382,7 +414,14 @@ ATCOMMAND_STRUCT CelluarATCommands[ATC_LAST_POS]=
     
     
     {//ATC_GNNS_SUPPLY_EN,
-        "AT+UGPIOC=23,3\r\n",  // Configure GPIO2 as GNSS supply enable
+        "AT+UGPIOC=23,0,1\r\n",  // GPIO2 drives GNSS supply, host controlled as AT+UGPS is not used
+        5000,
+        OKMsgCmpFun,
+        6u,
+        0u,
+    },
+    {//ATC_GNNS_SUPPLY_OFF,
+        "AT+UGPIOC=23,0,0\r\n",  // GNSS supply off, receiver starts without ephemeris next time
         5000,
         OKMsgCmpFun,
         6u,
@@ -411,10 +450,10 @@ ATCOMMAND_STRUCT CelluarATCommands[ATC_LAST_POS]=
     },
     
     {//ATC_UI2CR,
-        "AT+UI2CR=3\r\n",  // 
+        "AT+UI2CR=100\r\n",  // Read one UBX-NAV-PVT frame (UBX_NAV_PVT_FRAME_SIZE) from the GNSS stream
         5000,
         OKMsgCmpFun,
-        6u,
+        CELL_MAX_RESPONSE_BYTES,
         0u,
     },
     {//ATC_GNSS_ON
@@ -496,12 +535,129 @@ ATCOMMAND_STRUCT CelluarATCommands[ATC_LAST_POS]=
         0u,
     },
     {//ATC_ULOC
-        "AT+ULOC=2,3,0,120,10\r\n",
+        cellDataBuffer,     // Timeout is set to the remaining position budget of the event
         5000,
-        OKMsgCmpFun,
+        CellLocateCmpFun,
         200u,
         0u,
     },
+    {//ATC_UCGED_MODE
+        "AT+UCGED=2\r\n",
+        1000u,
+        OKMsgCmpFun,
+        6u,
+        0u,
+    },
+    {//ATC_UCGED_Q
+        "AT+UCGED?\r\n",
+        2000u,
+        CellInfoCmpFun,
+        CELL_MAX_RESPONSE_BYTES,
+        0u,
+    },
+    {//ATC_UBANDMASK_Q
+        "AT+UBANDMASK?\r\n",
+        1000u,
+        BandMaskQryCmpFun,
+        CELL_MAX_RESPONSE_BYTES,
+        0u,
+    },
+    {//ATC_UBANDMASK
+        cellDataBuffer,     // Created by CellularNetCacheCreateBandMaskCommand
+        1000u,
+        OKMsgCmpFun,
+        6u,
+        0u,
+    },
+    {//ATC_COPS_MANUAL
+        cellDataBuffer,     // Cached operator, timeout is set to CELL_NET_CACHE_ATTACH_TIMEOUT_MS
+        30000u,
+        OKMsgCmpFun,
+        6u,
+        0u,
+    },
+    {//ATC_COPS_AUTO
+        "AT+COPS=0\r\n",
+        5000u,
+        OKMsgCmpFun,
+        6u,
+        0u,
+    },
+    {//ATC_USECPRF_RESUME
+        "AT+USECPRF=0,13,1\r\n",      // TLS session resumption, op code unknown to older firmware
+        15000,
+        OKMsgCmpFun,
+        6u,
+        0u,
+    },
+    {//ATC_UDNSRN
+        "AT+UDNSRN=0,\"" INET_HOST "\"\r\n",
+        20000u,
+        DNSResolveCmpFun,
+        CELL_MAX_RESPONSE_BYTES,
+        0u,
+    },
+    {//ATC_USECPRF_ECDSA_AES128
+        "AT+USECPRF=0,2,99,\"C0\",\"2B\"\r\n",   // IANA suite id, older firmware takes 0..n only
+        15000,
+        OKMsgCmpFun,
+        6u,
+        0u,
+    },
+    {//ATC_USECPRF_RSA_AES128
+        "AT+USECPRF=0,2,99,\"C0\",\"2F\"\r\n",
+        15000,
+        OKMsgCmpFun,
+        6u,
+        0u,
+    },
+    {//ATC_USOCO_ASYNC
+        //"AT+USOCO=<*socket>,<address>,443,1",
+        cellDataBuffer,
+        5000,
+        OKMsgCmpFun,
+        CELL_MAX_RESPONSE_BYTES,
+        0u,
+    },
+    {//ATC_CMGF
+        "AT+CMGF=0\r\n",
+        1000,
+        OKMsgCmpFun,
+        6u,
+        0u,
+    },
+    {//ATC_CMGS
+        //"AT+CMGS=<length>\r", created by CellularSMSCreatePDU
+        cellHeaderBuffer,
+        5000,
+        InputCmpFun,
+        CELL_MAX_RESPONSE_BYTES,
+        0u,
+    },
+    {//ATC_CMGS_PDU
+        //"<PDU hex><Ctrl-Z>", sent over the air before the reply
+        cellDataBuffer,
+        60000,
+        SMSSentCmpFun,
+        CELL_MAX_RESPONSE_BYTES,
+        0u,
+    },
+    {//ATC_USOCTL_SENT
+        //"AT+USOCTL=<socket>,2",
+        cellDataBuffer,
+        1000,
+        SocketCounterCmpFun,
+        CELL_MAX_RESPONSE_BYTES,
+        0u,
+    },
+    {//ATC_USOCTL_RECEIVED
+        //"AT+USOCTL=<socket>,3",
+        cellDataBuffer,
+        1000,
+        SocketCounterCmpFun,
+        CELL_MAX_RESPONSE_BYTES,
+        0u,
+    },
 
     
 
@@ -597,7 +753,8 @@ static int32_t ICCIDCmpFun(uint8_t response[],  int32_t response_buf_length)
     int32_t ret = 0;
     uint8_t *iccid = NULL;
     uint8_t counter = 0;
-    if(strncmp((char const*)response, "ICCID: ", 7u) == 0)
+    // Whole line is needed, a partial ICCID would look like a SIM swap
+    if((strncmp((char const*)response, "ICCID: ", 7u) == 0) && (strstr((char const*)response, "OK") != NULL))
     {
         iccid = (uint8_t *)strstr((char const*)response, ": ");
         if(iccid != NULL)
@@ -612,6 +769,7 @@ static int32_t ICCIDCmpFun(uint8_t response[],  int32_t response_buf_length)
                     break;
                 }
             }
+            gCellularDriver.iccid[counter] = 0;
             ret = 0;
         }
     }
@@ -621,6 +779,43 @@ static int32_t ICCIDCmpFun(uint8_t response[],  int32_t response_buf_length)
     }
     return ret;
 }
+
+//------------------------------------------------------------------------------
+//  static int32_t FirmwareCmpFun(uint8_t response[],  int32_t response_buf_length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse the module firmware revision from response of ATI,
+//!  the last line before OK after manufacturer and model
+//
+//------------------------------------------------------------------------------
+static int32_t FirmwareCmpFun(uint8_t response[],  int32_t response_buf_length)
+{
+    int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
+    char const *end = strstr((char const*)response, "\r\nOK");
+    char const *start = NULL;
+    uint32_t length = 0;
+
+    (void)response_buf_length;
+    if(end != NULL)
+    {
+        while((end > (char const*)response) && ((end[-1] == '\r') || (end[-1] == '\n')))
+        {
+            end--;
+        }
+        start = end;
+        while((start > (char const*)response) && (start[-1] != '\n'))
+        {
+            start--;
+        }
+        length = FIND_MIN((uint32_t)(end - start), CELLULAR_FIRMWARE_LENGTH);
+        memcpy(gCellularDriver.firmware, start, length);
+        gCellularDriver.firmware[length] = 0;
+        ret = 0;
+    }
+    return ret;
+}
 //------------------------------------------------------------------------------
 //  static int32_t SignalStrengthCmpFun(uint8_t response[],  int32_t response_buf_length)
 //
@@ -714,8 +909,10 @@ static int32_t OperatorQryCmpFun(uint8_t response[],  int32_t response_buf_lengt
     int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
     uint8_t *cellOperator = NULL;
     uint32_t counter = 0;
+    uint32_t accessTechnology = CELL_ACT_UNKNOWN;
     if(strncmp((char const*)response, "+COPS: ", 6u) == 0)
     {
+        gCellularDriver.accessTechnology = CELL_ACT_UNKNOWN;
         cellOperator = (uint8_t *)strstr((char const*)response, "\"");
         if(cellOperator != NULL)
         {
@@ -728,6 +925,12 @@ static int32_t OperatorQryCmpFun(uint8_t response[],  int32_t response_buf_lengt
                     break;
                 }
             }
+            // Access technology follows the operator name
+            cellOperator = (uint8_t *)strchr((char const*)cellOperator, ',');
+            if((cellOperator != NULL) && (sscanf((char const*)cellOperator, ",%u", &accessTechnology) == 1))
+            {
+                gCellularDriver.accessTechnology = (uint8_t)accessTechnology;
+            }
             ret = 0;
         }
     }
@@ -767,12 +970,11 @@ static int32_t TimeQryCmpFun(uint8_t response[],  int32_t response_buf_length)
                 }
                 time++;
             }
-//            if(gCellularDriver.isRTCTimeUpdated == false)
-//            {
-                UpdateRTCTime(tBuff);
+            // Modem clock is only network time once NITZ was received, before that it counts from its default date
+            if(UpdateRTCTime(tBuff, (int32_t)strtol((char const*)&tBuff[CCLK_TIME_ZONE_OFFSET], NULL, 10)) == true)
+            {
                 gCellularDriver.isRTCTimeUpdated = true;
-//            }
-            gCellularDriver.isRTCTimeUpdated = true;
+            }
             ret = 0;
         }
     }
@@ -1005,9 +1207,11 @@ static int32_t SocketDataReadWriteCmpFun(uint8_t response[],  int32_t response_b
             }
         }
     }
-    else if(cellHttpsReceiving.status == 401u)
+    else if((cellHttpsReceiving.status == 401u) && (httpResponse != NULL))
     {
+        // Expired token, no need to wait for the rest
         cellHttpsReceiving.isTokenValid = false;
+        ret = 0;
     }
     else
     {
@@ -1048,12 +1252,11 @@ static int32_t DirectLinkDownCmpFun  (uint8_t response[],  int32_t response_buf_
 static int32_t GPSParserCmpFun  (uint8_t response[],  int32_t response_buf_length)
 {
     int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
-    printf("%s\r\n", response);
     if(response_buf_length > 22)
     {
-        if(strncmp((char const*)response, "+UGGGA: ", 6u) == 0)
+        if(strncmp((char const*)response, "+UGGGA: ", 8u) == 0)
         {
-            ParseGPSReceivedData(&response[10], (response_buf_length - 10 - 11));
+            ParseGPSReceivedData(response, (uint32_t)response_buf_length);
             ret = 0;
         }
     }
@@ -1072,94 +1275,194 @@ static int32_t GPSParserCmpFun  (uint8_t response[],  int32_t response_buf_lengt
 static int32_t GPSSetParserCmpFun  (uint8_t response[],  int32_t response_buf_length)
 {
     int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
-    printf("%s\r\n", response);
     if(response_buf_length > 22)
     {
-        if(strncmp((char const*)response, "+UGGSV: ", 6u) == 0)
+        if(strncmp((char const*)response, "+UGGSV: ", 8u) == 0)
         {
-//            ParseGPSReceivedData(&response[10], (response_buf_length - 10 - 11));
+            ParseGPSReceivedData(response, (uint32_t)response_buf_length);
             ret = 0;
         }
     }
     return ret;
 }
 //------------------------------------------------------------------------------
-//  void ParseGPSReceivedData(uint8_t GPSData[], uint32_t Length)
+//  static int32_t CellLocateCmpFun(uint8_t response[],  int32_t response_buf_length)
 //
-//   Author:  Dilawar Ali
-//   Date:    2018/08/18
+//   Author:  agent
+//   Date:    2026/10/19
 //
-//!  This function NMEA sentence received from GNSS module
+//!  This function wait for the +UULOC URC that follows OK of AT+ULOC
 //
 //------------------------------------------------------------------------------
-static void ParseGPSReceivedData(uint8_t GPSData[], uint32_t Length)
+static int32_t CellLocateCmpFun(uint8_t response[],  int32_t response_buf_length)
 {
-    uint8_t sToken[16][25];
-    memset(sToken, 0, (16*25));
-    
-    uint8_t numberOfTokens = TokenizeString(GPSData, sToken, ',', Length);
-    if(numberOfTokens == 16)
+    int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
+
+    if(response_buf_length > 0)
     {
-        GPSReceivedCoordinates.latitude             = (float32_t) atof((char*)sToken[1u]);
-        GPSReceivedCoordinates.latitudeDir          = (int8_t)    *sToken[2u];
-        GPSReceivedCoordinates.longitude            = (float32_t) atof((char*)sToken[3u]);
-        GPSReceivedCoordinates.longitudeDir         = (int8_t)    *sToken[4u];
-        GPSReceivedCoordinates.accuracy             = (int32_t)   atoi((char*)sToken[5u]);
-        GPSReceivedCoordinates.horizantalDilution   = (float32_t) atof((char*)sToken[7u]);
-        if(GPSReceivedCoordinates.accuracy > 0)
+        ret = PositionParseCellLocate(response, (uint32_t)response_buf_length);
+        if(ret == ERR_POSITION_PARSE_FAILED)
         {
-            GPSReceivedCoordinates.isGpsValid = true;
+            // Modem answered, no estimate available
+            ret = 0;
         }
-        else
+    }
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static int32_t CellInfoCmpFun(uint8_t response[],  int32_t response_buf_length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse the serving cell operator and band from AT+UCGED?
+//
+//------------------------------------------------------------------------------
+static int32_t CellInfoCmpFun(uint8_t response[],  int32_t response_buf_length)
+{
+    int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
+
+    if(response_buf_length > 0)
+    {
+        // Answered without a usable cell is complete as well, the cache is kept
+        if(CellularNetCacheParseCellInfo(response, (uint32_t)response_buf_length) != ERR_INCOMPLETE_DATA_RECEIVED)
         {
-            GPSReceivedCoordinates.isGpsValid = false;
+            ret = 0;
         }
     }
-    
+    return ret;
 }
 
-//==============================================================================
+//------------------------------------------------------------------------------
+//  static int32_t BandMaskQryCmpFun(uint8_t response[],  int32_t response_buf_length)
 //
-//   TokenizeString(char *s_String, char s_Token[][25], char c_Delimiter, 
-//                                                  unsigned char messageLength)
+//   Author:  agent
+//   Date:    2026/10/19
 //
-//   Author:   Tayyab Tahir(in Cornell)
-//   Date:     2018/05/21   
+//!  This function parse the band masks configured in the module
 //
-//!  This function Tokenizes GPS string wrt to parsed delimeter 
+//------------------------------------------------------------------------------
+static int32_t BandMaskQryCmpFun(uint8_t response[],  int32_t response_buf_length)
+{
+    int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
+
+    if(response_buf_length > 0)
+    {
+        ret = CellularNetCacheParseBandMask(response, (uint32_t)response_buf_length);
+        if(ret == ERR_CELL_NET_CACHE_PARSE_FAILED)
+        {
+            ret = 0;
+        }
+    }
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static int32_t DNSResolveCmpFun(uint8_t response[],  int32_t response_buf_length)
 //
-//==============================================================================
-static uint8_t TokenizeString(uint8_t *srcString, uint8_t dstToken[][25], uint8_t c_Delimiter, uint8_t messageLength)
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse the iNet host address looked up by the module
+//
+//------------------------------------------------------------------------------
+static int32_t DNSResolveCmpFun(uint8_t response[],  int32_t response_buf_length)
 {
-  int j = 0;
-  unsigned int i_Offset = 0;
-  char b_Flag = 0;
-  int count = 0;
-  for (i_Offset = 0;i_Offset <= messageLength; i_Offset++)
-  {
-    // loop length controlers
-    if(((count+1) >= (16)) || ((j+1) >= (25)))
+    int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
+
+    if(response_buf_length > 0)
     {
-      //Buffer Overflow control
-      break;
+        ret = CellularDNSParseResolve(response, (uint32_t)response_buf_length);
+        if(ret == ERR_CELL_DNS_PARSE_FAILED)
+        {
+            // Reply is complete, the lookup is recorded as failed
+            ret = 0;
+        }
     }
-    
-    if (srcString[i_Offset] != c_Delimiter && srcString[i_Offset] != '\t' && srcString[i_Offset] != '\n' && srcString[i_Offset] != '\0')
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static int32_t SMSSentCmpFun(uint8_t response[],  int32_t response_buf_length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse +CMGS: <mr> and OK once the SMS is submitted
+//
+//------------------------------------------------------------------------------
+static int32_t SMSSentCmpFun(uint8_t response[],  int32_t response_buf_length)
+{
+    int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
+    char const *reference = strstr((char const*)response, "+CMGS: ");
+
+    if((reference != NULL) && (strstr(reference, "OK") != NULL))
+    {
+        ret = 0;
+    }
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static int32_t SocketCounterCmpFun(uint8_t response[],  int32_t response_buf_length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse the byte total of the socket for the usage accounting
+//
+//------------------------------------------------------------------------------
+static int32_t SocketCounterCmpFun(uint8_t response[],  int32_t response_buf_length)
+{
+    int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
+
+    if(response_buf_length > 0)
+    {
+        ret = CellularUsageParseSocketCounter(response, (uint32_t)response_buf_length);
+        if(ret == ERR_CELL_USAGE_PARSE_FAILED)
+        {
+            // Reply is complete, the handshake is estimated
+            ret = 0;
+        }
+    }
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  void ParseGPSReceivedData(uint8_t GPSData[], uint32_t Length)
+//
+//   Author:  Dilawar Ali
+//   Date:    2018/08/18
+//
+//!  This function stream the GNSS response through the NMEA parser and update
+//!  the coordinates when a GGA sentence passes its checksum
+//
+//------------------------------------------------------------------------------
+static void ParseGPSReceivedData(uint8_t GPSData[], uint32_t Length)
+{
+    static NMEAParser_t gnssParser;
+    static bool isParserInitialized = false;
+    uint32_t completed = 0;
+
+    if(isParserInitialized == false)
     {
-      dstToken[count][j] = srcString[i_Offset];
-      j++;
-      b_Flag = 1;
-      continue;
+        NMEAParserInit(&gnssParser);
+        isParserInitialized = true;
     }
-    if (b_Flag)
+
+    completed = NMEAParserFeedBuffer(&gnssParser, GPSData, Length);
+    if((completed & (1u << NMEA_SENTENCE_GGA)) != 0u)
     {
-      dstToken[count][j] = '\0';
-      count++;
-      j = 0;
-      b_Flag = 0;
+        GPSReceivedCoordinates.latitude           = gnssParser.fix.latitude;
+        GPSReceivedCoordinates.longitude          = gnssParser.fix.longitude;
+        GPSReceivedCoordinates.horizantalDilution = gnssParser.fix.hdop;
+        GPSReceivedCoordinates.accuracy           = gnssParser.fix.fixQuality;
+        GPSReceivedCoordinates.uncertainty        = ((gnssParser.fix.hdop * GNSS_UERE_METERS) + 99u) / 100u;
+        GPSReceivedCoordinates.fixTicks           = GetRTCTicks();
+        GPSReceivedCoordinates.source             = POSITION_SOURCE_GNSS;
+        GPSReceivedCoordinates.isGpsValid         = (gnssParser.fix.fixQuality > 0u);
     }
-  }
-  return (count + 1);
 }
 
 //==============================================================================
@@ -1188,7 +1491,12 @@ uint32_t CreateUARTTXdata(ATCOMMAND_INDEX_ENUM cmdIndex, uint8_t Buffer[], uint3
         break;
         
     case ATC_USOCO:
-        size = snprintf((char *)Buffer, buffSize, "AT+USOCO=%d,\"%s\",%d\r\n\0", gCellularDriver.TCPSocket, INET_HOST, INET_SSL_PORT);
+        // Cached address of the host saves the lookup in the module
+        size = snprintf((char *)Buffer, buffSize, "AT+USOCO=%d,\"%s\",%d\r\n\0", gCellularDriver.TCPSocket, CellularDNSGetAddress(), INET_SSL_PORT);
+        break;
+        
+    case ATC_USOCO_ASYNC:
+        size = snprintf((char *)Buffer, buffSize, "AT+USOCO=%d,\"%s\",%d,1\r\n\0", gCellularDriver.TCPSocket, CellularDNSGetAddress(), INET_SSL_PORT);
         break;
         
     case AT_USODL:
@@ -1196,11 +1504,17 @@ uint32_t CreateUARTTXdata(ATCOMMAND_INDEX_ENUM cmdIndex, uint8_t Buffer[], uint3
         break;
         
     case ATC_USOCL:
-        size = snprintf((char *)Buffer, buffSize, "\0");//"AT+USOCL=%d\r\n\0", gCellularDriver.TCPSocket);
+        size = snprintf((char *)Buffer, buffSize, "AT+USOCL=%d\r\n\0", gCellularDriver.TCPSocket);
         break;
     case ATC_USORD:
         size = snprintf((char *)Buffer, buffSize, "AT+USORD=%d,256\r\n\0", gCellularDriver.TCPSocket);
         break;
+    case ATC_USOCTL_SENT:
+        size = snprintf((char *)Buffer, buffSize, "AT+USOCTL=%d,2\r\n\0", gCellularDriver.TCPSocket);
+        break;
+    case ATC_USOCTL_RECEIVED:
+        size = snprintf((char *)Buffer, buffSize, "AT+USOCTL=%d,3\r\n\0", gCellularDriver.TCPSocket);
+        break;
     default:
         // Invalid Request
         size = ERR_INVALID_AT_COMMAND;
@@ -1208,3 +1522,94 @@ uint32_t CreateUARTTXdata(ATCOMMAND_INDEX_ENUM cmdIndex, uint8_t Buffer[], uint3
     }
     return size;
 }
+
+//------------------------------------------------------------------------------
+//  int32_t CellularParseNetworkTimeURC(uint8_t const response[])
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function update RTC from the NITZ network time URC enabled by
+//!  AT+CTZU=1 and AT+CTZR, +CTZE: <tz>,<dst>,"<time>" or +CTZV: <tz>,"<time>".
+//!  <time> is local time and <tz> its offset in quarters of an hour, DST
+//!  included.
+//!
+//! \return 0 when a complete URC was found, ERR_INCOMPLETE_DATA_RECEIVED otherwise
+//
+//------------------------------------------------------------------------------
+int32_t CellularParseNetworkTimeURC(uint8_t const response[])
+{
+    int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
+    char const *urc = strstr((char const*)response, "+CTZE: ");
+    char const *lineEnd = NULL, *time = NULL;
+    char *numberEnd = NULL;
+    int32_t timeZoneQuarters = 0;
+    
+    if(urc == NULL)
+    {
+        urc = strstr((char const*)response, "+CTZV: ");
+    }
+    if(urc != NULL)
+    {
+        urc = &urc[NETWORK_TIME_URC_PREFIX];
+        lineEnd = strpbrk(urc, "\r\n");
+    }
+    
+    if(lineEnd != NULL)
+    {
+        ret = 0;
+        // Zone is quoted e.g. "-20"
+        if(*urc == '"')
+        {
+            urc++;
+        }
+        timeZoneQuarters = (int32_t)strtol(urc, &numberEnd, 10);
+        
+        // Time is the field holding the date separator, absent when network sent the zone only
+        time = numberEnd;
+        while((time < lineEnd) && (*time != '/'))
+        {
+            time++;
+        }
+        time = &time[-2];
+        if((numberEnd != urc) && (time > numberEnd) && ((lineEnd - time) >= (int32_t)NETWORK_TIME_LENGTH) &&
+           (UpdateRTCTime((uint8_t const*)time, timeZoneQuarters) == true))
+        {
+            gCellularDriver.isRTCTimeUpdated = true;
+        }
+    }
+    
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularParseSocketConnectURC(uint8_t const response[], uint32_t socket)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function look for +UUSOCO: <socket>,<socket_error>, the result of
+//!  an asynchronous connect of the socket
+//!
+//! \return 0 when connected, ERR_UNABLE_TO_OPEN_TCP_SOCK when the connect
+//!  failed, ERR_INCOMPLETE_DATA_RECEIVED while the URC is not there
+//
+//------------------------------------------------------------------------------
+int32_t CellularParseSocketConnectURC(uint8_t const response[], uint32_t socket)
+{
+    int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
+    char const *urc = strstr((char const*)response, "+UUSOCO: ");
+    uint32_t urcSocket = 0, socketError = 0;
+    
+    // Other sockets may report too
+    while((urc != NULL) && (ret == ERR_INCOMPLETE_DATA_RECEIVED))
+    {
+        if((sscanf(urc, "+UUSOCO: %u,%u", &urcSocket, &socketError) == 2) && (urcSocket == socket))
+        {
+            ret = (socketError == 0u) ? 0 : ERR_UNABLE_TO_OPEN_TCP_SOCK;
+        }
+        urc = strstr(&urc[1], "+UUSOCO: ");
+    }
+    
+    return ret;
+}
@@ -0,0 +1,443 @@
+//==============================================================================
+//
+//  CellularDNS.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularDNS.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the iNet host address cache. AT+USOCO given the host
+//! name makes the module resolve it on every connect. The address is looked
+//! up with AT+UDNSRN instead, kept in DataFlash and used until it is older
+//! than CELL_DNS_TTL_S or a connect to it fails.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "CellularDNS.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "DataFlash.h"
+#include "Event.h"
+#include "ExtCommunication.h"
+#include "SysTask.h"
+#include "Timer.h"
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define CELL_DNS_EWMA_SHIFT             2u
+#define CELL_DNS_IPV4_OCTETS            4u
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static CellularDNSRecord_t dnsRecord;
+static CellularDNSRecord_t saveRecord;          // Snapshot written by SysTask
+static volatile BOOLEAN isSavePending = false;
+static CellularDNSStats_t dnsStats;
+
+// Address parsed from the last +UDNSRN
+static char resolvedAddress[IP_ADDR_LEN + 1u];
+static BOOLEAN isResolvedAddressValid = false;
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void CellularDNSResetRecord(void);
+static BOOLEAN ParseIPv4(char const text[], uint8_t octets[]);
+static void PutBigEndian16(uint8_t data[], uint32_t value);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static void CellularDNSResetRecord(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function clear the cache, sockets connect by host name
+//
+//------------------------------------------------------------------------------
+static void CellularDNSResetRecord(void)
+{
+    memset(&dnsRecord, 0, sizeof(dnsRecord));
+    dnsRecord.magic = CELL_DNS_MAGIC;
+    dnsRecord.version = CELL_DNS_VERSION;
+    dnsRecord.size = sizeof(CellularDNSRecord_t);
+    snprintf(dnsRecord.host, sizeof(dnsRecord.host), "%s", INET_HOST);
+}
+
+//------------------------------------------------------------------------------
+//  static BOOLEAN ParseIPv4(char const text[], uint8_t octets[])
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when text is a whole dotted IPv4 address
+//
+//------------------------------------------------------------------------------
+static BOOLEAN ParseIPv4(char const text[], uint8_t octets[])
+{
+    BOOLEAN ret = false;
+    unsigned int value[CELL_DNS_IPV4_OCTETS] = {0};
+    char extra = 0;
+    uint32_t i = 0;
+
+    if(sscanf(text, "%3u.%3u.%3u.%3u%c", &value[0], &value[1], &value[2], &value[3], &extra) == 4)
+    {
+        ret = true;
+        for(i = 0; i < CELL_DNS_IPV4_OCTETS; i++)
+        {
+            if(value[i] > UINT8_MAX)
+            {
+                ret = false;
+            }
+            octets[i] = (uint8_t)value[i];
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static void PutBigEndian16(uint8_t data[], uint32_t value)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write a 16 bit field of the SPI readout, saturating
+//
+//------------------------------------------------------------------------------
+static void PutBigEndian16(uint8_t data[], uint32_t value)
+{
+    value = FIND_MIN(value, UINT16_MAX);
+    data[0] = (uint8_t)((value >> 8) & 0xFFu);
+    data[1] = (uint8_t)(value & 0xFFu);
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  int32_t CellularDNSLoadFromFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read the cached address, called from SysTask at start up
+//
+//------------------------------------------------------------------------------
+int32_t CellularDNSLoadFromFlash(void)
+{
+    int32_t ret = 0;
+    uint8_t pageBuffer[DATAFLASH_BYTES_PER_PAGE] = {0};
+    uint8_t octets[CELL_DNS_IPV4_OCTETS] = {0};
+
+    DataFlashDisablePowerSaving();
+    ret = DataFlashReadPage(CELL_DNS_PAGE_NUMBER, pageBuffer, DATAFLASH_BYTES_PER_PAGE);
+    DataFlashEnablePowerSaving();
+
+    if(ret >= 0)
+    {
+        memcpy(&dnsRecord, pageBuffer, sizeof(dnsRecord));
+        // An address of another host is of no use, e.g. after a firmware update
+        if((dnsRecord.magic != CELL_DNS_MAGIC) || (dnsRecord.version != CELL_DNS_VERSION) ||
+           (dnsRecord.size != sizeof(CellularDNSRecord_t)) ||
+           (memchr(dnsRecord.host, 0, sizeof(dnsRecord.host)) == NULL) || (strcmp(dnsRecord.host, INET_HOST) != 0) ||
+           (memchr(dnsRecord.address, 0, sizeof(dnsRecord.address)) == NULL) ||
+           ((dnsRecord.address[0] != 0) && (ParseIPv4(dnsRecord.address, octets) == false)))
+        {
+            ret = ERR_CELL_DNS_RECORD_INVALID;
+        }
+    }
+
+    if(ret < 0)
+    {
+        CellularDNSResetRecord();
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularDNSSaveToFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the record snapshot taken after a lookup. Called from
+//!  SysTask which owns the DataFlash.
+//
+//------------------------------------------------------------------------------
+int32_t CellularDNSSaveToFlash(void)
+{
+    int32_t ret = 0;
+
+    DataFlashDisablePowerSaving();
+    ret = DataFlashErasePage(CELL_DNS_PAGE_NUMBER);
+    if(ret >= 0)
+    {
+        ret = DataFlashWriteBuffer(0, (uint8_t *)&saveRecord, sizeof(saveRecord));
+    }
+    if(ret >= 0)
+    {
+        ret = DataFlashWriteBufferToPage(CELL_DNS_PAGE_NUMBER);
+    }
+    DataFlashEnablePowerSaving();
+    isSavePending = false;
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularDNSIsCached(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when sockets connect to a cached address
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularDNSIsCached(void)
+{
+    return (dnsRecord.address[0] != 0);
+}
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularDNSIsExpired(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when the host should be looked up again, no
+//!  address, older than CELL_DNS_TTL_S or of unknown age
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularDNSIsExpired(void)
+{
+    BOOLEAN ret = true;
+    uint32_t now = 0;
+
+    if((dnsRecord.address[0] != 0) && (dnsRecord.resolvedTime != 0u) && (IsRTCTimeSynced() == true))
+    {
+        now = GetRTCTime();
+        ret = ((now < dnsRecord.resolvedTime) || ((now - dnsRecord.resolvedTime) >= CELL_DNS_TTL_S));
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  char const* CellularDNSGetAddress(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the cached address, or the host name when none
+//
+//------------------------------------------------------------------------------
+char const* CellularDNSGetAddress(void)
+{
+    return (dnsRecord.address[0] != 0) ? dnsRecord.address : INET_HOST;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularDNSParseResolve(uint8_t const response[], uint32_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse the address from +UDNSRN: "<IP address>"
+//!
+//! \return 0, ERR_INCOMPLETE_DATA_RECEIVED until OK or
+//!         ERR_CELL_DNS_PARSE_FAILED when it is no IPv4 address
+//
+//------------------------------------------------------------------------------
+int32_t CellularDNSParseResolve(uint8_t const response[], uint32_t length)
+{
+    int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
+    char const *text = strstr((char const *)response, "+UDNSRN:");
+    char address[IP_ADDR_LEN + 1u] = {0};
+    uint8_t octets[CELL_DNS_IPV4_OCTETS] = {0};
+
+    (void)length;
+    if((text != NULL) && (strstr(text, "OK") != NULL))
+    {
+        ret = ERR_CELL_DNS_PARSE_FAILED;
+        isResolvedAddressValid = false;
+        // IPv6 results are not used, connects by host name stay as they are
+        if((sscanf(text, "+UDNSRN: \"%16[0-9.]\"", address) == 1) && (ParseIPv4(address, octets) == true))
+        {
+            snprintf(resolvedAddress, sizeof(resolvedAddress), "%s", address);
+            isResolvedAddressValid = true;
+            ret = 0;
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularDNSRecordResolve(BOOLEAN isResolved, uint32_t resolveMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function cache the address parsed last and ask SysTask to persist it
+//
+//------------------------------------------------------------------------------
+void CellularDNSRecordResolve(BOOLEAN isResolved, uint32_t resolveMs)
+{
+    RTOS_ERR  err;
+    SysMsg_t *msg = NULL;
+
+    dnsStats.lastResolveMs = resolveMs;
+    if((isResolved == true) && (isResolvedAddressValid == true))
+    {
+        dnsStats.resolves++;
+        snprintf(dnsRecord.address, sizeof(dnsRecord.address), "%s", resolvedAddress);
+        dnsRecord.resolvedTime = (IsRTCTimeSynced() == true) ? GetRTCTime() : 0u;
+        if(dnsRecord.averageResolveMs == 0u)
+        {
+            dnsRecord.averageResolveMs = resolveMs;
+        }
+        else if(resolveMs >= dnsRecord.averageResolveMs)
+        {
+            dnsRecord.averageResolveMs += ((resolveMs - dnsRecord.averageResolveMs) >> CELL_DNS_EWMA_SHIFT);
+        }
+        else
+        {
+            dnsRecord.averageResolveMs -= ((dnsRecord.averageResolveMs - resolveMs) >> CELL_DNS_EWMA_SHIFT);
+        }
+
+        // Lookups are CELL_DNS_TTL_S apart, each one is persisted
+        if(isSavePending == false)
+        {
+            msg = (SysMsg_t*)GetTaskMessageFromPool();
+            if(msg != NULL)
+            {
+                saveRecord = dnsRecord;
+                isSavePending = true;
+                msg->msgId = SAVE_DNS_CACHE_TO_FLASH;
+                msg->msgInfo = 1;
+                msg->ptrData = NULL;
+                OSTaskQPost(&SYSTaskTCB, (void *)msg, sizeof(SysMsg_t), OS_OPT_POST_FIFO, &err);
+            }
+        }
+    }
+    else
+    {
+        dnsStats.resolveFailures++;
+    }
+    isResolvedAddressValid = false;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularDNSRecordConnect(BOOLEAN isConnected)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record a connect to the cached address. A failed one drops
+//!  the address, the host may have moved.
+//
+//------------------------------------------------------------------------------
+void CellularDNSRecordConnect(BOOLEAN isConnected)
+{
+    if(isConnected == true)
+    {
+        dnsStats.cachedConnects++;
+        dnsStats.savedMs += dnsRecord.averageResolveMs;
+    }
+    else
+    {
+        dnsStats.cachedConnectFailures++;
+        memset(dnsRecord.address, 0, sizeof(dnsRecord.address));
+    }
+}
+
+//------------------------------------------------------------------------------
+//  CellularDNSStats_t const* CellularDNSGetStats(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns lookup and cached connect counts
+//
+//------------------------------------------------------------------------------
+CellularDNSStats_t const* CellularDNSGetStats(void)
+{
+    return &dnsStats;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularDNSGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the cached address and lookup statistics for the
+//!  radio configuration readout, big endian
+//!
+//! \return bytes written or ERR_CELL_DNS_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularDNSGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+{
+    int32_t ret = ERR_CELL_DNS_NOT_AVAILABLE;
+
+    if(bufferSize >= CELL_DNS_DIAGNOSTIC_SIZE)
+    {
+        memset(buffer, 0, CELL_DNS_IPV4_OCTETS);
+        (void)ParseIPv4(dnsRecord.address, buffer);
+        PutBigEndian16(&buffer[4], dnsStats.resolves);
+        PutBigEndian16(&buffer[6], dnsStats.resolveFailures);
+        PutBigEndian16(&buffer[8], dnsRecord.averageResolveMs);
+        PutBigEndian16(&buffer[10], dnsStats.lastResolveMs);
+        PutBigEndian16(&buffer[12], dnsStats.cachedConnects);
+        PutBigEndian16(&buffer[14], dnsStats.cachedConnectFailures);
+        buffer[16] = (uint8_t)((dnsStats.savedMs >> 24) & 0xFFu);
+        buffer[17] = (uint8_t)((dnsStats.savedMs >> 16) & 0xFFu);
+        buffer[18] = (uint8_t)((dnsStats.savedMs >> 8) & 0xFFu);
+        buffer[19] = (uint8_t)(dnsStats.savedMs & 0xFFu);
+        ret = CELL_DNS_DIAGNOSTIC_SIZE;
+    }
+
+    return ret;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
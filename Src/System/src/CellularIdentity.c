@@ -0,0 +1,237 @@
+//==============================================================================
+//
+//  CellularIdentity.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularIdentity.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the module identity cache. IMEI and firmware revision
+//! do not change and the ICCID only with the SIM card, so AT+CGSN, ATI and
+//! the APN write are skipped while the ICCID read on init matches the cache.
+//! The identity is still queried every CELL_IDENTITY_VERIFY_INITS inits.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "CellularIdentity.h"
+
+#include <string.h>
+
+#include "DataFlash.h"
+#include "Event.h"
+#include "SysTask.h"
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static CellularIdentityRecord_t identityRecord;
+static CellularIdentityRecord_t saveRecord;     // Snapshot written by SysTask
+static BOOLEAN isRecordValid = false;
+static BOOLEAN isRecordChanged = false;
+static volatile BOOLEAN isSavePending = false;
+static uint32_t initsSinceVerify = 0;
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  int32_t CellularIdentityLoadFromFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read the cached identity, called from SysTask at start up
+//
+//------------------------------------------------------------------------------
+int32_t CellularIdentityLoadFromFlash(void)
+{
+    int32_t ret = 0;
+    uint8_t pageBuffer[DATAFLASH_BYTES_PER_PAGE] = {0};
+
+    DataFlashDisablePowerSaving();
+    ret = DataFlashReadPage(CELL_IDENTITY_PAGE_NUMBER, pageBuffer, DATAFLASH_BYTES_PER_PAGE);
+    DataFlashEnablePowerSaving();
+
+    if(ret >= 0)
+    {
+        memcpy(&identityRecord, pageBuffer, sizeof(identityRecord));
+        if((identityRecord.magic != CELL_IDENTITY_MAGIC) || (identityRecord.version != CELL_IDENTITY_VERSION) ||
+           (identityRecord.size != sizeof(CellularIdentityRecord_t)) ||
+           (identityRecord.imei[CELLULAR_IMEI_LENGTH] != 0u) || (identityRecord.iccid[CELLULAR_ICCID_LENGTH] != 0u) ||
+           (identityRecord.firmware[CELLULAR_FIRMWARE_LENGTH] != 0u) || (identityRecord.iccid[0] == 0u))
+        {
+            ret = ERR_CELL_IDENTITY_RECORD_INVALID;
+        }
+    }
+
+    isRecordValid = (ret >= 0);
+    if(ret < 0)
+    {
+        memset(&identityRecord, 0, sizeof(identityRecord));
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularIdentitySaveToFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the record snapshot taken by CellularIdentityUpdate.
+//!  Called from SysTask which owns the DataFlash.
+//
+//------------------------------------------------------------------------------
+int32_t CellularIdentitySaveToFlash(void)
+{
+    int32_t ret = 0;
+
+    DataFlashDisablePowerSaving();
+    ret = DataFlashErasePage(CELL_IDENTITY_PAGE_NUMBER);
+    if(ret >= 0)
+    {
+        ret = DataFlashWriteBuffer(0, (uint8_t *)&saveRecord, sizeof(saveRecord));
+    }
+    if(ret >= 0)
+    {
+        ret = DataFlashWriteBufferToPage(CELL_IDENTITY_PAGE_NUMBER);
+    }
+    DataFlashEnablePowerSaving();
+    isSavePending = false;
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularIdentityRestore(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function compare the ICCID just read with the cached one and, when
+//!  it matches, fill IMEI and firmware revision of the driver from the cache
+//!
+//! \return 0, ERR_CELL_IDENTITY_RECORD_INVALID, ERR_CELL_IDENTITY_SIM_CHANGED
+//!         or ERR_CELL_IDENTITY_VERIFY_DUE when the identity must be queried
+//
+//------------------------------------------------------------------------------
+int32_t CellularIdentityRestore(void)
+{
+    int32_t ret = 0;
+
+    if(isRecordValid == false)
+    {
+        ret = ERR_CELL_IDENTITY_RECORD_INVALID;
+    }
+    else if(strncmp((char const *)gCellularDriver.iccid, (char const *)identityRecord.iccid, CELLULAR_ICCID_LENGTH) != 0)
+    {
+        ret = ERR_CELL_IDENTITY_SIM_CHANGED;
+    }
+    else if(++initsSinceVerify >= CELL_IDENTITY_VERIFY_INITS)
+    {
+        // Covers a module swapped or updated behind the cache
+        ret = ERR_CELL_IDENTITY_VERIFY_DUE;
+    }
+    else
+    {
+        memcpy(gCellularDriver.imei, identityRecord.imei, sizeof(gCellularDriver.imei));
+        memcpy(gCellularDriver.firmware, identityRecord.firmware, sizeof(gCellularDriver.firmware));
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularIdentityUpdate(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function cache the identity queried from the module and ask SysTask
+//!  to persist it when it changed
+//
+//------------------------------------------------------------------------------
+void CellularIdentityUpdate(void)
+{
+    RTOS_ERR  err;
+    SysMsg_t *msg = NULL;
+
+    initsSinceVerify = 0;
+    if((isRecordValid == false) ||
+       (memcmp(identityRecord.imei, gCellularDriver.imei, sizeof(identityRecord.imei)) != 0) ||
+       (memcmp(identityRecord.iccid, gCellularDriver.iccid, sizeof(identityRecord.iccid)) != 0) ||
+       (memcmp(identityRecord.firmware, gCellularDriver.firmware, sizeof(identityRecord.firmware)) != 0))
+    {
+        identityRecord.magic = CELL_IDENTITY_MAGIC;
+        identityRecord.version = CELL_IDENTITY_VERSION;
+        identityRecord.size = sizeof(CellularIdentityRecord_t);
+        memcpy(identityRecord.imei, gCellularDriver.imei, sizeof(identityRecord.imei));
+        memcpy(identityRecord.iccid, gCellularDriver.iccid, sizeof(identityRecord.iccid));
+        memcpy(identityRecord.firmware, gCellularDriver.firmware, sizeof(identityRecord.firmware));
+        identityRecord.imei[CELLULAR_IMEI_LENGTH] = 0;
+        identityRecord.iccid[CELLULAR_ICCID_LENGTH] = 0;
+        identityRecord.firmware[CELLULAR_FIRMWARE_LENGTH] = 0;
+        isRecordValid = true;
+        isRecordChanged = true;
+    }
+
+    if((isRecordChanged == true) && (isSavePending == false))
+    {
+        msg = (SysMsg_t*)GetTaskMessageFromPool();
+        if(msg != NULL)
+        {
+            saveRecord = identityRecord;
+            isRecordChanged = false;
+            isSavePending = true;
+            msg->msgId = SAVE_CELL_IDENTITY_TO_FLASH;
+            msg->msgInfo = 1;
+            msg->ptrData = NULL;
+            OSTaskQPost(&SYSTaskTCB, (void *)msg, sizeof(SysMsg_t), OS_OPT_POST_FIFO, &err);
+        }
+    }
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
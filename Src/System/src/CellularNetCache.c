@@ -0,0 +1,715 @@
+//==============================================================================
+//
+//  CellularNetCache.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularNetCache.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the network cache. The operator and E-UTRA band of the
+//! serving cell are read with AT+UCGED after each registration. The next
+//! attach restricts AT+UBANDMASK to that band and selects the operator
+//! manually, so the module does not scan every band of every RAT.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "CellularNetCache.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Cellular.h"
+#include "CellularRAT.h"
+#include "DataFlash.h"
+#include "Event.h"
+#include "SysTask.h"
+#include "Timer.h"
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define CELL_NET_MAX_BAND               128u    // bitmask1 holds bands 1-64, bitmask2 65-128
+#define CELL_NET_MAX_MASK_FIELDS        6u
+#define CELL_NET_EWMA_SHIFT             2u
+#define CELL_NET_DIAGNOSTIC_UNIT_MS     100u
+#define CELL_NET_DECIMAL_64_SIZE        21u
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static CellularNetCacheRecord_t cacheRecord;
+static CellularNetCacheRecord_t saveRecord;     // Snapshot written by SysTask
+static BOOLEAN isRecordChanged = false;
+static volatile BOOLEAN isSavePending = false;
+static BOOLEAN isSavedOnce = false;
+static uint32_t lastSaveTicks = 0;
+
+// Serving cell parsed from the last +UCGED
+static char servingPlmn[CELL_NET_PLMN_LENGTH + 2u];
+static uint8_t servingBand = 0;
+static BOOLEAN isServingCellValid = false;
+
+// RATs whose mask is restricted in the module NVM, unknown after a reset so
+// the first attach restores them all
+static uint8_t restrictedRats = (uint8_t)((1u << CELL_BANDMASK_RATS) - 1u);
+static uint8_t pendingRestrictedRats = 0;
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void CellularNetCacheResetRecord(void);
+static char const* ParseDecimal(char const *text, char const *end, uint64_t *value);
+static uint32_t FormatDecimal(char buffer[], uint64_t value);
+static void AddRegistrationSample(CellularRegistrationStats_t *stats, BOOLEAN isRegistered, uint32_t attachMs);
+static void PutBigEndian16(uint8_t data[], uint32_t value);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static void CellularNetCacheResetRecord(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function clear the cache, the next attach is a full scan
+//
+//------------------------------------------------------------------------------
+static void CellularNetCacheResetRecord(void)
+{
+    memset(&cacheRecord, 0, sizeof(cacheRecord));
+    cacheRecord.magic = CELL_NET_CACHE_MAGIC;
+    cacheRecord.version = CELL_NET_CACHE_VERSION;
+    cacheRecord.size = sizeof(CellularNetCacheRecord_t);
+    cacheRecord.bandMaskRat = CELL_BANDMASK_RAT_NONE;
+}
+
+//------------------------------------------------------------------------------
+//  static char const* ParseDecimal(char const *text, char const *end, uint64_t *value)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse an unsigned decimal of up to 64 bits, band masks do
+//!  not fit strtoul
+//!
+//! \return first character after the number or NULL when there is none
+//
+//------------------------------------------------------------------------------
+static char const* ParseDecimal(char const *text, char const *end, uint64_t *value)
+{
+    char const *ret = NULL;
+
+    while((text < end) && (*text == ' '))
+    {
+        text++;
+    }
+    *value = 0;
+    while((text < end) && (*text >= '0') && (*text <= '9'))
+    {
+        *value = (*value * 10u) + (uint64_t)(*text - '0');
+        text++;
+        ret = text;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static uint32_t FormatDecimal(char buffer[], uint64_t value)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write a 64 bit unsigned decimal, buffer holds
+//!  CELL_NET_DECIMAL_64_SIZE characters
+//!
+//! \return number of digits
+//
+//------------------------------------------------------------------------------
+static uint32_t FormatDecimal(char buffer[], uint64_t value)
+{
+    char digits[CELL_NET_DECIMAL_64_SIZE];
+    uint32_t count = 0, i = 0;
+
+    do
+    {
+        digits[count++] = (char)('0' + (value % 10u));
+        value /= 10u;
+    }while(value > 0u);
+
+    for(i = 0; i < count; i++)
+    {
+        buffer[i] = digits[count - 1u - i];
+    }
+    buffer[count] = 0;
+
+    return count;
+}
+
+//------------------------------------------------------------------------------
+//  static void AddRegistrationSample(CellularRegistrationStats_t *stats, BOOLEAN isRegistered, uint32_t attachMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function add an attach to the statistics of its kind
+//
+//------------------------------------------------------------------------------
+static void AddRegistrationSample(CellularRegistrationStats_t *stats, BOOLEAN isRegistered, uint32_t attachMs)
+{
+    if(stats->attempts < UINT16_MAX)
+    {
+        stats->attempts++;
+    }
+    stats->lastMs = attachMs;
+    if((isRegistered == true) && (stats->successes < UINT16_MAX))
+    {
+        stats->successes++;
+        if(stats->successes == 1u)
+        {
+            stats->averageMs = attachMs;
+        }
+        else if(attachMs >= stats->averageMs)
+        {
+            stats->averageMs += ((attachMs - stats->averageMs) >> CELL_NET_EWMA_SHIFT);
+        }
+        else
+        {
+            stats->averageMs -= ((stats->averageMs - attachMs) >> CELL_NET_EWMA_SHIFT);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void PutBigEndian16(uint8_t data[], uint32_t value)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write a 16 bit field of the SPI readout, saturating
+//
+//------------------------------------------------------------------------------
+static void PutBigEndian16(uint8_t data[], uint32_t value)
+{
+    value = FIND_MIN(value, UINT16_MAX);
+    data[0] = (uint8_t)((value >> 8) & 0xFFu);
+    data[1] = (uint8_t)(value & 0xFFu);
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  int32_t CellularNetCacheLoadFromFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read the network cache, called from SysTask at start up
+//
+//------------------------------------------------------------------------------
+int32_t CellularNetCacheLoadFromFlash(void)
+{
+    int32_t ret = 0;
+    uint8_t pageBuffer[DATAFLASH_BYTES_PER_PAGE] = {0};
+
+    DataFlashDisablePowerSaving();
+    ret = DataFlashReadPage(CELL_NET_CACHE_PAGE_NUMBER, pageBuffer, DATAFLASH_BYTES_PER_PAGE);
+    DataFlashEnablePowerSaving();
+
+    if(ret >= 0)
+    {
+        memcpy(&cacheRecord, pageBuffer, sizeof(cacheRecord));
+        if((cacheRecord.magic != CELL_NET_CACHE_MAGIC) || (cacheRecord.version != CELL_NET_CACHE_VERSION) ||
+           (cacheRecord.size != sizeof(CellularNetCacheRecord_t)) ||
+           (memchr(cacheRecord.plmn, 0, sizeof(cacheRecord.plmn)) == NULL))
+        {
+            ret = ERR_CELL_NET_CACHE_RECORD_INVALID;
+        }
+    }
+
+    if(ret < 0)
+    {
+        CellularNetCacheResetRecord();
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularNetCacheSaveToFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the record snapshot taken by
+//!  CellularNetCacheRequestSave. Called from SysTask which owns the DataFlash.
+//
+//------------------------------------------------------------------------------
+int32_t CellularNetCacheSaveToFlash(void)
+{
+    int32_t ret = 0;
+
+    DataFlashDisablePowerSaving();
+    ret = DataFlashErasePage(CELL_NET_CACHE_PAGE_NUMBER);
+    if(ret >= 0)
+    {
+        ret = DataFlashWriteBuffer(0, (uint8_t *)&saveRecord, sizeof(saveRecord));
+    }
+    if(ret >= 0)
+    {
+        ret = DataFlashWriteBufferToPage(CELL_NET_CACHE_PAGE_NUMBER);
+    }
+    DataFlashEnablePowerSaving();
+    isSavePending = false;
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularNetCacheRequestSave(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function snapshot a changed record and ask SysTask to persist it,
+//!  at most once per CELL_NET_CACHE_SAVE_INTERVAL_MS except for the first
+//
+//------------------------------------------------------------------------------
+void CellularNetCacheRequestSave(void)
+{
+    RTOS_ERR  err;
+    SysMsg_t *msg = NULL;
+
+    if((isRecordChanged == true) && (isSavePending == false) &&
+       ((isSavedOnce == false) || (RTCDRV_TicksToMsec(GetRTCTicks() - lastSaveTicks) >= CELL_NET_CACHE_SAVE_INTERVAL_MS)))
+    {
+        msg = (SysMsg_t*)GetTaskMessageFromPool();
+        if(msg != NULL)
+        {
+            isSavedOnce = true;
+            lastSaveTicks = GetRTCTicks();
+            saveRecord = cacheRecord;
+            isRecordChanged = false;
+            isSavePending = true;
+            msg->msgId = SAVE_NET_CACHE_TO_FLASH;
+            msg->msgInfo = 1;
+            msg->ptrData = NULL;
+            OSTaskQPost(&SYSTaskTCB, (void *)msg, sizeof(SysMsg_t), OS_OPT_POST_FIFO, &err);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularNetCacheIsUsable(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when an operator is cached and the last
+//!  cached attaches did not keep failing
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularNetCacheIsUsable(void)
+{
+    return ((cacheRecord.plmn[0] != 0) && (cacheRecord.consecutiveFailures < CELL_NET_CACHE_MAX_FAILURES));
+}
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularNetCacheIsFullMaskKnown(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true once the band masks of the module were read,
+//!  bands are never restricted before
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularNetCacheIsFullMaskKnown(void)
+{
+    return (cacheRecord.isFullMaskValid != 0u);
+}
+
+//------------------------------------------------------------------------------
+//  void CellularNetCacheForgetOperator(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function drop the cached operator and band when the SIM card was
+//!  swapped, the next attach is a full scan
+//
+//------------------------------------------------------------------------------
+void CellularNetCacheForgetOperator(void)
+{
+    if(cacheRecord.plmn[0] != 0)
+    {
+        memset(cacheRecord.plmn, 0, sizeof(cacheRecord.plmn));
+        cacheRecord.band = 0;
+        cacheRecord.bandMaskRat = CELL_BANDMASK_RAT_NONE;
+        cacheRecord.consecutiveFailures = 0;
+        isRecordChanged = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularNetCacheCreateBandMaskCommand(uint8_t buffer[], uint32_t bufferSize, BOOLEAN isRestricted)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create the next AT+UBANDMASK needed to restrict the RAT of
+//!  the cache to the cached band or to restore the masks read from the
+//!  module. Call CellularNetCacheConfirmBandMask once it is accepted.
+//!
+//! \return command size, 0 when the masks are as wanted or
+//!         ERR_CELL_NET_CACHE_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularNetCacheCreateBandMaskCommand(uint8_t buffer[], uint32_t bufferSize, BOOLEAN isRestricted)
+{
+    int32_t ret = 0;
+    uint8_t rat = 0, target = 0, bit = 0;
+    uint64_t mask[2] = {0, 0};
+    char mask1[CELL_NET_DECIMAL_64_SIZE], mask2[CELL_NET_DECIMAL_64_SIZE];
+
+    if(cacheRecord.isFullMaskValid != 0u)
+    {
+        rat = cacheRecord.bandMaskRat;
+        // A band the module does not support leaves nothing to restrict to
+        if((isRestricted == true) && (rat < CELL_BANDMASK_RATS) &&
+           (cacheRecord.band > 0u) && (cacheRecord.band <= CELL_NET_MAX_BAND) &&
+           ((cacheRecord.band <= 64u) ? ((cacheRecord.fullMask[rat][0] & ((uint64_t)1u << (cacheRecord.band - 1u))) != 0u) :
+                                        ((cacheRecord.fullMask[rat][1] & ((uint64_t)1u << (cacheRecord.band - 65u))) != 0u)))
+        {
+            target = (uint8_t)(1u << rat);
+        }
+
+        for(rat = 0; (rat < CELL_BANDMASK_RATS) && (ret == 0); rat++)
+        {
+            bit = (uint8_t)(1u << rat);
+            if((cacheRecord.fullMask[rat][0] == 0u) && (cacheRecord.fullMask[rat][1] == 0u))
+            {
+                // RAT not reported by the module, nothing to restrict or restore
+                restrictedRats &= (uint8_t)~bit;
+            }
+            else if((restrictedRats & bit) != (target & bit))
+            {
+                mask[0] = cacheRecord.fullMask[rat][0];
+                mask[1] = cacheRecord.fullMask[rat][1];
+                if((target & bit) != 0u)
+                {
+                    mask[0] &= (cacheRecord.band <= 64u) ? ((uint64_t)1u << (cacheRecord.band - 1u)) : 0u;
+                    mask[1] &= (cacheRecord.band > 64u) ? ((uint64_t)1u << (cacheRecord.band - 65u)) : 0u;
+                }
+                (void)FormatDecimal(mask1, mask[0]);
+                (void)FormatDecimal(mask2, mask[1]);
+                ret = snprintf((char *)buffer, bufferSize, "AT+UBANDMASK=%u,%s,%s\r\n", rat, mask1, mask2);
+                if((ret < 0) || ((uint32_t)ret >= bufferSize))
+                {
+                    ret = ERR_CELL_NET_CACHE_NOT_AVAILABLE;
+                }
+                pendingRestrictedRats = restrictedRats ^ bit;
+            }
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularNetCacheConfirmBandMask(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function note the AT+UBANDMASK created last as accepted by the module
+//
+//------------------------------------------------------------------------------
+void CellularNetCacheConfirmBandMask(void)
+{
+    restrictedRats = pendingRestrictedRats;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularNetCacheCreateSelectCommand(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create AT+COPS manual selection of the cached operator
+//!
+//! \return command size or ERR_CELL_NET_CACHE_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularNetCacheCreateSelectCommand(uint8_t buffer[], uint32_t bufferSize)
+{
+    int32_t ret = ERR_CELL_NET_CACHE_NOT_AVAILABLE;
+
+    if(cacheRecord.plmn[0] != 0)
+    {
+        // Numeric format, the name reported by +COPS? differs between networks
+        ret = snprintf((char *)buffer, bufferSize, "AT+COPS=1,2,\"%s\"\r\n", cacheRecord.plmn);
+        if((ret < 0) || ((uint32_t)ret >= bufferSize))
+        {
+            ret = ERR_CELL_NET_CACHE_NOT_AVAILABLE;
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularNetCacheParseBandMask(uint8_t const response[], uint32_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse +UBANDMASK: <rat>,<bitmask1>[,<bitmask2>],... and
+//!  keep it as the full mask when none is held
+//!
+//! \return 0, ERR_INCOMPLETE_DATA_RECEIVED until OK or
+//!         ERR_CELL_NET_CACHE_PARSE_FAILED
+//
+//------------------------------------------------------------------------------
+int32_t CellularNetCacheParseBandMask(uint8_t const response[], uint32_t length)
+{
+    int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
+    char const *end = (char const *)&response[length];
+    char const *text = strstr((char const *)response, "+UBANDMASK:");
+    char const *lineEnd = NULL;
+    uint64_t fields[CELL_NET_MAX_MASK_FIELDS];
+    uint32_t count = 0, perRat = 0, i = 0;
+
+    if((text != NULL) && (strstr(text, "OK") != NULL))
+    {
+        ret = ERR_CELL_NET_CACHE_PARSE_FAILED;
+        lineEnd = text;
+        while((lineEnd < end) && (*lineEnd != '\r') && (*lineEnd != '\n'))
+        {
+            lineEnd++;
+        }
+        text = &text[11];
+        while((text != NULL) && (count < CELL_NET_MAX_MASK_FIELDS))
+        {
+            text = ParseDecimal(text, lineEnd, &fields[count]);
+            if(text != NULL)
+            {
+                count++;
+                text = ((text < lineEnd) && (*text == ',')) ? &text[1] : NULL;
+            }
+        }
+
+        // Either every RAT has bitmask2 or none has
+        perRat = ((count == 3u) || (count == 6u)) ? 3u : 2u;
+        if((count == 2u) || (count == 3u) || (count == 4u) || (count == 6u))
+        {
+            ret = 0;
+            for(i = 0; (i < count) && (ret == 0); i += perRat)
+            {
+                if(fields[i] >= CELL_BANDMASK_RATS)
+                {
+                    ret = ERR_CELL_NET_CACHE_PARSE_FAILED;
+                }
+            }
+            // A mask read later may be a restricted one left by a reset
+            for(i = 0; (i < count) && (ret == 0) && (cacheRecord.isFullMaskValid == 0u); i += perRat)
+            {
+                cacheRecord.fullMask[fields[i]][0] = fields[i + 1u];
+                cacheRecord.fullMask[fields[i]][1] = (perRat == 3u) ? fields[i + 2u] : 0u;
+            }
+            if((ret == 0) && (cacheRecord.isFullMaskValid == 0u))
+            {
+                cacheRecord.isFullMaskValid = 1u;
+                isRecordChanged = true;
+            }
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularNetCacheParseCellInfo(uint8_t const response[], uint32_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse the operator and band of the serving cell from
+//!  +UCGED: 2 (<rat>,<svc>,<MCC>,<MNC> then <EARFCN>,<band>,...)
+//!
+//! \return 0, ERR_INCOMPLETE_DATA_RECEIVED until OK or
+//!         ERR_CELL_NET_CACHE_PARSE_FAILED
+//
+//------------------------------------------------------------------------------
+int32_t CellularNetCacheParseCellInfo(uint8_t const response[], uint32_t length)
+{
+    int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
+    char const *text = strstr((char const *)response, "+UCGED:");
+    char mcc[4] = {0}, mnc[4] = {0};
+    unsigned int mode = 0, rat = 0, service = 0, earfcn = 0, band = 0;
+
+    (void)length;
+    if((text != NULL) && (strstr(text, "OK") != NULL))
+    {
+        ret = ERR_CELL_NET_CACHE_PARSE_FAILED;
+        isServingCellValid = false;
+        if((sscanf(text, "+UCGED: %u", &mode) == 1) && (mode == 2u))
+        {
+            text = strchr(text, '\n');
+            if((text != NULL) && (sscanf(&text[1], "%u,%u,%3[0-9],%3[0-9]", &rat, &service, mcc, mnc) == 4) &&
+               (strlen(mcc) == 3u) && (strlen(mnc) >= 2u))
+            {
+                snprintf(servingPlmn, sizeof(servingPlmn), "%s%s", mcc, mnc);
+                servingBand = 0;
+                // E-UTRA cell line, other RATs report no band
+                text = strchr(&text[1], '\n');
+                if((text != NULL) && (sscanf(&text[1], "%u,%u", &earfcn, &band) == 2) &&
+                   (band > 0u) && (band <= CELL_NET_MAX_BAND))
+                {
+                    servingBand = (uint8_t)band;
+                }
+                isServingCellValid = true;
+                ret = 0;
+            }
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularNetCacheRecordAttach(BOOLEAN isCached, BOOLEAN isRegistered, uint32_t attachMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record the registration time of a cached or full scan attach
+//
+//------------------------------------------------------------------------------
+void CellularNetCacheRecordAttach(BOOLEAN isCached, BOOLEAN isRegistered, uint32_t attachMs)
+{
+    if(isCached == true)
+    {
+        AddRegistrationSample(&cacheRecord.cached, isRegistered, attachMs);
+        if(isRegistered == true)
+        {
+            cacheRecord.consecutiveFailures = 0;
+        }
+        else if(cacheRecord.consecutiveFailures < UINT8_MAX)
+        {
+            cacheRecord.consecutiveFailures++;
+        }
+    }
+    else
+    {
+        AddRegistrationSample(&cacheRecord.fullScan, isRegistered, attachMs);
+    }
+    isRecordChanged = true;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularNetCacheUpdate(uint8_t accessTechnology)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function cache the serving cell parsed last after a registration,
+//!  accessTechnology is the +COPS <AcT>
+//
+//------------------------------------------------------------------------------
+void CellularNetCacheUpdate(uint8_t accessTechnology)
+{
+    uint8_t bandMaskRat = CELL_BANDMASK_RAT_NONE;
+
+    if(accessTechnology == CELL_ACT_LTE)
+    {
+        bandMaskRat = CELL_BANDMASK_RAT_LTE_M;
+    }
+    else if(accessTechnology == CELL_ACT_NB_IOT)
+    {
+        bandMaskRat = CELL_BANDMASK_RAT_NB_IOT;
+    }
+
+    if((isServingCellValid == true) && (accessTechnology != CELL_ACT_UNKNOWN))
+    {
+        // A new cell starts with a clean failure count, the same one keeps it
+        if((strcmp(servingPlmn, cacheRecord.plmn) != 0) || (servingBand != cacheRecord.band) ||
+           (bandMaskRat != cacheRecord.bandMaskRat))
+        {
+            snprintf(cacheRecord.plmn, sizeof(cacheRecord.plmn), "%s", servingPlmn);
+            cacheRecord.band = servingBand;
+            cacheRecord.bandMaskRat = bandMaskRat;
+            cacheRecord.consecutiveFailures = 0;
+            isRecordChanged = true;
+        }
+    }
+    isServingCellValid = false;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularNetCacheGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the cached operator, band and the registration
+//!  statistics for the radio configuration readout, big endian
+//!
+//! \return CELL_NET_CACHE_DIAGNOSTIC_SIZE or ERR_CELL_NET_CACHE_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularNetCacheGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+{
+    int32_t ret = ERR_CELL_NET_CACHE_NOT_AVAILABLE;
+
+    if(bufferSize >= CELL_NET_CACHE_DIAGNOSTIC_SIZE)
+    {
+        memcpy(buffer, cacheRecord.plmn, CELL_NET_PLMN_LENGTH);
+        buffer[6] = cacheRecord.bandMaskRat;
+        buffer[7] = cacheRecord.band;
+        PutBigEndian16(&buffer[8], cacheRecord.cached.attempts);
+        PutBigEndian16(&buffer[10], cacheRecord.cached.successes);
+        PutBigEndian16(&buffer[12], (cacheRecord.cached.averageMs / CELL_NET_DIAGNOSTIC_UNIT_MS));
+        PutBigEndian16(&buffer[14], cacheRecord.fullScan.attempts);
+        PutBigEndian16(&buffer[16], cacheRecord.fullScan.successes);
+        PutBigEndian16(&buffer[18], (cacheRecord.fullScan.averageMs / CELL_NET_DIAGNOSTIC_UNIT_MS));
+        ret = CELL_NET_CACHE_DIAGNOSTIC_SIZE;
+    }
+
+    return ret;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,358 @@
+//==============================================================================
+//
+//  CellularPrewarm.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularPrewarm.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the upload path warm up. An event is created when the
+//! instrument state has changed already, the upload then pays CFUN=1, the
+//! registration and the connect. Instrument messages that come before an
+//! alarm hint the cellular task to attach, look the host up and connect the
+//! token socket meanwhile. The radio stays attached while hints keep coming
+//! and CELL_PREWARM_HOLD_MS after, so the uploads of the alarm and of its
+//! follow ups find it registered.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "CellularPrewarm.h"
+
+#include <string.h>
+
+#include "Cellular.h"
+#include "Event.h"
+#include "Timer.h"
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static CellularPrewarmStats_t prewarmStats;
+static volatile uint32_t lastHintTicks = 0;
+static volatile BOOLEAN isHintSeen = false;
+static BOOLEAN isWarm = false;                  // Warmed up in this hold window, no upload yet
+
+// Distance of each reading from normal in the previous instrument message
+static int32_t lastDeviation[MAX_SENSOR_SUPPORTED];
+static uint8_t risingMessages[MAX_SENSOR_SUPPORTED];
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void PutBigEndian16(uint8_t data[], uint32_t value);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static void PutBigEndian16(uint8_t data[], uint32_t value)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write a 16 bit field of the SPI readout, saturating
+//
+//------------------------------------------------------------------------------
+static void PutBigEndian16(uint8_t data[], uint32_t value)
+{
+    value = FIND_MIN(value, UINT16_MAX);
+    data[0] = (uint8_t)((value >> 8) & 0xFFu);
+    data[1] = (uint8_t)(value & 0xFFu);
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  void CellularPrewarmCheckSensors(InstSensorInfo_t const *sensorInfo)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function hint at an alarm coming when a sensor is in low alarm or
+//!  its reading moved away from normal for CELL_PREWARM_RISING_MESSAGES
+//!  instrument messages. Called from the SPI interrupt for each message.
+//
+//------------------------------------------------------------------------------
+void CellularPrewarmCheckSensors(InstSensorInfo_t const *sensorInfo)
+{
+    uint8_t loopCounter = 0;
+    int32_t deviation = 0;
+    BOOLEAN isRising = false;
+    BOOLEAN isLowAlarm = false;
+    SensorInfo_t const *sensor = NULL;
+    
+    for(loopCounter = 0; (loopCounter < sensorInfo->numberOfSensors) && (loopCounter < MAX_SENSOR_SUPPORTED); loopCounter++)
+    {
+        sensor = &sensorInfo->sensorArray[loopCounter];
+        deviation = (int32_t)(int16_t)(((uint8_t)sensor->SensorReadingHigh << 8) | (uint8_t)sensor->SensorReadingLow);
+        if(sensor->SensorType == SENSOR_GAS_TYPE_O2)
+        {
+            // Oxygen alarms on depletion and on enrichment
+            deviation -= CELL_PREWARM_O2_NORMAL_READING;
+        }
+        if(deviation < 0)
+        {
+            deviation = -deviation;
+        }
+        
+        if(sensor->SensorStatus == LOW_ALARM)
+        {
+            isLowAlarm = true;
+        }
+        
+        // Alarm raised already or reading back towards normal, start over
+        if((sensor->SensorStatus != SENSOR_NORMAL) || (deviation < lastDeviation[loopCounter]))
+        {
+            risingMessages[loopCounter] = 0;
+        }
+        else if((deviation > lastDeviation[loopCounter]) && (risingMessages[loopCounter] < CELL_PREWARM_RISING_MESSAGES))
+        {
+            risingMessages[loopCounter]++;
+        }
+        lastDeviation[loopCounter] = deviation;
+        
+        if(risingMessages[loopCounter] >= CELL_PREWARM_RISING_MESSAGES)
+        {
+            isRising = true;
+        }
+    }
+    
+    if(isLowAlarm == true)
+    {
+        CellularPrewarmHint(CELL_PREWARM_LOW_ALARM);
+    }
+    else if(isRising == true)
+    {
+        CellularPrewarmHint(CELL_PREWARM_GAS_RISING);
+    }
+}
+
+//------------------------------------------------------------------------------
+//  void CellularPrewarmHint(CELL_PREWARM_REASON_t reason)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function extend the hold window, the cellular task is asked to warm
+//!  up when the window opens
+//
+//------------------------------------------------------------------------------
+void CellularPrewarmHint(CELL_PREWARM_REASON_t reason)
+{
+    RTOS_ERR  err;
+    CellMsg_t *msg = NULL;
+    BOOLEAN isWindowOpening = (CellularPrewarmIsHeld() == false);
+    
+    lastHintTicks = GetRTCTicks();
+    isHintSeen = true;
+    if(reason < CELL_PREWARM_REASON_COUNT)
+    {
+        prewarmStats.hints[reason]++;
+    }
+    
+    // Within the window the radio is kept attached, one warm up is enough
+    if(isWindowOpening == true)
+    {
+        msg = (CellMsg_t*)GetTaskMessageFromPool();
+        if(msg != NULL)
+        {
+            msg->msgId = CELL_PREWARM_CONNECTION;
+            msg->msgInfo = (uint16_t)reason;
+            msg->ptrData = NULL;
+            OSTaskQPost(&CellTaskTCB, (void *)msg, sizeof(SysMsg_t), OS_OPT_POST_FIFO, &err);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularPrewarmIsHeld(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true within CELL_PREWARM_HOLD_MS of the last hint
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularPrewarmIsHeld(void)
+{
+    return (BOOLEAN)(CellularPrewarmGetRemainingMs() > 0u);
+}
+
+//------------------------------------------------------------------------------
+//  uint32_t CellularPrewarmGetRemainingMs(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the time left in the hold window, 0 when closed
+//
+//------------------------------------------------------------------------------
+uint32_t CellularPrewarmGetRemainingMs(void)
+{
+    uint32_t remainingMs = 0;
+    uint32_t elapsedMs = 0;
+    
+    if(isHintSeen == true)
+    {
+        elapsedMs = RTCDRV_TicksToMsec(GetRTCTicks() - lastHintTicks);
+        if(elapsedMs < CELL_PREWARM_HOLD_MS)
+        {
+            remainingMs = CELL_PREWARM_HOLD_MS - elapsedMs;
+        }
+    }
+    return remainingMs;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularPrewarmRecordWarmup(BOOLEAN isAttached, uint32_t warmupMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record a warm up done by the cellular task
+//
+//------------------------------------------------------------------------------
+void CellularPrewarmRecordWarmup(BOOLEAN isAttached, uint32_t warmupMs)
+{
+    if(isAttached == true)
+    {
+        prewarmStats.warmups++;
+        prewarmStats.lastWarmupMs = warmupMs;
+        isWarm = true;
+    }
+    else
+    {
+        prewarmStats.warmupFailures++;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  void CellularPrewarmRecordUpload(BOOLEAN isAttached)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record an upload starting, a hit when the radio is already
+//!  attached in a hold window
+//
+//------------------------------------------------------------------------------
+void CellularPrewarmRecordUpload(BOOLEAN isAttached)
+{
+    // Uploads switch the radio off unless held, attached means warm
+    if(isAttached == true)
+    {
+        prewarmStats.hits++;
+        if(isWarm == true)
+        {
+            prewarmStats.savedMs += prewarmStats.lastWarmupMs;
+        }
+    }
+    isWarm = false;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularPrewarmRecordRelease(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record the radio switched off, a miss when the hold window
+//!  had no upload
+//
+//------------------------------------------------------------------------------
+void CellularPrewarmRecordRelease(void)
+{
+    if(isWarm == true)
+    {
+        prewarmStats.misses++;
+    }
+    isWarm = false;
+}
+
+//------------------------------------------------------------------------------
+//  CellularPrewarmStats_t const* CellularPrewarmGetStats(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the hint and warm up counts
+//
+//------------------------------------------------------------------------------
+CellularPrewarmStats_t const* CellularPrewarmGetStats(void)
+{
+    return &prewarmStats;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularPrewarmGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the hint and warm up statistics for the radio
+//!  configuration readout, big endian
+//!
+//! \return CELL_PREWARM_DIAGNOSTIC_SIZE or ERR_CELL_PREWARM_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularPrewarmGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+{
+    int32_t ret = ERR_CELL_PREWARM_NOT_AVAILABLE;
+    
+    if(bufferSize >= CELL_PREWARM_DIAGNOSTIC_SIZE)
+    {
+        PutBigEndian16(&buffer[0], prewarmStats.hints[CELL_PREWARM_GAS_RISING]);
+        PutBigEndian16(&buffer[2], prewarmStats.hints[CELL_PREWARM_LOW_ALARM]);
+        PutBigEndian16(&buffer[4], prewarmStats.hints[CELL_PREWARM_PROXIMITY]);
+        PutBigEndian16(&buffer[6], prewarmStats.warmups);
+        PutBigEndian16(&buffer[8], prewarmStats.warmupFailures);
+        PutBigEndian16(&buffer[10], prewarmStats.hits);
+        PutBigEndian16(&buffer[12], prewarmStats.misses);
+        PutBigEndian16(&buffer[14], prewarmStats.lastWarmupMs);
+        buffer[16] = (uint8_t)((prewarmStats.savedMs >> 24) & 0xFFu);
+        buffer[17] = (uint8_t)((prewarmStats.savedMs >> 16) & 0xFFu);
+        buffer[18] = (uint8_t)((prewarmStats.savedMs >> 8) & 0xFFu);
+        buffer[19] = (uint8_t)(prewarmStats.savedMs & 0xFFu);
+        ret = CELL_PREWARM_DIAGNOSTIC_SIZE;
+    }
+    
+    return ret;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,562 @@
+//==============================================================================
+//
+//  CellularRAT.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularRAT.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the RAT selection. Every attach and socket connect is
+//! measured against the RAT the module registered on, the AT+URAT order is
+//! the one with the lowest expected upload energy and the other RATs are
+//! probed now and then so a change of coverage is noticed.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "CellularRAT.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "DataFlash.h"
+#include "Event.h"
+#include "SysTask.h"
+#include "Timer.h"
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define CELL_RAT_URAT_BASE              7u      // AT+URAT value of CELL_RAT_LTE_M
+#define CELL_RAT_CURRENT_UNIT           16u     // Weight of the LTE-M radio current
+#define CELL_RAT_DIAGNOSTIC_UNIT_MS     100u
+
+// Averages before the first measurement, SARA-R4 figures
+static uint32_t const RAT_DEFAULT_ATTACH_MS[CELL_RAT_COUNT]  = {6000u, 12000u, 5000u};
+static uint32_t const RAT_DEFAULT_CONNECT_MS[CELL_RAT_COUNT] = {1500u, 4000u, 2500u};
+// Average radio current relative to CELL_RAT_CURRENT_UNIT
+static uint32_t const RAT_CURRENT_WEIGHT[CELL_RAT_COUNT]     = {16u, 12u, 24u};
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static CellularRATRecord_t ratRecord;
+static CellularRATRecord_t saveRecord;          // Snapshot written by SysTask
+static BOOLEAN isRecordChanged = false;
+static volatile BOOLEAN isSavePending = false;
+static BOOLEAN isSavedOnce = false;
+static uint32_t lastSaveTicks = 0;
+
+static uint8_t registeredRat = CELL_RAT_UNKNOWN;
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void CellularRATResetRecord(void);
+static uint8_t AccessTechnologyToRat(uint8_t accessTechnology);
+static uint32_t UpdateAverage(uint32_t average, uint32_t sample);
+static void CountAttempt(uint16_t *counter);
+static void PutBigEndian16(uint8_t data[], uint32_t value);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static void CellularRATResetRecord(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function clear the statistics, the order falls back to the
+//!  defaults of the module
+//
+//------------------------------------------------------------------------------
+static void CellularRATResetRecord(void)
+{
+    uint8_t i = 0;
+
+    memset(&ratRecord, 0, sizeof(ratRecord));
+    ratRecord.magic = CELL_RAT_MAGIC;
+    ratRecord.version = CELL_RAT_VERSION;
+    ratRecord.size = sizeof(CellularRATRecord_t);
+    for(i = 0; i < CELL_RAT_COUNT; i++)
+    {
+        ratRecord.order[i] = i;
+        ratRecord.stats[i].attachMs = RAT_DEFAULT_ATTACH_MS[i];
+        ratRecord.stats[i].connectMs = RAT_DEFAULT_CONNECT_MS[i];
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static uint8_t AccessTechnologyToRat(uint8_t accessTechnology)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function map the +COPS <AcT> to the RAT it belongs to
+//
+//------------------------------------------------------------------------------
+static uint8_t AccessTechnologyToRat(uint8_t accessTechnology)
+{
+    uint8_t ret = CELL_RAT_UNKNOWN;
+
+    switch(accessTechnology)
+    {
+    case CELL_ACT_LTE:
+        ret = CELL_RAT_LTE_M;
+        break;
+
+    case CELL_ACT_NB_IOT:
+        ret = CELL_RAT_NB_IOT;
+        break;
+
+    case CELL_ACT_GSM:
+    case CELL_ACT_EGPRS:
+    case CELL_ACT_EC_GSM_IOT:
+        ret = CELL_RAT_GPRS;
+        break;
+
+    default:
+        break;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static uint32_t UpdateAverage(uint32_t average, uint32_t sample)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function move an average towards a sample by 1 / 2^CELL_RAT_EWMA_SHIFT
+//
+//------------------------------------------------------------------------------
+static uint32_t UpdateAverage(uint32_t average, uint32_t sample)
+{
+    uint32_t ret = 0;
+
+    if(sample >= average)
+    {
+        ret = average + ((sample - average) >> CELL_RAT_EWMA_SHIFT);
+    }
+    else
+    {
+        ret = average - ((average - sample) >> CELL_RAT_EWMA_SHIFT);
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static void CountAttempt(uint16_t *counter)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function increment a counter, saturating
+//
+//------------------------------------------------------------------------------
+static void CountAttempt(uint16_t *counter)
+{
+    if(*counter < UINT16_MAX)
+    {
+        (*counter)++;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void PutBigEndian16(uint8_t data[], uint32_t value)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write a 16 bit field of the SPI readout, saturating
+//
+//------------------------------------------------------------------------------
+static void PutBigEndian16(uint8_t data[], uint32_t value)
+{
+    value = FIND_MIN(value, UINT16_MAX);
+    data[0] = (uint8_t)((value >> 8) & 0xFFu);
+    data[1] = (uint8_t)(value & 0xFFu);
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  int32_t CellularRATLoadFromFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read the RAT record, called from SysTask at start up
+//
+//------------------------------------------------------------------------------
+int32_t CellularRATLoadFromFlash(void)
+{
+    int32_t ret = 0;
+    uint8_t pageBuffer[DATAFLASH_BYTES_PER_PAGE] = {0};
+    uint8_t i = 0;
+
+    DataFlashDisablePowerSaving();
+    ret = DataFlashReadPage(CELL_RAT_PAGE_NUMBER, pageBuffer, DATAFLASH_BYTES_PER_PAGE);
+    DataFlashEnablePowerSaving();
+
+    if(ret >= 0)
+    {
+        memcpy(&ratRecord, pageBuffer, sizeof(ratRecord));
+        if((ratRecord.magic != CELL_RAT_MAGIC) || (ratRecord.version != CELL_RAT_VERSION) ||
+           (ratRecord.size != sizeof(CellularRATRecord_t)))
+        {
+            ret = ERR_CELL_RAT_RECORD_INVALID;
+        }
+        for(i = 0; (ret >= 0) && (i < CELL_RAT_COUNT); i++)
+        {
+            if(ratRecord.order[i] >= CELL_RAT_COUNT)
+            {
+                ret = ERR_CELL_RAT_RECORD_INVALID;
+            }
+        }
+    }
+
+    if(ret < 0)
+    {
+        CellularRATResetRecord();
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularRATSaveToFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the record snapshot taken by CellularRATRequestSave.
+//!  Called from SysTask which owns the DataFlash.
+//
+//------------------------------------------------------------------------------
+int32_t CellularRATSaveToFlash(void)
+{
+    int32_t ret = 0;
+
+    DataFlashDisablePowerSaving();
+    ret = DataFlashErasePage(CELL_RAT_PAGE_NUMBER);
+    if(ret >= 0)
+    {
+        ret = DataFlashWriteBuffer(0, (uint8_t *)&saveRecord, sizeof(saveRecord));
+    }
+    if(ret >= 0)
+    {
+        ret = DataFlashWriteBufferToPage(CELL_RAT_PAGE_NUMBER);
+    }
+    DataFlashEnablePowerSaving();
+    isSavePending = false;
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularRATRequestSave(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function snapshot a changed record and ask SysTask to persist it,
+//!  at most once per CELL_RAT_SAVE_INTERVAL_MS
+//
+//------------------------------------------------------------------------------
+void CellularRATRequestSave(void)
+{
+    RTOS_ERR  err;
+    SysMsg_t *msg = NULL;
+
+    if((isRecordChanged == true) && (isSavePending == false) &&
+       ((isSavedOnce == false) || (RTCDRV_TicksToMsec(GetRTCTicks() - lastSaveTicks) >= CELL_RAT_SAVE_INTERVAL_MS)))
+    {
+        msg = (SysMsg_t*)GetTaskMessageFromPool();
+        if(msg != NULL)
+        {
+            isSavedOnce = true;
+            lastSaveTicks = GetRTCTicks();
+            saveRecord = ratRecord;
+            isRecordChanged = false;
+            isSavePending = true;
+            msg->msgId = SAVE_RAT_STATS_TO_FLASH;
+            msg->msgInfo = 1;
+            msg->ptrData = NULL;
+            OSTaskQPost(&SYSTaskTCB, (void *)msg, sizeof(SysMsg_t), OS_OPT_POST_FIFO, &err);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularRATSelectOrder(BOOLEAN isModemReset)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function choose the RAT preference for the next attach, lowest
+//!  expected cost first or the probed RAT first every
+//!  CELL_RAT_REPROBE_INTERVAL attaches
+//!
+//! \return true when AT+URAT has to be sent
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularRATSelectOrder(BOOLEAN isModemReset)
+{
+    BOOLEAN ret = isModemReset;
+    uint8_t order[CELL_RAT_COUNT];
+    uint32_t cost[CELL_RAT_COUNT];
+    uint8_t i = 0, j = 0, rat = 0, probe = 0;
+
+    // Insertion sort by cost, ties keep the module default order
+    for(i = 0; i < CELL_RAT_COUNT; i++)
+    {
+        cost[i] = CellularRATGetCost((CELL_RAT_t)i);
+        for(j = i; (j > 0) && (cost[order[j - 1u]] > cost[i]); j--)
+        {
+            order[j] = order[j - 1u];
+        }
+        order[j] = i;
+    }
+
+    if((ratRecord.attachCount % CELL_RAT_REPROBE_INTERVAL) == (CELL_RAT_REPROBE_INTERVAL - 1u))
+    {
+        for(i = 1; i < CELL_RAT_COUNT; i++)
+        {
+            if(ratRecord.stats[order[i]].lastMeasured < ratRecord.stats[order[probe]].lastMeasured)
+            {
+                probe = i;
+            }
+        }
+        rat = order[probe];
+        for(i = probe; i > 0; i--)
+        {
+            order[i] = order[i - 1u];
+        }
+        order[0] = rat;
+    }
+
+    if(memcmp(order, ratRecord.order, sizeof(order)) != 0)
+    {
+        memcpy(ratRecord.order, order, sizeof(order));
+        isRecordChanged = true;
+        ret = true;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularRATCreateCommand(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create AT+URAT with the selected order
+//!
+//! \return command size or ERR_CELL_RAT_BUFFER_TOO_SMALL
+//
+//------------------------------------------------------------------------------
+int32_t CellularRATCreateCommand(uint8_t buffer[], uint32_t bufferSize)
+{
+    int32_t ret = snprintf((char *)buffer, bufferSize, "AT+URAT=%u,%u,%u\r\n",
+                           (ratRecord.order[0] + CELL_RAT_URAT_BASE),
+                           (ratRecord.order[1] + CELL_RAT_URAT_BASE),
+                           (ratRecord.order[2] + CELL_RAT_URAT_BASE));
+
+    if((ret < 0) || ((uint32_t)ret >= bufferSize))
+    {
+        ret = ERR_CELL_RAT_BUFFER_TOO_SMALL;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularRATRecordAttach(uint8_t accessTechnology, uint32_t attachMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record a registration, accessTechnology is the +COPS
+//!  <AcT>. RATs ahead of the registered one in the order count as failed.
+//
+//------------------------------------------------------------------------------
+void CellularRATRecordAttach(uint8_t accessTechnology, uint32_t attachMs)
+{
+    CellularRATStats_t *stats = NULL;
+    uint8_t i = 0;
+
+    registeredRat = AccessTechnologyToRat(accessTechnology);
+    ratRecord.attachCount++;
+    if(registeredRat != CELL_RAT_UNKNOWN)
+    {
+        for(i = 0; (i < CELL_RAT_COUNT) && (ratRecord.order[i] != registeredRat); i++)
+        {
+            CountAttempt(&ratRecord.stats[ratRecord.order[i]].attachAttempts);
+            ratRecord.stats[ratRecord.order[i]].lastMeasured = ratRecord.attachCount;
+        }
+        stats = &ratRecord.stats[registeredRat];
+        CountAttempt(&stats->attachAttempts);
+        CountAttempt(&stats->attachSuccesses);
+        stats->lastMeasured = ratRecord.attachCount;
+        // A fallback attach also spent the scans of the RATs ahead, its time is not the RAT's own
+        if(i == 0u)
+        {
+            stats->attachMs = UpdateAverage(stats->attachMs, attachMs);
+        }
+    }
+    isRecordChanged = true;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularRATRecordAttachFailure(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record an attach that did not register on any RAT
+//
+//------------------------------------------------------------------------------
+void CellularRATRecordAttachFailure(void)
+{
+    uint8_t i = 0;
+
+    registeredRat = CELL_RAT_UNKNOWN;
+    ratRecord.attachCount++;
+    for(i = 0; i < CELL_RAT_COUNT; i++)
+    {
+        CountAttempt(&ratRecord.stats[i].attachAttempts);
+        ratRecord.stats[i].lastMeasured = ratRecord.attachCount;
+    }
+    isRecordChanged = true;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularRATRecordConnect(BOOLEAN isConnected, uint32_t connectMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record a socket connect on the RAT registered last
+//
+//------------------------------------------------------------------------------
+void CellularRATRecordConnect(BOOLEAN isConnected, uint32_t connectMs)
+{
+    CellularRATStats_t *stats = NULL;
+
+    if(registeredRat != CELL_RAT_UNKNOWN)
+    {
+        stats = &ratRecord.stats[registeredRat];
+        CountAttempt(&stats->connectAttempts);
+        if(isConnected == true)
+        {
+            CountAttempt(&stats->connectSuccesses);
+            stats->connectMs = UpdateAverage(stats->connectMs, connectMs);
+        }
+        isRecordChanged = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  uint32_t CellularRATGetCost(CELL_RAT_t rat)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the expected cost of a successful upload on a RAT,
+//!  attach and connect time weighted by radio current and divided by the
+//!  success rates
+//
+//------------------------------------------------------------------------------
+uint32_t CellularRATGetCost(CELL_RAT_t rat)
+{
+    CellularRATStats_t const *stats = &ratRecord.stats[rat];
+    uint64_t cost = 0;
+
+    // Success rates start at 1/2 and move with every attempt (Laplace)
+    cost = (uint64_t)(stats->attachMs + stats->connectMs) * RAT_CURRENT_WEIGHT[rat];
+    cost = (cost * (stats->attachAttempts + 2u) * (stats->connectAttempts + 2u)) /
+           ((uint64_t)(stats->attachSuccesses + 1u) * (stats->connectSuccesses + 1u) * CELL_RAT_CURRENT_UNIT);
+
+    return (uint32_t)FIND_MIN(cost, UINT32_MAX);
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularRATGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the order and per RAT statistics for the radio
+//!  configuration readout, big endian
+//!
+//! \return CELL_RAT_DIAGNOSTIC_SIZE or ERR_CELL_RAT_BUFFER_TOO_SMALL
+//
+//------------------------------------------------------------------------------
+int32_t CellularRATGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+{
+    int32_t ret = ERR_CELL_RAT_BUFFER_TOO_SMALL;
+    CellularRATStats_t const *stats = NULL;
+    uint32_t index = 0;
+    uint8_t i = 0;
+
+    if(bufferSize >= CELL_RAT_DIAGNOSTIC_SIZE)
+    {
+        // AT+URAT values in preference order
+        for(i = 0; i < CELL_RAT_COUNT; i++)
+        {
+            buffer[index++] = ratRecord.order[i] + CELL_RAT_URAT_BASE;
+        }
+        for(i = 0; i < CELL_RAT_COUNT; i++)
+        {
+            stats = &ratRecord.stats[i];
+            PutBigEndian16(&buffer[index], stats->attachAttempts);
+            PutBigEndian16(&buffer[index + 2u], stats->attachSuccesses);
+            PutBigEndian16(&buffer[index + 4u], stats->connectAttempts);
+            PutBigEndian16(&buffer[index + 6u], stats->connectSuccesses);
+            PutBigEndian16(&buffer[index + 8u], (stats->attachMs / CELL_RAT_DIAGNOSTIC_UNIT_MS));
+            PutBigEndian16(&buffer[index + 10u], (stats->connectMs / CELL_RAT_DIAGNOSTIC_UNIT_MS));
+            index += 12u;
+        }
+        ret = (int32_t)index;
+    }
+
+    return ret;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,406 @@
+//==============================================================================
+//
+//  CellularSMS.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularSMS.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the SMS fallback of alarm events. The summary is text
+//! for the phones of the cell numbers, e.g.
+//!   ALARM GAS 17040MN-001 Bench 2018-11-28 10:00:05Z G0003 HIGH 55.0ppm
+//!   40.438185,-79.999422 #12
+//! packed in the GSM 7 bit default alphabet into a PDU mode SMS-SUBMIT, so
+//! it needs neither AT+CSCS nor the text mode parameters of the module. The
+//! service centre stored on the SIM is used.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "CellularSMS.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Cellular.h"
+#include "NMEAParser.h"
+#include "SPI_Comm.h"
+#include "Timer.h"
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define CELL_SMS_SENT_HISTORY           4u          //!< Alarms remembered as sent, they stay queued for iNet
+#define CELL_SMS_MAX_NUMBER_DIGITS      20u
+#define CELL_SMS_SUBMIT_FIRST_OCTET     0x11u       //!< TP-MTI SMS-SUBMIT, TP-VPF relative
+#define CELL_SMS_TYPE_INTERNATIONAL     0x91u
+#define CELL_SMS_TYPE_UNKNOWN           0x81u
+#define CELL_SMS_CTRL_Z                 0x1Au
+
+typedef struct
+{
+    uint32_t createdTicks;
+    uint8_t sequenceNumber;
+}SMSSentAlarm_t;
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static CellularSMSStats_t smsStats;
+static SMSSentAlarm_t sentAlarms[CELL_SMS_SENT_HISTORY];
+static uint32_t sentAlarmIndex = 0;
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static uint32_t CreateAlarmText(PTR_COMM_EVT_t commEvent, char text[], uint32_t textSize);
+static uint32_t FormatReading(char buffer[], uint32_t bufferSize, SensorInfo_t const *sensor);
+static uint32_t PackSeptets(char const text[], uint32_t length, uint8_t octets[]);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static uint32_t CreateAlarmText(PTR_COMM_EVT_t commEvent, char text[], uint32_t textSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the alarm summary, cut to one SMS
+//
+//------------------------------------------------------------------------------
+static uint32_t CreateAlarmText(PTR_COMM_EVT_t commEvent, char text[], uint32_t textSize)
+{
+    static char const* const statusNames[] = {"", "LOW", "HIGH", "", "OR", "", "", "", "", "", "", "", "", "", "TWA", "STEL"};
+    char const *kind = "GAS";
+    uint32_t length = 0;
+    uint32_t loopCounter = 0;
+    SensorInfo_t const *sensor = NULL;
+
+    if(commEvent->InstrumentState == PANIC)
+    {
+        kind = "PANIC";
+    }
+    else if(commEvent->InstrumentState == MANDOWN)
+    {
+        kind = "MAN DOWN";
+    }
+    length = (uint32_t)snprintf(text, textSize, "ALARM %s %s %s %04u-%02u-%02u %02u:%02u:%02uZ", kind, RemoteUnit.SerialNumber, RemoteUnit.UserName,
+                                commEvent->dateTimeInfo.date.year, commEvent->dateTimeInfo.date.month, commEvent->dateTimeInfo.date.day,
+                                commEvent->dateTimeInfo.time.hours, commEvent->dateTimeInfo.time.minutes, commEvent->dateTimeInfo.time.seconds);
+
+    // Sensors in alarm only, as classified by GetEventPriority
+    for(loopCounter = 0; (loopCounter < commEvent->instSensorInfo.numberOfSensors) && (length < textSize); loopCounter++)
+    {
+        sensor = &commEvent->instSensorInfo.sensorArray[loopCounter];
+        if((sensor->SensorStatus < (sizeof(statusNames) / sizeof(statusNames[0]))) && (statusNames[sensor->SensorStatus][0] != 0))
+        {
+            length += (uint32_t)snprintf(&text[length], textSize - length, " G%04u %s ", sensor->SensorType, statusNames[sensor->SensorStatus]);
+            if(length < textSize)
+            {
+                length += FormatReading(&text[length], textSize - length, sensor);
+            }
+        }
+    }
+
+    if((commEvent->GPSLocationInfo.isGpsValid == true) && (length < textSize))
+    {
+        length += (uint32_t)snprintf(&text[length], textSize - length, " %s%ld.%06ld,%s%ld.%06ld",
+                                     (commEvent->GPSLocationInfo.latitude < 0) ? "-" : "",
+                                     labs((long)commEvent->GPSLocationInfo.latitude) / NMEA_MICRO_DEGREES_PER_DEGREE,
+                                     labs((long)commEvent->GPSLocationInfo.latitude) % NMEA_MICRO_DEGREES_PER_DEGREE,
+                                     (commEvent->GPSLocationInfo.longitude < 0) ? "-" : "",
+                                     labs((long)commEvent->GPSLocationInfo.longitude) / NMEA_MICRO_DEGREES_PER_DEGREE,
+                                     labs((long)commEvent->GPSLocationInfo.longitude) % NMEA_MICRO_DEGREES_PER_DEGREE);
+    }
+    if(length < textSize)
+    {
+        length += (uint32_t)snprintf(&text[length], textSize - length, " #%u", commEvent->sequenceNumber);
+    }
+
+    return (length < textSize) ? length : (textSize - 1u);
+}
+
+//------------------------------------------------------------------------------
+//  static uint32_t FormatReading(char buffer[], uint32_t bufferSize, SensorInfo_t const *sensor)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function print the sensor reading with its decimals and unit
+//
+//------------------------------------------------------------------------------
+static uint32_t FormatReading(char buffer[], uint32_t bufferSize, SensorInfo_t const *sensor)
+{
+    static char const* const unitNames[] = {"", "ppm", "%VOL", "%LEL"};
+    int16_t reading = (int16_t)(((uint16_t)(uint8_t)sensor->SensorReadingHigh << 8) | (uint8_t)sensor->SensorReadingLow);
+    uint32_t magnitude = (reading < 0) ? (uint32_t)(-reading) : (uint32_t)reading;
+    uint32_t scale = 1u;
+    uint32_t loopCounter = 0;
+    int32_t size = 0;
+
+    for(loopCounter = 0; (loopCounter < sensor->DecimalPlaces) && (loopCounter < 4u); loopCounter++)
+    {
+        scale *= 10u;
+    }
+    if(scale > 1u)
+    {
+        size = snprintf(buffer, bufferSize, "%s%u.%0*u", (reading < 0) ? "-" : "", magnitude / scale, (int)loopCounter, magnitude % scale);
+    }
+    else
+    {
+        size = snprintf(buffer, bufferSize, "%d", reading);
+    }
+    if((size >= 0) && ((uint32_t)size < bufferSize) && (sensor->SensorMeasuringUnits < (sizeof(unitNames) / sizeof(unitNames[0]))))
+    {
+        size += snprintf(&buffer[size], bufferSize - (uint32_t)size, "%s", unitNames[sensor->SensorMeasuringUnits]);
+    }
+
+    return (size > 0) ? (uint32_t)size : 0u;
+}
+
+//------------------------------------------------------------------------------
+//  static uint32_t PackSeptets(char const text[], uint32_t length, uint8_t octets[])
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function pack text in the GSM 7 bit default alphabet. Letters,
+//!  digits and most ASCII punctuation keep their code, other characters
+//!  are sent as '?'. Returns the octets written.
+//
+//------------------------------------------------------------------------------
+static uint32_t PackSeptets(char const text[], uint32_t length, uint8_t octets[])
+{
+    uint32_t index = 0;
+    uint32_t bit = 0;
+    uint8_t septet = 0;
+
+    memset(octets, 0, ((length * 7u) + 7u) / 8u);
+    for(index = 0; index < length; index++)
+    {
+        septet = (uint8_t)text[index];
+        if(!(((septet >= 0x20u) && (septet <= 0x5Au) && (septet != 0x24u) && (septet != 0x40u)) ||
+             ((septet >= 0x61u) && (septet <= 0x7Au))))
+        {
+            septet = (uint8_t)'?';
+        }
+        bit = index * 7u;
+        octets[bit / 8u] |= (uint8_t)(septet << (bit % 8u));
+        if((bit % 8u) > 1u)
+        {
+            octets[(bit / 8u) + 1u] |= (uint8_t)(septet >> (8u - (bit % 8u)));
+        }
+    }
+
+    return ((length * 7u) + 7u) / 8u;
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularSMSIsAlarmDue(PTR_COMM_EVT_t commEvent)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true for an alarm event older than the deadline
+//!  that was not sent by SMS yet
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularSMSIsAlarmDue(PTR_COMM_EVT_t commEvent)
+{
+    BOOLEAN isDue = false;
+    uint32_t index = 0;
+
+    if((commEvent->priority == EVENT_PRIORITY_ALARM) &&
+       (RTCDRV_TicksToMsec(GetRTCTicks() - commEvent->createdTicks) >= CELL_SMS_ALARM_DEADLINE_MS))
+    {
+        isDue = true;
+        for(index = 0; index < CELL_SMS_SENT_HISTORY; index++)
+        {
+            if((sentAlarms[index].createdTicks == commEvent->createdTicks) && (sentAlarms[index].sequenceNumber == commEvent->sequenceNumber))
+            {
+                isDue = false;
+            }
+        }
+    }
+
+    return isDue;
+}
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularSMSIsDeadlinePassed(uint32_t createdTicks)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when an alarm created at createdTicks is
+//!  older than the deadline and was not sent by SMS yet
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularSMSIsDeadlinePassed(uint32_t createdTicks)
+{
+    BOOLEAN isPassed = false;
+    uint32_t index = 0;
+
+    if(RTCDRV_TicksToMsec(GetRTCTicks() - createdTicks) >= CELL_SMS_ALARM_DEADLINE_MS)
+    {
+        isPassed = true;
+        for(index = 0; index < CELL_SMS_SENT_HISTORY; index++)
+        {
+            if(sentAlarms[index].createdTicks == createdTicks)
+            {
+                isPassed = false;
+            }
+        }
+    }
+
+    return isPassed;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularSMSCreatePDU(PTR_COMM_EVT_t commEvent, uint8_t const number[], uint8_t cmdBuffer[], uint32_t cmdBufferSize, uint8_t pduBuffer[], uint32_t pduBufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the AT+CMGS command and the SMS-SUBMIT PDU in hex,
+//!  ended by Ctrl-Z, summarizing the alarm for the number given
+//!
+//! \return PDU text length, ERR_CELL_SMS_NO_RECIPIENT when the number holds
+//!  no digit or ERR_CELL_SMS_BUFFER_TOO_SMALL
+//
+//------------------------------------------------------------------------------
+int32_t CellularSMSCreatePDU(PTR_COMM_EVT_t commEvent, uint8_t const number[], uint8_t cmdBuffer[], uint32_t cmdBufferSize, uint8_t pduBuffer[], uint32_t pduBufferSize)
+{
+    int32_t ret = 0;
+    char text[CELL_SMS_MAX_TEXT_LENGTH + 1u];
+    char digits[CELL_SMS_MAX_NUMBER_DIGITS + 1u];
+    uint8_t pdu[CELL_SMS_MAX_PDU_OCTETS];
+    uint32_t numberOfDigits = 0, textLength = 0, size = 0, index = 0;
+
+    // Number may hold separators, a leading '+' makes it international
+    for(index = 0; (index < PHONE_NUMBER_LEN) && (number[index] != 0) && (numberOfDigits < CELL_SMS_MAX_NUMBER_DIGITS); index++)
+    {
+        if((number[index] >= '0') && (number[index] <= '9'))
+        {
+            digits[numberOfDigits++] = (char)number[index];
+        }
+    }
+    if(numberOfDigits == 0u)
+    {
+        ret = ERR_CELL_SMS_NO_RECIPIENT;
+    }
+    else if((cmdBufferSize < CELL_SMS_COMMAND_BUFFER_SIZE) || (pduBufferSize < CELL_SMS_PDU_BUFFER_SIZE))
+    {
+        ret = ERR_CELL_SMS_BUFFER_TOO_SMALL;
+    }
+    else
+    {
+        textLength = CreateAlarmText(commEvent, text, sizeof(text));
+
+        pdu[size++] = 0x00u;                        // SMSC from the SIM
+        pdu[size++] = CELL_SMS_SUBMIT_FIRST_OCTET;
+        pdu[size++] = 0x00u;                        // TP-MR set by the module
+        pdu[size++] = (uint8_t)numberOfDigits;
+        pdu[size++] = (number[0] == '+') ? CELL_SMS_TYPE_INTERNATIONAL : CELL_SMS_TYPE_UNKNOWN;
+        for(index = 0; index < numberOfDigits; index += 2u)
+        {
+            // Semi-octets swapped, odd count padded with F
+            pdu[size++] = (uint8_t)((digits[index] - '0') | ((((index + 1u) < numberOfDigits) ? (uint8_t)(digits[index + 1u] - '0') : 0x0Fu) << 4));
+        }
+        pdu[size++] = 0x00u;                        // TP-PID
+        pdu[size++] = 0x00u;                        // TP-DCS, GSM 7 bit
+        pdu[size++] = CELL_SMS_VALIDITY_PERIOD;
+        pdu[size++] = (uint8_t)textLength;          // TP-UDL in septets
+        size += PackSeptets(text, textLength, &pdu[size]);
+
+        // AT+CMGS takes the TPDU length, the SMSC part excluded
+        (void)snprintf((char *)cmdBuffer, cmdBufferSize, "AT+CMGS=%u\r", size - 1u);
+        for(index = 0; index < size; index++)
+        {
+            (void)snprintf((char *)&pduBuffer[2u * index], 3u, "%02X", pdu[index]);
+        }
+        pduBuffer[2u * size] = CELL_SMS_CTRL_Z;
+        pduBuffer[(2u * size) + 1u] = 0;
+        ret = (int32_t)((2u * size) + 1u);
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularSMSRecordAlarm(PTR_COMM_EVT_t commEvent, uint32_t messagesSent)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function count the messages sent for an alarm due, once one went
+//!  out the alarm is not due anymore
+//
+//------------------------------------------------------------------------------
+void CellularSMSRecordAlarm(PTR_COMM_EVT_t commEvent, uint32_t messagesSent)
+{
+    if(messagesSent > 0u)
+    {
+        smsStats.alarmsSent++;
+        smsStats.messagesSent += messagesSent;
+        smsStats.lastAlarmAgeMs = RTCDRV_TicksToMsec(GetRTCTicks() - commEvent->createdTicks);
+        sentAlarms[sentAlarmIndex].createdTicks = commEvent->createdTicks;
+        sentAlarms[sentAlarmIndex].sequenceNumber = commEvent->sequenceNumber;
+        sentAlarmIndex = (sentAlarmIndex + 1u) % CELL_SMS_SENT_HISTORY;
+    }
+    else
+    {
+        smsStats.alarmsFailed++;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  CellularSMSStats_t const* CellularSMSGetStats(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the SMS fallback counts
+//
+//------------------------------------------------------------------------------
+CellularSMSStats_t const* CellularSMSGetStats(void)
+{
+    return &smsStats;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,354 @@
+//==============================================================================
+//
+//  CellularTLS.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularTLS.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the TLS handshake statistics. The module runs TLS and
+//! reports neither the handshake kind nor its bytes, so a connect is counted
+//! as resumable when resumption is on and the previous connect since the
+//! module reset succeeded, else as full. The time of AT+USOCO includes the
+//! TCP connect, same for both kinds.
+//!
+//! The profile offers a single cipher suite, the cheapest one the server
+//! takes. A suite the firmware rejects or the server keeps failing is
+//! replaced by the next in tlsSuites, the last leaves the choice to the module.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "CellularTLS.h"
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define CELL_TLS_EWMA_SHIFT             2u
+
+typedef struct
+{
+    uint16_t ianaId;                //!< 0 for the module default list
+    ATCOMMAND_INDEX_ENUM command;
+}TLSSuite_t;
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+// Cheapest first. ECDSA needs an ECDSA server certificate while the GoDaddy
+// root of iNet implies an RSA chain, so ECDHE-RSA with AES-GCM comes next.
+static TLSSuite_t const tlsSuites[CELL_TLS_SUITE_COUNT] =
+{
+    {0xC02Bu, ATC_USECPRF_ECDSA_AES128},
+    {0xC02Fu, ATC_USECPRF_RSA_AES128},
+    {0x0000u, ATC_USECPRF_3},
+};
+
+static CellularTLSStats_t tlsStats;
+static BOOLEAN isSessionCached = false;
+static BOOLEAN isSuitePending = true;
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void AddHandshakeSample(CellularTLSHandshakeStats_t *stats, BOOLEAN isConnected, uint32_t connectMs);
+static void SelectNextSuite(void);
+static uint32_t PutHandshakeStats(uint8_t buffer[], CellularTLSHandshakeStats_t const *stats);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static void AddHandshakeSample(CellularTLSHandshakeStats_t *stats, BOOLEAN isConnected, uint32_t connectMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function add a connect to the statistics of its kind
+//
+//------------------------------------------------------------------------------
+static void AddHandshakeSample(CellularTLSHandshakeStats_t *stats, BOOLEAN isConnected, uint32_t connectMs)
+{
+    stats->attempts++;
+    stats->lastMs = connectMs;
+    if(isConnected == false)
+    {
+        stats->failures++;
+    }
+    else if((stats->attempts - stats->failures) == 1u)
+    {
+        stats->averageMs = connectMs;
+    }
+    else if(connectMs >= stats->averageMs)
+    {
+        stats->averageMs += ((connectMs - stats->averageMs) >> CELL_TLS_EWMA_SHIFT);
+    }
+    else
+    {
+        stats->averageMs -= ((stats->averageMs - connectMs) >> CELL_TLS_EWMA_SHIFT);
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void SelectNextSuite(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function move to the next suite of the preference list, the last
+//!  one is kept
+//
+//------------------------------------------------------------------------------
+static void SelectNextSuite(void)
+{
+    if((tlsStats.suite + 1u) < CELL_TLS_SUITE_COUNT)
+    {
+        tlsStats.suite++;
+        isSuitePending = true;
+        // The session was negotiated with another suite
+        isSessionCached = false;
+    }
+    tlsStats.suiteFailures = 0;
+}
+
+//------------------------------------------------------------------------------
+//  static uint32_t PutHandshakeStats(uint8_t buffer[], CellularTLSHandshakeStats_t const *stats)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write attempts, failures, average and last time as
+//!  saturated big endian 16 bit fields
+//!
+//! \return bytes written
+//
+//------------------------------------------------------------------------------
+static uint32_t PutHandshakeStats(uint8_t buffer[], CellularTLSHandshakeStats_t const *stats)
+{
+    uint32_t field[4] = {0};
+    uint32_t i = 0;
+
+    field[0] = stats->attempts;
+    field[1] = stats->failures;
+    field[2] = stats->averageMs;
+    field[3] = stats->lastMs;
+    for(i = 0; i < 4u; i++)
+    {
+        field[i] = FIND_MIN(field[i], UINT16_MAX);
+        buffer[2u * i] = (uint8_t)((field[i] >> 8) & 0xFFu);
+        buffer[(2u * i) + 1u] = (uint8_t)(field[i] & 0xFFu);
+    }
+
+    return 8u;
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  void CellularTLSReset(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function forget the session and the profile options, the module
+//!  was reset and loses both
+//
+//------------------------------------------------------------------------------
+void CellularTLSReset(void)
+{
+    isSessionCached = false;
+    isSuitePending = true;
+    tlsStats.isResumptionEnabled = false;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularTLSSetResumption(BOOLEAN isEnabled)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record whether the security profile took session
+//!  resumption, firmware without it rejects the option
+//
+//------------------------------------------------------------------------------
+void CellularTLSSetResumption(BOOLEAN isEnabled)
+{
+    tlsStats.isResumptionEnabled = isEnabled;
+}
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularTLSIsSuitePending(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when the security profile does not hold the
+//!  cipher suite to offer yet
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularTLSIsSuitePending(void)
+{
+    return isSuitePending;
+}
+
+//------------------------------------------------------------------------------
+//  ATCOMMAND_INDEX_ENUM CellularTLSGetSuiteCommand(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the AT+USECPRF op code 2 command of the suite to
+//!  offer
+//
+//------------------------------------------------------------------------------
+ATCOMMAND_INDEX_ENUM CellularTLSGetSuiteCommand(void)
+{
+    return tlsSuites[tlsStats.suite].command;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularTLSSetSuiteApplied(BOOLEAN isAccepted)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record the result of the suite command, a rejected suite
+//!  is skipped and the next one becomes pending
+//
+//------------------------------------------------------------------------------
+void CellularTLSSetSuiteApplied(BOOLEAN isAccepted)
+{
+    isSuitePending = false;
+    if(isAccepted == false)
+    {
+        SelectNextSuite();
+    }
+}
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularTLSIsResumable(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when the next connect can resume the session
+//!  of the last successful one
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularTLSIsResumable(void)
+{
+    return ((tlsStats.isResumptionEnabled == true) && (isSessionCached == true));
+}
+
+//------------------------------------------------------------------------------
+//  void CellularTLSRecordHandshake(BOOLEAN isResumable, BOOLEAN isConnected, uint32_t connectMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record a secure socket connect, isResumable as returned by
+//!  CellularTLSIsResumable before it. A suite failing
+//!  CELL_TLS_SUITE_MAX_FAILURES full handshakes in a row is left for the next.
+//
+//------------------------------------------------------------------------------
+void CellularTLSRecordHandshake(BOOLEAN isResumable, BOOLEAN isConnected, uint32_t connectMs)
+{
+    AddHandshakeSample((isResumable == true) ? &tlsStats.resumable : &tlsStats.full, isConnected, connectMs);
+    // A failed connect may have been refused by the server for the session
+    isSessionCached = isConnected;
+    if(isResumable == false)
+    {
+        AddHandshakeSample(&tlsStats.suites[tlsStats.suite], isConnected, connectMs);
+        if(isConnected == true)
+        {
+            tlsStats.suiteFailures = 0;
+        }
+        else if(++tlsStats.suiteFailures >= CELL_TLS_SUITE_MAX_FAILURES)
+        {
+            SelectNextSuite();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  CellularTLSStats_t const* CellularTLSGetStats(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the handshake statistics
+//
+//------------------------------------------------------------------------------
+CellularTLSStats_t const* CellularTLSGetStats(void)
+{
+    return &tlsStats;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularTLSGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the profile options, the suite offered and the
+//!  full, resumable and per suite handshake statistics for the radio
+//!  configuration readout, big endian
+//!
+//! \return bytes written or ERR_CELL_TLS_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularTLSGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+{
+    int32_t ret = ERR_CELL_TLS_NOT_AVAILABLE;
+    uint32_t index = 0;
+    uint32_t suite = 0;
+
+    if(bufferSize >= CELL_TLS_DIAGNOSTIC_SIZE)
+    {
+        buffer[index++] = (tlsStats.isResumptionEnabled == true) ? 1u : 0u;
+        buffer[index++] = (uint8_t)((tlsSuites[tlsStats.suite].ianaId >> 8) & 0xFFu);
+        buffer[index++] = (uint8_t)(tlsSuites[tlsStats.suite].ianaId & 0xFFu);
+        index += PutHandshakeStats(&buffer[index], &tlsStats.full);
+        index += PutHandshakeStats(&buffer[index], &tlsStats.resumable);
+        for(suite = 0; suite < CELL_TLS_SUITE_COUNT; suite++)
+        {
+            index += PutHandshakeStats(&buffer[index], &tlsStats.suites[suite]);
+        }
+        ret = (int32_t)index;
+    }
+
+    return ret;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
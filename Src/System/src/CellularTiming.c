@@ -0,0 +1,375 @@
+//==============================================================================
+//
+//  CellularPrewarm.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularPrewarm.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the upload phase timing. PostDataToiNet and the AT
+//! layer mark the end of each phase with GetRTCTicks, the transaction turns
+//! the marks into phase times when it closes. Nearest rank percentiles are
+//! taken over the last CELL_TIMING_HISTORY completed transactions, so the
+//! phase a slow upload lost its time in shows without a UART capture.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "CellularTiming.h"
+
+#include <string.h>
+
+#include "Timer.h"
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define CELL_TIMING_TOTAL               CELL_TIMING_PHASE_COUNT     //!< History column of the whole transaction
+#define CELL_TIMING_NOT_MARKED          UINT32_MAX                  //!< History entry of a phase the transaction skipped
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static CellularTimingTransaction_t openTransaction;
+static CellularTimingTransaction_t lastTransaction;
+static CellularTimingStats_t timingStats;
+static BOOLEAN isOpen = false;
+static uint32_t markedPhases = 0;          // Bit per CELL_TIMING_PHASE_t marked in the open transaction
+
+// Phase times of the completed transactions, oldest overwritten. A skipped
+// phase, e.g. registration with the radio attached already, is no sample.
+static uint32_t history[CELL_TIMING_HISTORY][CELL_TIMING_PHASE_COUNT + 1u];
+static uint32_t historyIndex = 0;
+static uint32_t historyCount = 0;
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void UpdatePercentiles(void);
+static void PutBigEndian16(uint8_t data[], uint32_t value);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static void UpdatePercentiles(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function take p50, p90 and max of each history column, nearest rank,
+//!  over the transactions that went through the phase
+//
+//------------------------------------------------------------------------------
+static void UpdatePercentiles(void)
+{
+    uint32_t sorted[CELL_TIMING_HISTORY];
+    uint32_t column = 0, index = 0, position = 0, value = 0;
+    uint32_t samples = 0, p50 = 0, p90 = 0, max = 0;
+    
+    for(column = 0; column <= (uint32_t)CELL_TIMING_TOTAL; column++)
+    {
+        // Insertion sort, the history is a handful of samples
+        samples = 0;
+        for(index = 0; index < historyCount; index++)
+        {
+            value = history[index][column];
+            if(value != CELL_TIMING_NOT_MARKED)
+            {
+                for(position = samples; (position > 0u) && (sorted[position - 1u] > value); position--)
+                {
+                    sorted[position] = sorted[position - 1u];
+                }
+                sorted[position] = value;
+                samples++;
+            }
+        }
+        p50 = 0;
+        p90 = 0;
+        max = 0;
+        if(samples > 0u)
+        {
+            p50 = sorted[((samples * 50u) + 99u) / 100u - 1u];
+            p90 = sorted[((samples * 90u) + 99u) / 100u - 1u];
+            max = sorted[samples - 1u];
+        }
+        if(column == (uint32_t)CELL_TIMING_TOTAL)
+        {
+            timingStats.totalP50Ms = p50;
+            timingStats.totalP90Ms = p90;
+        }
+        else
+        {
+            timingStats.samples[column] = samples;
+            timingStats.p50Ms[column] = p50;
+            timingStats.p90Ms[column] = p90;
+            timingStats.maxMs[column] = max;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void PutBigEndian16(uint8_t data[], uint32_t value)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write a 16 bit field of the SPI readout, saturating
+//
+//------------------------------------------------------------------------------
+static void PutBigEndian16(uint8_t data[], uint32_t value)
+{
+    value = FIND_MIN(value, UINT16_MAX);
+    data[0] = (uint8_t)((value >> 8) & 0xFFu);
+    data[1] = (uint8_t)(value & 0xFFu);
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  void CellularTimingBegin(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function start a transaction. One open already, the attach of the
+//!  batch, is continued by its first request.
+//
+//------------------------------------------------------------------------------
+void CellularTimingBegin(void)
+{
+    if(isOpen == false)
+    {
+        memset(&openTransaction, 0, sizeof(openTransaction));
+        openTransaction.startTicks = GetRTCTicks();
+        markedPhases = 0;
+        isOpen = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  void CellularTimingMark(CELL_TIMING_PHASE_t phase)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function record the end of a phase. Marks of the later phases are
+//!  cleared, a request on another socket in between starts them over.
+//
+//------------------------------------------------------------------------------
+void CellularTimingMark(CELL_TIMING_PHASE_t phase)
+{
+    // Warm ups and GNSS work outside an upload are not timed
+    if((isOpen == true) && (phase < CELL_TIMING_PHASE_COUNT))
+    {
+        openTransaction.markTicks[phase] = GetRTCTicks();
+        markedPhases &= ((1u << (uint32_t)phase) - 1u);
+        markedPhases |= (1u << (uint32_t)phase);
+    }
+}
+
+//------------------------------------------------------------------------------
+//  BOOLEAN CellularTimingIsMarked(CELL_TIMING_PHASE_t phase)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when the phase ended in the open transaction
+//
+//------------------------------------------------------------------------------
+BOOLEAN CellularTimingIsMarked(CELL_TIMING_PHASE_t phase)
+{
+    return (BOOLEAN)((isOpen == true) && ((markedPhases & (1u << (uint32_t)phase)) != 0u));
+}
+
+//------------------------------------------------------------------------------
+//  void CellularTimingEnd(COMM_EVT_TYPE_t evtType, BOOLEAN isSuccess)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function close the transaction and turn its marks into phase times.
+//!  A completed one is added to the history and the percentiles updated.
+//
+//------------------------------------------------------------------------------
+void CellularTimingEnd(COMM_EVT_TYPE_t evtType, BOOLEAN isSuccess)
+{
+    uint32_t phase = 0;
+    uint32_t previousTicks = openTransaction.startTicks;
+    
+    if(isOpen == true)
+    {
+        isOpen = false;
+        openTransaction.evtType = evtType;
+        for(phase = 0; phase < (uint32_t)CELL_TIMING_PHASE_COUNT; phase++)
+        {
+            if((markedPhases & (1u << phase)) != 0u)
+            {
+                openTransaction.phaseMs[phase] = RTCDRV_TicksToMsec(openTransaction.markTicks[phase] - previousTicks);
+                previousTicks = openTransaction.markTicks[phase];
+            }
+        }
+        openTransaction.totalMs = RTCDRV_TicksToMsec(previousTicks - openTransaction.startTicks);
+        openTransaction.isCompleted = (BOOLEAN)((isSuccess == true) &&
+                                                ((markedPhases & (1u << (uint32_t)CELL_TIMING_LAST_RESPONSE)) != 0u));
+        memcpy(&lastTransaction, &openTransaction, sizeof(lastTransaction));
+        
+        if(openTransaction.isCompleted == true)
+        {
+            timingStats.transactions++;
+            for(phase = 0; phase < (uint32_t)CELL_TIMING_PHASE_COUNT; phase++)
+            {
+                history[historyIndex][phase] = ((markedPhases & (1u << phase)) != 0u) ?
+                                                openTransaction.phaseMs[phase] : CELL_TIMING_NOT_MARKED;
+            }
+            history[historyIndex][CELL_TIMING_TOTAL] = openTransaction.totalMs;
+            historyIndex = (historyIndex + 1u) % CELL_TIMING_HISTORY;
+            if(historyCount < CELL_TIMING_HISTORY)
+            {
+                historyCount++;
+            }
+            UpdatePercentiles();
+        }
+        else
+        {
+            timingStats.failures++;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  void CellularTimingCancel(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function drop the open transaction, a batch that sent nothing
+//
+//------------------------------------------------------------------------------
+void CellularTimingCancel(void)
+{
+    isOpen = false;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularTimingGetLastDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the transaction closed last for the radio
+//!  configuration readout: event type, completed flag, then big endian 16 bit
+//!  ms of each phase and of the whole transaction, saturating
+//!
+//! \return CELL_TIMING_LAST_DIAGNOSTIC_SIZE or ERR_CELL_TIMING_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularTimingGetLastDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+{
+    int32_t ret = ERR_CELL_TIMING_NOT_AVAILABLE;
+    uint32_t index = 2u, phase = 0;
+    
+    if(bufferSize >= CELL_TIMING_LAST_DIAGNOSTIC_SIZE)
+    {
+        buffer[0] = (uint8_t)lastTransaction.evtType;
+        buffer[1] = (uint8_t)lastTransaction.isCompleted;
+        for(phase = 0; phase < (uint32_t)CELL_TIMING_PHASE_COUNT; phase++)
+        {
+            PutBigEndian16(&buffer[index], lastTransaction.phaseMs[phase]);
+            index += 2u;
+        }
+        PutBigEndian16(&buffer[index], lastTransaction.totalMs);
+        ret = CELL_TIMING_LAST_DIAGNOSTIC_SIZE;
+    }
+    
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  CellularTimingStats_t const* CellularTimingGetStats(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the phase percentiles over the history, each taken
+//!  over the transactions that went through the phase
+//
+//------------------------------------------------------------------------------
+CellularTimingStats_t const* CellularTimingGetStats(void)
+{
+    return &timingStats;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularTimingGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the timing record for the radio configuration
+//!  readout: completed and failed transactions, then of each phase the number
+//!  of transactions that went through it in one byte with p50, p90 and max in
+//!  ms, then p50 and p90 of the whole transaction. Times and counts are big
+//!  endian 16 bit, saturating.
+//!
+//! \return CELL_TIMING_DIAGNOSTIC_SIZE or ERR_CELL_TIMING_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularTimingGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+{
+    int32_t ret = ERR_CELL_TIMING_NOT_AVAILABLE;
+    uint32_t index = 4u, phase = 0;
+    
+    if(bufferSize >= CELL_TIMING_DIAGNOSTIC_SIZE)
+    {
+        PutBigEndian16(&buffer[0], timingStats.transactions);
+        PutBigEndian16(&buffer[2], timingStats.failures);
+        for(phase = 0; phase < (uint32_t)CELL_TIMING_PHASE_COUNT; phase++)
+        {
+            buffer[index] = (uint8_t)timingStats.samples[phase];
+            PutBigEndian16(&buffer[index + 1u], timingStats.p50Ms[phase]);
+            PutBigEndian16(&buffer[index + 3u], timingStats.p90Ms[phase]);
+            PutBigEndian16(&buffer[index + 5u], timingStats.maxMs[phase]);
+            index += 7u;
+        }
+        PutBigEndian16(&buffer[index], timingStats.totalP50Ms);
+        PutBigEndian16(&buffer[index + 2u], timingStats.totalP90Ms);
+        ret = CELL_TIMING_DIAGNOSTIC_SIZE;
+    }
+    
+    return ret;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
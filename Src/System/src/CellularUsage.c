@@ -0,0 +1,369 @@
+//==============================================================================
+//
+//  CellularUsage.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        CellularUsage.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the cellular byte accounting. Bytes written to and read
+//! from the UART are charged to the event type being uploaded and to what
+//! they carried: AT control, the HTTP header, the body or the response. AT
+//! control stays on the UART, the rest goes over the air. The TLS handshake
+//! runs in the module, its bytes are read with +USOCTL right after the
+//! connect. The socket is released as the direct link exits, so TLS record
+//! overhead after the handshake is not counted.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "CellularUsage.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Cellular.h"
+#include "Timer.h"
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define USOCTL_PARAM_BYTES_SENT         2u
+#define USOCTL_PARAM_BYTES_RECEIVED     3u
+#define UINT24_MAX                      0xFFFFFFu
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static CellularUsageStats_t usageStats;
+static COMM_EVT_TYPE_t currentEvent = CELL_USAGE_NO_EVENT;
+static uint32_t radioOnTicks = 0;
+static uint32_t linkTicks = 0;
+static BOOLEAN isRadioOn = false;
+static BOOLEAN isLinkOpen = false;
+
+// Socket totals parsed since the last connect was recorded
+static uint32_t socketBytesSent = 0;
+static uint32_t socketBytesReceived = 0;
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void PutBigEndian16(uint8_t data[], uint32_t value);
+static void PutBigEndian24(uint8_t data[], uint32_t value);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static void PutBigEndian16(uint8_t data[], uint32_t value)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write a 16 bit field of the SPI readout, saturating
+//
+//------------------------------------------------------------------------------
+static void PutBigEndian16(uint8_t data[], uint32_t value)
+{
+    value = FIND_MIN(value, UINT16_MAX);
+    data[0] = (uint8_t)((value >> 8) & 0xFFu);
+    data[1] = (uint8_t)(value & 0xFFu);
+}
+
+//------------------------------------------------------------------------------
+//  static void PutBigEndian24(uint8_t data[], uint32_t value)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write a 24 bit field of the SPI readout, saturating
+//
+//------------------------------------------------------------------------------
+static void PutBigEndian24(uint8_t data[], uint32_t value)
+{
+    value = FIND_MIN(value, UINT24_MAX);
+    data[0] = (uint8_t)((value >> 16) & 0xFFu);
+    data[1] = (uint8_t)((value >> 8) & 0xFFu);
+    data[2] = (uint8_t)(value & 0xFFu);
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  COMM_EVT_TYPE_t CellularUsageSetEvent(COMM_EVT_TYPE_t evtType)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function charge the bytes from now on to the event type given,
+//!  CELL_USAGE_NO_EVENT outside an upload
+//!
+//! \return event type charged before, to be set back
+//
+//------------------------------------------------------------------------------
+COMM_EVT_TYPE_t CellularUsageSetEvent(COMM_EVT_TYPE_t evtType)
+{
+    COMM_EVT_TYPE_t previousEvent = currentEvent;
+    
+    currentEvent = (evtType < CELL_USAGE_NO_EVENT) ? evtType : CELL_USAGE_NO_EVENT;
+    return previousEvent;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularUsageRecordSent(ATCOMMAND_INDEX_ENUM atIndex, uint32_t count)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function count bytes written to the UART. The header and the body
+//!  go to the socket in direct link, anything else is AT control.
+//
+//------------------------------------------------------------------------------
+void CellularUsageRecordSent(ATCOMMAND_INDEX_ENUM atIndex, uint32_t count)
+{
+    CellularUsageCounters_t *counters = &usageStats.slots[currentEvent];
+    uint32_t currentTicks = GetRTCTicks();
+    
+    switch(atIndex)
+    {
+    case ATC_WRITEHEADER:
+        counters->bytes[CELL_USAGE_HEADER_SENT] += count;
+        break;
+        
+    case ATC_USOWR:
+        counters->bytes[CELL_USAGE_PAYLOAD_SENT] += count;
+        break;
+        
+    default:
+        counters->bytes[CELL_USAGE_AT_SENT] += count;
+        break;
+    }
+    
+    // Airtime bounds, the command is written once whatever its size
+    switch(atIndex)
+    {
+    case ATC_CFUN_1:
+        if(isRadioOn == false)
+        {
+            radioOnTicks = currentTicks;
+            isRadioOn = true;
+        }
+        break;
+        
+    case ATC_CFUN_0:
+        if(isRadioOn == true)
+        {
+            usageStats.radioOnMs += RTCDRV_TicksToMsec(currentTicks - radioOnTicks);
+            isRadioOn = false;
+        }
+        break;
+        
+    case AT_USODL:
+        linkTicks = currentTicks;
+        isLinkOpen = true;
+        break;
+        
+    case ATC_USODL_CLOSE:
+        if(isLinkOpen == true)
+        {
+            counters->linkMs += RTCDRV_TicksToMsec(currentTicks - linkTicks);
+            isLinkOpen = false;
+        }
+        break;
+        
+    default:
+        break;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  void CellularUsageRecordReceived(ATCOMMAND_INDEX_ENUM atIndex, uint32_t count)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function count bytes read from the UART, the HTTP response while
+//!  the header or the body is written in direct link
+//
+//------------------------------------------------------------------------------
+void CellularUsageRecordReceived(ATCOMMAND_INDEX_ENUM atIndex, uint32_t count)
+{
+    CellularUsageCounters_t *counters = &usageStats.slots[currentEvent];
+    
+    if((atIndex == ATC_WRITEHEADER) || (atIndex == ATC_USOWR))
+    {
+        counters->bytes[CELL_USAGE_RESPONSE_RECEIVED] += count;
+    }
+    else
+    {
+        counters->bytes[CELL_USAGE_AT_RECEIVED] += count;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularUsageParseSocketCounter(uint8_t const response[], uint32_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse +USOCTL: <socket>,<param_id>,<param_val> for the
+//!  total bytes sent (2) or received (3)
+//!
+//! \return 0, ERR_INCOMPLETE_DATA_RECEIVED until OK or
+//!         ERR_CELL_USAGE_PARSE_FAILED
+//
+//------------------------------------------------------------------------------
+int32_t CellularUsageParseSocketCounter(uint8_t const response[], uint32_t length)
+{
+    int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
+    char const *text = strstr((char const *)response, "+USOCTL:");
+    unsigned int socket = 0, param = 0;
+    unsigned long value = 0;
+    
+    (void)length;
+    if((text != NULL) && (strstr(text, "OK") != NULL))
+    {
+        ret = ERR_CELL_USAGE_PARSE_FAILED;
+        if(sscanf(text, "+USOCTL: %u,%u,%lu", &socket, &param, &value) == 3)
+        {
+            if(param == USOCTL_PARAM_BYTES_SENT)
+            {
+                socketBytesSent = (uint32_t)value;
+                ret = 0;
+            }
+            else if(param == USOCTL_PARAM_BYTES_RECEIVED)
+            {
+                socketBytesReceived = (uint32_t)value;
+                ret = 0;
+            }
+        }
+    }
+    
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  void CellularUsageRecordHandshake(BOOLEAN isResumable)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function count a connect and its handshake, the socket bytes parsed
+//!  since the previous connect. Module firmware counting the application
+//!  bytes only reports none, the TLSBench figures of the kind are taken then.
+//
+//------------------------------------------------------------------------------
+void CellularUsageRecordHandshake(BOOLEAN isResumable)
+{
+    CellularUsageCounters_t *counters = &usageStats.slots[currentEvent];
+    
+    if((socketBytesSent == 0u) && (socketBytesReceived == 0u))
+    {
+        counters->estimatedHandshakes++;
+        socketBytesSent = (isResumable == true) ? CELL_USAGE_TLS_RESUMED_SENT : CELL_USAGE_TLS_FULL_SENT;
+        socketBytesReceived = (isResumable == true) ? CELL_USAGE_TLS_RESUMED_RECEIVED : CELL_USAGE_TLS_FULL_RECEIVED;
+    }
+    counters->connects++;
+    counters->bytes[CELL_USAGE_TLS_SENT] += socketBytesSent;
+    counters->bytes[CELL_USAGE_TLS_RECEIVED] += socketBytesReceived;
+    socketBytesSent = 0;
+    socketBytesReceived = 0;
+}
+
+//------------------------------------------------------------------------------
+//  CellularUsageStats_t const* CellularUsageGetStats(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the byte counts per event type and category
+//
+//------------------------------------------------------------------------------
+CellularUsageStats_t const* CellularUsageGetStats(void)
+{
+    return &usageStats;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t CellularUsageGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the compact usage record for the radio configuration
+//!  readout, big endian: 24 bit byte counts per category of the token,
+//!  register and upload events, AT control bytes outside events, connects
+//!  per event type and the radio on time in seconds
+//!
+//! \return CELL_USAGE_DIAGNOSTIC_SIZE or ERR_CELL_USAGE_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t CellularUsageGetDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+{
+    int32_t ret = ERR_CELL_USAGE_NOT_AVAILABLE;
+    uint32_t index = 0, slot = 0, category = 0;
+    uint32_t radioOnSeconds = usageStats.radioOnMs / 1000u;
+    
+    if(bufferSize >= CELL_USAGE_DIAGNOSTIC_SIZE)
+    {
+        for(slot = 0; slot < (uint32_t)CELL_USAGE_NO_EVENT; slot++)
+        {
+            for(category = 0; category < (uint32_t)CELL_USAGE_CATEGORY_COUNT; category++)
+            {
+                PutBigEndian24(&buffer[index], usageStats.slots[slot].bytes[category]);
+                index += 3u;
+            }
+        }
+        PutBigEndian24(&buffer[index], usageStats.slots[CELL_USAGE_NO_EVENT].bytes[CELL_USAGE_AT_SENT]);
+        index += 3u;
+        PutBigEndian24(&buffer[index], usageStats.slots[CELL_USAGE_NO_EVENT].bytes[CELL_USAGE_AT_RECEIVED]);
+        index += 3u;
+        for(slot = 0; slot < (uint32_t)CELL_USAGE_NO_EVENT; slot++)
+        {
+            PutBigEndian16(&buffer[index], usageStats.slots[slot].connects);
+            index += 2u;
+        }
+        buffer[index++] = (uint8_t)((radioOnSeconds >> 24) & 0xFFu);
+        buffer[index++] = (uint8_t)((radioOnSeconds >> 16) & 0xFFu);
+        buffer[index++] = (uint8_t)((radioOnSeconds >> 8) & 0xFFu);
+        buffer[index++] = (uint8_t)(radioOnSeconds & 0xFFu);
+        ret = CELL_USAGE_DIAGNOSTIC_SIZE;
+    }
+    
+    return ret;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -39,9 +39,12 @@
 //==============================================================================
 //  INCLUDES
 //==============================================================================
+#include <string.h>
 #include "Event.h"
 #include  <common/include/rtos_utils.h>
 #include "main.h"
+#include "Timer.h"
+#include "GeofenceMonitor.h"
 //==============================================================================
 //  CONSTANTS, TYPEDEFS AND MACROS 
 //==============================================================================
@@ -49,10 +52,21 @@
 //==============================================================================
 //  LOCAL DATA DECLARATIONS
 //==============================================================================
+static EventLatencyStats_t eventLatencyStats[EVENT_PRIORITY_LAST];
+
+// Periodic Event posted to queue but not yet picked by cellular Task
+static ComEvent_t *pendingPeriodicEvent = NULL;
+
+// Last instrument snapshot acknowledged by iNet
+static InstSensorInfo_t deliveredSensorInfo;
+static uint32_t deliveredTime = 0;
+static BOOLEAN isDeliveredSnapshotValid = false;
 
 //==============================================================================
 //  LOCAL FUNCTION PROTOTYPES
 //==============================================================================
+static void UpdateDeliveredSnapshot(ComEvent_t const* msg);
+static void PutBigEndian32(uint8_t data[], uint32_t value);
 
 //==============================================================================
 //  GLOBAL DATA DECLARATIONS
@@ -65,6 +79,59 @@ InstInfo_t InstrumentInfo;
 //  LOCAL FUNCTIONS IMPLEMENTATION
 //==============================================================================
 
+//------------------------------------------------------------------------------
+//  static void UpdateDeliveredSnapshot(ComEvent_t const* msg)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function merge the sensors of a sent Event into the delivered snapshot
+//
+//------------------------------------------------------------------------------
+static void UpdateDeliveredSnapshot(ComEvent_t const* msg)
+{
+    uint8_t loopCounter = 0;
+    CPU_SR_ALLOC();
+    
+    // Snapshot is compared from the SPI interrupt, it never sees it half updated
+    CPU_CRITICAL_ENTER();
+    if((isDeliveredSnapshotValid == false) || (msg->changedSensorsMask == ALL_SENSORS_CHANGED_MASK))
+    {
+        memcpy(&deliveredSensorInfo, &msg->instSensorInfo, sizeof(InstSensorInfo_t));
+    }
+    else
+    {
+        deliveredSensorInfo.numberOfSensors = msg->instSensorInfo.numberOfSensors;
+        for(loopCounter = 0; loopCounter < msg->instSensorInfo.numberOfSensors; loopCounter++)
+        {
+            if(CHECKBIT(msg->changedSensorsMask, loopCounter) != 0)
+            {
+                deliveredSensorInfo.sensorArray[loopCounter] = msg->instSensorInfo.sensorArray[loopCounter];
+            }
+        }
+    }
+    deliveredTime = GetRTCTime();
+    isDeliveredSnapshotValid = true;
+    CPU_CRITICAL_EXIT();
+}
+
+//------------------------------------------------------------------------------
+//  static void PutBigEndian32(uint8_t data[], uint32_t value)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write value big endian on 4 bytes
+//
+//------------------------------------------------------------------------------
+static void PutBigEndian32(uint8_t data[], uint32_t value)
+{
+    data[0] = (uint8_t)(value >> 24);
+    data[1] = (uint8_t)(value >> 16);
+    data[2] = (uint8_t)(value >> 8);
+    data[3] = (uint8_t)value;
+}
+
 
 //==============================================================================
 //  GLOBAL FUNCTIONS IMPLEMENTATION
@@ -145,15 +212,375 @@ void ReturnEventMessageToPool(ComEvent_t* msg, BOOLEAN isEventSent)
     RTOS_ERR        err;
     if(isEventSent == true)
     {
+        if(msg->commEvtType == INSTRUMENT_DATA_UPLOAD)
+        {
+            UpdateDeliveredSnapshot(msg);
+        }
         OSQPost(&eventMessagesFreeQueue, msg, sizeof(ComEvent_t), OS_OPT_POST_FIFO + OS_OPT_POST_ALL + OS_OPT_POST_NO_SCHED, &err);
     }
+    else if(msg->priority == EVENT_PRIORITY_ALARM)
+    {
+        // Failed alarm goes back to the head of its lane so it is retried first
+        OSQPost(&eventAlarmMessagesQueue, msg, sizeof(ComEvent_t), OS_OPT_POST_LIFO + OS_OPT_POST_ALL + OS_OPT_POST_NO_SCHED, &err);
+    }
+    else
+    {
+        OSQPost(&eventMessagesQueue, msg, sizeof(ComEvent_t), OS_OPT_POST_FIFO + OS_OPT_POST_ALL + OS_OPT_POST_NO_SCHED, &err);
+    }
+    APP_RTOS_ASSERT_DBG((RTOS_ERR_CODE_GET(err) == RTOS_ERR_NONE), 1);
+}
+
+//------------------------------------------------------------------------------
+//  EVENT_PRIORITY_t GetEventPriority(INSTRUMENT_STATUS_t instrumentState, InstSensorInfo_t const *sensorInfo, BOOLEAN isPeriodic)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function classify the event priority from instrument and sensors status
+//
+//------------------------------------------------------------------------------
+EVENT_PRIORITY_t GetEventPriority(INSTRUMENT_STATUS_t instrumentState, InstSensorInfo_t const *sensorInfo, BOOLEAN isPeriodic)
+{
+    EVENT_PRIORITY_t priority = EVENT_PRIORITY_STATE_CHANGE;
+    uint8_t loopCounter = 0;
+    
+    if((instrumentState == PANIC) || (instrumentState == MANDOWN))
+    {
+        priority = EVENT_PRIORITY_ALARM;
+    }
+    else
+    {
+        for(loopCounter = 0; loopCounter < sensorInfo->numberOfSensors; loopCounter++)
+        {
+            switch(sensorInfo->sensorArray[loopCounter].SensorStatus)
+            {
+            case LOW_ALARM:
+            case HIGH_ALARM:
+            case OR:
+            case TWA_ALARM:
+            case STEL_ALARM:
+                priority = EVENT_PRIORITY_ALARM;
+                break;
+                
+            default:
+                break;
+            }
+        }
+        
+        // Periodic status update without any alarm condition
+        if((priority != EVENT_PRIORITY_ALARM) && (isPeriodic == true))
+        {
+            priority = EVENT_PRIORITY_PERIODIC;
+        }
+    }
+    return priority;
+}
+
+//------------------------------------------------------------------------------
+//  void PostEventToQueue(ComEvent_t* msg)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function post the Event to the queue lane of its priority class
+//
+//------------------------------------------------------------------------------
+void PostEventToQueue(ComEvent_t* msg)
+{
+    RTOS_ERR        err;
+    
+    msg->createdTicks = GetRTCTicks();
+    if(msg->priority == EVENT_PRIORITY_ALARM)
+    {
+        OSQPost(&eventAlarmMessagesQueue, msg, sizeof(ComEvent_t), OS_OPT_POST_FIFO + OS_OPT_POST_ALL + OS_OPT_POST_NO_SCHED, &err);
+    }
     else
     {
+        if(msg->priority == EVENT_PRIORITY_PERIODIC)
+        {
+            pendingPeriodicEvent = msg;
+        }
         OSQPost(&eventMessagesQueue, msg, sizeof(ComEvent_t), OS_OPT_POST_FIFO + OS_OPT_POST_ALL + OS_OPT_POST_NO_SCHED, &err);
     }
     APP_RTOS_ASSERT_DBG((RTOS_ERR_CODE_GET(err) == RTOS_ERR_NONE), 1);
 }
 
+//------------------------------------------------------------------------------
+//  ComEvent_t* GetNextEventFromQueue(OS_TICK timeout)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function get the most urgent pending Event, alarm lane is served first
+//
+//------------------------------------------------------------------------------
+ComEvent_t* GetNextEventFromQueue(OS_TICK timeout)
+{
+    RTOS_ERR        err;
+    void         *p_msg;
+    OS_MSG_SIZE   msg_size;
+    CPU_TS        ts;
+    CPU_SR_ALLOC();
+    
+    p_msg = OSQPend(&eventAlarmMessagesQueue, 0, OS_OPT_PEND_NON_BLOCKING, &msg_size, &ts, &err);
+    if(p_msg == NULL)
+    {
+        p_msg = OSQPend(&eventMessagesQueue, timeout, OS_OPT_PEND_BLOCKING, &msg_size, &ts, &err);
+    }
+    
+    // Periodic Event is owned by cellular Task now, stop merging into it.
+    // SPI interrupt runs to completion so any merge is finished before this point
+    CPU_CRITICAL_ENTER();
+    if((p_msg != NULL) && (p_msg == pendingPeriodicEvent))
+    {
+        pendingPeriodicEvent = NULL;
+    }
+    CPU_CRITICAL_EXIT();
+    
+    return (ComEvent_t*)p_msg;
+}
+
+//------------------------------------------------------------------------------
+//  ComEvent_t* GetPendingPeriodicEvent(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the periodic Event still waiting in queue, if any,
+//!  so a newer periodic snapshot can be merged into it
+//
+//------------------------------------------------------------------------------
+ComEvent_t* GetPendingPeriodicEvent(void)
+{
+    return pendingPeriodicEvent;
+}
+
+//------------------------------------------------------------------------------
+//  uint8_t GetChangedSensorsMask(InstSensorInfo_t const *sensorInfo)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function compare sensors with the last snapshot delivered to iNet and
+//!  returns bit mask of the sensors whose status changed or reading drifted
+//
+//------------------------------------------------------------------------------
+uint8_t GetChangedSensorsMask(InstSensorInfo_t const *sensorInfo)
+{
+    uint8_t mask = 0;
+    uint8_t loopCounter = 0;
+    int32_t newReading = 0, deliveredReading = 0, drift = 0;
+    SensorInfo_t const *newSensor = NULL;
+    SensorInfo_t const *deliveredSensor = NULL;
+    CPU_SR_ALLOC();
+    
+    CPU_CRITICAL_ENTER();
+    if((isDeliveredSnapshotValid == false) || (sensorInfo->numberOfSensors != deliveredSensorInfo.numberOfSensors))
+    {
+        mask = ALL_SENSORS_CHANGED_MASK;
+    }
+    else
+    {
+        for(loopCounter = 0; loopCounter < sensorInfo->numberOfSensors; loopCounter++)
+        {
+            newSensor = &sensorInfo->sensorArray[loopCounter];
+            deliveredSensor = &deliveredSensorInfo.sensorArray[loopCounter];
+            
+            newReading = (int32_t)(int16_t)(((uint8_t)newSensor->SensorReadingHigh << 8) | (uint8_t)newSensor->SensorReadingLow);
+            deliveredReading = (int32_t)(int16_t)(((uint8_t)deliveredSensor->SensorReadingHigh << 8) | (uint8_t)deliveredSensor->SensorReadingLow);
+            drift = newReading - deliveredReading;
+            if(drift < 0)
+            {
+                drift = -drift;
+            }
+            
+            if((newSensor->SensorType != deliveredSensor->SensorType) ||
+               (newSensor->SensorStatus != deliveredSensor->SensorStatus) ||
+                   (newSensor->DecimalPlaces != deliveredSensor->DecimalPlaces) ||
+                       (drift >= (int32_t)PERIODIC_READING_DRIFT_COUNTS))
+            {
+                SETBIT(mask, loopCounter);
+            }
+        }
+    }
+    CPU_CRITICAL_EXIT();
+    return mask;
+}
+
+//------------------------------------------------------------------------------
+//  BOOLEAN IsHeartbeatDue(uint32_t secondsSince1970)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when nothing is delivered to iNet for the
+//!  heartbeat interval, a longer one while the instrument stays in a
+//!  geofence zone as its position is already known to iNet
+//
+//------------------------------------------------------------------------------
+BOOLEAN IsHeartbeatDue(uint32_t secondsSince1970)
+{
+    uint32_t interval = (GeofenceMonitorIsInsideZone() == true) ? GEOFENCE_HEARTBEAT_INTERVAL : PERIODIC_INET_HEARTBEAT_INTERVAL;
+    BOOLEAN isDue = false;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    isDue = (BOOLEAN)((isDeliveredSnapshotValid == false) ||
+                      ((secondsSince1970 - deliveredTime) >= interval));
+    CPU_CRITICAL_EXIT();
+
+    return isDue;
+}
+
+//------------------------------------------------------------------------------
+//  uint32_t GetPendingEventsCount(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the number of events waiting in all queue lanes
+//
+//------------------------------------------------------------------------------
+uint32_t GetPendingEventsCount(void)
+{
+    return (uint32_t)(eventAlarmMessagesQueue.MsgQ.NbrEntries + eventMessagesQueue.MsgQ.NbrEntries);
+}
+
+//------------------------------------------------------------------------------
+//  uint32_t GetPendingAlarmsTicks(uint32_t createdTicks[], uint32_t maxCount)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function copy the creation ticks of the alarm events waiting in
+//!  their lane, oldest first, maxCount at most
+//!
+//! \return number of alarms copied
+//
+//------------------------------------------------------------------------------
+uint32_t GetPendingAlarmsTicks(uint32_t createdTicks[], uint32_t maxCount)
+{
+    OS_MSG const *entry = NULL;
+    uint32_t count = 0;
+    CPU_SR_ALLOC();
+    
+    // Lane is walked in place, nothing may be posted or pended meanwhile
+    CPU_CRITICAL_ENTER();
+    entry = eventAlarmMessagesQueue.MsgQ.OutPtr;
+    while((entry != NULL) && (count < maxCount))
+    {
+        createdTicks[count++] = ((ComEvent_t const*)entry->MsgPtr)->createdTicks;
+        entry = entry->NextPtr;
+    }
+    CPU_CRITICAL_EXIT();
+    
+    return count;
+}
+
+//------------------------------------------------------------------------------
+//  ComEvent_t* GetNextAlarmFromQueue(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function get the oldest alarm event without waiting, the caller
+//!  gives it back with ReturnEventMessageToPool
+//
+//------------------------------------------------------------------------------
+ComEvent_t* GetNextAlarmFromQueue(void)
+{
+    RTOS_ERR        err;
+    OS_MSG_SIZE   msg_size;
+    CPU_TS        ts;
+    
+    return (ComEvent_t*)OSQPend(&eventAlarmMessagesQueue, 0, OS_OPT_PEND_NON_BLOCKING, &msg_size, &ts, &err);
+}
+
+//------------------------------------------------------------------------------
+//  void RecordEventLatency(ComEvent_t const* msg)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function accumulate the creation to upload latency of a sent Event
+//
+//------------------------------------------------------------------------------
+void RecordEventLatency(ComEvent_t const* msg)
+{
+    EventLatencyStats_t *stats = NULL;
+    uint32_t latency = 0;
+    
+    if(msg->priority < EVENT_PRIORITY_LAST)
+    {
+        stats = &eventLatencyStats[msg->priority];
+        latency = GetRTCTicks() - msg->createdTicks;
+        
+        stats->eventsSent++;
+        stats->totalLatencyTicks += latency;
+        stats->lastLatencyTicks = latency;
+        if(latency > stats->maxLatencyTicks)
+        {
+            stats->maxLatencyTicks = latency;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  EventLatencyStats_t const* GetEventLatencyStats(EVENT_PRIORITY_t priority)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the latency statistics of a priority class
+//
+//------------------------------------------------------------------------------
+EventLatencyStats_t const* GetEventLatencyStats(EVENT_PRIORITY_t priority)
+{
+    EventLatencyStats_t const *stats = NULL;
+    
+    if(priority < EVENT_PRIORITY_LAST)
+    {
+        stats = &eventLatencyStats[priority];
+    }
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t GetEventLatencyDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the latency record for the radio configuration
+//!  readout, big endian 32 bit per priority class, alarm first: events sent,
+//!  then average, max and last creation to iNet acknowledge latency in ms
+//!
+//! \return EVENT_LATENCY_DIAGNOSTIC_SIZE or ERR_EVENT_LATENCY_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t GetEventLatencyDiagnostics(uint8_t buffer[], uint32_t bufferSize)
+{
+    int32_t ret = ERR_EVENT_LATENCY_NOT_AVAILABLE;
+    EventLatencyStats_t const *stats = NULL;
+    uint32_t index = 0, priority = 0;
+    
+    if(bufferSize >= EVENT_LATENCY_DIAGNOSTIC_SIZE)
+    {
+        for(priority = 0; priority < (uint32_t)EVENT_PRIORITY_LAST; priority++)
+        {
+            stats = GetEventLatencyStats((EVENT_PRIORITY_t)priority);
+            PutBigEndian32(&buffer[index], stats->eventsSent);
+            PutBigEndian32(&buffer[index + 4u], (stats->eventsSent > 0u) ? RTCDRV_TicksToMsec(stats->totalLatencyTicks / stats->eventsSent) : 0u);
+            PutBigEndian32(&buffer[index + 8u], RTCDRV_TicksToMsec(stats->maxLatencyTicks));
+            PutBigEndian32(&buffer[index + 12u], RTCDRV_TicksToMsec(stats->lastLatencyTicks));
+            index += 16u;
+        }
+        ret = EVENT_LATENCY_DIAGNOSTIC_SIZE;
+    }
+    
+    return ret;
+}
+
 
 uint8_t GetNextSequence(void)
 {
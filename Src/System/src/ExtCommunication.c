@@ -39,7 +39,6 @@
 //==============================================================================
 
 #include <stdio.h>
-#include <time.h>
 #include <string.h>
 #include <Math.h>
 
@@ -49,6 +48,9 @@
 #include "SPI_Comm.h"
 #include "Timer.h"
 #include "Cellular.h"
+#include "NMEAParser.h"
+#include "GeofenceMonitor.h"
+#include "HttpHeader.h"
 
 //==============================================================================
 //  CONSTANTS, TYPEDEFS AND MACROS 
@@ -84,6 +86,9 @@ const uint8_t inetwasdev1Cert[] =
 //  LOCAL DATA DECLARATIONS
 //==============================================================================
 static uint8_t iNetEventId[25];
+
+// Request header up to "Content-Length: ", built once per event type, URL and token
+static HttpHeader_t requestHeader;
 //==============================================================================
 //  LOCAL FUNCTION PROTOTYPES
 //==============================================================================
@@ -93,7 +98,7 @@ static int32_t JSONCreateInstrumentRegister(uint8_t urlBuffer[], uint32_t urlBuf
 static int32_t JParseGetToken(uint8_t js_data[], uint32_t len, uint8_t tokenBuffer[], uint32_t tokenBufferLength, PTR_COMM_EVT_t evt);
 static int32_t JParseInstrumentRegister(uint8_t js_data[], uint32_t len, uint8_t ResponseBuffer[], uint32_t ResponseBufferLength, PTR_COMM_EVT_t evt);
 static int32_t JParseInstrumentDataUpload(uint8_t js_data[], uint32_t len, uint8_t ResponseBuffer[], uint32_t ResponseBufferLength, PTR_COMM_EVT_t evt);
-static void JSONGpsDataConversion(float *latitude, float *longitude, char *latitudeDirection, char *longitudeDirection);
+static int32_t JSONFormatMicroDegrees(char buffer[], uint32_t bufferSize, int32_t microDegrees);
 
 
 //==============================================================================
@@ -173,6 +178,11 @@ static int32_t JSONCreateInstrumentDataUpload(uint8_t urlBuffer[], uint32_t urlB
     
     for(loopCounter = 0; loopCounter < commEvt->instSensorInfo.numberOfSensors; loopCounter++)
     {
+        // Skip sensors unchanged since the last delivered snapshot
+        if(CHECKBIT(commEvt->changedSensorsMask, loopCounter) == 0)
+        {
+            continue;
+        }
         gasUnitReading = 0;
         // Get gas code of sensor
         sprintf((char *)gasCode, "G%04u", commEvt->instSensorInfo.sensorArray[loopCounter].SensorType);
@@ -194,7 +204,7 @@ static int32_t JSONCreateInstrumentDataUpload(uint8_t urlBuffer[], uint32_t urlB
         
     }
     
-    if (commEvt->instSensorInfo.numberOfSensors > 0)
+    if (index > 1)
     {
         // Remove last ','
         index--;
@@ -209,10 +219,21 @@ static int32_t JSONCreateInstrumentDataUpload(uint8_t urlBuffer[], uint32_t urlB
     // When Valid gps co-ordinates are attached
     if(commEvt->GPSLocationInfo.isGpsValid == true)
     {
-        // convert GPS data to accepted format of iNet
-        JSONGpsDataConversion(&commEvt->GPSLocationInfo.latitude, &commEvt->GPSLocationInfo.longitude, (char *)&commEvt->GPSLocationInfo.latitudeDir, (char *)&commEvt->GPSLocationInfo.longitudeDir);
-        // Add GPS position in JSON Data
-        size += snprintf((char *)&dataBuffer[size], (dataBufferSize - size), ",\"position\":{\"latitude\":%4.6f,\"longitude\":%4.6f,\"accuracy\":%4.6f}", commEvt->GPSLocationInfo.latitude, commEvt->GPSLocationInfo.longitude,commEvt->GPSLocationInfo.horizantalDilution);
+        // Add position in JSON Data, coordinates are fixed point micro-degrees and
+        // accuracy is the horizontal uncertainty in meters
+        size += snprintf((char *)&dataBuffer[size], (dataBufferSize - size), ",\"position\":{\"latitude\":");
+        size += JSONFormatMicroDegrees((char *)&dataBuffer[size], (dataBufferSize - size), commEvt->GPSLocationInfo.latitude);
+        size += snprintf((char *)&dataBuffer[size], (dataBufferSize - size), ",\"longitude\":");
+        size += JSONFormatMicroDegrees((char *)&dataBuffer[size], (dataBufferSize - size), commEvt->GPSLocationInfo.longitude);
+        size += snprintf((char *)&dataBuffer[size], (dataBufferSize - size), ",\"accuracy\":%u,\"source\":\"%s\"}", (unsigned int)commEvt->GPSLocationInfo.uncertainty,
+                         (commEvt->GPSLocationInfo.source == POSITION_SOURCE_CELL_LOCATE) ? "cell" : "gnss");
+    }
+    
+    // Fence set version tells iNet whether to send a new set in its response
+    size += snprintf((char *)&dataBuffer[size], (dataBufferSize - size), ",\"geofenceSet\":%u", commEvt->geofenceSet);
+    if(commEvt->geofenceSet != 0u)
+    {
+        size += snprintf((char *)&dataBuffer[size], (dataBufferSize - size), ",\"zone\":%u", commEvt->geofenceId);
     }
     
     // Add Sensor Data in jSON data
@@ -240,36 +261,20 @@ static int32_t JSONCreateInstrumentRegister(uint8_t urlBuffer[], uint32_t urlBuf
 }
 
 //------------------------------------------------------------------------------
-//  static void JSONGpsDataConversion(float *latitude, float *longitude, char *latitudeDirection, char *longitudeDirection)
+//  static int32_t JSONFormatMicroDegrees(char buffer[], uint32_t bufferSize, int32_t microDegrees)
 //
-//   Author:  Dilawar Ali
-//   Date:    2018/04/20
+//   Author:  agent
+//   Date:    2026/10/19
 //
-//!  This function convert gps data received from settelite to gps data needed to iNet
+//!  This function print micro-degrees as decimal degrees with six decimals
 //
 //------------------------------------------------------------------------------
-static void JSONGpsDataConversion(float *latitude, float *longitude, char *latitudeDirection, char *longitudeDirection)
+static int32_t JSONFormatMicroDegrees(char buffer[], uint32_t bufferSize, int32_t microDegrees)
 {
-    int localLatitude,localLongitude;
-    float localF, localL;
-    localF = *latitude/100.0f;
-    localL = *longitude/100.0f;
-    localLatitude = (int) localF;
-    localLongitude = (int) localL;
-    *latitude = (float) localLatitude +(100.0f * ( (localF - (float)localLatitude)/60.0f));
-    *longitude = (float) localLongitude+(100.0f * ((localL - (float)localLongitude)/60.0f));
-    // Conversion added
-    if( *latitudeDirection == 'S' )
-    {
-        // Convert latitude
-        *latitude =  ( (*latitude )* (-1) );
-    }
-    // Check logitude Direction
-    if( *longitudeDirection == 'W' )
-    {
-        // Convert Longitude sign
-        *longitude =  ( (*longitude )* (-1) );
-    }
+    uint32_t magnitude = (microDegrees < 0) ? (uint32_t)(-microDegrees) : (uint32_t)microDegrees;
+
+    return snprintf(buffer, bufferSize, "%s%lu.%06lu", ((microDegrees < 0) ? "-" : ""),
+                    (unsigned long)(magnitude / NMEA_MICRO_DEGREES_PER_DEGREE), (unsigned long)(magnitude % NMEA_MICRO_DEGREES_PER_DEGREE));
 }
 
 
@@ -284,20 +289,7 @@ static void JSONGpsDataConversion(float *latitude, float *longitude, char *latit
 //------------------------------------------------------------------------------
 void GetCurrentTimeAndDate(DateTimeInfo_t *currentTime)
 {
-    uint32_t secondsSince1970 = 0u;
-    secondsSince1970 = RTCDRV_GetWallClock();
-    
-    struct tm *tms;
-    tms = gmtime((time_t*)&secondsSince1970);
-    
-    // Synchronize system clock
-    currentTime->date.month     = tms->tm_mon + 1; // struct tm monthId(0-11)
-    currentTime->date.day       = tms->tm_mday;
-    currentTime->date.year      = tms->tm_year + 1900;
-    currentTime->time.hours     = tms->tm_hour;
-    currentTime->time.minutes   = tms->tm_min;
-    currentTime->time.seconds   = tms->tm_sec;
-    
+    EpochToDateTime(RTCDRV_GetWallClock(), currentTime);
 }
 
 //------------------------------------------------------------------------------
@@ -333,6 +325,8 @@ static int32_t JParseGetToken(uint8_t js_data[], uint32_t len, uint8_t tokenBuff
             {
                 size=(js_tok[i+1].end-js_tok[i+1].start);
                 snprintf((char *)tokenBuffer,tokenBufferLength,"Bearer %.*s",size,(char *)&js_data[js_tok[i+1].start]);
+                // Authorization of the request header changed
+                HttpHeaderInvalidate(&requestHeader);
             }
             else if (( 0 == strncmp((char const*)&js_data[js_tok[i].start],"expires_in",size)) && (size != 0))
             {
@@ -367,13 +361,22 @@ static int32_t JParseInstrumentRegister(uint8_t js_data[], uint32_t len, uint8_t
 //   Author:  Dilawar Ali
 //   Date:    2018/04/23
 //
-//!  This function Parse server response incase of Token event and update token buffer with valid received token
+//!  This function Parse server response of an event upload, store the iNet
+//!  event id and stage the geofence set when one is sent
 //
 //------------------------------------------------------------------------------
 static int32_t JParseInstrumentDataUpload(uint8_t js_data[], uint32_t len, uint8_t ResponseBuffer[], uint32_t ResponseBufferLength, PTR_COMM_EVT_t evt)
 {
     uint8_t *start = NULL;
     uint8_t loopCounter = 0;
+    char const *geofences = strstr((char const*)js_data, "\"geofences\":");
+    
+    // Geofence set is only sent when the event reported another version
+    if(geofences != NULL)
+    {
+        (void)GeofenceMonitorStageSet(&geofences[12], (len - (uint32_t)(&geofences[12] - (char const*)js_data)));
+    }
+    
     start = (uint8_t *)strstr((char const*)js_data, ":");
     if(start != NULL)
     {
@@ -389,47 +392,23 @@ static int32_t JParseInstrumentDataUpload(uint8_t js_data[], uint32_t len, uint8
 }
 
 //------------------------------------------------------------------------------
-//  int32_t CreateHttpHeader(uint8_t *buffer, uint32_t buffLen)
+//  int32_t CreateHttpHeader(COMM_EVT_TYPE_t evt, uint8_t *buffer, uint32_t buffLen, uint32_t contentLength)
 //
 //   Author:  Dilawar Ali
 //   Date:    2018/06/19
 //
-//!  This function Parse server response incase of Token event and update token buffer with valid received token
+//!  This function create the HTTP request header of the event type in buffer.
+//!  The header is formatted once per event type, URL and token, later
+//!  requests only write their Content-Length in place. A header that does
+//!  not fit leaves the buffer empty.
+//!
+//! \return header length or -1 when it does not fit
 //
 //------------------------------------------------------------------------------
 int32_t CreateHttpHeader(COMM_EVT_TYPE_t evt, uint8_t *buffer, uint32_t buffLen, uint32_t contentLength)
 {
-    int32_t ret = -1;
-    if(evt == GET_INET_TOKEN)
-    {
-        ret = snprintf((char *)buffer, buffLen, "POST %s HTTP/1.1\r\n"
-                       "Host: %s\r\n"
-                           "Connection: close\r\n"
-                               "Content-Length: %d\r\n"
-                                   "Content-Type: %s\r\n"
-                                       "Accept: */*\r\n\r\n",
-                                       httpUrlBuffer,
-                                       INET_HOST,
-                                       contentLength,
-                                       CONTENT_TYPE_URL_ENCODED);
-        
-        
-    }
-    else
-    {
-        ret = snprintf((char *)buffer, buffLen, "POST %s HTTP/1.1\r\n"
-                       "Host: %s\r\n"
-                           "Connection: close\r\n"
-                               "Content-Length: %d\r\n"
-                                   "Content-Type: %s\r\n"
-                                       "Authorization: %s\r\n"
-                                           "Accept: */*\r\n\r\n",
-                                           httpUrlBuffer,
-                                           INET_HOST,
-                                           contentLength,
-                                           CONTENT_TYPE_JSON,
-                                           tokenBuffer);
-    }
-    
-    return ret;
+    return HttpHeaderCreate(&requestHeader, (uint32_t)evt, (char const*)httpUrlBuffer, INET_HOST,
+                            ((evt == GET_INET_TOKEN) ? CONTENT_TYPE_URL_ENCODED : CONTENT_TYPE_JSON),
+                            ((evt == GET_INET_TOKEN) ? NULL : (char const*)tokenBuffer),
+                            buffer, buffLen, contentLength);
 }
\ No newline at end of file
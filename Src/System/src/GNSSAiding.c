@@ -0,0 +1,462 @@
+//==============================================================================
+//
+//  GNSSAiding.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        GNSSAiding.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the GNSS aiding record. The last fix and the offset
+//! between network time and UTC survive power cycles in DataFlash and are
+//! injected as UBX-MGA-INI so the receiver does not start cold.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "GNSSAiding.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "DataFlash.h"
+#include "Event.h"
+#include "SysTask.h"
+#include "Timer.h"
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define MGA_INI_TIME_UTC_TYPE           0x10u
+#define MGA_INI_TIME_UTC_PAYLOAD_SIZE   24u
+#define MGA_INI_POS_LLH_TYPE            0x01u
+#define MGA_INI_POS_LLH_PAYLOAD_SIZE    20u
+#define MGA_INI_LEAP_SECONDS_UNKNOWN    0x80u
+
+#define MGA_INI_MAX_FRAME_SIZE          (MGA_INI_TIME_UTC_PAYLOAD_SIZE + UBX_FRAME_OVERHEAD)
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static GNSSAidingRecord_t aidingRecord;
+static GNSSAidingRecord_t saveRecord;           // Snapshot written by SysTask
+static BOOLEAN isRecordChanged = false;
+static volatile BOOLEAN isSavePending = false;
+static BOOLEAN isSavedOnce = false;
+static uint32_t lastSaveTicks = 0;
+
+static BOOLEAN isSessionOpen = false;
+static uint8_t sessionStartType = GNSS_START_COLD;
+static uint32_t sessionPowerOnTicks = 0;
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void GNSSAidingResetRecord(void);
+static void PutLittleEndian(uint8_t data[], uint32_t value, uint8_t size);
+static BOOLEAN GetCurrentUtc(uint32_t *utcSeconds);
+static void AddTTFFSample(GNSSTTFFStats_t *stats, uint32_t ttffMs);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static void GNSSAidingResetRecord(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function clear the record, no aiding is available after it
+//
+//------------------------------------------------------------------------------
+static void GNSSAidingResetRecord(void)
+{
+    uint32_t i = 0;
+
+    memset(&aidingRecord, 0, sizeof(aidingRecord));
+    aidingRecord.magic = GNSS_AIDING_MAGIC;
+    aidingRecord.version = GNSS_AIDING_VERSION;
+    aidingRecord.size = sizeof(GNSSAidingRecord_t);
+    for(i = 0; i < GNSS_START_TYPES; i++)
+    {
+        aidingRecord.ttff[i].minMs = UINT32_MAX;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void PutLittleEndian(uint8_t data[], uint32_t value, uint8_t size)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write a little endian UBX field of 1 to 4 bytes
+//
+//------------------------------------------------------------------------------
+static void PutLittleEndian(uint8_t data[], uint32_t value, uint8_t size)
+{
+    uint8_t i = 0;
+
+    for(i = 0; i < size; i++)
+    {
+        data[i] = (uint8_t)(value & 0xFFu);
+        value >>= 8;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static BOOLEAN GetCurrentUtc(uint32_t *utcSeconds)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function gives UTC from the network synced RTC and the offset
+//!  measured at the last fix
+//
+//------------------------------------------------------------------------------
+static BOOLEAN GetCurrentUtc(uint32_t *utcSeconds)
+{
+    BOOLEAN ret = false;
+
+    if((aidingRecord.isUtcOffsetValid != 0u) && (IsRTCTimeSynced() == true))
+    {
+        *utcSeconds = (uint32_t)((int32_t)GetRTCTime() + aidingRecord.utcOffset);
+        ret = true;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static void AddTTFFSample(GNSSTTFFStats_t *stats, uint32_t ttffMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function add a time to first fix to the statistics of its start type
+//
+//------------------------------------------------------------------------------
+static void AddTTFFSample(GNSSTTFFStats_t *stats, uint32_t ttffMs)
+{
+    uint32_t bin = FIND_MIN((ttffMs / GNSS_TTFF_BIN_WIDTH_MS), (GNSS_TTFF_HISTOGRAM_BINS - 1u));
+
+    stats->count++;
+    stats->totalMs += ttffMs;
+    if(ttffMs < stats->minMs)
+    {
+        stats->minMs = ttffMs;
+    }
+    if(ttffMs > stats->maxMs)
+    {
+        stats->maxMs = ttffMs;
+    }
+    if(stats->histogram[bin] < UINT16_MAX)
+    {
+        stats->histogram[bin]++;
+    }
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  int32_t GNSSAidingLoadFromFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read the aiding record, called from SysTask at start up
+//
+//------------------------------------------------------------------------------
+int32_t GNSSAidingLoadFromFlash(void)
+{
+    int32_t ret = 0;
+    uint8_t pageBuffer[DATAFLASH_BYTES_PER_PAGE] = {0};
+
+    DataFlashDisablePowerSaving();
+    ret = DataFlashReadPage(GNSS_AIDING_PAGE_NUMBER, pageBuffer, DATAFLASH_BYTES_PER_PAGE);
+    DataFlashEnablePowerSaving();
+
+    if(ret >= 0)
+    {
+        memcpy(&aidingRecord, pageBuffer, sizeof(aidingRecord));
+        if((aidingRecord.magic != GNSS_AIDING_MAGIC) || (aidingRecord.version != GNSS_AIDING_VERSION) ||
+           (aidingRecord.size != sizeof(GNSSAidingRecord_t)))
+        {
+            ret = ERR_GNSS_AIDING_RECORD_INVALID;
+        }
+    }
+
+    if(ret < 0)
+    {
+        GNSSAidingResetRecord();
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t GNSSAidingSaveToFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the record snapshot taken by GNSSAidingRequestSave.
+//!  Called from SysTask which owns the DataFlash.
+//
+//------------------------------------------------------------------------------
+int32_t GNSSAidingSaveToFlash(void)
+{
+    int32_t ret = 0;
+
+    DataFlashDisablePowerSaving();
+    ret = DataFlashErasePage(GNSS_AIDING_PAGE_NUMBER);
+    if(ret >= 0)
+    {
+        ret = DataFlashWriteBuffer(0, (uint8_t *)&saveRecord, sizeof(saveRecord));
+    }
+    if(ret >= 0)
+    {
+        ret = DataFlashWriteBufferToPage(GNSS_AIDING_PAGE_NUMBER);
+    }
+    DataFlashEnablePowerSaving();
+    isSavePending = false;
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  void GNSSAidingRequestSave(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function snapshot a changed record and ask SysTask to persist it,
+//!  at most once per GNSS_AIDING_SAVE_INTERVAL_MS
+//
+//------------------------------------------------------------------------------
+void GNSSAidingRequestSave(void)
+{
+    RTOS_ERR  err;
+    SysMsg_t *msg = NULL;
+
+    if((isRecordChanged == true) && (isSavePending == false) &&
+       ((isSavedOnce == false) || (RTCDRV_TicksToMsec(GetRTCTicks() - lastSaveTicks) >= GNSS_AIDING_SAVE_INTERVAL_MS)))
+    {
+        msg = (SysMsg_t*)GetTaskMessageFromPool();
+        if(msg != NULL)
+        {
+            isSavedOnce = true;
+            lastSaveTicks = GetRTCTicks();
+            saveRecord = aidingRecord;
+            isRecordChanged = false;
+            isSavePending = true;
+            msg->msgId = SAVE_GNSS_AIDING_TO_FLASH;
+            msg->msgInfo = 1;
+            msg->ptrData = NULL;
+            OSTaskQPost(&SYSTaskTCB, (void *)msg, sizeof(SysMsg_t), OS_OPT_POST_FIFO, &err);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  int32_t GNSSAidingCreateTimeCommand(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create AT+UI2CW with UBX-MGA-INI-TIME_UTC
+//!
+//! \return command size or ERR_GNSS_AIDING_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t GNSSAidingCreateTimeCommand(uint8_t buffer[], uint32_t bufferSize)
+{
+    int32_t ret = ERR_GNSS_AIDING_NOT_AVAILABLE;
+    uint8_t payload[MGA_INI_TIME_UTC_PAYLOAD_SIZE] = {0};
+    uint8_t frame[MGA_INI_MAX_FRAME_SIZE];
+    uint32_t frameSize = 0, utcSeconds = 0;
+    DateTimeInfo_t utcTime;
+
+    if(GetCurrentUtc(&utcSeconds) == true)
+    {
+        EpochToDateTime(utcSeconds, &utcTime);
+
+        payload[0] = MGA_INI_TIME_UTC_TYPE;
+        payload[2] = 0;                                 // Reference: time of receipt
+        payload[3] = MGA_INI_LEAP_SECONDS_UNKNOWN;
+        PutLittleEndian(&payload[4], utcTime.date.year, 2);
+        payload[6] = utcTime.date.month;
+        payload[7] = utcTime.date.day;
+        payload[8] = utcTime.time.hours;
+        payload[9] = utcTime.time.minutes;
+        payload[10] = utcTime.time.seconds;
+        PutLittleEndian(&payload[16], GNSS_AIDING_TIME_ACCURACY_SECONDS, 2);
+
+        frameSize = GPSCreateUBXFrame(UBX_CLASS_MGA, UBX_ID_MGA_INI, payload, sizeof(payload), frame, sizeof(frame));
+        ret = GPSCreateI2CWriteCommand(frame, frameSize, buffer, bufferSize);
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t GNSSAidingCreatePositionCommand(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create AT+UI2CW with UBX-MGA-INI-POS_LLH, accuracy grows
+//!  with the age of the last fix
+//!
+//! \return command size or ERR_GNSS_AIDING_NOT_AVAILABLE
+//
+//------------------------------------------------------------------------------
+int32_t GNSSAidingCreatePositionCommand(uint8_t buffer[], uint32_t bufferSize)
+{
+    int32_t ret = ERR_GNSS_AIDING_NOT_AVAILABLE;
+    uint8_t payload[MGA_INI_POS_LLH_PAYLOAD_SIZE] = {0};
+    uint8_t frame[MGA_INI_MAX_FRAME_SIZE];
+    uint32_t frameSize = 0, utcSeconds = 0, age = 0, accuracyMm = 0;
+
+    if((aidingRecord.isPositionValid != 0u) && (GetCurrentUtc(&utcSeconds) == true) && (utcSeconds >= aidingRecord.fixTime))
+    {
+        age = utcSeconds - aidingRecord.fixTime;
+        if(age <= GNSS_AIDING_MAX_POSITION_AGE)
+        {
+            accuracyMm = aidingRecord.hAcc + (age * GNSS_AIDING_DRIFT_MM_PER_SECOND);
+
+            payload[0] = MGA_INI_POS_LLH_TYPE;
+            PutLittleEndian(&payload[4], (uint32_t)aidingRecord.latitude, 4);
+            PutLittleEndian(&payload[8], (uint32_t)aidingRecord.longitude, 4);
+            PutLittleEndian(&payload[12], (uint32_t)(aidingRecord.heightMSL / 10), 4);
+            PutLittleEndian(&payload[16], (accuracyMm / 10u), 4);
+
+            frameSize = GPSCreateUBXFrame(UBX_CLASS_MGA, UBX_ID_MGA_INI, payload, sizeof(payload), frame, sizeof(frame));
+            ret = GPSCreateI2CWriteCommand(frame, frameSize, buffer, bufferSize);
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  void GNSSAidingStartSession(GNSS_START_TYPE_t startType, uint32_t powerOnTicks)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function start TTFF measurement of a receiver power up
+//
+//------------------------------------------------------------------------------
+void GNSSAidingStartSession(GNSS_START_TYPE_t startType, uint32_t powerOnTicks)
+{
+    isSessionOpen = true;
+    sessionStartType = (uint8_t)startType;
+    sessionPowerOnTicks = powerOnTicks;
+}
+
+//------------------------------------------------------------------------------
+//  void GNSSAidingUpdateFix(UBXNavPvt_t const *navPvt)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function keep a valid fix for aiding and close the TTFF measurement
+//
+//------------------------------------------------------------------------------
+void GNSSAidingUpdateFix(UBXNavPvt_t const *navPvt)
+{
+    uint32_t ttffMs = 0, fixTime = 0;
+    DateTimeInfo_t fixDateTime;
+    BOOLEAN isFixValid = ((navPvt->flags & UBX_NAV_PVT_FLAG_FIX_OK) != 0u) && (navPvt->fixType >= UBX_FIX_TYPE_3D) &&
+                         (navPvt->fixType <= UBX_FIX_TYPE_GNSS_DEAD_RECKONING);
+
+    if(isFixValid == true)
+    {
+        if(isSessionOpen == true)
+        {
+            isSessionOpen = false;
+            ttffMs = RTCDRV_TicksToMsec(GetRTCTicks() - sessionPowerOnTicks);
+            AddTTFFSample(&aidingRecord.ttff[sessionStartType], ttffMs);
+            printf("GNSS TTFF %lu ms, start type %u\r\n", (unsigned long)ttffMs, sessionStartType);
+        }
+
+        fixDateTime.date.year = navPvt->year;
+        fixDateTime.date.month = navPvt->month;
+        fixDateTime.date.day = navPvt->day;
+        fixDateTime.time.hours = navPvt->hour;
+        fixDateTime.time.minutes = navPvt->minute;
+        fixDateTime.time.seconds = navPvt->second;
+
+        // Position age is judged from the fix time, keep only fixes with resolved UTC
+        if(((navPvt->valid & UBX_NAV_PVT_VALID_UTC) == UBX_NAV_PVT_VALID_UTC) && (DateTimeToEpoch(&fixDateTime, &fixTime) == true))
+        {
+            aidingRecord.latitude = navPvt->latitude;
+            aidingRecord.longitude = navPvt->longitude;
+            aidingRecord.heightMSL = navPvt->heightMSL;
+            aidingRecord.hAcc = navPvt->hAcc;
+            aidingRecord.fixTime = fixTime;
+            aidingRecord.isPositionValid = 1u;
+
+            // RTC is network UTC, the offset takes its drift and is only meaningful once it is synced
+            if(IsRTCTimeSynced() == true)
+            {
+                aidingRecord.utcOffset = (int32_t)(aidingRecord.fixTime - GetRTCTime());
+                aidingRecord.isUtcOffsetValid = 1u;
+            }
+            isRecordChanged = true;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  GNSSTTFFStats_t const* GNSSAidingGetTTFFStats(GNSS_START_TYPE_t startType)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns TTFF statistics of a start type
+//
+//------------------------------------------------------------------------------
+GNSSTTFFStats_t const* GNSSAidingGetTTFFStats(GNSS_START_TYPE_t startType)
+{
+    GNSSTTFFStats_t const *ret = NULL;
+
+    if(startType < GNSS_START_TYPES)
+    {
+        ret = &aidingRecord.ttff[startType];
+    }
+
+    return ret;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,329 @@
+//==============================================================================
+//
+//  GNSSDutyCycle.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        GNSSDutyCycle.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the GNSS duty cycle controller. SysTask runs it, fixes
+//! are reported from cellular task which owns the modem I2C passthrough.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "GNSSDutyCycle.h"
+
+#include <stdio.h>
+
+#include "Cellular.h"
+#include "GeofenceMonitor.h"
+#include "Timer.h"
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define MM_PER_DEGREE_E7_X1000          11132       //!< Meridian length of 1e-7 degree, 1/1000 mm
+#define DEGREES_E7_PER_COS_STEP         100000000   //!< 10 degrees
+#define DEGREES_E7_HALF_CIRCLE          1800000000
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+//! cos(latitude) in Q15 for every 10 degrees, interpolated in between
+static const uint16_t cosTableQ15[] = {32768u, 32270u, 30792u, 28378u, 25102u, 21063u, 16384u, 11207u, 5690u, 0u};
+
+static GNSS_DUTY_STATE_t dutyState = GNSS_DUTY_OFF;
+static uint32_t stateTicks = 0;                 // Power down or power up time
+static uint32_t pollTicks = 0;
+static BOOLEAN isFixDueNow = true;              // First fix right after start up
+
+static UBXNavPvt_t referenceFix;                // Last fix good enough to compare against
+static BOOLEAN isReferenceValid = false;
+
+static UBXNavPvt_t reportedFix;                 // Written by cellular task
+static volatile BOOLEAN isFixReported = false;
+static volatile BOOLEAN isAlarmReported = false;
+
+static GNSSDutyCycleStats_t dutyStats = {0, 0, 0, 0, 0, GNSS_DUTY_MIN_INTERVAL_MS};
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static uint32_t ElapsedMs(uint32_t referenceTicks);
+static uint32_t CosineQ15(int32_t latitude);
+static BOOLEAN IsWithinRadius(UBXNavPvt_t const *first, UBXNavPvt_t const *second, uint32_t radiusMm);
+static void EvaluateFix(UBXNavPvt_t const *navPvt);
+static void PowerDown(void);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static uint32_t ElapsedMs(uint32_t referenceTicks)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns milliseconds since referenceTicks
+//
+//------------------------------------------------------------------------------
+static uint32_t ElapsedMs(uint32_t referenceTicks)
+{
+    return RTCDRV_TicksToMsec(GetRTCTicks() - referenceTicks);
+}
+
+//------------------------------------------------------------------------------
+//  static uint32_t CosineQ15(int32_t latitude)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns cos of latitude (1e-7 degrees) in Q15, good to a
+//!  fraction of a percent which is plenty for a radius test
+//
+//------------------------------------------------------------------------------
+static uint32_t CosineQ15(int32_t latitude)
+{
+    uint32_t absLatitude = (uint32_t)((latitude < 0) ? -latitude : latitude);
+    uint32_t index = absLatitude / DEGREES_E7_PER_COS_STEP;
+    uint32_t fraction = absLatitude % DEGREES_E7_PER_COS_STEP;
+    uint32_t ret = 0;
+
+    if(index < ((sizeof(cosTableQ15) / sizeof(cosTableQ15[0])) - 1u))
+    {
+        ret = cosTableQ15[index] - (uint32_t)(((uint64_t)(cosTableQ15[index] - cosTableQ15[index + 1u]) * fraction) / DEGREES_E7_PER_COS_STEP);
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static BOOLEAN IsWithinRadius(UBXNavPvt_t const *first, UBXNavPvt_t const *second, uint32_t radiusMm)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function compare horizontal distance of two fixes with a radius,
+//!  flat earth approximation in integer arithmetic
+//
+//------------------------------------------------------------------------------
+static BOOLEAN IsWithinRadius(UBXNavPvt_t const *first, UBXNavPvt_t const *second, uint32_t radiusMm)
+{
+    int64_t deltaLongitude = (int64_t)second->longitude - first->longitude;
+    int64_t northMm = (((int64_t)second->latitude - first->latitude) * MM_PER_DEGREE_E7_X1000) / 1000;
+    int64_t eastMm = 0;
+
+    // Shortest way across the antimeridian
+    if(deltaLongitude > DEGREES_E7_HALF_CIRCLE)
+    {
+        deltaLongitude -= 2 * (int64_t)DEGREES_E7_HALF_CIRCLE;
+    }
+    else if(deltaLongitude < -DEGREES_E7_HALF_CIRCLE)
+    {
+        deltaLongitude += 2 * (int64_t)DEGREES_E7_HALF_CIRCLE;
+    }
+    eastMm = (((deltaLongitude * MM_PER_DEGREE_E7_X1000) / 1000) * CosineQ15(first->latitude)) >> 15;
+
+    return (((northMm * northMm) + (eastMm * eastMm)) <= ((int64_t)radiusMm * radiusMm));
+}
+
+//------------------------------------------------------------------------------
+//  static void EvaluateFix(UBXNavPvt_t const *navPvt)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function adapt the fix interval. A fix away from the reference by
+//!  more than radius plus its own accuracy is movement. A good fix inside
+//!  the radius doubles the interval, a poor one leaves it unchanged.
+//
+//------------------------------------------------------------------------------
+static void EvaluateFix(UBXNavPvt_t const *navPvt)
+{
+    BOOLEAN isGoodFix = (navPvt->pDOP <= GNSS_DUTY_MAX_PDOP) && (navPvt->hAcc <= GNSS_DUTY_STATIONARY_RADIUS_MM);
+
+    dutyStats.fixes++;
+    if((isReferenceValid == true) && (IsWithinRadius(&referenceFix, navPvt, (GNSS_DUTY_STATIONARY_RADIUS_MM + navPvt->hAcc)) == false))
+    {
+        dutyStats.movements++;
+        dutyStats.intervalMs = GNSS_DUTY_MIN_INTERVAL_MS;
+        referenceFix = *navPvt;
+    }
+    else if(isGoodFix == true)
+    {
+        if(isReferenceValid == true)
+        {
+            dutyStats.intervalMs = FIND_MIN((dutyStats.intervalMs * 2u), GNSS_DUTY_MAX_INTERVAL_MS);
+        }
+        referenceFix = *navPvt;
+        isReferenceValid = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void PowerDown(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function switch the receiver off until the next fix is due
+//
+//------------------------------------------------------------------------------
+static void PowerDown(void)
+{
+    dutyStats.onTimeMs += ElapsedMs(stateTicks);
+    CellularPostGNSSRequest(CELL_GPS_OFF);
+    dutyState = GNSS_DUTY_OFF;
+    stateTicks = GetRTCTicks();
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  void GNSSDutyCycleRun(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function run the controller, called from SysTask on every schedule
+//!  message. It request CELL_GET_GPS_COORDINATES and CELL_GPS_OFF from cellular task.
+//
+//------------------------------------------------------------------------------
+void GNSSDutyCycleRun(void)
+{
+    UBXNavPvt_t navPvt;
+
+    if(isAlarmReported == true)
+    {
+        isAlarmReported = false;
+        dutyStats.alarms++;
+        dutyStats.intervalMs = GNSS_DUTY_MIN_INTERVAL_MS;
+        isFixDueNow = true;
+    }
+
+    if(isFixReported == true)
+    {
+        navPvt = reportedFix;
+        isFixReported = false;
+        if((dutyState == GNSS_DUTY_ACQUIRING) && ((navPvt.flags & UBX_NAV_PVT_FLAG_FIX_OK) != 0u) &&
+           (navPvt.fixType >= UBX_FIX_TYPE_3D) && (navPvt.fixType <= UBX_FIX_TYPE_GNSS_DEAD_RECKONING))
+        {
+            EvaluateFix(&navPvt);
+            GeofenceMonitorEvaluateFix(&navPvt);
+            PowerDown();
+            // An alarm raised while acquiring is served by this fix
+            isFixDueNow = false;
+        }
+    }
+
+    switch(dutyState)
+    {
+    case GNSS_DUTY_OFF:
+        if((isFixDueNow == true) || (ElapsedMs(stateTicks) >= dutyStats.intervalMs))
+        {
+            isFixDueNow = false;
+            dutyState = GNSS_DUTY_ACQUIRING;
+            stateTicks = GetRTCTicks();
+            pollTicks = stateTicks;
+            // Cellular task powers and configures the receiver on the first poll
+            CellularPostGNSSRequest(CELL_GET_GPS_COORDINATES);
+        }
+        break;
+
+    case GNSS_DUTY_ACQUIRING:
+        if(ElapsedMs(stateTicks) >= GNSS_DUTY_ACQUIRE_TIMEOUT_MS)
+        {
+            printf("GNSS no fix in %u ms\r\n", GNSS_DUTY_ACQUIRE_TIMEOUT_MS);
+            dutyStats.timeouts++;
+            PowerDown();
+        }
+        else if(ElapsedMs(pollTicks) >= GNSS_DUTY_POLL_INTERVAL_MS)
+        {
+            pollTicks = GetRTCTicks();
+            CellularPostGNSSRequest(CELL_GET_GPS_COORDINATES);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  void GNSSDutyCycleReportFix(UBXNavPvt_t const *navPvt)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function hand a NAV-PVT read by cellular task to the controller
+//
+//------------------------------------------------------------------------------
+void GNSSDutyCycleReportFix(UBXNavPvt_t const *navPvt)
+{
+    // Polls are seconds apart, SysTask takes the fix long before the next one
+    reportedFix = *navPvt;
+    isFixReported = true;
+}
+
+//------------------------------------------------------------------------------
+//  void GNSSDutyCycleNotifyAlarm(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function request a fresh fix and the shortest interval on alarm
+//
+//------------------------------------------------------------------------------
+void GNSSDutyCycleNotifyAlarm(void)
+{
+    isAlarmReported = true;
+}
+
+//------------------------------------------------------------------------------
+//  GNSSDutyCycleStats_t const* GNSSDutyCycleGetStats(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns fix counts and receiver on time
+//
+//------------------------------------------------------------------------------
+GNSSDutyCycleStats_t const* GNSSDutyCycleGetStats(void)
+{
+    return &dutyStats;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -39,5 +39,477 @@
 
 #include "GPS.h"
 
+#include <stdio.h>
+#include <string.h>
 
+#include "Timer.h"
 
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+#define UBX_CFG_PRT_PAYLOAD_SIZE        20u
+#define UBX_DDC_PORT_ID                 0u
+#define UBX_DDC_TX_READY                0x083Du        // TX ready on the data ready pin, as wired to the modem
+#define UBX_DDC_ADDRESS_MODE            (0x42u << 1)   // ZOE-M8 I2C address in CFG-PRT mode field
+#define UBX_PROTOCOL_UBX                0x0001u
+#define UBX_PROTOCOL_NMEA               0x0002u
+
+#define UBX_MAX_FRAME_SIZE              (UBX_CFG_PRT_PAYLOAD_SIZE + UBX_FRAME_OVERHEAD)
+
+typedef enum
+{
+    UBX_STATE_SYNC_1 = 0,
+    UBX_STATE_SYNC_2,
+    UBX_STATE_CLASS,
+    UBX_STATE_ID,
+    UBX_STATE_LENGTH_1,
+    UBX_STATE_LENGTH_2,
+    UBX_STATE_PAYLOAD,
+    UBX_STATE_CHECKSUM_A,
+    UBX_STATE_CHECKSUM_B,
+}UBX_STATE_t;
+
+//! UBX frame scanner, kept across +UI2CR reads as a frame may be split
+typedef struct
+{
+    uint8_t  state;
+    uint8_t  msgClass;
+    uint8_t  msgId;
+    uint8_t  checksumA;
+    uint8_t  checksumB;
+    uint16_t length;
+    uint16_t received;
+    uint8_t  payload[UBX_NAV_PVT_PAYLOAD_SIZE];
+}UBXParser_t;
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static UBXParser_t ubxParser;
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void UBXChecksumUpdate(uint8_t data, uint8_t *checksumA, uint8_t *checksumB);
+static int32_t UBXParseByte(uint8_t data);
+static uint8_t HexToNibble(uint8_t ch);
+static uint32_t GetLittleEndian(uint8_t const data[], uint8_t size);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static void UBXChecksumUpdate(uint8_t data, uint8_t *checksumA, uint8_t *checksumB)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function add a byte to the UBX 8-bit Fletcher checksum
+//
+//------------------------------------------------------------------------------
+static void UBXChecksumUpdate(uint8_t data, uint8_t *checksumA, uint8_t *checksumB)
+{
+    *checksumA += data;
+    *checksumB += *checksumA;
+}
+
+//------------------------------------------------------------------------------
+//  static int32_t UBXParseByte(uint8_t data)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function run one byte through the frame scanner. 0xFF filler sent by
+//!  the receiver when its I2C buffer is empty is skipped while hunting sync.
+//!
+//! \return 1 when a NAV-PVT frame with valid checksum is complete, 0 otherwise
+//!         or ERR_UBX_CHECKSUM_MISMATCH
+//
+//------------------------------------------------------------------------------
+static int32_t UBXParseByte(uint8_t data)
+{
+    int32_t ret = 0;
+    UBXParser_t *parser = &ubxParser;
+
+    switch(parser->state)
+    {
+    case UBX_STATE_SYNC_1:
+        if(data == UBX_SYNC_CHAR_1)
+        {
+            parser->state = UBX_STATE_SYNC_2;
+        }
+        break;
+
+    case UBX_STATE_SYNC_2:
+        if(data == UBX_SYNC_CHAR_2)
+        {
+            parser->checksumA = 0;
+            parser->checksumB = 0;
+            parser->state = UBX_STATE_CLASS;
+        }
+        else if(data != UBX_SYNC_CHAR_1)
+        {
+            parser->state = UBX_STATE_SYNC_1;
+        }
+        break;
+
+    case UBX_STATE_CLASS:
+        UBXChecksumUpdate(data, &parser->checksumA, &parser->checksumB);
+        parser->msgClass = data;
+        parser->state = UBX_STATE_ID;
+        break;
+
+    case UBX_STATE_ID:
+        UBXChecksumUpdate(data, &parser->checksumA, &parser->checksumB);
+        parser->msgId = data;
+        parser->state = UBX_STATE_LENGTH_1;
+        break;
+
+    case UBX_STATE_LENGTH_1:
+        UBXChecksumUpdate(data, &parser->checksumA, &parser->checksumB);
+        parser->length = data;
+        parser->state = UBX_STATE_LENGTH_2;
+        break;
+
+    case UBX_STATE_LENGTH_2:
+        UBXChecksumUpdate(data, &parser->checksumA, &parser->checksumB);
+        parser->length |= (uint16_t)((uint16_t)data << 8);
+        parser->received = 0;
+        parser->state = (parser->length > 0u) ? UBX_STATE_PAYLOAD : UBX_STATE_CHECKSUM_A;
+        break;
+
+    case UBX_STATE_PAYLOAD:
+        UBXChecksumUpdate(data, &parser->checksumA, &parser->checksumB);
+        // Only NAV-PVT is stored, other frames are checked and dropped
+        if(parser->received < UBX_NAV_PVT_PAYLOAD_SIZE)
+        {
+            parser->payload[parser->received] = data;
+        }
+        parser->received++;
+        if(parser->received >= parser->length)
+        {
+            parser->state = UBX_STATE_CHECKSUM_A;
+        }
+        break;
+
+    case UBX_STATE_CHECKSUM_A:
+        parser->state = (data == parser->checksumA) ? UBX_STATE_CHECKSUM_B : UBX_STATE_SYNC_1;
+        if(parser->state == UBX_STATE_SYNC_1)
+        {
+            ret = ERR_UBX_CHECKSUM_MISMATCH;
+        }
+        break;
+
+    case UBX_STATE_CHECKSUM_B:
+        if(data != parser->checksumB)
+        {
+            ret = ERR_UBX_CHECKSUM_MISMATCH;
+        }
+        else if((parser->msgClass == UBX_CLASS_NAV) && (parser->msgId == UBX_ID_NAV_PVT) && (parser->length == UBX_NAV_PVT_PAYLOAD_SIZE))
+        {
+            ret = 1;
+        }
+        parser->state = UBX_STATE_SYNC_1;
+        break;
+
+    default:
+        parser->state = UBX_STATE_SYNC_1;
+        break;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static uint8_t HexToNibble(uint8_t ch)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function convert a hex digit, 0xFF if not hex
+//
+//------------------------------------------------------------------------------
+static uint8_t HexToNibble(uint8_t ch)
+{
+    uint8_t ret = 0xFF;
+
+    if((ch >= '0') && (ch <= '9'))
+    {
+        ret = ch - '0';
+    }
+    else if((ch >= 'A') && (ch <= 'F'))
+    {
+        ret = ch - 'A' + 10u;
+    }
+    else if((ch >= 'a') && (ch <= 'f'))
+    {
+        ret = ch - 'a' + 10u;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static uint32_t GetLittleEndian(uint8_t const data[], uint8_t size)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read a little endian field of 1 to 4 bytes
+//
+//------------------------------------------------------------------------------
+static uint32_t GetLittleEndian(uint8_t const data[], uint8_t size)
+{
+    uint32_t value = 0;
+
+    while(size > 0u)
+    {
+        size--;
+        value = (value << 8) | data[size];
+    }
+
+    return value;
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  uint32_t GPSCreateUBXFrame(uint8_t msgClass, uint8_t msgId, uint8_t const payload[], uint16_t payloadSize, uint8_t frame[], uint32_t frameSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function wrap a payload in a UBX frame, returns frame size or 0
+//
+//------------------------------------------------------------------------------
+uint32_t GPSCreateUBXFrame(uint8_t msgClass, uint8_t msgId, uint8_t const payload[], uint16_t payloadSize, uint8_t frame[], uint32_t frameSize)
+{
+    uint32_t size = 0, i = 0;
+    uint8_t checksumA = 0, checksumB = 0;
+
+    if(frameSize >= (uint32_t)(payloadSize + UBX_FRAME_OVERHEAD))
+    {
+        frame[0] = UBX_SYNC_CHAR_1;
+        frame[1] = UBX_SYNC_CHAR_2;
+        frame[2] = msgClass;
+        frame[3] = msgId;
+        frame[4] = (uint8_t)(payloadSize & 0xFFu);
+        frame[5] = (uint8_t)(payloadSize >> 8);
+        if(payloadSize > 0u)
+        {
+            memcpy(&frame[6], payload, payloadSize);
+        }
+        size = 6u + payloadSize;
+
+        // Checksum covers class, id, length and payload
+        for(i = 2u; i < size; i++)
+        {
+            UBXChecksumUpdate(frame[i], &checksumA, &checksumB);
+        }
+        frame[size++] = checksumA;
+        frame[size++] = checksumB;
+    }
+
+    return size;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t GPSCreateI2CWriteCommand(uint8_t const frame[], uint32_t frameSize, uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create AT+UI2CW="<hex>",<length> for a UBX frame
+//
+//------------------------------------------------------------------------------
+int32_t GPSCreateI2CWriteCommand(uint8_t const frame[], uint32_t frameSize, uint8_t buffer[], uint32_t bufferSize)
+{
+    int32_t size = 0;
+    uint32_t i = 0;
+
+    size = snprintf((char *)buffer, bufferSize, "AT+UI2CW=\"");
+    for(i = 0; (i < frameSize) && (size > 0) && ((uint32_t)size < bufferSize); i++)
+    {
+        size += snprintf((char *)&buffer[size], (bufferSize - size), "%02X", frame[i]);
+    }
+    if((size > 0) && ((uint32_t)size < bufferSize))
+    {
+        size += snprintf((char *)&buffer[size], (bufferSize - size), "\",%u\r\n", (unsigned int)frameSize);
+    }
+    if((size <= 0) || ((uint32_t)size >= bufferSize))
+    {
+        size = ERR_UBX_BUFFER_TOO_SMALL;
+    }
+
+    return size;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t GPSCreateConfigPortCommand(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create AT+UI2CW with UBX-CFG-PRT setting the I2C port to UBX output only
+//
+//------------------------------------------------------------------------------
+int32_t GPSCreateConfigPortCommand(uint8_t buffer[], uint32_t bufferSize)
+{
+    uint8_t payload[UBX_CFG_PRT_PAYLOAD_SIZE] = {0};
+    uint8_t frame[UBX_MAX_FRAME_SIZE];
+    uint32_t frameSize = 0;
+
+    payload[0]  = UBX_DDC_PORT_ID;
+    payload[2]  = (uint8_t)(UBX_DDC_TX_READY & 0xFFu);
+    payload[3]  = (uint8_t)(UBX_DDC_TX_READY >> 8);
+    payload[4]  = UBX_DDC_ADDRESS_MODE;
+    payload[12] = (uint8_t)(UBX_PROTOCOL_UBX | UBX_PROTOCOL_NMEA);  // inProtoMask
+    payload[14] = (uint8_t)UBX_PROTOCOL_UBX;                        // outProtoMask, no NMEA in the stream
+
+    frameSize = GPSCreateUBXFrame(UBX_CLASS_CFG, UBX_ID_CFG_PRT, payload, sizeof(payload), frame, sizeof(frame));
+
+    return GPSCreateI2CWriteCommand(frame, frameSize, buffer, bufferSize);
+}
+
+//------------------------------------------------------------------------------
+//  int32_t GPSCreatePollNavPvtCommand(uint8_t buffer[], uint32_t bufferSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create AT+UI2CW with the UBX-NAV-PVT poll request
+//
+//------------------------------------------------------------------------------
+int32_t GPSCreatePollNavPvtCommand(uint8_t buffer[], uint32_t bufferSize)
+{
+    uint8_t frame[UBX_FRAME_OVERHEAD];
+    uint32_t frameSize = 0;
+
+    // A new poll starts a new answer, drop any half received frame
+    ubxParser.state = UBX_STATE_SYNC_1;
+    frameSize = GPSCreateUBXFrame(UBX_CLASS_NAV, UBX_ID_NAV_PVT, NULL, 0, frame, sizeof(frame));
+
+    return GPSCreateI2CWriteCommand(frame, frameSize, buffer, bufferSize);
+}
+
+//------------------------------------------------------------------------------
+//  int32_t GPSParseNavPvtResponse(uint8_t const response[], uint32_t length, UBXNavPvt_t *navPvt)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse the hex data of a +UI2CR response. A frame split over
+//!  two reads is completed by the next call.
+//!
+//! \return 0 when navPvt is filled, ERR_UBX_FRAME_NOT_FOUND when more data
+//!         is needed or ERR_UBX_CHECKSUM_MISMATCH
+//
+//------------------------------------------------------------------------------
+int32_t GPSParseNavPvtResponse(uint8_t const response[], uint32_t length, UBXNavPvt_t *navPvt)
+{
+    int32_t ret = ERR_UBX_FRAME_NOT_FOUND;
+    int32_t result = 0;
+    uint8_t const *data = (uint8_t const *)strstr((char const *)response, "+UI2CR:");
+    uint8_t const *end = &response[length];
+    uint8_t highNibble = 0, lowNibble = 0;
+    uint8_t *payload = ubxParser.payload;
+
+    if(data != NULL)
+    {
+        data += 7;
+        // Skip separators up to the hex data
+        while((data < end) && (HexToNibble(*data) == 0xFF) && (*data != '\r'))
+        {
+            data++;
+        }
+
+        while(((data + 1) < end) && (ret == ERR_UBX_FRAME_NOT_FOUND))
+        {
+            highNibble = HexToNibble(data[0]);
+            lowNibble = HexToNibble(data[1]);
+            if((highNibble == 0xFF) || (lowNibble == 0xFF))
+            {
+                break;
+            }
+            data += 2;
+
+            result = UBXParseByte((uint8_t)((highNibble << 4) | lowNibble));
+            if(result == 1)
+            {
+                ret = 0;
+            }
+            else if(result < 0)
+            {
+                ret = result;
+            }
+        }
+    }
+
+    if(ret == 0)
+    {
+        navPvt->iTOW      = GetLittleEndian(&payload[0], 4);
+        navPvt->year      = (uint16_t)GetLittleEndian(&payload[4], 2);
+        navPvt->month     = payload[6];
+        navPvt->day       = payload[7];
+        navPvt->hour      = payload[8];
+        navPvt->minute    = payload[9];
+        navPvt->second    = payload[10];
+        navPvt->valid     = payload[11];
+        navPvt->fixType   = payload[20];
+        navPvt->flags     = payload[21];
+        navPvt->numSV     = payload[23];
+        navPvt->longitude = (int32_t)GetLittleEndian(&payload[24], 4);
+        navPvt->latitude  = (int32_t)GetLittleEndian(&payload[28], 4);
+        navPvt->heightMSL = (int32_t)GetLittleEndian(&payload[36], 4);
+        navPvt->hAcc      = GetLittleEndian(&payload[40], 4);
+        navPvt->pDOP      = (uint16_t)GetLittleEndian(&payload[76], 2);
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  void GPSUpdateCoordinates(UBXNavPvt_t const *navPvt)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function copy a NAV-PVT solution to the coordinates attached to events
+//
+//------------------------------------------------------------------------------
+void GPSUpdateCoordinates(UBXNavPvt_t const *navPvt)
+{
+    bool isFixValid = false;
+
+    isFixValid = ((navPvt->flags & UBX_NAV_PVT_FLAG_FIX_OK) != 0u) &&
+                 (navPvt->fixType >= UBX_FIX_TYPE_2D) && (navPvt->fixType <= UBX_FIX_TYPE_GNSS_DEAD_RECKONING);
+
+    if(isFixValid == true)
+    {
+        // 1e-7 degrees to micro-degrees, rounded away from zero
+        GPSReceivedCoordinates.latitude  = (navPvt->latitude >= 0) ? ((navPvt->latitude + 5) / 10) : ((navPvt->latitude - 5) / 10);
+        GPSReceivedCoordinates.longitude = (navPvt->longitude >= 0) ? ((navPvt->longitude + 5) / 10) : ((navPvt->longitude - 5) / 10);
+        GPSReceivedCoordinates.horizantalDilution = navPvt->pDOP;
+        GPSReceivedCoordinates.uncertainty = (navPvt->hAcc + 999u) / 1000u;
+        GPSReceivedCoordinates.fixTicks = GetRTCTicks();
+        GPSReceivedCoordinates.source = POSITION_SOURCE_GNSS;
+        GPSReceivedCoordinates.accuracy = 1u;
+    }
+    else
+    {
+        GPSReceivedCoordinates.accuracy = 0u;
+    }
+    GPSReceivedCoordinates.isGpsValid = isFixValid;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
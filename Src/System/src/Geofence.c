@@ -0,0 +1,591 @@
+//==============================================================================
+//
+//  Geofence.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        Geofence.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the geofence engine, set parsing and the circle and
+//! polygon tests.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "Geofence.h"
+
+#include <string.h>
+
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define NORTH_DM_PER_MICRO_DEGREE_Q16   72955       //!< 0.11132 m, Q16
+#define MICRO_DEGREES_PER_COS_STEP      10000000    //!< 10 degrees
+#define MICRO_DEGREES_QUARTER_CIRCLE    90000000
+#define MICRO_DEGREES_HALF_CIRCLE       180000000
+#define DECIMETERS_PER_METER            10
+
+#define MAX_INTEGER_DIGITS              10u
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+//! cos(latitude) in Q15 for every 10 degrees, interpolated in between
+static const uint16_t cosTableQ15[] = {32768u, 32270u, 30792u, 28378u, 25102u, 21063u, 16384u, 11207u, 5690u, 0u};
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static char const* SkipSpaces(char const *text, char const *end);
+static char const* ExpectChar(char const *text, char const *end, char expected);
+static char const* ParseInteger(char const *text, char const *end, int32_t *value);
+static char const* ParseFence(char const *text, char const *end, GeofenceFence_t *fence);
+static int64_t EdgeDistanceSquare(int64_t aEast, int64_t aNorth, int64_t bEast, int64_t bNorth, int64_t east, int64_t north);
+static bool IsInsidePolygon(GeofenceShape_t const *shape, int64_t east, int64_t north);
+static bool IsInShape(GeofenceShape_t const *shape, int32_t latitude, int32_t longitude, int32_t margin);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static char const* SkipSpaces(char const *text, char const *end)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function skip JSON white space
+//
+//------------------------------------------------------------------------------
+static char const* SkipSpaces(char const *text, char const *end)
+{
+    while((text != NULL) && (text < end) && ((*text == ' ') || (*text == '\t') || (*text == '\r') || (*text == '\n')))
+    {
+        text++;
+    }
+    return text;
+}
+
+//------------------------------------------------------------------------------
+//  static char const* ExpectChar(char const *text, char const *end, char expected)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function consume the expected character after white space
+//!
+//! \return pointer after it or NULL
+//
+//------------------------------------------------------------------------------
+static char const* ExpectChar(char const *text, char const *end, char expected)
+{
+    text = SkipSpaces(text, end);
+
+    return ((text != NULL) && (text < end) && (*text == expected)) ? &text[1] : NULL;
+}
+
+//------------------------------------------------------------------------------
+//  static char const* ParseInteger(char const *text, char const *end, int32_t *value)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse a signed decimal integer
+//!
+//! \return pointer after the number or NULL when there are no digits or it
+//!         does not fit 32 bits
+//
+//------------------------------------------------------------------------------
+static char const* ParseInteger(char const *text, char const *end, int32_t *value)
+{
+    bool isNegative = false;
+    int64_t number = 0;
+    uint32_t digits = 0;
+
+    text = SkipSpaces(text, end);
+    if((text != NULL) && (text < end) && (*text == '-'))
+    {
+        isNegative = true;
+        text++;
+    }
+    while((text != NULL) && (text < end) && (*text >= '0') && (*text <= '9') && (digits <= MAX_INTEGER_DIGITS))
+    {
+        number = (number * 10) + (*text - '0');
+        digits++;
+        text++;
+    }
+    number = (isNegative == true) ? -number : number;
+
+    if((digits == 0u) || (digits > MAX_INTEGER_DIGITS) || (number > INT32_MAX) || (number < INT32_MIN))
+    {
+        text = NULL;
+    }
+    else
+    {
+        *value = (int32_t)number;
+    }
+
+    return text;
+}
+
+//------------------------------------------------------------------------------
+//  static char const* ParseFence(char const *text, char const *end, GeofenceFence_t *fence)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse one fence array [id,type,radius,lat,lon,...]
+//!
+//! \return pointer after the closing bracket or NULL
+//
+//------------------------------------------------------------------------------
+static char const* ParseFence(char const *text, char const *end, GeofenceFence_t *fence)
+{
+    int32_t id = 0, type = 0, radius = 0;
+
+    text = ExpectChar(text, end, '[');
+    text = ParseInteger(text, end, &id);
+    text = ExpectChar(text, end, ',');
+    text = ParseInteger(text, end, &type);
+    text = ExpectChar(text, end, ',');
+    text = ParseInteger(text, end, &radius);
+
+    fence->vertexCount = 0;
+    while((text != NULL) && (ExpectChar(text, end, ',') != NULL))
+    {
+        if(fence->vertexCount >= GEOFENCE_MAX_VERTICES)
+        {
+            text = NULL;
+        }
+        else
+        {
+            text = ParseInteger(ExpectChar(text, end, ','), end, &fence->latitude[fence->vertexCount]);
+            text = ExpectChar(text, end, ',');
+            text = ParseInteger(text, end, &fence->longitude[fence->vertexCount]);
+            fence->vertexCount++;
+        }
+    }
+    text = ExpectChar(text, end, ']');
+
+    if((text != NULL) && (id > (int32_t)GEOFENCE_ID_NONE) && (id <= UINT8_MAX) && (radius >= 0) &&
+       (((type == GEOFENCE_TYPE_CIRCLE) && (fence->vertexCount == 1u) && (radius > 0)) ||
+        ((type == GEOFENCE_TYPE_POLYGON) && (fence->vertexCount >= GEOFENCE_MIN_POLYGON_VERTICES))))
+    {
+        fence->id = (uint8_t)id;
+        fence->type = (uint8_t)type;
+        fence->radius = (uint32_t)radius;
+    }
+    else
+    {
+        text = NULL;
+    }
+
+    return text;
+}
+
+//------------------------------------------------------------------------------
+//  static int64_t EdgeDistanceSquare(int64_t aEast, int64_t aNorth, int64_t bEast, int64_t bNorth, int64_t east, int64_t north)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the squared distance of a point from the edge a-b,
+//!  coordinates are bounded by GEOFENCE_MAX_EXTENT_DM so products fit 64 bits
+//
+//------------------------------------------------------------------------------
+static int64_t EdgeDistanceSquare(int64_t aEast, int64_t aNorth, int64_t bEast, int64_t bNorth, int64_t east, int64_t north)
+{
+    int64_t edgeEast = bEast - aEast;
+    int64_t edgeNorth = bNorth - aNorth;
+    int64_t lengthSquare = (edgeEast * edgeEast) + (edgeNorth * edgeNorth);
+    int64_t dot = ((east - aEast) * edgeEast) + ((north - aNorth) * edgeNorth);
+    int64_t deltaEast = east - aEast;
+    int64_t deltaNorth = north - aNorth;
+
+    if((dot > 0) && (dot >= lengthSquare))
+    {
+        // Beyond b
+        deltaEast = east - bEast;
+        deltaNorth = north - bNorth;
+    }
+    else if(dot > 0)
+    {
+        // Foot of perpendicular on the edge
+        deltaEast = east - (aEast + ((edgeEast * dot) / lengthSquare));
+        deltaNorth = north - (aNorth + ((edgeNorth * dot) / lengthSquare));
+    }
+
+    return (deltaEast * deltaEast) + (deltaNorth * deltaNorth);
+}
+
+//------------------------------------------------------------------------------
+//  static bool IsInsidePolygon(GeofenceShape_t const *shape, int64_t east, int64_t north)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function count crossings of a ray going east from the point, odd
+//!  count is inside. Intersections are compared by cross multiplication.
+//
+//------------------------------------------------------------------------------
+static bool IsInsidePolygon(GeofenceShape_t const *shape, int64_t east, int64_t north)
+{
+    bool isInside = false;
+    uint32_t current = 0, previous = (uint32_t)shape->vertexCount - 1u;
+    int64_t crossing = 0, edge = 0;
+
+    for(current = 0; current < shape->vertexCount; previous = current++)
+    {
+        if((shape->north[current] > north) != (shape->north[previous] > north))
+        {
+            edge = (int64_t)shape->north[previous] - shape->north[current];
+            crossing = ((int64_t)shape->east[previous] - shape->east[current]) * (north - shape->north[current]);
+            // Point is west of the intersection
+            if(((edge > 0) && (((east - shape->east[current]) * edge) < crossing)) ||
+               ((edge < 0) && (((east - shape->east[current]) * edge) > crossing)))
+            {
+                isInside = !isInside;
+            }
+        }
+    }
+
+    return isInside;
+}
+
+//------------------------------------------------------------------------------
+//  static bool IsInShape(GeofenceShape_t const *shape, int32_t latitude, int32_t longitude, int32_t margin)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function test a fix against a fence grown by margin (decimeters),
+//!  a negative margin shrinks it
+//
+//------------------------------------------------------------------------------
+static bool IsInShape(GeofenceShape_t const *shape, int32_t latitude, int32_t longitude, int32_t margin)
+{
+    bool ret = false;
+    int64_t deltaLongitude = (int64_t)longitude - shape->referenceLongitude;
+    int64_t east = 0, north = 0, distance = 0, minDistance = INT64_MAX;
+    int32_t growth = (margin > 0) ? margin : 0;
+    uint32_t current = 0, previous = 0;
+
+    // Shortest way across the antimeridian
+    if(deltaLongitude > MICRO_DEGREES_HALF_CIRCLE)
+    {
+        deltaLongitude -= 2 * (int64_t)MICRO_DEGREES_HALF_CIRCLE;
+    }
+    else if(deltaLongitude < -MICRO_DEGREES_HALF_CIRCLE)
+    {
+        deltaLongitude += 2 * (int64_t)MICRO_DEGREES_HALF_CIRCLE;
+    }
+    east = (deltaLongitude * shape->eastScaleQ16) >> 16;
+    north = (((int64_t)latitude - shape->referenceLatitude) * NORTH_DM_PER_MICRO_DEGREE_Q16) >> 16;
+
+    // Most fixes are far from most fences
+    if((east >= ((int64_t)shape->minEast - growth)) && (east <= ((int64_t)shape->maxEast + growth)) &&
+       (north >= ((int64_t)shape->minNorth - growth)) && (north <= ((int64_t)shape->maxNorth + growth)))
+    {
+        if(shape->type == GEOFENCE_TYPE_CIRCLE)
+        {
+            distance = (int64_t)shape->radius + margin;
+            ret = (distance >= 0) && (((east * east) + (north * north)) <= (distance * distance));
+        }
+        else
+        {
+            ret = IsInsidePolygon(shape, east, north);
+            if(margin != 0)
+            {
+                previous = (uint32_t)shape->vertexCount - 1u;
+                for(current = 0; current < shape->vertexCount; previous = current++)
+                {
+                    distance = EdgeDistanceSquare(shape->east[previous], shape->north[previous],
+                                                  shape->east[current], shape->north[current], east, north);
+                    minDistance = (distance < minDistance) ? distance : minDistance;
+                }
+                if(margin > 0)
+                {
+                    ret = (ret == true) || (minDistance <= ((int64_t)margin * margin));
+                }
+                else
+                {
+                    ret = (ret == true) && (minDistance >= ((int64_t)margin * margin));
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  uint32_t GeofenceCosineQ15(int32_t latitude)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns cos of latitude (micro-degrees) in Q15, linear
+//!  interpolation keeps the error below half a percent
+//
+//------------------------------------------------------------------------------
+uint32_t GeofenceCosineQ15(int32_t latitude)
+{
+    uint32_t absLatitude = (uint32_t)((latitude < 0) ? -latitude : latitude);
+    uint32_t index = absLatitude / MICRO_DEGREES_PER_COS_STEP;
+    uint32_t fraction = absLatitude % MICRO_DEGREES_PER_COS_STEP;
+    uint32_t ret = 0;
+
+    if(index < ((sizeof(cosTableQ15) / sizeof(cosTableQ15[0])) - 1u))
+    {
+        ret = cosTableQ15[index] - (uint32_t)(((uint64_t)(cosTableQ15[index] - cosTableQ15[index + 1u]) * fraction) / MICRO_DEGREES_PER_COS_STEP);
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t GeofenceParseSet(char const text[], uint32_t length, GeofenceSet_t *set)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse a fence set downloaded from iNet. Format is a JSON
+//!  array of the set version followed by one array per fence,
+//!  [id,type,radius,lat,lon,...] with coordinates in integer micro-degrees,
+//!  e.g. [3,[1,0,150,40438185,-79999422],[2,1,0,40440000,-80001000,...]]
+//!
+//! \return 0 or ERR_GEOFENCE_PARSE_FAILED
+//
+//------------------------------------------------------------------------------
+int32_t GeofenceParseSet(char const text[], uint32_t length, GeofenceSet_t *set)
+{
+    int32_t ret = ERR_GEOFENCE_PARSE_FAILED;
+    char const *end = &text[length];
+    int32_t version = 0;
+
+    memset(set, 0, sizeof(GeofenceSet_t));
+    text = ExpectChar(text, end, '[');
+    text = ParseInteger(text, end, &version);
+
+    while((text != NULL) && (ExpectChar(text, end, ',') != NULL))
+    {
+        if(set->count >= GEOFENCE_MAX_FENCES)
+        {
+            text = NULL;
+        }
+        else
+        {
+            text = ParseFence(ExpectChar(text, end, ','), end, &set->fences[set->count]);
+            set->count++;
+        }
+    }
+    text = ExpectChar(text, end, ']');
+
+    if((text != NULL) && (version > 0) && (version <= UINT16_MAX))
+    {
+        set->version = (uint16_t)version;
+        ret = 0;
+    }
+    else
+    {
+        memset(set, 0, sizeof(GeofenceSet_t));
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t GeofencePrepare(GeofenceSet_t const *set, GeofenceIndex_t *index)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function project the fences of a set around their reference points
+//!  and compute bounding boxes, done once when a set is loaded
+//!
+//! \return 0 or ERR_GEOFENCE_INVALID when a fence is malformed or too large
+//
+//------------------------------------------------------------------------------
+int32_t GeofencePrepare(GeofenceSet_t const *set, GeofenceIndex_t *index)
+{
+    int32_t ret = 0;
+    uint32_t fenceIndex = 0, vertex = 0;
+    GeofenceFence_t const *fence = NULL;
+    GeofenceShape_t *shape = NULL;
+    int32_t minLatitude = 0, maxLatitude = 0;
+    int64_t east = 0, north = 0, deltaLongitude = 0;
+
+    memset(index, 0, sizeof(GeofenceIndex_t));
+    if(set->count > GEOFENCE_MAX_FENCES)
+    {
+        ret = ERR_GEOFENCE_INVALID;
+    }
+
+    for(fenceIndex = 0; (ret == 0) && (fenceIndex < set->count); fenceIndex++)
+    {
+        fence = &set->fences[fenceIndex];
+        shape = &index->shapes[fenceIndex];
+        if((fence->id == GEOFENCE_ID_NONE) || (fence->vertexCount > GEOFENCE_MAX_VERTICES) ||
+           ((fence->type == GEOFENCE_TYPE_CIRCLE) && ((fence->vertexCount != 1u) || (fence->radius == 0u) ||
+                                                       (fence->radius > (uint32_t)(GEOFENCE_MAX_EXTENT_DM / DECIMETERS_PER_METER)))) ||
+           ((fence->type == GEOFENCE_TYPE_POLYGON) && (fence->vertexCount < GEOFENCE_MIN_POLYGON_VERTICES)) ||
+           (fence->type > GEOFENCE_TYPE_POLYGON))
+        {
+            ret = ERR_GEOFENCE_INVALID;
+            break;
+        }
+
+        minLatitude = fence->latitude[0];
+        maxLatitude = fence->latitude[0];
+        for(vertex = 0; vertex < fence->vertexCount; vertex++)
+        {
+            if((fence->latitude[vertex] > MICRO_DEGREES_QUARTER_CIRCLE) || (fence->latitude[vertex] < -MICRO_DEGREES_QUARTER_CIRCLE) ||
+               (fence->longitude[vertex] > MICRO_DEGREES_HALF_CIRCLE) || (fence->longitude[vertex] < -MICRO_DEGREES_HALF_CIRCLE))
+            {
+                ret = ERR_GEOFENCE_INVALID;
+            }
+            minLatitude = (fence->latitude[vertex] < minLatitude) ? fence->latitude[vertex] : minLatitude;
+            maxLatitude = (fence->latitude[vertex] > maxLatitude) ? fence->latitude[vertex] : maxLatitude;
+        }
+
+        shape->id = fence->id;
+        shape->type = fence->type;
+        shape->vertexCount = fence->vertexCount;
+        shape->referenceLatitude = fence->latitude[0];
+        shape->referenceLongitude = fence->longitude[0];
+        // Scale of the middle latitude, polygons are small against the earth
+        shape->eastScaleQ16 = (int32_t)(((int64_t)NORTH_DM_PER_MICRO_DEGREE_Q16 * GeofenceCosineQ15((int32_t)(((int64_t)minLatitude + maxLatitude) / 2))) >> 15);
+
+        if(fence->type == GEOFENCE_TYPE_CIRCLE)
+        {
+            shape->radius = (int32_t)fence->radius * DECIMETERS_PER_METER;
+            shape->minEast = -shape->radius;
+            shape->maxEast = shape->radius;
+            shape->minNorth = -shape->radius;
+            shape->maxNorth = shape->radius;
+        }
+        else
+        {
+            for(vertex = 0; (ret == 0) && (vertex < fence->vertexCount); vertex++)
+            {
+                deltaLongitude = (int64_t)fence->longitude[vertex] - shape->referenceLongitude;
+                if(deltaLongitude > MICRO_DEGREES_HALF_CIRCLE)
+                {
+                    deltaLongitude -= 2 * (int64_t)MICRO_DEGREES_HALF_CIRCLE;
+                }
+                else if(deltaLongitude < -MICRO_DEGREES_HALF_CIRCLE)
+                {
+                    deltaLongitude += 2 * (int64_t)MICRO_DEGREES_HALF_CIRCLE;
+                }
+                east = (deltaLongitude * shape->eastScaleQ16) >> 16;
+                north = (((int64_t)fence->latitude[vertex] - shape->referenceLatitude) * NORTH_DM_PER_MICRO_DEGREE_Q16) >> 16;
+                if((east > GEOFENCE_MAX_EXTENT_DM) || (east < -GEOFENCE_MAX_EXTENT_DM) ||
+                   (north > GEOFENCE_MAX_EXTENT_DM) || (north < -GEOFENCE_MAX_EXTENT_DM))
+                {
+                    ret = ERR_GEOFENCE_INVALID;
+                }
+                shape->east[vertex] = (int32_t)east;
+                shape->north[vertex] = (int32_t)north;
+                shape->minEast = (shape->east[vertex] < shape->minEast) ? shape->east[vertex] : shape->minEast;
+                shape->maxEast = (shape->east[vertex] > shape->maxEast) ? shape->east[vertex] : shape->maxEast;
+                shape->minNorth = (shape->north[vertex] < shape->minNorth) ? shape->north[vertex] : shape->minNorth;
+                shape->maxNorth = (shape->north[vertex] > shape->maxNorth) ? shape->north[vertex] : shape->maxNorth;
+            }
+        }
+        index->count++;
+    }
+
+    if(ret < 0)
+    {
+        memset(index, 0, sizeof(GeofenceIndex_t));
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  uint8_t GeofenceFindZone(GeofenceIndex_t const *index, int32_t latitude, int32_t longitude, uint8_t currentZone, uint32_t margin)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the fence holding a fix (micro-degrees). The
+//!  current zone is kept until the fix is more than margin (decimeters)
+//!  outside it, another fence is entered only when the fix is more than
+//!  margin inside it. Fixes close to a boundary therefore change nothing.
+//!
+//! \return fence id or GEOFENCE_ID_NONE
+//
+//------------------------------------------------------------------------------
+uint8_t GeofenceFindZone(GeofenceIndex_t const *index, int32_t latitude, int32_t longitude, uint8_t currentZone, uint32_t margin)
+{
+    uint8_t ret = GEOFENCE_ID_NONE;
+    uint32_t shapeIndex = 0;
+    int32_t signedMargin = (margin > (uint32_t)GEOFENCE_MAX_EXTENT_DM) ? GEOFENCE_MAX_EXTENT_DM : (int32_t)margin;
+    bool isZoneKept = false;
+
+    for(shapeIndex = 0; (currentZone != GEOFENCE_ID_NONE) && (shapeIndex < index->count); shapeIndex++)
+    {
+        if(index->shapes[shapeIndex].id == currentZone)
+        {
+            isZoneKept = IsInShape(&index->shapes[shapeIndex], latitude, longitude, signedMargin);
+            break;
+        }
+    }
+
+    if(isZoneKept == true)
+    {
+        ret = currentZone;
+    }
+    else
+    {
+        // Overlapping fences resolve to the first one of the set
+        for(shapeIndex = 0; shapeIndex < index->count; shapeIndex++)
+        {
+            if(IsInShape(&index->shapes[shapeIndex], latitude, longitude, -signedMargin) == true)
+            {
+                ret = index->shapes[shapeIndex].id;
+                break;
+            }
+        }
+    }
+
+    return ret;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,395 @@
+//==============================================================================
+//
+//  GeofenceMonitor.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        GeofenceMonitor.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the geofence monitor. The set is parsed in cellular
+//! task, applied, persisted and evaluated in SysTask, transitions are picked
+//! up by the instrument event creation.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "GeofenceMonitor.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "DataFlash.h"
+#include "Event.h"
+#include "SysTask.h"
+#include "Timer.h"
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define NAV_PVT_TO_MICRO_DEGREES        10
+#define MM_PER_DECIMETER                100u
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static GeofenceRecord_t fenceRecord;
+static GeofenceIndex_t fenceIndex;
+static GeofenceSet_t stagedSet;                 // Written by cellular task
+static volatile BOOLEAN isStagedPending = false;
+
+static volatile uint8_t currentZone = GEOFENCE_ID_NONE;
+static volatile BOOLEAN isTransitionPending = false;
+static BOOLEAN isFixEvaluated = false;
+static uint32_t lastFixTicks = 0;
+
+static GeofenceMonitorStats_t monitorStats = {0, 0, 0, 0, 0, 0};
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void GeofenceMonitorResetRecord(void);
+static int32_t NavPvtToMicroDegrees(int32_t value);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static void GeofenceMonitorResetRecord(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function clear the record to an empty set
+//
+//------------------------------------------------------------------------------
+static void GeofenceMonitorResetRecord(void)
+{
+    memset(&fenceRecord, 0, sizeof(fenceRecord));
+    fenceRecord.magic = GEOFENCE_MAGIC;
+    fenceRecord.version = GEOFENCE_RECORD_VERSION;
+    fenceRecord.size = sizeof(GeofenceRecord_t);
+    memset(&fenceIndex, 0, sizeof(fenceIndex));
+}
+
+//------------------------------------------------------------------------------
+//  static int32_t NavPvtToMicroDegrees(int32_t value)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function round 1e-7 degrees to micro-degrees
+//
+//------------------------------------------------------------------------------
+static int32_t NavPvtToMicroDegrees(int32_t value)
+{
+    return (value >= 0) ? ((value + 5) / NAV_PVT_TO_MICRO_DEGREES) : ((value - 5) / NAV_PVT_TO_MICRO_DEGREES);
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  int32_t GeofenceMonitorLoadFromFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read and prepare the fence set, called from SysTask at
+//!  start up
+//
+//------------------------------------------------------------------------------
+int32_t GeofenceMonitorLoadFromFlash(void)
+{
+    int32_t ret = 0;
+    uint8_t pageBuffer[DATAFLASH_BYTES_PER_PAGE] = {0};
+    uint32_t offset = 0, chunkSize = 0;
+    uint16_t pageNumber = GEOFENCE_FIRST_PAGE_NUMBER;
+
+    DataFlashDisablePowerSaving();
+    for(offset = 0; (ret >= 0) && (offset < sizeof(fenceRecord)); offset += chunkSize)
+    {
+        chunkSize = FIND_MIN((sizeof(fenceRecord) - offset), DATAFLASH_BYTES_PER_PAGE);
+        ret = DataFlashReadPage(pageNumber++, pageBuffer, DATAFLASH_BYTES_PER_PAGE);
+        if(ret >= 0)
+        {
+            memcpy(&((uint8_t *)&fenceRecord)[offset], pageBuffer, chunkSize);
+        }
+    }
+    DataFlashEnablePowerSaving();
+
+    if(ret >= 0)
+    {
+        if((fenceRecord.magic != GEOFENCE_MAGIC) || (fenceRecord.version != GEOFENCE_RECORD_VERSION) ||
+           (fenceRecord.size != sizeof(GeofenceRecord_t)))
+        {
+            ret = ERR_GEOFENCE_INVALID;
+        }
+        else
+        {
+            ret = GeofencePrepare(&fenceRecord.set, &fenceIndex);
+        }
+    }
+
+    if(ret < 0)
+    {
+        GeofenceMonitorResetRecord();
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t GeofenceMonitorSaveToFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function apply the set staged by GeofenceMonitorStageSet and
+//!  persist it. Called from SysTask which owns the DataFlash.
+//
+//------------------------------------------------------------------------------
+int32_t GeofenceMonitorSaveToFlash(void)
+{
+    int32_t ret = GeofencePrepare(&stagedSet, &fenceIndex);
+    uint32_t offset = 0, chunkSize = 0;
+    uint16_t pageNumber = GEOFENCE_FIRST_PAGE_NUMBER;
+
+    if(ret < 0)
+    {
+        // Keep evaluating the set held
+        monitorStats.setsRejected++;
+        (void)GeofencePrepare(&fenceRecord.set, &fenceIndex);
+    }
+    else
+    {
+        monitorStats.setsReceived++;
+        fenceRecord.set = stagedSet;
+        printf("Geofence set %u, %u fences\r\n", fenceRecord.set.version, fenceRecord.set.count);
+
+        DataFlashDisablePowerSaving();
+        for(offset = 0; (ret >= 0) && (offset < sizeof(fenceRecord)); offset += chunkSize)
+        {
+            chunkSize = FIND_MIN((sizeof(fenceRecord) - offset), DATAFLASH_BYTES_PER_PAGE);
+            ret = DataFlashErasePage(pageNumber);
+            if(ret >= 0)
+            {
+                ret = DataFlashWriteBuffer(0, &((uint8_t *)&fenceRecord)[offset], chunkSize);
+            }
+            if(ret >= 0)
+            {
+                ret = DataFlashWriteBufferToPage(pageNumber);
+            }
+            pageNumber++;
+        }
+        DataFlashEnablePowerSaving();
+    }
+    isStagedPending = false;
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t GeofenceMonitorStageSet(char const text[], uint32_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse a set received from iNet and ask SysTask to apply it
+//!  when its version differs from the one held
+//!
+//! \return 0 or ERR_GEOFENCE_PARSE_FAILED
+//
+//------------------------------------------------------------------------------
+int32_t GeofenceMonitorStageSet(char const text[], uint32_t length)
+{
+    int32_t ret = 0;
+    RTOS_ERR  err;
+    SysMsg_t *msg = NULL;
+
+    // iNet repeats the set until uploads report its version, a later response applies it
+    if(isStagedPending == false)
+    {
+        ret = GeofenceParseSet(text, length, &stagedSet);
+        if(ret < 0)
+        {
+            monitorStats.setsRejected++;
+        }
+        else if(stagedSet.version != fenceRecord.set.version)
+        {
+            msg = (SysMsg_t*)GetTaskMessageFromPool();
+            if(msg != NULL)
+            {
+                isStagedPending = true;
+                msg->msgId = SAVE_GEOFENCES_TO_FLASH;
+                msg->msgInfo = 1;
+                msg->ptrData = NULL;
+                OSTaskQPost(&SYSTaskTCB, (void *)msg, sizeof(SysMsg_t), OS_OPT_POST_FIFO, &err);
+            }
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  void GeofenceMonitorEvaluateFix(UBXNavPvt_t const *navPvt)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function find the zone of a fix and flag a transition when it
+//!  changes, called from SysTask for every fix of the GNSS duty cycle
+//
+//------------------------------------------------------------------------------
+void GeofenceMonitorEvaluateFix(UBXNavPvt_t const *navPvt)
+{
+    uint8_t zone = GEOFENCE_ID_NONE;
+    uint32_t marginMm = (navPvt->hAcc > GEOFENCE_MIN_MARGIN_MM) ? navPvt->hAcc : GEOFENCE_MIN_MARGIN_MM;
+
+    if(navPvt->hAcc > GEOFENCE_MAX_HACC_MM)
+    {
+        monitorStats.ignoredFixes++;
+    }
+    else if((fenceIndex.count > 0u) || (currentZone != GEOFENCE_ID_NONE))
+    {
+        monitorStats.evaluations++;
+        zone = GeofenceFindZone(&fenceIndex, NavPvtToMicroDegrees(navPvt->latitude), NavPvtToMicroDegrees(navPvt->longitude),
+                                currentZone, (marginMm / MM_PER_DECIMETER));
+        isFixEvaluated = true;
+        lastFixTicks = GetRTCTicks();
+
+        if(zone != currentZone)
+        {
+            if(currentZone != GEOFENCE_ID_NONE)
+            {
+                monitorStats.exits++;
+            }
+            if(zone != GEOFENCE_ID_NONE)
+            {
+                monitorStats.enters++;
+            }
+            printf("Geofence zone %u -> %u\r\n", currentZone, zone);
+            currentZone = zone;
+            isTransitionPending = true;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  BOOLEAN GeofenceMonitorIsTransitionPending(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when a zone was entered or left and no event
+//!  reported it yet
+//
+//------------------------------------------------------------------------------
+BOOLEAN GeofenceMonitorIsTransitionPending(void)
+{
+    return isTransitionPending;
+}
+
+//------------------------------------------------------------------------------
+//  void GeofenceMonitorClearTransition(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function acknowledge the transition once an event carries it
+//
+//------------------------------------------------------------------------------
+void GeofenceMonitorClearTransition(void)
+{
+    isTransitionPending = false;
+}
+
+//------------------------------------------------------------------------------
+//  BOOLEAN GeofenceMonitorIsInsideZone(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true while a recent fix holds the instrument in
+//!  the zone already reported
+//
+//------------------------------------------------------------------------------
+BOOLEAN GeofenceMonitorIsInsideZone(void)
+{
+    return (BOOLEAN)((currentZone != GEOFENCE_ID_NONE) && (isTransitionPending == false) && (isFixEvaluated == true) &&
+                     (RTCDRV_TicksToMsec(GetRTCTicks() - lastFixTicks) <= GEOFENCE_MAX_FIX_AGE_MS));
+}
+
+//------------------------------------------------------------------------------
+//  uint8_t GeofenceMonitorGetZone(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the current fence id or GEOFENCE_ID_NONE
+//
+//------------------------------------------------------------------------------
+uint8_t GeofenceMonitorGetZone(void)
+{
+    return currentZone;
+}
+
+//------------------------------------------------------------------------------
+//  uint16_t GeofenceMonitorGetSetVersion(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the version of the set held, 0 when none
+//
+//------------------------------------------------------------------------------
+uint16_t GeofenceMonitorGetSetVersion(void)
+{
+    return fenceRecord.set.version;
+}
+
+//------------------------------------------------------------------------------
+//  GeofenceMonitorStats_t const* GeofenceMonitorGetStats(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns evaluation and transition counts
+//
+//------------------------------------------------------------------------------
+GeofenceMonitorStats_t const* GeofenceMonitorGetStats(void)
+{
+    return &monitorStats;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,210 @@
+//==============================================================================
+//
+//  HttpHeader.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        HttpHeader.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the HTTP request header builder. Content-Length comes
+//! last in the header, it is the only field that changes per request.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "HttpHeader.h"
+
+#include <stdio.h>
+#include <string.h>
+
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static bool IsTemplateValid(HttpHeader_t const *header, uint32_t requestType, char const *url, uint8_t const buffer[]);
+static uint32_t PutContentLength(uint8_t buffer[], uint32_t contentLength);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static bool IsTemplateValid(HttpHeader_t const *header, uint32_t requestType, char const *url, uint8_t const buffer[])
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true when the buffer holds the header template of
+//!  the request type for the URL. Another user of the buffer, an SMS,
+//!  overwrites its request line.
+//
+//------------------------------------------------------------------------------
+static bool IsTemplateValid(HttpHeader_t const *header, uint32_t requestType, char const *url, uint8_t const buffer[])
+{
+    uint32_t urlLength = (uint32_t)strlen(url);
+    
+    return ((header->isValid == true) && (header->requestType == requestType) && (header->buffer == buffer) &&
+            (strncmp((char const*)buffer, "POST ", 5) == 0) &&
+            (strncmp((char const*)&buffer[5], url, urlLength) == 0) &&
+            (buffer[5u + urlLength] == ' '));
+}
+
+//------------------------------------------------------------------------------
+//  static uint32_t PutContentLength(uint8_t buffer[], uint32_t contentLength)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the Content-Length value and the blank line ending
+//!  the header, HTTP_CONTENT_LENGTH_MAX_SIZE bytes at most
+//!
+//! \return bytes written, the terminator excluded
+//
+//------------------------------------------------------------------------------
+static uint32_t PutContentLength(uint8_t buffer[], uint32_t contentLength)
+{
+    uint8_t digits[10];
+    uint32_t count = 0, size = 0;
+    
+    do
+    {
+        digits[count++] = (uint8_t)('0' + (contentLength % 10u));
+        contentLength /= 10u;
+    }while(contentLength > 0u);
+    
+    while(count > 0u)
+    {
+        buffer[size++] = digits[--count];
+    }
+    memcpy(&buffer[size], "\r\n\r\n", 5);
+    
+    return (size + 4u);
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  void HttpHeaderInvalidate(HttpHeader_t *header)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function drops the header template, the next request formats its
+//!  header again. Called when the authorization changes.
+//
+//------------------------------------------------------------------------------
+void HttpHeaderInvalidate(HttpHeader_t *header)
+{
+    header->isValid = false;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t HttpHeaderCreate(HttpHeader_t *header, uint32_t requestType, char const *url,
+//                           char const *host, char const *contentType, char const *authorization,
+//                           uint8_t buffer[], uint32_t bufferSize, uint32_t contentLength)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create the HTTP POST request header in buffer. The
+//!  Authorization field is left out when authorization is NULL. When the
+//!  header does not fit the buffer is left empty so no partial or stale
+//!  header can be written to the socket.
+//!
+//! \return header length or -1 when it does not fit
+//
+//------------------------------------------------------------------------------
+int32_t HttpHeaderCreate(HttpHeader_t *header, uint32_t requestType, char const *url,
+                         char const *host, char const *contentType, char const *authorization,
+                         uint8_t buffer[], uint32_t bufferSize, uint32_t contentLength)
+{
+    int32_t ret = -1;
+    
+    if(IsTemplateValid(header, requestType, url, buffer) == false)
+    {
+        header->isValid = false;
+        if(authorization == NULL)
+        {
+            ret = snprintf((char *)buffer, bufferSize, "POST %s HTTP/1.1\r\n"
+                           "Host: %s\r\n"
+                               "Connection: close\r\n"
+                                   "Content-Type: %s\r\n"
+                                       "Content-Length: ",
+                                       url,
+                                       host,
+                                       contentType);
+        }
+        else
+        {
+            ret = snprintf((char *)buffer, bufferSize, "POST %s HTTP/1.1\r\n"
+                           "Host: %s\r\n"
+                               "Connection: close\r\n"
+                                   "Content-Type: %s\r\n"
+                                       "Authorization: %s\r\n"
+                                           "Content-Length: ",
+                                           url,
+                                           host,
+                                           contentType,
+                                           authorization);
+        }
+        if((ret > 0) && (((uint32_t)ret + HTTP_CONTENT_LENGTH_MAX_SIZE) <= bufferSize))
+        {
+            header->buffer = buffer;
+            header->requestType = requestType;
+            header->contentLengthOffset = (uint32_t)ret;
+            header->isValid = true;
+        }
+    }
+    
+    if((header->isValid == true) && ((header->contentLengthOffset + HTTP_CONTENT_LENGTH_MAX_SIZE) <= bufferSize))
+    {
+        ret = (int32_t)(header->contentLengthOffset + PutContentLength(&buffer[header->contentLengthOffset], contentLength));
+    }
+    else
+    {
+        // Truncated header is never written
+        if(bufferSize > 0u)
+        {
+            buffer[0] = '\0';
+        }
+        ret = -1;
+    }
+    
+    return ret;
+}
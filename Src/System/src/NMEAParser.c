@@ -0,0 +1,506 @@
+//==============================================================================
+//
+//  NMEAParser.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        NMEAParser.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the single pass GGA/RMC/GSV parser. Every character is
+//! consumed as it arrives, numeric fields are accumulated as integers and no
+//! libc float or string function is used.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "NMEAParser.h"
+
+#include <string.h>
+
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+//! Digits after the decimal point kept per field, ddmm.mmmmm still fits uint32
+#define NMEA_MAX_DECIMALS               5u
+//! Decimals ddmm.mmmmm coordinates are normalized to
+#define NMEA_COORDINATE_DECIMALS        5u
+#define NMEA_MINUTES_PER_DEGREE_SCALED  (60u * 100000u)
+
+typedef enum
+{
+    NMEA_STATE_WAIT_START = 0,
+    NMEA_STATE_ADDRESS,
+    NMEA_STATE_FIELD,
+    NMEA_STATE_CHECKSUM,
+}NMEA_STATE_t;
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void NMEAStartField(NMEAParser_t *parser);
+static uint32_t NMEAScaleValue(uint32_t value, uint8_t decimals, uint8_t targetDecimals);
+static int32_t NMEACoordinateToMicroDegrees(uint32_t value, uint8_t decimals);
+static uint8_t NMEAHexValue(uint8_t ch);
+static void NMEAEndField(NMEAParser_t *parser);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static void NMEAStartField(NMEAParser_t *parser)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function clear the field accumulator
+//
+//------------------------------------------------------------------------------
+static void NMEAStartField(NMEAParser_t *parser)
+{
+    parser->value = 0;
+    parser->decimals = 0;
+    parser->isDecimal = false;
+    parser->isNegative = false;
+    parser->hasDigits = false;
+    parser->firstChar = '\0';
+}
+
+//------------------------------------------------------------------------------
+//  static uint32_t NMEAScaleValue(uint32_t value, uint8_t decimals, uint8_t targetDecimals)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function rescale an accumulated field to the wanted number of decimals
+//
+//------------------------------------------------------------------------------
+static uint32_t NMEAScaleValue(uint32_t value, uint8_t decimals, uint8_t targetDecimals)
+{
+    while(decimals < targetDecimals)
+    {
+        value *= 10u;
+        decimals++;
+    }
+    while(decimals > targetDecimals)
+    {
+        value /= 10u;
+        decimals--;
+    }
+
+    return value;
+}
+
+//------------------------------------------------------------------------------
+//  static int32_t NMEACoordinateToMicroDegrees(uint32_t value, uint8_t decimals)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function convert NMEA (d)ddmm.mmmmm to micro-degrees
+//
+//------------------------------------------------------------------------------
+static int32_t NMEACoordinateToMicroDegrees(uint32_t value, uint8_t decimals)
+{
+    uint32_t degrees = 0, minutes = 0;
+
+    value = NMEAScaleValue(value, decimals, NMEA_COORDINATE_DECIMALS);
+    degrees = value / (100u * 100000u);
+    minutes = value % (100u * 100000u);
+
+    // minutes are in 1e-5 so micro-degrees = minutes * 10 / 60, rounded
+    return (int32_t)((degrees * NMEA_MICRO_DEGREES_PER_DEGREE) + ((minutes + 3u) / 6u));
+}
+
+//------------------------------------------------------------------------------
+//  static uint8_t NMEAHexValue(uint8_t ch)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function convert a checksum hex digit, 0xFF if not hex
+//
+//------------------------------------------------------------------------------
+static uint8_t NMEAHexValue(uint8_t ch)
+{
+    uint8_t ret = 0xFF;
+
+    if((ch >= '0') && (ch <= '9'))
+    {
+        ret = ch - '0';
+    }
+    else if((ch >= 'A') && (ch <= 'F'))
+    {
+        ret = ch - 'A' + 10u;
+    }
+    else if((ch >= 'a') && (ch <= 'f'))
+    {
+        ret = ch - 'a' + 10u;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static void NMEAEndField(NMEAParser_t *parser)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function store the finished field into the staged fix. Empty fields
+//!  keep the previous value except the GGA coordinates which are cleared.
+//
+//------------------------------------------------------------------------------
+static void NMEAEndField(NMEAParser_t *parser)
+{
+    NMEAFix_t *staged = &parser->staged;
+    uint8_t field = parser->fieldIndex;
+
+    // RMC has the status at field 2, shift its position fields to GGA numbering
+    if((parser->sentence == NMEA_SENTENCE_RMC) && (field >= 3u))
+    {
+        field--;
+    }
+
+    if(parser->sentence == NMEA_SENTENCE_GSV)
+    {
+        if((field == 3u) && (parser->hasDigits == true))
+        {
+            staged->satellitesInView = (uint8_t)parser->value;
+        }
+    }
+    else
+    {
+        switch(field)
+        {
+        case 1:
+            if(parser->hasDigits == true)
+            {
+                staged->utcTime = NMEAScaleValue(parser->value, parser->decimals, 0);
+            }
+            break;
+
+        case 2:
+            if(parser->sentence == NMEA_SENTENCE_RMC)
+            {
+                if(parser->fieldIndex == 2u)
+                {
+                    staged->isRmcValid = (parser->firstChar == 'A');
+                }
+                else
+                {
+                    staged->latitude = NMEACoordinateToMicroDegrees(parser->value, parser->decimals);
+                }
+            }
+            else
+            {
+                staged->latitude = NMEACoordinateToMicroDegrees(parser->value, parser->decimals);
+            }
+            break;
+
+        case 3:
+            if(parser->firstChar == 'S')
+            {
+                staged->latitude = -staged->latitude;
+            }
+            break;
+
+        case 4:
+            staged->longitude = NMEACoordinateToMicroDegrees(parser->value, parser->decimals);
+            break;
+
+        case 5:
+            if(parser->firstChar == 'W')
+            {
+                staged->longitude = -staged->longitude;
+            }
+            break;
+
+        case 6:
+            if(parser->sentence == NMEA_SENTENCE_GGA)
+            {
+                staged->fixQuality = (uint8_t)parser->value;
+            }
+            break;
+
+        case 7:
+            if(parser->sentence == NMEA_SENTENCE_GGA)
+            {
+                staged->satellitesUsed = (uint8_t)parser->value;
+            }
+            break;
+
+        case 8:
+            if((parser->sentence == NMEA_SENTENCE_GGA) && (parser->hasDigits == true))
+            {
+                staged->hdop = (uint16_t)NMEAScaleValue(parser->value, parser->decimals, 2);
+            }
+            else if((parser->sentence == NMEA_SENTENCE_RMC) && (parser->hasDigits == true))
+            {
+                staged->utcDate = NMEAScaleValue(parser->value, parser->decimals, 0);
+            }
+            break;
+
+        case 9:
+            if((parser->sentence == NMEA_SENTENCE_GGA) && (parser->hasDigits == true))
+            {
+                staged->altitude = (int32_t)NMEAScaleValue(parser->value, parser->decimals, 1);
+                if(parser->isNegative == true)
+                {
+                    staged->altitude = -staged->altitude;
+                }
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  void NMEAParserInit(NMEAParser_t *parser)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function reset the parser and clear the fix
+//
+//------------------------------------------------------------------------------
+void NMEAParserInit(NMEAParser_t *parser)
+{
+    memset(parser, 0, sizeof(NMEAParser_t));
+    parser->state = NMEA_STATE_WAIT_START;
+}
+
+//------------------------------------------------------------------------------
+//  int32_t NMEAParserFeed(NMEAParser_t *parser, uint8_t ch)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function process one received character.
+//!
+//! \return NMEA_SENTENCE_t of a sentence completed with valid checksum,
+//!         NMEA_SENTENCE_NONE while in progress or
+//!         ERR_NMEA_CHECKSUM_MISMATCH
+//
+//------------------------------------------------------------------------------
+int32_t NMEAParserFeed(NMEAParser_t *parser, uint8_t ch)
+{
+    int32_t ret = NMEA_SENTENCE_NONE;
+    uint8_t nibble = 0;
+
+    if(ch == '$')
+    {
+        // Start of sentence always restarts, a truncated sentence is dropped
+        parser->state = NMEA_STATE_ADDRESS;
+        parser->sentence = NMEA_SENTENCE_NONE;
+        parser->checksum = 0;
+        parser->addressLength = 0;
+        parser->fieldIndex = 0;
+        parser->staged = parser->fix;
+    }
+    else if((ch == '\r') || (ch == '\n'))
+    {
+        if((parser->state != NMEA_STATE_WAIT_START) && (parser->state != NMEA_STATE_CHECKSUM))
+        {
+            ret = ERR_NMEA_SENTENCE_MALFORMED;
+        }
+        parser->state = NMEA_STATE_WAIT_START;
+    }
+    else
+    {
+        switch(parser->state)
+        {
+        case NMEA_STATE_ADDRESS:
+            parser->checksum ^= ch;
+            if(ch != ',')
+            {
+                // Keep the last three characters so any talker id matches
+                parser->address[0] = parser->address[1];
+                parser->address[1] = parser->address[2];
+                parser->address[2] = (char)ch;
+                parser->addressLength++;
+            }
+            else
+            {
+                if(parser->addressLength >= 3u)
+                {
+                    if(memcmp(parser->address, "GGA", 3) == 0)
+                    {
+                        parser->sentence = NMEA_SENTENCE_GGA;
+                    }
+                    else if(memcmp(parser->address, "RMC", 3) == 0)
+                    {
+                        parser->sentence = NMEA_SENTENCE_RMC;
+                    }
+                    else if(memcmp(parser->address, "GSV", 3) == 0)
+                    {
+                        parser->sentence = NMEA_SENTENCE_GSV;
+                    }
+                }
+
+                if(parser->sentence != NMEA_SENTENCE_NONE)
+                {
+                    parser->fieldIndex = 1;
+                    NMEAStartField(parser);
+                    parser->state = NMEA_STATE_FIELD;
+                }
+                else
+                {
+                    parser->state = NMEA_STATE_WAIT_START;
+                }
+            }
+            break;
+
+        case NMEA_STATE_FIELD:
+            if(ch == '*')
+            {
+                NMEAEndField(parser);
+                parser->receivedChecksum = 0;
+                parser->checksumDigits = 0;
+                parser->state = NMEA_STATE_CHECKSUM;
+            }
+            else
+            {
+                parser->checksum ^= ch;
+                if(ch == ',')
+                {
+                    NMEAEndField(parser);
+                    parser->fieldIndex++;
+                    NMEAStartField(parser);
+                }
+                else if((ch >= '0') && (ch <= '9'))
+                {
+                    parser->hasDigits = true;
+                    if(parser->isDecimal == false)
+                    {
+                        parser->value = (parser->value * 10u) + (ch - '0');
+                    }
+                    else if(parser->decimals < NMEA_MAX_DECIMALS)
+                    {
+                        parser->value = (parser->value * 10u) + (ch - '0');
+                        parser->decimals++;
+                    }
+                }
+                else if(ch == '.')
+                {
+                    parser->isDecimal = true;
+                }
+                else if(ch == '-')
+                {
+                    parser->isNegative = true;
+                }
+                else if(parser->firstChar == '\0')
+                {
+                    parser->firstChar = (char)ch;
+                }
+            }
+            break;
+
+        case NMEA_STATE_CHECKSUM:
+            nibble = NMEAHexValue(ch);
+            if((nibble == 0xFF) || (parser->checksumDigits >= 2u))
+            {
+                ret = ERR_NMEA_SENTENCE_MALFORMED;
+                parser->state = NMEA_STATE_WAIT_START;
+            }
+            else
+            {
+                parser->receivedChecksum = (uint8_t)((parser->receivedChecksum << 4) | nibble);
+                parser->checksumDigits++;
+                if(parser->checksumDigits == 2u)
+                {
+                    if(parser->receivedChecksum == parser->checksum)
+                    {
+                        parser->fix = parser->staged;
+                        parser->sentencesParsed++;
+                        ret = parser->sentence;
+                    }
+                    else
+                    {
+                        parser->checksumErrors++;
+                        ret = ERR_NMEA_CHECKSUM_MISMATCH;
+                    }
+                    parser->state = NMEA_STATE_WAIT_START;
+                }
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  uint32_t NMEAParserFeedBuffer(NMEAParser_t *parser, uint8_t const data[], uint32_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function feed a buffer and returns bit mask of completed sentences,
+//!  bit n set for NMEA_SENTENCE_t n
+//
+//------------------------------------------------------------------------------
+uint32_t NMEAParserFeedBuffer(NMEAParser_t *parser, uint8_t const data[], uint32_t length)
+{
+    uint32_t completed = 0, i = 0;
+    int32_t result = 0;
+
+    for(i = 0; i < length; i++)
+    {
+        result = NMEAParserFeed(parser, data[i]);
+        if(result > 0)
+        {
+            completed |= (1u << result);
+        }
+    }
+
+    return completed;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,328 @@
+//==============================================================================
+//
+//  Position.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        Position.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the event position selection and the CellLocate
+//! (AT+ULOC) request and response handling.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "Position.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Cellular.h"
+#include "Timer.h"
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define ULOC_SENSOR_CELL_LOCATE         2u          // GNSS belongs to the host, modem must not touch it
+#define ULOC_RESPONSE_TYPE_STANDARD     0u
+#define ULOC_MIN_TIMEOUT_SECONDS        1u
+#define MICRO_DEGREE_DIGITS             6u
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static uint32_t AbsTicksToMs(uint32_t firstTicks, uint32_t secondTicks);
+static char const* ParseMicroDegrees(char const *text, char const *end, int32_t *microDegrees);
+static char const* SkipFields(char const *text, char const *end, uint32_t fields);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+GPSInfo_t CellLocateCoordinates;
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static uint32_t AbsTicksToMs(uint32_t firstTicks, uint32_t secondTicks)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the distance of two tick stamps in milliseconds,
+//!  whichever comes first
+//
+//------------------------------------------------------------------------------
+static uint32_t AbsTicksToMs(uint32_t firstTicks, uint32_t secondTicks)
+{
+    int32_t delta = (int32_t)(secondTicks - firstTicks);
+
+    return RTCDRV_TicksToMsec((uint32_t)((delta < 0) ? -delta : delta));
+}
+
+//------------------------------------------------------------------------------
+//  static char const* ParseMicroDegrees(char const *text, char const *end, int32_t *microDegrees)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function convert decimal degrees text to micro-degrees, extra
+//!  decimals are truncated
+//!
+//! \return pointer after the number or NULL when there are no digits
+//
+//------------------------------------------------------------------------------
+static char const* ParseMicroDegrees(char const *text, char const *end, int32_t *microDegrees)
+{
+    BOOLEAN isNegative = false, hasDigits = false;
+    int32_t value = 0;
+    uint32_t decimals = 0;
+
+    if((text < end) && (*text == '-'))
+    {
+        isNegative = true;
+        text++;
+    }
+    while((text < end) && (*text >= '0') && (*text <= '9'))
+    {
+        value = (value * 10) + (*text - '0');
+        hasDigits = true;
+        text++;
+    }
+    if((text < end) && (*text == '.'))
+    {
+        text++;
+        while((text < end) && (*text >= '0') && (*text <= '9'))
+        {
+            if(decimals < MICRO_DEGREE_DIGITS)
+            {
+                value = (value * 10) + (*text - '0');
+                decimals++;
+            }
+            hasDigits = true;
+            text++;
+        }
+    }
+    for(; decimals < MICRO_DEGREE_DIGITS; decimals++)
+    {
+        value *= 10;
+    }
+    *microDegrees = (isNegative == true) ? -value : value;
+
+    return (hasDigits == true) ? text : NULL;
+}
+
+//------------------------------------------------------------------------------
+//  static char const* SkipFields(char const *text, char const *end, uint32_t fields)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function skip comma separated fields
+//!
+//! \return start of the next field or NULL at end of data
+//
+//------------------------------------------------------------------------------
+static char const* SkipFields(char const *text, char const *end, uint32_t fields)
+{
+    while((text != NULL) && (fields > 0u))
+    {
+        while((text < end) && (*text != ','))
+        {
+            text++;
+        }
+        text = (text < end) ? &text[1] : NULL;
+        fields--;
+    }
+    return text;
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  uint32_t PositionGetBudgetMs(EVENT_PRIORITY_t priority)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the position latency budget of an event priority
+//
+//------------------------------------------------------------------------------
+uint32_t PositionGetBudgetMs(EVENT_PRIORITY_t priority)
+{
+    uint32_t ret = POSITION_BUDGET_PERIODIC_MS;
+
+    if(priority == EVENT_PRIORITY_ALARM)
+    {
+        ret = POSITION_BUDGET_ALARM_MS;
+    }
+    else if(priority == EVENT_PRIORITY_STATE_CHANGE)
+    {
+        ret = POSITION_BUDGET_STATE_CHANGE_MS;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  BOOLEAN PositionSelect(GPSInfo_t *position, uint32_t eventTicks)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function replace an event position by the best one held: the GNSS
+//!  fix closest to the event time, event snapshot or latest, then the latest
+//!  CellLocate estimate, each only when close enough to the event time
+//!
+//! \return true when position is valid
+//
+//------------------------------------------------------------------------------
+BOOLEAN PositionSelect(GPSInfo_t *position, uint32_t eventTicks)
+{
+    BOOLEAN ret = true;
+    uint32_t snapshotAgeMs = AbsTicksToMs(position->fixTicks, eventTicks);
+    uint32_t latestAgeMs = AbsTicksToMs(GPSReceivedCoordinates.fixTicks, eventTicks);
+    BOOLEAN isSnapshotValid = (position->isGpsValid == true) && (position->source == POSITION_SOURCE_GNSS) &&
+                              (snapshotAgeMs <= POSITION_MAX_GNSS_AGE_MS);
+    BOOLEAN isLatestValid = (GPSReceivedCoordinates.isGpsValid == true) && (latestAgeMs <= POSITION_MAX_GNSS_AGE_MS);
+
+    // A fix read after the event, e.g. while its upload waited, may be closer than the snapshot
+    if((isLatestValid == true) && ((isSnapshotValid == false) || (latestAgeMs < snapshotAgeMs)))
+    {
+        *position = GPSReceivedCoordinates;
+    }
+    else if(isSnapshotValid == true)
+    {
+        // Snapshot taken at event creation is still the best
+    }
+    else if((CellLocateCoordinates.isGpsValid == true) &&
+            (AbsTicksToMs(CellLocateCoordinates.fixTicks, eventTicks) <= POSITION_MAX_CELL_LOCATE_AGE_MS))
+    {
+        *position = CellLocateCoordinates;
+    }
+    else
+    {
+        position->isGpsValid = false;
+        position->source = POSITION_SOURCE_NONE;
+        ret = false;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  uint32_t PositionCreateCellLocateCommand(uint8_t buffer[], uint32_t bufferSize, uint32_t timeoutMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create AT+ULOC single shot CellLocate request answered
+//!  within timeoutMs
+//
+//------------------------------------------------------------------------------
+uint32_t PositionCreateCellLocateCommand(uint8_t buffer[], uint32_t bufferSize, uint32_t timeoutMs)
+{
+    uint32_t timeoutSeconds = ((timeoutMs / 1000u) > ULOC_MIN_TIMEOUT_SECONDS) ? (timeoutMs / 1000u) : ULOC_MIN_TIMEOUT_SECONDS;
+
+    return (uint32_t)snprintf((char *)buffer, bufferSize, "AT+ULOC=2,%u,%u,%u,%u\r\n", ULOC_SENSOR_CELL_LOCATE,
+                              ULOC_RESPONSE_TYPE_STANDARD, (unsigned int)timeoutSeconds, POSITION_CELL_LOCATE_ACCURACY_M);
+}
+
+//------------------------------------------------------------------------------
+//  int32_t PositionParseCellLocate(uint8_t const response[], uint32_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse +UULOC into CellLocateCoordinates, format is
+//!  +UULOC: <date>,<time>,<lat>,<long>,<alt>,<uncertainty>,...
+//!
+//! \return 0 when estimate is valid, ERR_INCOMPLETE_DATA_RECEIVED until the
+//!         URC is complete or ERR_POSITION_PARSE_FAILED
+//
+//------------------------------------------------------------------------------
+int32_t PositionParseCellLocate(uint8_t const response[], uint32_t length)
+{
+    int32_t ret = ERR_INCOMPLETE_DATA_RECEIVED;
+    char const *end = (char const *)&response[length];
+    char const *text = strstr((char const *)response, "+UULOC:");
+    char const *lineEnd = NULL;
+    char *numberEnd = NULL;
+    int32_t latitude = 0, longitude = 0;
+    uint32_t uncertainty = 0;
+
+    if(text != NULL)
+    {
+        lineEnd = text;
+        while((lineEnd < end) && (*lineEnd != '\r') && (*lineEnd != '\n'))
+        {
+            lineEnd++;
+        }
+    }
+
+    // Wait for the complete line, the URC follows OK after the fix time
+    if((lineEnd != NULL) && (lineEnd < end))
+    {
+        ret = ERR_POSITION_PARSE_FAILED;
+        text = SkipFields(&text[7], lineEnd, 2u);
+        text = (text != NULL) ? ParseMicroDegrees(text, lineEnd, &latitude) : NULL;
+        text = SkipFields(text, lineEnd, 1u);
+        text = (text != NULL) ? ParseMicroDegrees(text, lineEnd, &longitude) : NULL;
+        text = SkipFields(text, lineEnd, 2u);
+        if(text != NULL)
+        {
+            uncertainty = (uint32_t)strtoul(text, &numberEnd, 10);
+            text = (numberEnd != text) ? numberEnd : NULL;
+        }
+
+        // Failed requests report 0,0
+        if((text != NULL) && ((latitude != 0) || (longitude != 0)))
+        {
+            CellLocateCoordinates.latitude = latitude;
+            CellLocateCoordinates.longitude = longitude;
+            CellLocateCoordinates.uncertainty = uncertainty;
+            CellLocateCoordinates.fixTicks = GetRTCTicks();
+            CellLocateCoordinates.horizantalDilution = 0;
+            CellLocateCoordinates.accuracy = 0;
+            CellLocateCoordinates.source = POSITION_SOURCE_CELL_LOCATE;
+            CellLocateCoordinates.isGpsValid = true;
+            ret = 0;
+        }
+    }
+
+    return ret;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
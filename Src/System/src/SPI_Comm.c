@@ -52,12 +52,26 @@
 #include "Event.h"
 #include "ExtCommunication.h"
 #include "Cellular.h"
+#include "GNSSDutyCycle.h"
+#include "GeofenceMonitor.h"
+#include "CellularRAT.h"
+#include "CellularNetCache.h"
+#include "CellularDNS.h"
+#include "CellularTLS.h"
+#include "CellularPrewarm.h"
+#include "CellularUsage.h"
+#include "CellularTiming.h"
 #include "main.h"
 
 //==============================================================================
 //	CONSTANTS, TYPEDEFS AND MACROS 
 //==============================================================================
 #define MSG_MAX_ID_LEN    16u
+#define FIRST_DIAGNOSTIC_PARAMETER      CELL_RAT_STATISTICS
+#define LAST_DIAGNOSTIC_PARAMETER       CELL_LAST_UPLOAD_TIMING
+
+// Writes a read only statistics record, returns its size or a negative error
+typedef int32_t (*DiagnosticGetter_t)(uint8_t buffer[], uint32_t bufferSize);
 
 //==============================================================================
 //	LOCAL DATA STRUCTURE DEFINITION
@@ -97,7 +111,24 @@ static bool isRadioConfigMessageSent = false;
 
 static unsigned char MasterRequestedRadioParameter = NO_PARAMETER;
 
+//Read only statistics records by parameter from FIRST_DIAGNOSTIC_PARAMETER on, a new record is one more row
+static DiagnosticGetter_t const diagnosticGetters[LAST_DIAGNOSTIC_PARAMETER - FIRST_DIAGNOSTIC_PARAMETER + 1u] =
+{
+    CellularRATGetDiagnostics,          // CELL_RAT_STATISTICS
+    CellularNetCacheGetDiagnostics,     // CELL_NETWORK_CACHE
+    NULL,                               // MODULE_FIRMWARE has its own case
+    CellularDNSGetDiagnostics,          // CELL_DNS_CACHE
+    CellularTLSGetDiagnostics,          // CELL_TLS_STATISTICS
+    CellularPrewarmGetDiagnostics,      // CELL_PREWARM_STATISTICS
+    CellularUsageGetDiagnostics,        // CELL_DATA_USAGE
+    CellularTimingGetDiagnostics,       // CELL_UPLOAD_TIMING
+    GetEventLatencyDiagnostics,         // EVENT_LATENCY_STATISTICS
+    CellularGetSchedulerDiagnostics,    // CELL_GNSS_SCHEDULER
+    CellularTimingGetLastDiagnostics,   // CELL_LAST_UPLOAD_TIMING
+};
+
 bool isEventBased = false;
+static BOOLEAN isProximityAlarmReceived = false;
 
 int32_t TimerTime = 0;
 int32_t TimerTimeA = 0;
@@ -487,6 +518,9 @@ static void ProcessInstrumentDataMessage(uint8_t *IncomingBuffer, uint8_t Starti
             RemoteUnit.SensorsInfo.numberOfSensors = SensorCount;
         }
         
+        // Readings heading to an alarm warm the upload path up
+        CellularPrewarmCheckSensors(&RemoteUnit.SensorsInfo);
+        
         // Byte 91-92 Checksum 
         Index ++;
         Index ++;
@@ -831,6 +865,11 @@ static void ProcessProximityAlarmMessage(uint8_t *IncomingBuffer, uint8_t Starti
         // Byte 57 User Security Level
         RemoteUnit.UserSecurityLevel = IncomingBuffer[Index++];
         
+        // Proximity alarm is always uploaded on the alarm lane
+        isProximityAlarmReceived = true;
+        // More may follow while the peer stays in alarm
+        CellularPrewarmHint(CELL_PREWARM_PROXIMITY);
+        
         // Byte 58-59 Checksum 
         Index ++;
         Index ++;
@@ -1225,6 +1264,7 @@ static uint8_t BuildRadioConfigureMessage(uint8_t *OutgoingBuffer)
     uint8_t Index = 0u;
     uint8_t LoopCounter = 0u;
     uint8_t returnLength = 0u;
+    int32_t payloadSize = 0;
     
     // Byte 0-1 Start framing Character of the message 
     OutgoingBuffer[Index++] = START_FRAMING_CHARACTER;
@@ -1376,13 +1416,37 @@ static uint8_t BuildRadioConfigureMessage(uint8_t *OutgoingBuffer)
         // Coming Soon
         break;
         
+    case MODULE_FIRMWARE:
+        for (LoopCounter = 0; LoopCounter < CELLULAR_FIRMWARE_LENGTH ;LoopCounter++)
+        {
+            OutgoingBuffer[Index++] =  gCellularDriver.firmware[LoopCounter];
+        }
+        //Populate length Byte left earlier
+        OutgoingBuffer[LENGTH_BYTE] = CELLULAR_FIRMWARE_LENGTH + ONE_BYTE_LENGTH;
+        break;
+        
     case CELL_ANTENNA_TYPE:
         OutgoingBuffer[Index++] =  gCellularDriver.antennaType;
         //Populate length Byte left earlier
         OutgoingBuffer[LENGTH_BYTE] = ONE_BYTE_LENGTH + ONE_BYTE_LENGTH;  
         break;
         
-        
+    default:
+        // Read only statistics records, written by the module that keeps them.
+        // Checksum and end framing follow the payload
+        if((MasterRequestedRadioParameter >= FIRST_DIAGNOSTIC_PARAMETER) &&
+           (MasterRequestedRadioParameter <= LAST_DIAGNOSTIC_PARAMETER) &&
+           (diagnosticGetters[MasterRequestedRadioParameter - FIRST_DIAGNOSTIC_PARAMETER] != NULL))
+        {
+            payloadSize = diagnosticGetters[MasterRequestedRadioParameter - FIRST_DIAGNOSTIC_PARAMETER](&OutgoingBuffer[Index], (SPI_SLAVE_BUFFER_LENGTH - Index - 4u));
+            if(payloadSize > 0)
+            {
+                Index += (uint8_t)payloadSize;
+                //Populate length Byte left earlier
+                OutgoingBuffer[LENGTH_BYTE] = (uint8_t)payloadSize + ONE_BYTE_LENGTH;
+            }
+        }
+        break;
     }
     
     // Byte (5 + n)  (5 + n + 1) CheckSum of the message
@@ -1532,6 +1596,10 @@ static void CreateInstrumentEvent(void)
     
     uint8_t loopCounter = 0;
     BOOLEAN isInfoChanged = false;
+    BOOLEAN isPeriodicEvent = false;
+    BOOLEAN isMergedEvent = false;
+    uint8_t changedSensorsMask = ALL_SENSORS_CHANGED_MASK;
+    EVENT_PRIORITY_t priority = EVENT_PRIORITY_STATE_CHANGE;
     PTR_COMM_EVT_t commEvt = NULL;
     CellMsg_t *msg;
     SysMsg_t  *sysMsg;
@@ -1560,6 +1628,15 @@ static void CreateInstrumentEvent(void)
             {
                 isInfoChanged = true;
             }
+            else if(isProximityAlarmReceived == true)
+            {
+                isInfoChanged = true;
+            }
+            else if(GeofenceMonitorIsTransitionPending() == true)
+            {
+                // Zone entered or left, reported now rather than at next heartbeat
+                isInfoChanged = true;
+            }
             else if((strcmp((char const*)referenceUserName, (char const*)RemoteUnit.UserName) != 0) || (strcmp((char const*)referenceSiteName, (char const*)RemoteUnit.SiteName) != 0))
             {
                 isInfoChanged = true;
@@ -1590,6 +1667,18 @@ static void CreateInstrumentEvent(void)
             InstrumentInfo.LastPeriodicMessageTimeStamp = secondsSince1970;
             //Update the flag to signal event creation 
             isInfoChanged = true;
+            isPeriodicEvent = true;
+            
+            // Only upload the sensors that changed since last delivered snapshot,
+            // nothing at all if unchanged until the heartbeat is due
+            if(IsHeartbeatDue(secondsSince1970) == false)
+            {
+                changedSensorsMask = GetChangedSensorsMask(&RemoteUnit.SensorsInfo);
+                if(changedSensorsMask == 0)
+                {
+                    isInfoChanged = false;
+                }
+            }
         }
         
         if(isInfoChanged == true)
@@ -1602,7 +1691,36 @@ static void CreateInstrumentEvent(void)
                 RemoteUnit.SensorsInfo.sensorArray[loopCounter].InternalSensorStatus = RemoteUnit.SensorsInfo.sensorArray[loopCounter].SensorStatus;
             }
             
-            commEvt = GetEventMessageFromPool();
+            if(isProximityAlarmReceived == true)
+            {
+                priority = EVENT_PRIORITY_ALARM;
+            }
+            else
+            {
+                priority = GetEventPriority((INSTRUMENT_STATUS_t)RemoteUnit.InstrumentState, &RemoteUnit.SensorsInfo, isPeriodicEvent);
+            }
+            
+            // Alarm location must be fresh, GNSS switches to shortest fix interval
+            if(priority == EVENT_PRIORITY_ALARM)
+            {
+                GNSSDutyCycleNotifyAlarm();
+            }
+            
+            // Coalesce with the periodic Event still waiting in queue
+            if(priority == EVENT_PRIORITY_PERIODIC)
+            {
+                commEvt = GetPendingPeriodicEvent();
+            }
+            if(commEvt != NULL)
+            {
+                isMergedEvent = true;
+                changedSensorsMask |= commEvt->changedSensorsMask;
+            }
+            else
+            {
+                commEvt = GetEventMessageFromPool();
+            }
+            
             if(commEvt != NULL)
             {
                 GetCurrentTimeAndDate(&commEvt->dateTimeInfo);
@@ -1623,27 +1741,36 @@ static void CreateInstrumentEvent(void)
                 }
                 
                 commEvt->sequenceNumber = GetNextSequence();
-                commEvt->GPSLocationInfo.isGpsValid = GPSReceivedCoordinates.isGpsValid;
-                commEvt->GPSLocationInfo.latitude = GPSReceivedCoordinates.latitude;
-                commEvt->GPSLocationInfo.latitudeDir = GPSReceivedCoordinates.latitudeDir;
-                commEvt->GPSLocationInfo.longitude = GPSReceivedCoordinates.longitude;
-                commEvt->GPSLocationInfo.longitudeDir = GPSReceivedCoordinates.longitudeDir;
-                
+                commEvt->GPSLocationInfo = GPSReceivedCoordinates;
+                commEvt->geofenceSet = GeofenceMonitorGetSetVersion();
+                commEvt->geofenceId = GeofenceMonitorGetZone();
+                commEvt->changedSensorsMask = changedSensorsMask;
+                commEvt->priority = priority;
                 
-                //Add comm Event to event Queue
-                OSQPost(&eventMessagesQueue, commEvt, sizeof(ComEvent_t), OS_OPT_POST_FIFO + OS_OPT_POST_ALL + OS_OPT_POST_NO_SCHED, &err);
+                //Add comm Event to the event Queue lane of its priority
+                if(isMergedEvent == false)
+                {
+                    PostEventToQueue(commEvt);
+                }
                 
-                // Post message to cellualr Task to send Event to iNet
-                msg = (CellMsg_t*)GetTaskMessageFromPool();
-                if(msg != NULL)
+                // Periodic events are batched by the SysTask mailbox timer,
+                // others are posted to cellular Task right away
+                if(commEvt->priority != EVENT_PRIORITY_PERIODIC)
                 {
-                    eventsCreated++;
-                    msg->msgId = CELL_SEND_EVENT_TO_INET;
-                    msg->msgInfo = 1;
-                    msg->ptrData = NULL;
-                    OSTaskQPost(&CellTaskTCB, (void *)msg, sizeof(SysMsg_t), OS_OPT_POST_FIFO, &err);
+                    msg = (CellMsg_t*)GetTaskMessageFromPool();
+                    if(msg != NULL)
+                    {
+                        eventsCreated++;
+                        msg->msgId = CELL_SEND_EVENT_TO_INET;
+                        msg->msgInfo = 1;
+                        msg->ptrData = NULL;
+                        // Alarm jumps ahead of any GPS or batch request already pending
+                        OSTaskQPost(&CellTaskTCB, (void *)msg, sizeof(SysMsg_t), ((commEvt->priority == EVENT_PRIORITY_ALARM) ? OS_OPT_POST_LIFO : OS_OPT_POST_FIFO), &err);
+                    }
                 }
             }
+            isProximityAlarmReceived = false;
+            GeofenceMonitorClearTransition();
         }
         
         if(RemoteUnit.InstrumentState == 4)
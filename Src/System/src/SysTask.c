@@ -45,13 +45,21 @@
 #include "Timer.h"
 #include "Cellular.h"
 #include "FileCommit.h"
+#include "UARTCapture.h"
+#include "GNSSAiding.h"
+#include "GNSSDutyCycle.h"
+#include "GeofenceMonitor.h"
+#include "CellularRAT.h"
+#include "CellularNetCache.h"
+#include "CellularIdentity.h"
+#include "CellularDNS.h"
+#include "Event.h"
 
 //==============================================================================
 //  CONSTANTS, TYPEDEFS AND MACROS 
 //==============================================================================
 #define GPS_DATA_LENGTH           256u
 #define MAILBOX_PERIODIC_INTERVAL 60u
-#define GPS_PERIODIC_INTERVAL     15u
 //==============================================================================
 //  LOCAL DATA STRUCTURE DEFINITION
 //==============================================================================
@@ -70,7 +78,6 @@ Device_Parameters_t deviceParams;
 //==============================================================================
 //  LOCAL FUNCTION PROTOTYPES
 //==============================================================================
-inline static void SendPeriodicGPSMessage(void);
 inline static void SendPriodicCommMessage(void);
 
 //==============================================================================
@@ -95,7 +102,7 @@ static void SendPriodicCommMessage(void)
     if(mailBoxPeriodicTimeout == 0)
     {
         mailBoxPeriodicTimeout = 15;
-        if(eventMessagesQueue.MsgQ.NbrEntries > 0)
+        if(GetPendingEventsCount() > 0)
         {
             msg = (CellMsg_t*)GetTaskMessageFromPool();
             if(msg != NULL)
@@ -113,53 +120,6 @@ static void SendPriodicCommMessage(void)
     }
 }
 
-//------------------------------------------------------------------------------
-//  static void SendPeriodicGPSMessage(void)
-//
-//   Author:  Dilawar Ali
-//   Date:    2018/08/18
-//
-//!  This function Periodically Send GPS Message to task to get GPS data from GNSS
-//
-//------------------------------------------------------------------------------
-static void SendPeriodicGPSMessage(void)
-{
-    static uint16_t GPSPeriodicTimeout = GPS_PERIODIC_INTERVAL;
-    static uint8_t counter = 0;
-    CellMsg_t *msg = NULL;
-    RTOS_ERR  err;
-    
-    if(GPSPeriodicTimeout == 0)
-    {
-        
-        GPSPeriodicTimeout = GPS_PERIODIC_INTERVAL;
-        msg = (CellMsg_t*)GetTaskMessageFromPool();
-        if(counter < 12)
-        {
-            counter++;
-        if(msg != NULL)
-        {
-            msg->msgId = CELL_GET_GPS_COORDINATES;
-            msg->msgInfo = 1;
-            msg->ptrData = NULL;
-            OSTaskQPost(&CellTaskTCB, (void *)msg, sizeof(SysMsg_t), OS_OPT_POST_FIFO, &err);
-        }
-    }
-    else
-    {
-            counter = 0;
-            msg->msgId = CELL_GPS_OFF;
-            msg->msgInfo = 1;
-            msg->ptrData = NULL;
-            OSTaskQPost(&CellTaskTCB, (void *)msg, sizeof(SysMsg_t), OS_OPT_POST_FIFO, &err);
-        }
-    }
-    else
-    {
-        GPSPeriodicTimeout--;
-    }
-}
-
 int32_t DataFlashTestCode(void)
 {
     int32_t ret = 0, i = 0;
@@ -238,6 +198,12 @@ void SysTask(void *arg)
     
     (void)SPISlaveConfigure();
     DataFlashTestCode();
+    (void)GNSSAidingLoadFromFlash();
+    (void)GeofenceMonitorLoadFromFlash();
+    (void)CellularRATLoadFromFlash();
+    (void)CellularNetCacheLoadFromFlash();
+    (void)CellularIdentityLoadFromFlash();
+    (void)CellularDNSLoadFromFlash();
    
     while(1)
     {
@@ -250,7 +216,8 @@ void SysTask(void *arg)
             
         case EVENT_MANAGEMENT_EVENT_RECEVIED:
             SendPriodicCommMessage();
-            SendPeriodicGPSMessage();
+            CellularPostAlarmCheck();
+            GNSSDutyCycleRun();
             break;
             
         case POWER_MANAGEMENT_EVENT_RECEVIED:
@@ -262,6 +229,34 @@ void SysTask(void *arg)
 
             break;
             
+        case DUMP_UART_CAPTURE_TO_FLASH:
+            UARTCaptureDumpToFlash();
+            break;
+            
+        case SAVE_GNSS_AIDING_TO_FLASH:
+            GNSSAidingSaveToFlash();
+            break;
+            
+        case SAVE_GEOFENCES_TO_FLASH:
+            GeofenceMonitorSaveToFlash();
+            break;
+            
+        case SAVE_RAT_STATS_TO_FLASH:
+            CellularRATSaveToFlash();
+            break;
+            
+        case SAVE_NET_CACHE_TO_FLASH:
+            CellularNetCacheSaveToFlash();
+            break;
+            
+        case SAVE_CELL_IDENTITY_TO_FLASH:
+            CellularIdentitySaveToFlash();
+            break;
+            
+        case SAVE_DNS_CACHE_TO_FLASH:
+            CellularDNSSaveToFlash();
+            break;
+            
         case DEVICE_SHUTDOWN_MSG:
             DataFlashDisablePowerSaving();
             
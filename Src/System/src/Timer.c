@@ -39,8 +39,6 @@
 //==============================================================================
 #include "Timer.h"
 #include <stddef.h>
-#include <time.h>
-#include <stdlib.h>
 
 #include "Cellular.h"
 #include "Main.h"
@@ -49,13 +47,18 @@
 //==============================================================================
 #define MAY2018_29Time      1527590650
 
-#define TIME_ARRAY_ELEMENTS             3u            //!< Time string array elements for integer conversion
-#define YEAR_INCREMENT                  100u          //!< Offset of 100 to save year
-#define MONTH_VALUE                     1u            //!< First element of intTimeVal array to save month
-#define DAY_VALUE                       2u            //!< Second element of intTimeVal array to save month
-#define HOUR_VALUE                      3u            //!< Third element of intTimeVal array to save month
-#define MINUTE_VALUE                    4u            //!< Fourth element of intTimeVal array to save month
-#define SECONDS_VALUE                   5u            //!< Fifth element of intTimeVal array to save month
+#define NETWORK_TIME_FIELDS             6u            //!< yy/MM/dd,hh:mm:ss, two digits each
+#define NETWORK_TIME_FIELD_STRIDE       3u            //!< Two digits and a separator
+#define NETWORK_TIME_CENTURY            2000u
+#define NETWORK_TIME_MIN_YEAR           18u           //!< Earlier years are the modem clock before network time
+#define SECONDS_PER_TIME_ZONE_QUARTER   900
+
+#define EPOCH_YEAR                      1970u
+#define EPOCH_LAST_YEAR                 2105u         //!< Last full year of 32 bit seconds
+#define MONTHS_PER_YEAR                 12u
+#define SECONDS_PER_MINUTE              60u
+#define SECONDS_PER_HOUR                3600u
+#define SECONDS_PER_DAY                 86400u
 
 #define SYS_TASK_SCHEDULE_TIMEOUT       5u            // 5 Seconds Interval
 //==============================================================================
@@ -63,10 +66,19 @@
 //==============================================================================
 
 static RTCDRV_TimerID_t RTCTimerId;
+static BOOLEAN isRTCTimeSynced = false;      // Wall clock set from network since reset
+
+// Days of each month in a common and in a leap year, as Clk_DaysInMonth of micrium clk
+static const uint8_t daysInMonth[2u][MONTHS_PER_YEAR] =
+{
+    {31u, 28u, 31u, 30u, 31u, 30u, 31u, 31u, 30u, 31u, 30u, 31u},
+    {31u, 29u, 31u, 30u, 31u, 30u, 31u, 31u, 30u, 31u, 30u, 31u},
+};
 //==============================================================================
 //  LOCAL FUNCTION PROTOTYPES
 //==============================================================================
 static void PeriodicFunctionCall( RTCDRV_TimerID_t id, void * user );
+static uint32_t IsLeapYear(uint32_t year);
 //==============================================================================
 //  GLOBAL DATA DECLARATIONS
 //==============================================================================
@@ -124,6 +136,21 @@ static void PeriodicFunctionCall( RTCDRV_TimerID_t id, void * user )
     
 }
 
+//------------------------------------------------------------------------------
+//  static uint32_t IsLeapYear(uint32_t year)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns 1 for a leap year and 0 otherwise, to index
+//!  daysInMonth
+//
+//------------------------------------------------------------------------------
+static uint32_t IsLeapYear(uint32_t year)
+{
+    return ((((year % 4u) == 0u) && (((year % 100u) != 0u) || ((year % 400u) == 0u))) ? 1u : 0u);
+}
+
 //==============================================================================
 //  GLOBAL FUNCTIONS IMPLEMENTATION
 //==============================================================================
@@ -163,6 +190,7 @@ void UpdateRTCTimeFromSNTP(uint32_t timeStamp)
 {
     timeStamp -= SECOND_SINCE_1970;
     RTCDRV_SetWallClock(timeStamp);
+    isRTCTimeSynced = true;
 }
 
 //------------------------------------------------------------------------------
@@ -194,61 +222,150 @@ uint32_t GetRTCTicks(void)
 }
 
 //------------------------------------------------------------------------------
-//   void UpdateRTCTime(uint8_t time[])
+//   BOOLEAN UpdateRTCTime(uint8_t const cellularTime[], int32_t timeZoneQuarters)
 //
 //   Author:   Muhammad Shuaib, Ported from MORRISON
 //   Date:     2017/05/03
 //
-//!  This function Update the RTC Time from Cellular
-//
-//------------------------------------------------------------------------------
-void UpdateRTCTime(uint8_t cellularTime[])
-{  
-    // Array to store the value of time string for integer conversion
-    uint8_t timeArray[TIME_ARRAY_ELEMENTS];
-    // Time array address offset variable
-    uint8_t arrayOffsetVal = 0u;
-    // Variable to get int32_t value of time
-    int32_t intTimeVal[9];
-    // Variable to store local time for Unix timestamp conversion
-    struct tm localTimeValue;
-    // Variable to get the value of local time converted to Unix timestamp
-    time_t unixTimeStamp;
-    // Loop counter variable
-    uint8_t loopCounter = 0u;
+//!  This function Update the RTC Time from Cellular. cellularTime is the
+//!  local time "yy/MM/dd,hh:mm:ss" of +CTZE, +CTZV or +CCLK and
+//!  timeZoneQuarters its offset from UTC in quarters of an hour.
+//!
+//! \return true when the time was valid and RTC is updated
+//
+//------------------------------------------------------------------------------
+BOOLEAN UpdateRTCTime(uint8_t const cellularTime[], int32_t timeZoneQuarters)
+{
+    BOOLEAN ret = false;
+    DateTimeInfo_t localTime;
+    uint32_t fields[NETWORK_TIME_FIELDS] = {0};
+    uint32_t index = 0, offset = 0, localSeconds = 0;
     
-    // Get highest priority interface running info
+    // Two digit fields at fixed positions, separators are not checked
+    for(index = 0; index < NETWORK_TIME_FIELDS; index++)
+    {
+        offset = index * NETWORK_TIME_FIELD_STRIDE;
+        if((cellularTime[offset] < '0') || (cellularTime[offset] > '9') ||
+           (cellularTime[offset + 1u] < '0') || (cellularTime[offset + 1u] > '9'))
+        {
+            break;
+        }
+        fields[index] = ((uint32_t)(cellularTime[offset] - '0') * 10u) + (uint32_t)(cellularTime[offset + 1u] - '0');
+    }
     
-    // Update time via Cellular only if it is not updated already
-    // Initialize time int32_t value array
-    memset(intTimeVal,0,7u);
-    // Fetch time from cellularTime array
-    for(loopCounter = 0u; loopCounter <= 6; loopCounter++)
+    if((index == NETWORK_TIME_FIELDS) && (fields[0] >= NETWORK_TIME_MIN_YEAR))
     {
-        // Reset the time string array
-        memset(timeArray, 0, TIME_ARRAY_ELEMENTS);
-        // Get the value
-        strncpy((char*)(&(timeArray[0])),(char const*)&(cellularTime[arrayOffsetVal]),2u);
-        // Convert the value to integer value and store in local variable
-        intTimeVal[loopCounter] = (int32_t)(strtol((const char *)timeArray, NULL, 10));
-        // Increment offset variable value
-        arrayOffsetVal += TIME_ARRAY_ELEMENTS;
+        localTime.date.year = (uint16_t)(NETWORK_TIME_CENTURY + fields[0]);
+        localTime.date.month = (uint8_t)fields[1];
+        localTime.date.day = (uint8_t)fields[2];
+        localTime.time.hours = (uint8_t)fields[3];
+        localTime.time.minutes = (uint8_t)fields[4];
+        localTime.time.seconds = (uint8_t)fields[5];
+        
+        if(DateTimeToEpoch(&localTime, &localSeconds) == true)
+        {
+            // Save UTC Unix timestamp value into RTC
+            RTCDRV_SetWallClock((uint32_t)((int32_t)localSeconds - (timeZoneQuarters * SECONDS_PER_TIME_ZONE_QUARTER)));
+            isRTCTimeSynced = true;
+            ret = true;
+        }
     }
-    // Save year value
-    localTimeValue.tm_year = intTimeVal[0u] + (int32_t)YEAR_INCREMENT;
-    // Save month value,decremented by one (Jan = 0 and Dec = 11)
-    localTimeValue.tm_mon = (intTimeVal[MONTH_VALUE]- 1);
-    // Save day value
-    localTimeValue.tm_mday = intTimeVal[DAY_VALUE];
-    // Save hour value
-    localTimeValue.tm_hour = intTimeVal[HOUR_VALUE];
-    // Save minutes value
-    localTimeValue.tm_min = intTimeVal[MINUTE_VALUE];
-    // Save seconds value
-    localTimeValue.tm_sec = intTimeVal[SECONDS_VALUE];
-    localTimeValue.tm_isdst = -1; // Is DST on? 1 = yes, 0 = no, -1 = unknown
-    // Convert the value to Unix timestamp
-    unixTimeStamp = mktime(&localTimeValue);
-    // Save Unix timestamp value into hibernate module
-    RTCDRV_SetWallClock(unixTimeStamp);
+    
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//   BOOLEAN DateTimeToEpoch(DateTimeInfo_t const *dateTime, uint32_t *epoch)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function convert a date and time to seconds since 1970 with integer
+//!  arithmetic only, the way Clk_DateTimeToTS_Handler of micrium clk does
+//!
+//! \return false when date or time is out of range
+//
+//------------------------------------------------------------------------------
+BOOLEAN DateTimeToEpoch(DateTimeInfo_t const *dateTime, uint32_t *epoch)
+{
+    BOOLEAN ret = false;
+    uint32_t year = dateTime->date.year, month = dateTime->date.month;
+    uint32_t leapYear = 0, days = 0, index = 0;
+    
+    if((year >= EPOCH_YEAR) && (year <= EPOCH_LAST_YEAR) && (month >= 1u) && (month <= MONTHS_PER_YEAR))
+    {
+        leapYear = IsLeapYear(year);
+        if((dateTime->date.day >= 1u) && (dateTime->date.day <= daysInMonth[leapYear][month - 1u]) &&
+           (dateTime->time.hours < 24u) && (dateTime->time.minutes < 60u) && (dateTime->time.seconds < 60u))
+        {
+            days = dateTime->date.day - 1u;
+            for(index = 1u; index < month; index++)
+            {
+                days += daysInMonth[leapYear][index - 1u];
+            }
+            for(index = EPOCH_YEAR; index < year; index++)
+            {
+                days += 365u + IsLeapYear(index);
+            }
+            
+            *epoch = (days * SECONDS_PER_DAY) + (dateTime->time.hours * SECONDS_PER_HOUR) +
+                     (dateTime->time.minutes * SECONDS_PER_MINUTE) + dateTime->time.seconds;
+            ret = true;
+        }
+    }
+    
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//   void EpochToDateTime(uint32_t epoch, DateTimeInfo_t *dateTime)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function convert seconds since 1970 to UTC date and time with integer
+//!  arithmetic only, the way Clk_TS_ToDateTime of micrium clk does
+//
+//------------------------------------------------------------------------------
+void EpochToDateTime(uint32_t epoch, DateTimeInfo_t *dateTime)
+{
+    uint32_t days = epoch / SECONDS_PER_DAY;
+    uint32_t seconds = epoch % SECONDS_PER_DAY;
+    uint32_t year = EPOCH_YEAR, month = 1u;
+    uint32_t leapYear = IsLeapYear(year);
+    
+    // Whole years, then whole months of the remaining days
+    while(days >= (365u + leapYear))
+    {
+        days -= 365u + leapYear;
+        year++;
+        leapYear = IsLeapYear(year);
+    }
+    while(days >= daysInMonth[leapYear][month - 1u])
+    {
+        days -= daysInMonth[leapYear][month - 1u];
+        month++;
+    }
+    
+    dateTime->date.year = (uint16_t)year;
+    dateTime->date.month = (uint8_t)month;
+    dateTime->date.day = (uint8_t)(days + 1u);
+    dateTime->time.hours = (uint8_t)(seconds / SECONDS_PER_HOUR);
+    dateTime->time.minutes = (uint8_t)((seconds % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE);
+    dateTime->time.seconds = (uint8_t)(seconds % SECONDS_PER_MINUTE);
+}
+
+//------------------------------------------------------------------------------
+//   BOOLEAN IsRTCTimeSynced(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function tells whether the RTC was set from the network since reset,
+//!  before that it counts from the build default time
+//
+//------------------------------------------------------------------------------
+BOOLEAN IsRTCTimeSynced(void)
+{
+    return isRTCTimeSynced;
 }
@@ -0,0 +1,294 @@
+//==============================================================================
+//
+//  UARTCapture.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        UARTCapture.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file contains the cellular UART capture ring and its DataFlash dump.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include "UARTCapture.h"
+
+#include <string.h>
+
+#include "DataFlash.h"
+#include "Event.h"
+#include "SysTask.h"
+#include "Timer.h"
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define UART_CAPTURE_RECORD_HEADER_SIZE     sizeof(UARTCaptureRecord_t)
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static uint8_t captureBuffer[UART_CAPTURE_BUFFER_SIZE];
+static uint32_t captureHead = 0;            // Next byte to write
+static uint32_t captureTail = 0;            // Oldest record
+static uint32_t captureUsed = 0;
+static uint32_t captureRecordCount = 0;
+static uint32_t captureDroppedRecords = 0;
+
+static BOOLEAN isCaptureEnabled = UART_CAPTURE_DEFAULT_ENABLE;
+static volatile BOOLEAN isCaptureFrozen = false;    // Set while SysTask dumps the ring
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void CaptureWrite(uint8_t const data[], uint32_t size);
+static void CaptureRead(uint32_t offset, uint8_t data[], uint32_t size);
+static void CaptureDropOldestRecord(void);
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static void CaptureWrite(uint8_t const data[], uint32_t size)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function copy bytes at ring head, caller makes sure there is room
+//
+//------------------------------------------------------------------------------
+static void CaptureWrite(uint8_t const data[], uint32_t size)
+{
+    uint32_t firstPart = FIND_MIN(size, (UART_CAPTURE_BUFFER_SIZE - captureHead));
+
+    memcpy(&captureBuffer[captureHead], data, firstPart);
+    memcpy(&captureBuffer[0], &data[firstPart], (size - firstPart));
+    captureHead = (captureHead + size) % UART_CAPTURE_BUFFER_SIZE;
+    captureUsed += size;
+}
+
+//------------------------------------------------------------------------------
+//  static void CaptureRead(uint32_t offset, uint8_t data[], uint32_t size)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function copy bytes out of the ring starting offset bytes after tail
+//
+//------------------------------------------------------------------------------
+static void CaptureRead(uint32_t offset, uint8_t data[], uint32_t size)
+{
+    uint32_t start = (captureTail + offset) % UART_CAPTURE_BUFFER_SIZE;
+    uint32_t firstPart = FIND_MIN(size, (UART_CAPTURE_BUFFER_SIZE - start));
+
+    memcpy(data, &captureBuffer[start], firstPart);
+    memcpy(&data[firstPart], &captureBuffer[0], (size - firstPart));
+}
+
+//------------------------------------------------------------------------------
+//  static void CaptureDropOldestRecord(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function release the oldest record of the ring
+//
+//------------------------------------------------------------------------------
+static void CaptureDropOldestRecord(void)
+{
+    UARTCaptureRecord_t record;
+    uint32_t recordSize = 0;
+
+    CaptureRead(0, (uint8_t *)&record, UART_CAPTURE_RECORD_HEADER_SIZE);
+    recordSize = UART_CAPTURE_RECORD_HEADER_SIZE + record.length;
+
+    captureTail = (captureTail + recordSize) % UART_CAPTURE_BUFFER_SIZE;
+    captureUsed -= recordSize;
+    captureRecordCount--;
+    captureDroppedRecords++;
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  void UARTCaptureEnable(BOOLEAN enable)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function start or stop the cellular UART capture
+//
+//------------------------------------------------------------------------------
+void UARTCaptureEnable(BOOLEAN enable)
+{
+    isCaptureEnabled = enable;
+}
+
+//------------------------------------------------------------------------------
+//  void UARTCaptureRecord(UART_CAPTURE_DIR_t direction, uint8_t atIndex, uint8_t const data[], uint32_t size)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function add a TX/RX chunk to the capture ring, oldest records are
+//!  dropped to make room. Called from cellular task only.
+//
+//------------------------------------------------------------------------------
+void UARTCaptureRecord(UART_CAPTURE_DIR_t direction, uint8_t atIndex, uint8_t const data[], uint32_t size)
+{
+    UARTCaptureRecord_t record;
+
+    if((isCaptureEnabled == true) && (isCaptureFrozen == false) && (size > 0u))
+    {
+        record.ticks = GetRTCTicks();
+        record.length = (uint16_t)FIND_MIN(size, UART_CAPTURE_MAX_RECORD_DATA);
+        record.direction = (uint8_t)direction;
+        record.atIndex = atIndex;
+
+        // Make room for the new record
+        while((UART_CAPTURE_BUFFER_SIZE - captureUsed) < (UART_CAPTURE_RECORD_HEADER_SIZE + record.length))
+        {
+            CaptureDropOldestRecord();
+        }
+
+        CaptureWrite((uint8_t const *)&record, UART_CAPTURE_RECORD_HEADER_SIZE);
+        CaptureWrite(data, record.length);
+        captureRecordCount++;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  void UARTCaptureRequestDump(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function freeze the capture and ask SysTask to write it to DataFlash
+//
+//------------------------------------------------------------------------------
+void UARTCaptureRequestDump(void)
+{
+    RTOS_ERR  err;
+    SysMsg_t *msg = NULL;
+
+    if((isCaptureEnabled == true) && (isCaptureFrozen == false) && (captureRecordCount > 0u))
+    {
+        msg = (SysMsg_t*)GetTaskMessageFromPool();
+        if(msg != NULL)
+        {
+            isCaptureFrozen = true;
+            msg->msgId = DUMP_UART_CAPTURE_TO_FLASH;
+            msg->msgInfo = 1;
+            msg->ptrData = NULL;
+            OSTaskQPost(&SYSTaskTCB, (void *)msg, sizeof(SysMsg_t), OS_OPT_POST_FIFO, &err);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  int32_t UARTCaptureDumpToFlash(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the frozen capture to DataFlash and resume capturing.
+//!  Called from SysTask which owns the DataFlash.
+//
+//------------------------------------------------------------------------------
+int32_t UARTCaptureDumpToFlash(void)
+{
+    int32_t ret = 0;
+    uint8_t pageBuffer[DATAFLASH_BYTES_PER_PAGE] = {0};
+    UARTCaptureHeader_t header;
+    uint32_t offset = 0, chunkSize = 0;
+    uint16_t pageNumber = UART_CAPTURE_FIRST_PAGE_NUMBER;
+
+    if(captureRecordCount == 0u)
+    {
+        ret = ERR_UART_CAPTURE_EMPTY;
+    }
+    else if(captureUsed > ((UART_CAPTURE_LAST_PAGE_NUMBER - UART_CAPTURE_FIRST_PAGE_NUMBER + 1u) * DATAFLASH_BYTES_PER_PAGE))
+    {
+        ret = ERR_UART_CAPTURE_TOO_LARGE;
+    }
+    else
+    {
+        DataFlashDisablePowerSaving();
+        ret = DataFlashEraseSector(UART_CAPTURE_FLASH_SECTOR, false);
+
+        // Records first, header last so a partial dump is never taken as valid
+        while((ret >= 0) && (offset < captureUsed))
+        {
+            chunkSize = FIND_MIN(DATAFLASH_BYTES_PER_PAGE, (captureUsed - offset));
+            CaptureRead(offset, pageBuffer, chunkSize);
+            ret = DataFlashWriteBuffer(0, pageBuffer, chunkSize);
+            if(ret >= 0)
+            {
+                ret = DataFlashWriteBufferToPage(pageNumber);
+            }
+            offset += chunkSize;
+            pageNumber++;
+        }
+
+        if(ret >= 0)
+        {
+            header.magic = UART_CAPTURE_MAGIC;
+            header.version = UART_CAPTURE_VERSION;
+            header.recordHeaderSize = UART_CAPTURE_RECORD_HEADER_SIZE;
+            header.ticksPerSecond = RTCDRV_MsecsToTicks(1000u);
+            header.dataSize = captureUsed;
+            header.recordCount = captureRecordCount;
+            header.droppedRecords = captureDroppedRecords;
+            header.dumpTime = GetRTCTime();
+            ret = DataFlashWriteBuffer(0, (uint8_t *)&header, sizeof(header));
+            if(ret >= 0)
+            {
+                ret = DataFlashWriteBufferToPage(UART_CAPTURE_HEADER_PAGE_NUMBER);
+            }
+        }
+        DataFlashEnablePowerSaving();
+    }
+
+    // Start a fresh capture
+    captureHead = 0;
+    captureTail = 0;
+    captureUsed = 0;
+    captureRecordCount = 0;
+    captureDroppedRecords = 0;
+    isCaptureFrozen = false;
+
+    return ret;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
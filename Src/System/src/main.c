@@ -90,7 +90,7 @@ static void IdleTaskHookFunc(void);
 //==============================================================================
 uint32_t maintmp = 0;
 
-OS_Q   eventMessagesQueue, eventMessagesFreeQueue;
+OS_Q   eventMessagesQueue, eventAlarmMessagesQueue, eventMessagesFreeQueue;
 OS_Q   taskMessagesFreeQueue;
 
 OS_TCB   CellTaskTCB;
@@ -172,6 +172,9 @@ int main(void)
     OSQCreate(&eventMessagesQueue, "Comm Queue", MAX_EVENS_MESSAGES, &err);
     APP_RTOS_ASSERT_DBG((RTOS_ERR_CODE_GET(err) == RTOS_ERR_NONE), 1);
     
+    OSQCreate(&eventAlarmMessagesQueue, "Comm Alarm Queue", MAX_EVENS_MESSAGES, &err);
+    APP_RTOS_ASSERT_DBG((RTOS_ERR_CODE_GET(err) == RTOS_ERR_NONE), 1);
+    
     OSQCreate(&eventMessagesFreeQueue, "Comm free Queue", MAX_EVENS_MESSAGES, &err);
     APP_RTOS_ASSERT_DBG((RTOS_ERR_CODE_GET(err) == RTOS_ERR_NONE), 1);
     
@@ -0,0 +1,494 @@
+//==============================================================================
+//
+//  GeofenceBench.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        GeofenceBench.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! Host benchmark of the firmware geofence engine (System/src/Geofence.c).
+//! A set of circles and polygons is generated around a site, sent through
+//! the download parser and evaluated for random fixes. Every result is
+//! checked against a double precision reference and the evaluation cost per
+//! fix is reported for 1 to N fences, for fixes spread over the area and for
+//! fixes close to the fences where the exact tests run.
+//!
+//! Build:  gcc -O2 -Wall -I../../Src/System/inc -o GeofenceBench GeofenceBench.c ../../Src/System/src/Geofence.c -lm
+//! Run:    ./GeofenceBench [-f fences] [-n fixes] [-m margin_m]
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+
+#include "Geofence.h"
+
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+#define DEFAULT_FIXES           200000u
+#define DEFAULT_MARGIN_M        0u
+
+#define SITE_LATITUDE           40438185        // Micro-degrees, same site as ttff.sim
+#define SITE_LONGITUDE          (-79999422)
+#define FENCE_SPACING_M         1500.0
+#define AREA_HALF_WIDTH_M       5000.0
+#define METERS_PER_DEGREE       111320.0
+#define BOUNDARY_TOLERANCE_M    5.0             // Misses closer than this to an edge are expected
+#define SET_TEXT_SIZE           4096u
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static uint64_t randomState = 0x2545F4914F6CDD1Dull;
+
+static GeofenceSet_t set;
+static GeofenceIndex_t fenceIndex;
+static char setText[SET_TEXT_SIZE];
+
+static int32_t *fixLatitude = NULL;
+static int32_t *fixLongitude = NULL;
+
+static volatile uint32_t zoneSink = 0;
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static uint64_t NowNs(void);
+static double RandomUnit(void);
+static int32_t OffsetLatitude(double northM);
+static int32_t OffsetLongitude(int32_t latitude, double eastM);
+static void GenerateFences(uint32_t count);
+static uint32_t FormatSet(void);
+static double ReferenceSignedDistance(GeofenceFence_t const *fence, int32_t latitude, int32_t longitude);
+static uint8_t ReferenceZone(uint32_t count, int32_t latitude, int32_t longitude);
+static void GenerateFixes(uint32_t count, uint32_t fences, bool isNearFences);
+static double TimeFixes(uint32_t fixes, uint32_t margin);
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static uint64_t NowNs(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns monotonic time in nanoseconds
+//
+//------------------------------------------------------------------------------
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+//  static double RandomUnit(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns a repeatable pseudo random number in [0, 1)
+//
+//------------------------------------------------------------------------------
+static double RandomUnit(void)
+{
+    randomState ^= randomState >> 12;
+    randomState ^= randomState << 25;
+    randomState ^= randomState >> 27;
+
+    return (double)((randomState * 0x2545F4914F6CDD1Dull) >> 11) / 9007199254740992.0;
+}
+
+//------------------------------------------------------------------------------
+//  static int32_t OffsetLatitude(double northM)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the site latitude moved north by meters
+//
+//------------------------------------------------------------------------------
+static int32_t OffsetLatitude(double northM)
+{
+    return SITE_LATITUDE + (int32_t)lround((northM / METERS_PER_DEGREE) * 1e6);
+}
+
+//------------------------------------------------------------------------------
+//  static int32_t OffsetLongitude(int32_t latitude, double eastM)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the site longitude moved east by meters
+//
+//------------------------------------------------------------------------------
+static int32_t OffsetLongitude(int32_t latitude, double eastM)
+{
+    double cosLatitude = cos(((double)latitude / 1e6) * M_PI / 180.0);
+
+    return SITE_LONGITUDE + (int32_t)lround((eastM / (METERS_PER_DEGREE * cosLatitude)) * 1e6);
+}
+
+//------------------------------------------------------------------------------
+//  static void GenerateFences(uint32_t count)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function lay fences on a grid around the site, even ones are circles
+//!  and odd ones irregular polygons of GEOFENCE_MAX_VERTICES
+//
+//------------------------------------------------------------------------------
+static void GenerateFences(uint32_t count)
+{
+    uint32_t i = 0, vertex = 0;
+    double centerEast = 0.0, centerNorth = 0.0, angle = 0.0, radius = 0.0;
+    GeofenceFence_t *fence = NULL;
+
+    memset(&set, 0, sizeof(set));
+    set.version = 1;
+    set.count = (uint8_t)count;
+    for(i = 0; i < count; i++)
+    {
+        fence = &set.fences[i];
+        centerEast = ((double)(i % 3u) - 1.0) * FENCE_SPACING_M * 2.0;
+        centerNorth = ((double)(i / 3u) - 1.0) * FENCE_SPACING_M * 2.0;
+        fence->id = (uint8_t)(i + 1u);
+
+        if((i % 2u) == 0u)
+        {
+            fence->type = GEOFENCE_TYPE_CIRCLE;
+            fence->vertexCount = 1;
+            fence->radius = 100u + (uint32_t)(RandomUnit() * 500.0);
+            fence->latitude[0] = OffsetLatitude(centerNorth);
+            fence->longitude[0] = OffsetLongitude(fence->latitude[0], centerEast);
+        }
+        else
+        {
+            fence->type = GEOFENCE_TYPE_POLYGON;
+            fence->vertexCount = GEOFENCE_MAX_VERTICES;
+            for(vertex = 0; vertex < GEOFENCE_MAX_VERTICES; vertex++)
+            {
+                angle = ((double)vertex * 2.0 * M_PI) / GEOFENCE_MAX_VERTICES;
+                radius = 300.0 + (RandomUnit() * 400.0);
+                fence->latitude[vertex] = OffsetLatitude(centerNorth + (radius * sin(angle)));
+                fence->longitude[vertex] = OffsetLongitude(fence->latitude[vertex], centerEast + (radius * cos(angle)));
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static uint32_t FormatSet(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write the set in the iNet download format
+//
+//------------------------------------------------------------------------------
+static uint32_t FormatSet(void)
+{
+    uint32_t size = 0, i = 0, vertex = 0;
+
+    size += snprintf(&setText[size], sizeof(setText) - size, "[%u", set.version);
+    for(i = 0; i < set.count; i++)
+    {
+        size += snprintf(&setText[size], sizeof(setText) - size, ",[%u,%u,%u", set.fences[i].id, set.fences[i].type, set.fences[i].radius);
+        for(vertex = 0; vertex < set.fences[i].vertexCount; vertex++)
+        {
+            size += snprintf(&setText[size], sizeof(setText) - size, ",%d,%d", set.fences[i].latitude[vertex], set.fences[i].longitude[vertex]);
+        }
+        size += snprintf(&setText[size], sizeof(setText) - size, "]");
+    }
+    size += snprintf(&setText[size], sizeof(setText) - size, "]");
+
+    return size;
+}
+
+//------------------------------------------------------------------------------
+//  static double ReferenceSignedDistance(GeofenceFence_t const *fence, int32_t latitude, int32_t longitude)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the distance of a fix from the fence boundary in
+//!  meters with doubles, negative inside. Used as reference only.
+//
+//------------------------------------------------------------------------------
+static double ReferenceSignedDistance(GeofenceFence_t const *fence, int32_t latitude, int32_t longitude)
+{
+    double cosLatitude = cos(((double)fence->latitude[0] / 1e6) * M_PI / 180.0);
+    double east = (((double)longitude - fence->longitude[0]) / 1e6) * METERS_PER_DEGREE * cosLatitude;
+    double north = (((double)latitude - fence->latitude[0]) / 1e6) * METERS_PER_DEGREE;
+    double ret = 0.0, ax = 0.0, ay = 0.0, bx = 0.0, by = 0.0, t = 0.0, dx = 0.0, dy = 0.0, distance = 0.0;
+    bool isInside = false;
+    uint32_t current = 0, previous = 0;
+
+    if(fence->type == GEOFENCE_TYPE_CIRCLE)
+    {
+        ret = hypot(east, north) - (double)fence->radius;
+    }
+    else
+    {
+        ret = 1e12;
+        previous = fence->vertexCount - 1u;
+        for(current = 0; current < fence->vertexCount; previous = current++)
+        {
+            ax = (((double)fence->longitude[previous] - fence->longitude[0]) / 1e6) * METERS_PER_DEGREE * cosLatitude;
+            ay = (((double)fence->latitude[previous] - fence->latitude[0]) / 1e6) * METERS_PER_DEGREE;
+            bx = (((double)fence->longitude[current] - fence->longitude[0]) / 1e6) * METERS_PER_DEGREE * cosLatitude;
+            by = (((double)fence->latitude[current] - fence->latitude[0]) / 1e6) * METERS_PER_DEGREE;
+            if((by > north) != (ay > north))
+            {
+                if(east < (ax + (((north - ay) * (bx - ax)) / (by - ay))))
+                {
+                    isInside = !isInside;
+                }
+            }
+            dx = bx - ax;
+            dy = by - ay;
+            t = (((east - ax) * dx) + ((north - ay) * dy)) / ((dx * dx) + (dy * dy));
+            t = (t < 0.0) ? 0.0 : ((t > 1.0) ? 1.0 : t);
+            distance = hypot(east - (ax + (t * dx)), north - (ay + (t * dy)));
+            ret = (distance < ret) ? distance : ret;
+        }
+        ret = (isInside == true) ? -ret : ret;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static uint8_t ReferenceZone(uint32_t count, int32_t latitude, int32_t longitude)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the first fence holding a fix, reference only
+//
+//------------------------------------------------------------------------------
+static uint8_t ReferenceZone(uint32_t count, int32_t latitude, int32_t longitude)
+{
+    uint8_t ret = GEOFENCE_ID_NONE;
+    uint32_t i = 0;
+
+    for(i = 0; i < count; i++)
+    {
+        if(ReferenceSignedDistance(&set.fences[i], latitude, longitude) <= 0.0)
+        {
+            ret = set.fences[i].id;
+            break;
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static void GenerateFixes(uint32_t count, uint32_t fences, bool isNearFences)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function draw fixes over the whole area or within a kilometer of
+//!  the fence centers
+//
+//------------------------------------------------------------------------------
+static void GenerateFixes(uint32_t count, uint32_t fences, bool isNearFences)
+{
+    uint32_t i = 0, fence = 0;
+    double east = 0.0, north = 0.0;
+
+    for(i = 0; i < count; i++)
+    {
+        if(isNearFences == true)
+        {
+            fence = (uint32_t)(RandomUnit() * fences);
+            east = (((double)(fence % 3u) - 1.0) * FENCE_SPACING_M * 2.0) + ((RandomUnit() - 0.5) * 1600.0);
+            north = (((double)(fence / 3u) - 1.0) * FENCE_SPACING_M * 2.0) + ((RandomUnit() - 0.5) * 1600.0);
+        }
+        else
+        {
+            east = (RandomUnit() - 0.5) * 2.0 * AREA_HALF_WIDTH_M;
+            north = (RandomUnit() - 0.5) * 2.0 * AREA_HALF_WIDTH_M;
+        }
+        fixLatitude[i] = OffsetLatitude(north);
+        fixLongitude[i] = OffsetLongitude(fixLatitude[i], east);
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static double TimeFixes(uint32_t fixes, uint32_t margin)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns the engine cost in ns per fix
+//
+//------------------------------------------------------------------------------
+static double TimeFixes(uint32_t fixes, uint32_t margin)
+{
+    uint32_t i = 0;
+    uint8_t zone = GEOFENCE_ID_NONE;
+    uint64_t t0 = NowNs();
+
+    for(i = 0; i < fixes; i++)
+    {
+        zone = GeofenceFindZone(&fenceIndex, fixLatitude[i], fixLongitude[i], zone, margin);
+        zoneSink += zone;
+    }
+
+    return (double)(NowNs() - t0) / (double)fixes;
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+int main(int argc, char *argv[])
+{
+    int opt = 0;
+    uint32_t fences = GEOFENCE_MAX_FENCES, fixes = DEFAULT_FIXES, marginM = DEFAULT_MARGIN_M;
+    uint32_t count = 0, i = 0, textSize = 0, checked = 0, misses = 0, hardMisses = 0;
+    uint8_t zone = GEOFENCE_ID_NONE, expected = GEOFENCE_ID_NONE;
+    double worstMissM = 0.0, distance = 0.0, spreadNs = 0.0, nearNs = 0.0;
+    uint64_t t0 = 0;
+    GeofenceSet_t parsed;
+
+    while((opt = getopt(argc, argv, "f:n:m:")) != -1)
+    {
+        switch(opt)
+        {
+        case 'f':
+            fences = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+        case 'n':
+            fixes = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+        case 'm':
+            marginM = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+        default:
+            fprintf(stderr, "usage: %s [-f fences] [-n fixes] [-m margin_m]\n", argv[0]);
+            return 1;
+        }
+    }
+    if((fences == 0u) || (fences > GEOFENCE_MAX_FENCES) || (fixes == 0u))
+    {
+        fprintf(stderr, "fences must be 1-%u and fixes above 0\n", GEOFENCE_MAX_FENCES);
+        return 1;
+    }
+
+    fixLatitude = malloc(fixes * sizeof(int32_t));
+    fixLongitude = malloc(fixes * sizeof(int32_t));
+    if((fixLatitude == NULL) || (fixLongitude == NULL))
+    {
+        perror("malloc");
+        return 1;
+    }
+
+    // Download path: generated set, its text and the firmware parser
+    GenerateFences(fences);
+    textSize = FormatSet();
+    t0 = NowNs();
+    if(GeofenceParseSet(setText, textSize, &parsed) != 0)
+    {
+        fprintf(stderr, "set text rejected by parser: %s\n", setText);
+        return 1;
+    }
+    printf("set             : %u fences, %u bytes as downloaded, parsed in %.1f us\n", fences, textSize, (double)(NowNs() - t0) / 1000.0);
+    if(memcmp(&parsed, &set, sizeof(set)) != 0)
+    {
+        fprintf(stderr, "parsed set differs from generated set\n");
+        return 1;
+    }
+    if(GeofencePrepare(&parsed, &fenceIndex) != 0)
+    {
+        fprintf(stderr, "set rejected by prepare\n");
+        return 1;
+    }
+
+    // Accuracy against doubles without margin, fixes close to the fences
+    GenerateFixes(fixes, fences, true);
+    for(i = 0; i < fixes; i++)
+    {
+        zone = GeofenceFindZone(&fenceIndex, fixLatitude[i], fixLongitude[i], GEOFENCE_ID_NONE, 0u);
+        expected = ReferenceZone(fences, fixLatitude[i], fixLongitude[i]);
+        checked++;
+        if(zone != expected)
+        {
+            misses++;
+            distance = fabs(ReferenceSignedDistance(&set.fences[((zone != GEOFENCE_ID_NONE) ? zone : expected) - 1u], fixLatitude[i], fixLongitude[i]));
+            worstMissM = (distance > worstMissM) ? distance : worstMissM;
+            if(distance > BOUNDARY_TOLERANCE_M)
+            {
+                hardMisses++;
+            }
+        }
+    }
+    printf("accuracy        : %u fixes, %u differ from reference (worst %.2f m from boundary), %u beyond %.0f m\n",
+           checked, misses, worstMissM, hardMisses, BOUNDARY_TOLERANCE_M);
+
+    printf("cost per fix    : margin %u m\n", marginM);
+    printf("  fences   spread ns   near ns\n");
+    for(count = 1; count <= fences; count++)
+    {
+        set.count = (uint8_t)count;
+        (void)GeofencePrepare(&set, &fenceIndex);
+
+        GenerateFixes(fixes, count, false);
+        spreadNs = TimeFixes(fixes, marginM * 10u);
+        GenerateFixes(fixes, count, true);
+        nearNs = TimeFixes(fixes, marginM * 10u);
+        printf("  %6u  %10.1f  %8.1f\n", count, spreadNs, nearNs);
+    }
+
+    free(fixLatitude);
+    free(fixLongitude);
+
+    return (hardMisses == 0u) ? 0 : 1;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
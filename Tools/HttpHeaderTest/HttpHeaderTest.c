@@ -0,0 +1,266 @@
+//==============================================================================
+//
+//  HttpHeaderTest.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        HttpHeaderTest.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! Host test of the firmware HTTP header builder (System/src/HttpHeader.c).
+//! Checks the header template reuse and that an oversized URL or token never
+//! leaves a header the cellular task would write to the socket. The header
+//! buffer has the firmware size.
+//!
+//! Build:  gcc -O2 -Wall -I../../Src/System/inc -o HttpHeaderTest HttpHeaderTest.c ../../Src/System/src/HttpHeader.c
+//! Run:    ./HttpHeaderTest
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "HttpHeader.h"
+
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+#define HEADER_BUFFER_SIZE      300u        // CELLULAR_HEADER_BUFFER_SIZE
+#define TEST_HOST               "inetuploadft.indsci.com"
+#define TEST_URL                "/iNetAPI/v1/instrument/event"
+#define TEST_TOKEN              "Bearer 0123456789abcdef0123456789abcdef0123456789ab"
+#define TOKEN_REQUEST           0u
+#define EVENT_REQUEST           1u
+
+#define CHECK(condition)        Check((condition), #condition, __LINE__)
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static uint8_t headerBuffer[HEADER_BUFFER_SIZE];
+static uint32_t failures = 0;
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void Check(bool condition, char const *text, int line);
+static bool IsRequestSent(int32_t headerSize);
+static void TestTemplateReuse(void);
+static void TestOversizedUrl(void);
+static void TestOversizedToken(void);
+static void TestNoContentLengthRoom(void);
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static void Check(bool condition, char const *text, int line)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  Reports a failed check
+//
+//------------------------------------------------------------------------------
+static void Check(bool condition, char const *text, int line)
+{
+    if(condition == false)
+    {
+        fprintf(stderr, "line %d: %s\n", line, text);
+        failures++;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static bool IsRequestSent(int32_t headerSize)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  Mirrors the cellular task: the header is written only when the builder
+//!  succeeded and ATC_WRITEHEADER then writes the buffer string
+//
+//------------------------------------------------------------------------------
+static bool IsRequestSent(int32_t headerSize)
+{
+    return ((headerSize > 0) && (strlen((char const*)headerBuffer) > 0u));
+}
+
+//------------------------------------------------------------------------------
+//  static void TestTemplateReuse(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  The template is reused and only Content-Length changes
+//
+//------------------------------------------------------------------------------
+static void TestTemplateReuse(void)
+{
+    HttpHeader_t header = {0};
+    int32_t size = 0;
+    
+    size = HttpHeaderCreate(&header, EVENT_REQUEST, TEST_URL, TEST_HOST, "application/json", TEST_TOKEN,
+                            headerBuffer, HEADER_BUFFER_SIZE, 1234u);
+    CHECK(size == (int32_t)strlen((char const*)headerBuffer));
+    CHECK(IsRequestSent(size) == true);
+    CHECK(strstr((char const*)headerBuffer, "Authorization: " TEST_TOKEN "\r\n") != NULL);
+    CHECK(strstr((char const*)headerBuffer, "Content-Length: 1234\r\n\r\n") != NULL);
+    
+    size = HttpHeaderCreate(&header, EVENT_REQUEST, TEST_URL, TEST_HOST, "application/json", TEST_TOKEN,
+                            headerBuffer, HEADER_BUFFER_SIZE, 7u);
+    CHECK(size == (int32_t)strlen((char const*)headerBuffer));
+    CHECK(strstr((char const*)headerBuffer, "Content-Length: 7\r\n\r\n") != NULL);
+    CHECK(strstr((char const*)headerBuffer, "Content-Length: 1234") == NULL);
+}
+
+//------------------------------------------------------------------------------
+//  static void TestOversizedUrl(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  A URL longer than the header buffer is not sent, nor is the previous
+//!  header left in the buffer
+//
+//------------------------------------------------------------------------------
+static void TestOversizedUrl(void)
+{
+    HttpHeader_t header = {0};
+    char url[HEADER_BUFFER_SIZE + 16u];
+    int32_t size = 0;
+    
+    size = HttpHeaderCreate(&header, TOKEN_REQUEST, TEST_URL, TEST_HOST, "application/x-www-form-urlencoded", NULL,
+                            headerBuffer, HEADER_BUFFER_SIZE, 99u);
+    CHECK(IsRequestSent(size) == true);
+    
+    memset(url, 'u', sizeof(url) - 1u);
+    url[0] = '/';
+    url[sizeof(url) - 1u] = '\0';
+    size = HttpHeaderCreate(&header, TOKEN_REQUEST, url, TEST_HOST, "application/x-www-form-urlencoded", NULL,
+                            headerBuffer, HEADER_BUFFER_SIZE, 99u);
+    CHECK(size < 0);
+    CHECK(headerBuffer[0] == '\0');
+    CHECK(IsRequestSent(size) == false);
+}
+
+//------------------------------------------------------------------------------
+//  static void TestOversizedToken(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  A token that pushes the header past the buffer is not sent, also when
+//!  the template of the previous token was valid
+//
+//------------------------------------------------------------------------------
+static void TestOversizedToken(void)
+{
+    HttpHeader_t header = {0};
+    char token[HEADER_BUFFER_SIZE];
+    int32_t size = 0;
+    
+    size = HttpHeaderCreate(&header, EVENT_REQUEST, TEST_URL, TEST_HOST, "application/json", TEST_TOKEN,
+                            headerBuffer, HEADER_BUFFER_SIZE, 512u);
+    CHECK(IsRequestSent(size) == true);
+    
+    // New token received, the template is formatted again
+    HttpHeaderInvalidate(&header);
+    memset(token, 't', sizeof(token) - 1u);
+    token[sizeof(token) - 1u] = '\0';
+    size = HttpHeaderCreate(&header, EVENT_REQUEST, TEST_URL, TEST_HOST, "application/json", token,
+                            headerBuffer, HEADER_BUFFER_SIZE, 512u);
+    CHECK(size < 0);
+    CHECK(headerBuffer[0] == '\0');
+    CHECK(IsRequestSent(size) == false);
+    
+    // Still refused on the next request with the same token
+    size = HttpHeaderCreate(&header, EVENT_REQUEST, TEST_URL, TEST_HOST, "application/json", token,
+                            headerBuffer, HEADER_BUFFER_SIZE, 512u);
+    CHECK(IsRequestSent(size) == false);
+}
+
+//------------------------------------------------------------------------------
+//  static void TestNoContentLengthRoom(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  A header that fits only without its Content-Length value is refused
+//
+//------------------------------------------------------------------------------
+static void TestNoContentLengthRoom(void)
+{
+    HttpHeader_t header = {0};
+    char token[HEADER_BUFFER_SIZE];
+    uint32_t templateSize = 0;
+    int32_t size = 0;
+    
+    templateSize = (uint32_t)snprintf(NULL, 0, "POST %s HTTP/1.1\r\nHost: %s\r\nConnection: close\r\n"
+                                      "Content-Type: %s\r\nAuthorization: \r\nContent-Length: ",
+                                      TEST_URL, TEST_HOST, "application/json");
+    // Leave one byte of the Content-Length room after the template
+    memset(token, 't', sizeof(token));
+    token[HEADER_BUFFER_SIZE - templateSize - (HTTP_CONTENT_LENGTH_MAX_SIZE - 1u)] = '\0';
+    size = HttpHeaderCreate(&header, EVENT_REQUEST, TEST_URL, TEST_HOST, "application/json", token,
+                            headerBuffer, HEADER_BUFFER_SIZE, 4294967295u);
+    CHECK(size < 0);
+    CHECK(IsRequestSent(size) == false);
+    
+    token[HEADER_BUFFER_SIZE - templateSize - HTTP_CONTENT_LENGTH_MAX_SIZE] = '\0';
+    size = HttpHeaderCreate(&header, EVENT_REQUEST, TEST_URL, TEST_HOST, "application/json", token,
+                            headerBuffer, HEADER_BUFFER_SIZE, 4294967295u);
+    CHECK(size == (int32_t)(HEADER_BUFFER_SIZE - 1u));
+    CHECK(IsRequestSent(size) == true);
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  int main(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  Test entry point
+//
+//------------------------------------------------------------------------------
+int main(void)
+{
+    TestTemplateReuse();
+    TestOversizedUrl();
+    TestOversizedToken();
+    TestNoContentLengthRoom();
+    
+    printf("%s: %u failed checks\n", (failures == 0u) ? "PASS" : "FAIL", (unsigned)failures);
+    
+    return (failures == 0u) ? 0 : 1;
+}
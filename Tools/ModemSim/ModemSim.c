@@ -0,0 +1,2267 @@
+//==============================================================================
+//
+//  ModemSim.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        ModemSim.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! Host side SARA-R4 stand-in. It opens a pseudo terminal and answers the AT
+//! command subset used by Cellular.c and CellularATCommands.c, so the cellular
+//! stack (or a terminal) can be exercised on Linux without board or network.
+//!
+//! Build:  gcc -O2 -Wall -o ModemSim ModemSim.c
+//! Run:    ./ModemSim [-l /tmp/ttyCell] [-s scenario.sim] [-f host:port] [-r seed] [-v]
+//!
+//!   -l  create a symlink to the pty slave, e.g. for a fixed device name
+//!   -s  scenario file, see default.sim for the keywords
+//!   -f  forward direct link socket data to a real TCP server instead of the
+//!       built-in loopback iNet responder
+//!   -r  random seed for error injection
+//!   -v  print every AT command and response on stdout
+//!
+//! The GNSS receiver behind the modem I2C passthrough is modelled as well:
+//! +UGPIOC=23 switches its supply, +UI2CW accepts UBX NAV-PVT polls and
+//! MGA-INI aiding, +UI2CR returns the UBX stream padded with 0xFF filler.
+//! Time to first fix depends on the aiding received since power on.
+//!
+//! Registration follows the +URAT order: each RAT the network does not offer
+//! costs a scan before the next is tried, +COPS reports the RAT registered.
+//! The serving cell has one band and operator, +UBANDMASK restricting the
+//! scan to that band and +COPS=1 selecting that operator register faster.
+//! +USOCO given a host name spends a lookup (dns) before connecting. On a
+//! socket secured by +USOSEC it adds a full TLS handshake, or a resumed one
+//! after the first when +USECPRF op code 13 enabled session resumption. A
+//! suite set by +USECPRF op code 2 has its own full handshake cost, a suite
+//! the server does not take fails the connect after one round trip.
+//! +USOCO with <async_connect> 1 answers OK at once, the socket connects in
+//! the background and +UUSOCO reports the result; a session is resumable
+//! only once its handshake completed. With uusoco 0 the result is never
+//! reported and the socket stays held until +USOCL, as on a connect the
+//! network lost. The summary gives the sockets held at exit and the +USOCR
+//! refused for lack of one, a socket left open by the firmware shows there
+//! (token_connect_cme.sim, token_connect_lost.sim).
+//! +USOCTL reports the bytes sent (param 2) and received (param 3) on a
+//! socket, the handshake included, split by tlsClientBytes.
+//!
+//! +CMGS in PDU mode takes the SMS-SUBMIT after the "> " prompt up to Ctrl-Z,
+//! checks its length, decodes the destination and the 7 bit text and answers
+//! +CMGS: <mr> once registered and the SMS service is on. With server_stall
+//! the loopback iNet takes event uploads and never answers them, as a data
+//! path lost past the modem; each SMS then reports how long the stall lasted
+//! so the alarm deadline of CellularSMS.h can be checked (alarm_deadline.sim).
+//!
+//! Network time (NITZ) is received at registration. It sets the modem clock
+//! read by +CCLK when +CTZU=1 and is reported by +CTZV or +CTZE per +CTZR.
+//!
+//! On SIGINT the simulator prints per command counts and response latencies
+//! and the number of bytes exchanged on the UART.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <poll.h>
+#include <time.h>
+#include <termios.h>
+#include <netdb.h>
+#include <sys/socket.h>
+
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+#define SIM_LINE_SIZE               2048u
+#define SIM_LINK_BUFFER_SIZE        8192u
+#define SIM_MAX_PENDING_OUTPUT      64u
+#define SIM_MAX_RULES               64u
+#define SIM_MAX_URCS                32u
+#define SIM_MAX_SOCKETS             7u
+#define SIM_CMD_NAME_SIZE           16u
+#define SIM_TEXT_SIZE               256u
+
+#define SIM_DEFAULT_LATENCY_MS      20u
+#define SIM_ESCAPE_GUARD_MS         100u
+
+#define SIM_GNSS_SUPPLY_GPIO        23
+#define SIM_UBX_STREAM_SIZE         1024u
+#define SIM_UBX_MAX_READ            512u        //!< Largest +UI2CR answered, hex doubles it
+#define SIM_UBX_NAV_PVT_SIZE        92u
+
+#define SIM_RAT_COUNT               3u          //!< +URAT 7 LTE-M, 8 NB-IoT, 9 GPRS
+#define SIM_URAT_BASE               7
+#define SIM_TLS_FULL                0u
+#define SIM_TLS_RESUMED             1u
+#define SIM_TLS_MAX_SUITES          8u
+#define SIM_TLS_REJECT_BYTES        150u        //!< ClientHello and alert, measured by Tools/TLSBench
+#define SIM_SMS_MAX_TPDU            175u        //!< Largest +CMGS <length>
+#define SIM_SMS_TEXT_SIZE           161u
+
+typedef enum
+{
+    MODE_COMMAND = 0,
+    MODE_CERT_INPUT,
+    MODE_SMS_INPUT,
+    MODE_DIRECT_LINK,
+}SIM_MODE_t;
+
+//! Per command behaviour loaded from scenario file
+typedef struct
+{
+    char     name[SIM_CMD_NAME_SIZE];      //!< Command name without "AT", e.g. "+USOCO"
+    uint32_t latencyMs;
+    double   errorProbability;
+    char     errorText[SIM_TEXT_SIZE];
+
+    uint32_t count;
+    uint32_t errors;
+    uint64_t totalLatencyMs;
+}SimRule_t;
+
+//! Unsolicited result code fired once at a time offset from start
+typedef struct
+{
+    uint32_t atMs;
+    char     text[SIM_TEXT_SIZE];
+    bool     isSent;
+}SimUrc_t;
+
+//! Output scheduled to be written on the pty at a given time
+typedef struct
+{
+    uint64_t dueMs;
+    uint32_t length;
+    char    *data;
+    SIM_MODE_t nextMode;    //!< Mode entered once this output is written
+    bool     changeMode;
+}SimOutput_t;
+
+typedef struct
+{
+    bool     isUsed;
+    bool     isConnected;
+    bool     isRemoteClosed;    //!< Server closed, socket released on leaving direct link
+    bool     isSecure;          //!< +USOSEC enabled, connect adds a TLS handshake
+    bool     isConnectPending;  //!< Asynchronous +USOCO, +UUSOCO due at connectDueMs
+    bool     isConnectOk;
+    uint64_t connectDueMs;
+    uint32_t bytesSent;         //!< Over the air, for +USOCTL param 2
+    uint32_t bytesReceived;     //!< Over the air, for +USOCTL param 3
+    int      fd;            //!< Forward connection, -1 for loopback responder
+}SimSocket_t;
+
+//! Cipher suite +USECPRF op code 2 can select by IANA id
+typedef struct
+{
+    uint32_t ianaId;
+    bool     isAccepted;    //!< Server certificate and settings take the suite
+    uint32_t handshakeMs;   //!< Full handshake on top of the TCP connect
+    uint32_t handshakeBytes;
+    uint32_t handshakes;
+    uint32_t rejects;
+}SimTlsSuite_t;
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static int ptyMaster = -1;
+static int ptySlave = -1;
+static bool isVerbose = false;
+static volatile sig_atomic_t isExitRequested = 0;
+static uint64_t startMs = 0;
+
+static SIM_MODE_t mode = MODE_COMMAND;
+static bool isEchoOn = true;
+static bool isRadioOn = true;
+static uint64_t radioOnMs = 0;
+
+static char lineBuffer[SIM_LINE_SIZE];
+static uint32_t lineLength = 0;
+static uint32_t certRemaining = 0;
+
+static SimRule_t rules[SIM_MAX_RULES];
+static uint32_t numberOfRules = 0;
+static SimUrc_t urcs[SIM_MAX_URCS];
+static uint32_t numberOfUrcs = 0;
+static SimOutput_t pending[SIM_MAX_PENDING_OUTPUT];
+static uint32_t numberOfPending = 0;
+
+static SimSocket_t sockets[SIM_MAX_SOCKETS];
+static int linkSocket = -1;
+static char linkBuffer[SIM_LINK_BUFFER_SIZE];
+static uint32_t linkLength = 0;
+static uint64_t lastLinkByteMs = 0;
+
+// Scenario parameters
+static uint32_t registrationDelayMs = 2000u;
+static bool     isRatConfigured = false;        //!< Only RATs named by "rat" lines are offered
+static uint32_t ratRegistrationMs[SIM_RAT_COUNT];
+static bool     isRatOffered[SIM_RAT_COUNT];
+static uint32_t ratScanMs = 8000u;
+static int      ratOrder[SIM_RAT_COUNT] = {0, 1, 2};
+static uint32_t ratOrderCount = SIM_RAT_COUNT;
+static int      registeredRat = -1;
+static uint32_t attachDelayMs = 2000u;          //!< Radio on to registration with the current order
+static uint32_t ratAttaches[SIM_RAT_COUNT];
+static uint32_t networkBand = 12u;              //!< E-UTRA band of the serving cell
+static char     networkPlmn[8] = "310410";
+static uint32_t registrationCachedMs = 500u;    //!< Registration time with the band mask on the serving band only
+static uint64_t bandMask[2] = {134748318u, 134748318u}; //!< +UBANDMASK bands 1-64 of LTE-M and NB-IoT
+static bool     isManualSelection = false;
+static char     manualPlmn[8] = "";
+static uint32_t manualSelections = 0;
+static uint32_t dnsLookupMs = 1500u;            //!< Host name lookup, by +UDNSRN or within +USOCO
+static char     dnsAddress[64] = "203.0.113.10";
+static uint32_t dnsLookups = 0;
+static uint32_t dnsConnectLookups = 0;
+static bool     isTlsResumptionSupported = true;  //!< Firmware takes +USECPRF op code 13
+static bool     isTlsResumptionOn = false;
+static uint64_t tlsSessionMs = UINT64_MAX;       //!< Session of the last handshake resumable from then, kept until exit
+static uint32_t tlsHandshakeMs[2] = {1400u, 450u};        //!< Full and resumed, on top of the TCP connect
+static uint32_t tlsHandshakeBytes[2] = {5600u, 380u};     //!< Over the air, both directions
+static uint32_t tlsClientBytes[2] = {420u, 240u};         //!< Part of the handshake bytes sent by the module
+static uint32_t tlsHandshakes[2];
+static uint64_t tlsBytes = 0;
+static bool     isTlsSuiteIdSupported = true;     //!< Firmware takes IANA ids with +USECPRF op code 2
+// Figures of Tools/TLSBench against an RSA chain, scaled to tls_full
+static SimTlsSuite_t tlsSuites[SIM_TLS_MAX_SUITES] =
+{
+    {0xC02Bu, false, 1000u, 3900u, 0u, 0u},     // ECDHE-ECDSA-AES128-GCM-SHA256
+    {0xC02Fu, true,  1370u, 5500u, 0u, 0u},     // ECDHE-RSA-AES128-GCM-SHA256
+};
+static uint32_t numberOfTlsSuites = 2u;
+static int      tlsSuite = -1;                    //!< Index in tlsSuites, -1 for the module default list
+static bool     isAsyncConnectSupported = true;  //!< Firmware takes +USOCO <async_connect>
+static uint32_t asyncConnects = 0;
+static bool     isConnectUrcOn = true;          //!< +UUSOCO reports an asynchronous connect
+static uint32_t socketsRefused = 0;             //!< +USOCR with all sockets held
+static int32_t  smsFormat = 0;                  //!< +CMGF, 0 PDU mode
+static bool     isSmsServiceOn = true;
+static uint32_t smsSubmitMs = 2500u;            //!< Ctrl-Z to +CMGS: <mr>
+static char     smsPdu[(2u * (SIM_SMS_MAX_TPDU + 12u)) + 1u];
+static uint32_t smsPduLength = 0;
+static uint32_t smsTpduLength = 0;
+static uint32_t smsSent = 0;
+static uint32_t smsRejected = 0;
+static char     smsLastText[SIM_SMS_TEXT_SIZE] = "";
+static bool     isNitzEnabled = true;
+static int32_t  timeZoneQuarters = -20;         //!< Local offset from UTC, DST included
+static int32_t  ctzrMode = 0;
+static bool     isCtzuOn = false;
+static bool     isNitzReceived = false;
+static uint32_t serverLatencyMs = 300u;
+static bool     isServerStalled = false;        //!< Event uploads never answered, tokens are
+static uint64_t stallStartMs = 0;               //!< First upload left unanswered
+static uint32_t httpStalled = 0;
+static uint64_t smsFirstStallMs = 0;            //!< Stall time when the first SMS went out
+static int32_t  csqRssi = 18;
+static char     operatorName[SIM_TEXT_SIZE] = "SIM Operator";
+static char     forwardHost[SIM_TEXT_SIZE] = "";
+static char     forwardPort[16] = "";
+static char     gnssGga[SIM_TEXT_SIZE] = "$GPGGA,104634.00,4026.29113,N,07959.96532,W,1,08,1.05,295.2,M,-33.9,M,,*6B";
+static uint32_t gnssFixDelayMs = 30000u;      //!< Cold start
+static uint32_t gnssTtffTimeAidedMs = 20000u;
+static uint32_t gnssTtffAidedMs = 8000u;
+static uint32_t gnssTtffJitterMs = 0u;
+static int32_t  gnssLatitude = 404381855;       //!< 1e-7 degrees
+static int32_t  gnssLongitude = -799994220;
+static int32_t  gnssHeightMm = 295200;
+static uint64_t gnssOnMs = 0;
+static uint32_t gnssJitterMs = 0;               //!< Sampled at each power on
+static bool     isGnssOn = false;
+static bool     isGnssTimeAided = false;
+static bool     isGnssPositionAided = false;
+static bool     isGnssFixReported = false;
+static uint8_t  ubxStream[SIM_UBX_STREAM_SIZE];
+static uint32_t ubxStreamLength = 0;
+static uint32_t gnssStarts = 0;
+static uint32_t gnssAidingFrames = 0;
+
+static uint64_t uartRxBytes = 0;
+static uint64_t uartTxBytes = 0;
+static uint32_t httpRequests = 0;
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static uint64_t NowMs(void);
+static void Log(const char *format, ...);
+static SimRule_t* GetRule(const char *name);
+static void LoadScenario(const char *path);
+static void OpenPty(const char *linkPath);
+static void ScheduleOutput(uint32_t delayMs, const char *data, uint32_t length, bool changeMode, SIM_MODE_t nextMode);
+static void Reply(SimRule_t *rule, const char *format, ...);
+static void SelectRat(void);
+static bool SetTlsSuite(int cipher, const char *args);
+static void GnssPower(bool isOn);
+static bool GnssHasFix(void);
+static void QueueUbxFrame(uint8_t msgClass, uint8_t msgId, const uint8_t payload[], uint16_t length);
+static void QueueNavPvt(void);
+static void ProcessUbxWrite(const char *hex);
+static void ProcessCommand(char *cmd);
+static void ProcessLinkData(void);
+static void ProcessLoopbackRequest(void);
+static void ProcessSmsSubmit(void);
+static int  OpenForwardConnection(void);
+static void FlushPendingOutput(void);
+static void FireUrcs(void);
+static void FireSocketConnects(void);
+static void FireNitz(void);
+static void FormatLocalTime(char buffer[], size_t size);
+static void PrintStatistics(void);
+static void SignalHandler(int sig);
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static uint64_t NowMs(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns monotonic time in milliseconds
+//
+//------------------------------------------------------------------------------
+static uint64_t NowMs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000u) + ((uint64_t)ts.tv_nsec / 1000000u);
+}
+
+//------------------------------------------------------------------------------
+//  static void Log(const char *format, ...)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function print trace with simulator time stamp when verbose is on
+//
+//------------------------------------------------------------------------------
+static void Log(const char *format, ...)
+{
+    va_list args;
+    if(isVerbose == true)
+    {
+        printf("[%8llu] ", (unsigned long long)(NowMs() - startMs));
+        va_start(args, format);
+        vprintf(format, args);
+        va_end(args);
+        printf("\n");
+        fflush(stdout);
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static SimRule_t* GetRule(const char *name)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns behaviour rule of a command, created with defaults
+//
+//------------------------------------------------------------------------------
+static SimRule_t* GetRule(const char *name)
+{
+    SimRule_t *rule = NULL;
+    uint32_t index = 0;
+
+    for(index = 0; index < numberOfRules; index++)
+    {
+        if(strcasecmp(rules[index].name, name) == 0)
+        {
+            rule = &rules[index];
+            break;
+        }
+    }
+    if((rule == NULL) && (numberOfRules < SIM_MAX_RULES))
+    {
+        rule = &rules[numberOfRules++];
+        memset(rule, 0, sizeof(SimRule_t));
+        snprintf(rule->name, sizeof(rule->name), "%s", name);
+        rule->latencyMs = SIM_DEFAULT_LATENCY_MS;
+        snprintf(rule->errorText, sizeof(rule->errorText), "+CME ERROR: operation not allowed");
+    }
+    return rule;
+}
+
+//------------------------------------------------------------------------------
+//  static void LoadScenario(const char *path)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function load latencies, errors and URCs from scenario file
+//
+//------------------------------------------------------------------------------
+static void LoadScenario(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    char line[SIM_LINE_SIZE];
+    char key[32], name[SIM_CMD_NAME_SIZE], text[SIM_TEXT_SIZE];
+    unsigned int value = 0, accepted = 0, suiteMs = 0, suiteBytes = 0;
+    uint32_t index = 0;
+    int quarters = 0;
+    double probability = 0, latitude = 0, longitude = 0, height = 0;
+    SimRule_t *rule = NULL;
+
+    if(file == NULL)
+    {
+        fprintf(stderr, "Unable to open scenario %s: %s\n", path, strerror(errno));
+        exit(1);
+    }
+    while(fgets(line, sizeof(line), file) != NULL)
+    {
+        text[0] = 0;
+        if((line[0] == '#') || (sscanf(line, "%31s", key) != 1))
+        {
+            continue;
+        }
+        if((strcmp(key, "latency") == 0) && (sscanf(line, "%*s %15s %u", name, &value) == 2))
+        {
+            GetRule(name)->latencyMs = value;
+        }
+        else if((strcmp(key, "error") == 0) && (sscanf(line, "%*s %15s %lf \"%255[^\"]\"", name, &probability, text) >= 2))
+        {
+            rule = GetRule(name);
+            rule->errorProbability = probability;
+            if(text[0] != 0)
+            {
+                snprintf(rule->errorText, sizeof(rule->errorText), "%s", text);
+            }
+        }
+        else if((strcmp(key, "urc") == 0) && (sscanf(line, "%*s %u \"%255[^\"]\"", &value, text) == 2) && (numberOfUrcs < SIM_MAX_URCS))
+        {
+            urcs[numberOfUrcs].atMs = value;
+            snprintf(urcs[numberOfUrcs].text, SIM_TEXT_SIZE, "%s", text);
+            numberOfUrcs++;
+        }
+        else if((strcmp(key, "registration_delay") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            registrationDelayMs = value;
+        }
+        else if((strcmp(key, "rat") == 0) && (sscanf(line, "%*s %d %u", &quarters, &value) == 2) &&
+                (quarters >= SIM_URAT_BASE) && (quarters < (SIM_URAT_BASE + (int)SIM_RAT_COUNT)))
+        {
+            isRatConfigured = true;
+            isRatOffered[quarters - SIM_URAT_BASE] = true;
+            ratRegistrationMs[quarters - SIM_URAT_BASE] = value;
+        }
+        else if((strcmp(key, "rat_scan") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            ratScanMs = value;
+        }
+        else if((strcmp(key, "band") == 0) && (sscanf(line, "%*s %u", &value) == 1) && (value >= 1u) && (value <= 64u))
+        {
+            networkBand = value;
+        }
+        else if((strcmp(key, "plmn") == 0) && (sscanf(line, "%*s %7[0-9]", text) == 1))
+        {
+            snprintf(networkPlmn, sizeof(networkPlmn), "%s", text);
+        }
+        else if((strcmp(key, "registration_cached") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            registrationCachedMs = value;
+        }
+        else if((strcmp(key, "dns") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            dnsLookupMs = value;
+        }
+        else if((strcmp(key, "dns_address") == 0) && (sscanf(line, "%*s \"%63[^\"]\"", text) == 1))
+        {
+            snprintf(dnsAddress, sizeof(dnsAddress), "%s", text);
+        }
+        else if((strcmp(key, "tls_full") == 0) && (sscanf(line, "%*s %u %u", &tlsHandshakeMs[SIM_TLS_FULL], &tlsHandshakeBytes[SIM_TLS_FULL]) == 2))
+        {
+            // Both values are taken by the condition
+        }
+        else if((strcmp(key, "tls_resumed") == 0) && (sscanf(line, "%*s %u %u", &tlsHandshakeMs[SIM_TLS_RESUMED], &tlsHandshakeBytes[SIM_TLS_RESUMED]) == 2))
+        {
+            // Both values are taken by the condition
+        }
+        else if((strcmp(key, "tls_resumption") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            isTlsResumptionSupported = (value != 0);
+        }
+        else if((strcmp(key, "tls_suite_ids") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            isTlsSuiteIdSupported = (value != 0);
+        }
+        else if((strcmp(key, "tls_suite") == 0) && (sscanf(line, "%*s %x %u %u %u", &value, &accepted, &suiteMs, &suiteBytes) == 4))
+        {
+            index = 0;
+            while((index < numberOfTlsSuites) && (tlsSuites[index].ianaId != value))
+            {
+                index++;
+            }
+            if(index < SIM_TLS_MAX_SUITES)
+            {
+                numberOfTlsSuites = (index == numberOfTlsSuites) ? (numberOfTlsSuites + 1u) : numberOfTlsSuites;
+                tlsSuites[index].ianaId = value;
+                tlsSuites[index].isAccepted = (accepted != 0);
+                tlsSuites[index].handshakeMs = suiteMs;
+                tlsSuites[index].handshakeBytes = suiteBytes;
+            }
+        }
+        else if((strcmp(key, "async_connect") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            isAsyncConnectSupported = (value != 0);
+        }
+        else if((strcmp(key, "uusoco") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            isConnectUrcOn = (value != 0);
+        }
+        else if((strcmp(key, "sms") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            isSmsServiceOn = (value != 0);
+        }
+        else if((strcmp(key, "sms_submit") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            smsSubmitMs = value;
+        }
+        else if((strcmp(key, "nitz") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            isNitzEnabled = (value != 0);
+        }
+        else if((strcmp(key, "timezone") == 0) && (sscanf(line, "%*s %d", &quarters) == 1))
+        {
+            timeZoneQuarters = quarters;
+        }
+        else if((strcmp(key, "server_latency") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            serverLatencyMs = value;
+        }
+        else if((strcmp(key, "server_stall") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            isServerStalled = (value != 0);
+        }
+        else if((strcmp(key, "csq") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            csqRssi = (int32_t)value;
+        }
+        else if((strcmp(key, "operator") == 0) && (sscanf(line, "%*s \"%255[^\"]\"", text) == 1))
+        {
+            snprintf(operatorName, sizeof(operatorName), "%s", text);
+        }
+        else if((strcmp(key, "gnss_fix_delay") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            gnssFixDelayMs = value;
+        }
+        else if((strcmp(key, "gnss_ttff_time_aided") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            gnssTtffTimeAidedMs = value;
+        }
+        else if((strcmp(key, "gnss_ttff_aided") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            gnssTtffAidedMs = value;
+        }
+        else if((strcmp(key, "gnss_ttff_jitter") == 0) && (sscanf(line, "%*s %u", &value) == 1))
+        {
+            gnssTtffJitterMs = value;
+        }
+        else if((strcmp(key, "gnss_position") == 0) && (sscanf(line, "%*s %lf %lf %lf", &latitude, &longitude, &height) == 3))
+        {
+            gnssLatitude = (int32_t)(latitude * 1e7);
+            gnssLongitude = (int32_t)(longitude * 1e7);
+            gnssHeightMm = (int32_t)(height * 1000.0);
+        }
+        else if((strcmp(key, "gnss_gga") == 0) && (sscanf(line, "%*s %255s", text) == 1))
+        {
+            snprintf(gnssGga, sizeof(gnssGga), "%s", text);
+        }
+        else
+        {
+            fprintf(stderr, "Ignoring scenario line: %s", line);
+        }
+    }
+    fclose(file);
+}
+
+//------------------------------------------------------------------------------
+//  static void OpenPty(const char *linkPath)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function open raw pseudo terminal that plays the modem UART
+//
+//------------------------------------------------------------------------------
+static void OpenPty(const char *linkPath)
+{
+    struct termios tio;
+    char *slaveName = NULL;
+
+    ptyMaster = posix_openpt(O_RDWR | O_NOCTTY);
+    if((ptyMaster < 0) || (grantpt(ptyMaster) != 0) || (unlockpt(ptyMaster) != 0))
+    {
+        perror("pty");
+        exit(1);
+    }
+    slaveName = ptsname(ptyMaster);
+
+    // Keep slave open so the master does not see hangup between clients
+    ptySlave = open(slaveName, O_RDWR | O_NOCTTY);
+    tcgetattr(ptySlave, &tio);
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, B115200);
+    cfsetospeed(&tio, B115200);
+    tcsetattr(ptySlave, TCSANOW, &tio);
+
+    if(linkPath != NULL)
+    {
+        unlink(linkPath);
+        if(symlink(slaveName, linkPath) != 0)
+        {
+            perror("symlink");
+        }
+    }
+    printf("SARA-R4 simulator on %s%s%s\n", slaveName, (linkPath != NULL) ? " -> " : "", (linkPath != NULL) ? linkPath : "");
+    fflush(stdout);
+}
+
+//------------------------------------------------------------------------------
+//  static void ScheduleOutput(uint32_t delayMs, const char *data, uint32_t length, bool changeMode, SIM_MODE_t nextMode)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function queue data to be written to the UART after a delay, output
+//!  is kept in order so a later short reply never overtakes a slow one
+//
+//------------------------------------------------------------------------------
+static void ScheduleOutput(uint32_t delayMs, const char *data, uint32_t length, bool changeMode, SIM_MODE_t nextMode)
+{
+    SimOutput_t *out = NULL;
+    uint64_t due = NowMs() + delayMs;
+
+    if(numberOfPending < SIM_MAX_PENDING_OUTPUT)
+    {
+        if((numberOfPending > 0) && (pending[numberOfPending - 1].dueMs > due))
+        {
+            due = pending[numberOfPending - 1].dueMs;
+        }
+        out = &pending[numberOfPending++];
+        out->dueMs = due;
+        out->length = length;
+        out->data = malloc(length);
+        memcpy(out->data, data, length);
+        out->changeMode = changeMode;
+        out->nextMode = nextMode;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void Reply(SimRule_t *rule, const char *format, ...)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function send the final response of a command after its latency,
+//!  format is the information text or NULL for a bare OK
+//
+//------------------------------------------------------------------------------
+static void Reply(SimRule_t *rule, const char *format, ...)
+{
+    char text[SIM_LINE_SIZE];
+    char out[SIM_LINE_SIZE + 32];
+    int length = 0;
+    va_list args;
+
+    rule->count++;
+    rule->totalLatencyMs += rule->latencyMs;
+
+    if((rule->errorProbability > 0) && (((double)rand() / RAND_MAX) < rule->errorProbability))
+    {
+        rule->errors++;
+        length = snprintf(out, sizeof(out), "\r\n%s\r\n", rule->errorText);
+    }
+    else if(format == NULL)
+    {
+        length = snprintf(out, sizeof(out), "\r\nOK\r\n");
+    }
+    else
+    {
+        va_start(args, format);
+        vsnprintf(text, sizeof(text), format, args);
+        va_end(args);
+        length = snprintf(out, sizeof(out), "\r\n%s\r\n\r\nOK\r\n", text);
+    }
+    ScheduleOutput(rule->latencyMs, out, (uint32_t)length, false, MODE_COMMAND);
+}
+
+//------------------------------------------------------------------------------
+//  static int OpenForwardConnection(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function connect to the forward server given with -f
+//
+//------------------------------------------------------------------------------
+static int OpenForwardConnection(void)
+{
+    struct addrinfo hints, *result = NULL, *item = NULL;
+    int fd = -1;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if(getaddrinfo(forwardHost, forwardPort, &hints, &result) == 0)
+    {
+        for(item = result; item != NULL; item = item->ai_next)
+        {
+            fd = socket(item->ai_family, item->ai_socktype, item->ai_protocol);
+            if(fd >= 0)
+            {
+                if(connect(fd, item->ai_addr, item->ai_addrlen) == 0)
+                {
+                    break;
+                }
+                close(fd);
+                fd = -1;
+            }
+        }
+        freeaddrinfo(result);
+    }
+    return fd;
+}
+
+//------------------------------------------------------------------------------
+//  static void SelectRat(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function pick the RAT registered at radio on and the time it takes,
+//!  RATs not offered ahead of it in the +URAT order cost rat_scan each.
+//!  LTE RATs need the serving band in their band mask, a mask holding only
+//!  that band registers in registration_cached. A manual selection of
+//!  another operator finds no network.
+//
+//------------------------------------------------------------------------------
+static void SelectRat(void)
+{
+    uint32_t index = 0, scanMs = 0;
+    int rat = 0;
+    uint64_t servingBandBit = (uint64_t)1u << (networkBand - 1u);
+    bool isPlmnFound = (isManualSelection == false) || (strcmp(manualPlmn, networkPlmn) == 0);
+
+    registeredRat = -1;
+    for(index = 0; (index < ratOrderCount) && (registeredRat < 0) && (isPlmnFound == true); index++)
+    {
+        rat = ratOrder[index];
+        if((rat < 2) && ((bandMask[rat] & servingBandBit) == 0u))
+        {
+            scanMs += ratScanMs;
+        }
+        else if((rat < 2) && (bandMask[rat] == servingBandBit))
+        {
+            registeredRat = rat;
+            attachDelayMs = scanMs + registrationCachedMs;
+        }
+        else if(isRatConfigured == false)
+        {
+            registeredRat = rat;
+            attachDelayMs = scanMs + registrationDelayMs;
+        }
+        else if(isRatOffered[rat] == true)
+        {
+            registeredRat = rat;
+            attachDelayMs = scanMs + ratRegistrationMs[rat];
+        }
+        else
+        {
+            scanMs += ratScanMs;
+        }
+    }
+    if(registeredRat >= 0)
+    {
+        ratAttaches[registeredRat]++;
+        Log("Attach on URAT %d in %u ms", registeredRat + SIM_URAT_BASE, attachDelayMs);
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static bool SetTlsSuite(int cipher, const char *args)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function apply +USECPRF op code 2: 0 selects the default list, 99
+//!  the IANA id that follows when tls_suite_ids and tls_suite know it.
+//!  Returns false for a setting the firmware rejects.
+//
+//------------------------------------------------------------------------------
+static bool SetTlsSuite(int cipher, const char *args)
+{
+    unsigned int high = 0, low = 0;
+    uint32_t index = 0;
+    bool isAccepted = false;
+
+    if(cipher == 0)
+    {
+        tlsSuite = -1;
+        isAccepted = true;
+    }
+    else if((cipher == 99) && (isTlsSuiteIdSupported == true) &&
+            (sscanf(args, "=%*d,%*d,%*d,\"%2x\",\"%2x\"", &high, &low) == 2))
+    {
+        for(index = 0; index < numberOfTlsSuites; index++)
+        {
+            if(tlsSuites[index].ianaId == ((high << 8) | low))
+            {
+                tlsSuite = (int)index;
+                isAccepted = true;
+            }
+        }
+    }
+    if(isAccepted == true)
+    {
+        // The session was negotiated with the previous suite
+        tlsSessionMs = UINT64_MAX;
+    }
+    return isAccepted;
+}
+
+//------------------------------------------------------------------------------
+//  static void GnssPower(bool isOn)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function switch the receiver supply, a power up loses the aiding
+//!  and the UBX stream
+//
+//------------------------------------------------------------------------------
+static void GnssPower(bool isOn)
+{
+    if((isOn == true) && (isGnssOn == false))
+    {
+        gnssOnMs = NowMs();
+        gnssJitterMs = (gnssTtffJitterMs > 0u) ? (uint32_t)(rand() % (gnssTtffJitterMs + 1u)) : 0u;
+        isGnssTimeAided = false;
+        isGnssPositionAided = false;
+        isGnssFixReported = false;
+        ubxStreamLength = 0;
+        gnssStarts++;
+    }
+    isGnssOn = isOn;
+}
+
+//------------------------------------------------------------------------------
+//  static bool GnssHasFix(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true once the time to first fix of the current
+//!  start type has elapsed
+//
+//------------------------------------------------------------------------------
+static bool GnssHasFix(void)
+{
+    uint32_t ttffMs = gnssFixDelayMs;
+
+    if(isGnssPositionAided == true)
+    {
+        ttffMs = gnssTtffAidedMs;
+    }
+    else if(isGnssTimeAided == true)
+    {
+        ttffMs = gnssTtffTimeAidedMs;
+    }
+
+    return (isGnssOn == true) && ((NowMs() - gnssOnMs) >= ((uint64_t)ttffMs + gnssJitterMs));
+}
+
+//------------------------------------------------------------------------------
+//  static void QueueUbxFrame(uint8_t msgClass, uint8_t msgId, const uint8_t payload[], uint16_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function append a UBX frame to the stream read by +UI2CR
+//
+//------------------------------------------------------------------------------
+static void QueueUbxFrame(uint8_t msgClass, uint8_t msgId, const uint8_t payload[], uint16_t length)
+{
+    uint8_t *frame = &ubxStream[ubxStreamLength];
+    uint8_t checksumA = 0, checksumB = 0;
+    uint32_t index = 0;
+
+    if((ubxStreamLength + length + 8u) <= SIM_UBX_STREAM_SIZE)
+    {
+        frame[0] = 0xB5;
+        frame[1] = 0x62;
+        frame[2] = msgClass;
+        frame[3] = msgId;
+        frame[4] = (uint8_t)(length & 0xFFu);
+        frame[5] = (uint8_t)(length >> 8);
+        memcpy(&frame[6], payload, length);
+        for(index = 2; index < (6u + length); index++)
+        {
+            checksumA += frame[index];
+            checksumB += checksumA;
+        }
+        frame[6u + length] = checksumA;
+        frame[7u + length] = checksumB;
+        ubxStreamLength += length + 8u;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void QueueNavPvt(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function answer a NAV-PVT poll, no fix and no valid time until the
+//!  time to first fix has elapsed
+//
+//------------------------------------------------------------------------------
+static void QueueNavPvt(void)
+{
+    uint8_t payload[SIM_UBX_NAV_PVT_SIZE] = {0};
+    bool isFixed = GnssHasFix();
+    time_t now = time(NULL);
+    struct tm *utc = gmtime(&now);
+    uint32_t iTow = (uint32_t)(((utc->tm_wday * 86400) + (utc->tm_hour * 3600) + (utc->tm_min * 60) + utc->tm_sec) * 1000);
+    uint32_t hAcc = (isFixed == true) ? 2500u : 0xFFFFFFFFu;
+    uint16_t pDop = (isFixed == true) ? 150u : 9999u;
+
+    memcpy(&payload[0], &iTow, 4);
+    payload[4] = (uint8_t)((utc->tm_year + 1900) & 0xFF);
+    payload[5] = (uint8_t)((utc->tm_year + 1900) >> 8);
+    payload[6] = (uint8_t)(utc->tm_mon + 1);
+    payload[7] = (uint8_t)utc->tm_mday;
+    payload[8] = (uint8_t)utc->tm_hour;
+    payload[9] = (uint8_t)utc->tm_min;
+    payload[10] = (uint8_t)utc->tm_sec;
+    if(isFixed == true)
+    {
+        payload[11] = 0x07;         // validDate, validTime, fullyResolved
+        payload[20] = 3;            // 3D fix
+        payload[21] = 0x01;         // gnssFixOK
+        payload[23] = 8;
+        memcpy(&payload[24], &gnssLongitude, 4);
+        memcpy(&payload[28], &gnssLatitude, 4);
+        memcpy(&payload[32], &gnssHeightMm, 4);
+        memcpy(&payload[36], &gnssHeightMm, 4);
+        if(isGnssFixReported == false)
+        {
+            isGnssFixReported = true;
+            Log("GNSS fix after %llu ms (%s)", (unsigned long long)(NowMs() - gnssOnMs),
+                (isGnssPositionAided == true) ? "aided" : ((isGnssTimeAided == true) ? "time aided" : "cold"));
+        }
+    }
+    memcpy(&payload[40], &hAcc, 4);
+    memcpy(&payload[76], &pDop, 2);
+    QueueUbxFrame(0x01, 0x07, payload, sizeof(payload));
+}
+
+//------------------------------------------------------------------------------
+//  static void ProcessUbxWrite(const char *hex)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function decode the hex of +UI2CW and act on the UBX frames in it.
+//!  Configuration frames are accepted and ignored.
+//
+//------------------------------------------------------------------------------
+static void ProcessUbxWrite(const char *hex)
+{
+    uint8_t data[SIM_UBX_STREAM_SIZE];
+    uint32_t length = 0, index = 0;
+    unsigned int byte = 0;
+    uint16_t payloadLength = 0;
+
+    while((hex[2u * length] != 0) && (length < sizeof(data)) && (sscanf(&hex[2u * length], "%2x", &byte) == 1))
+    {
+        data[length++] = (uint8_t)byte;
+    }
+
+    while((index + 8u) <= length)
+    {
+        if((data[index] != 0xB5) || (data[index + 1u] != 0x62))
+        {
+            index++;
+            continue;
+        }
+        payloadLength = (uint16_t)(data[index + 4u] | (data[index + 5u] << 8));
+        if((data[index + 2u] == 0x01) && (data[index + 3u] == 0x07) && (payloadLength == 0u))
+        {
+            QueueNavPvt();
+        }
+        else if((data[index + 2u] == 0x13) && (data[index + 3u] == 0x40) && (payloadLength > 0u) && ((index + 6u) < length))
+        {
+            // MGA-INI, first payload byte is the message type
+            isGnssTimeAided |= (data[index + 6u] == 0x10);
+            isGnssPositionAided |= (data[index + 6u] == 0x01);
+            gnssAidingFrames++;
+        }
+        index += payloadLength + 8u;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void ProcessCommand(char *cmd)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function answer one AT command line
+//
+//------------------------------------------------------------------------------
+static void ProcessCommand(char *cmd)
+{
+    char name[SIM_CMD_NAME_SIZE] = {0};
+    char text[SIM_TEXT_SIZE] = {0};
+    char hex[(2u * SIM_UBX_MAX_READ) + 1u] = {0};
+    char *args = NULL;
+    uint32_t nameLength = 0, index = 0;
+    int socketId = 0, value = 0, gpio = 0, gpioMode = 0;
+    unsigned int length = 0;
+    SimRule_t *rule = NULL;
+    bool isRegistered = false;
+    bool isConnected = false;
+    bool isHostName = false;
+    bool isAsync = false;
+    int asyncConnect = 0;
+    uint32_t handshakeBytes = 0;
+    time_t now;
+    struct tm *utc;
+
+    Log("<- %s", cmd);
+    if(strncasecmp(cmd, "AT", 2) != 0)
+    {
+        return;
+    }
+
+    // Command name is "+XXXX", "E0", "I" or empty for plain AT
+    args = &cmd[2];
+    while((args[nameLength] != 0) && (args[nameLength] != '=') && (args[nameLength] != '?') && (nameLength < (SIM_CMD_NAME_SIZE - 1)))
+    {
+        name[nameLength] = args[nameLength];
+        nameLength++;
+        if((nameLength == 1) && (name[0] != '+'))
+        {
+            break;
+        }
+    }
+    args = &args[nameLength];
+    rule = GetRule((name[0] == 0) ? "AT" : name);
+
+    isRegistered = (isRadioOn == true) && (registeredRat >= 0) && ((NowMs() - radioOnMs) >= attachDelayMs);
+
+    if((name[0] == 0) || (strcasecmp(name, "I") == 0))
+    {
+        Reply(rule, (name[0] == 0) ? NULL : "u-blox\r\nSARA-R410M-02B\r\nL0.0.00.00.05.06");
+    }
+    else if(strcasecmp(name, "E") == 0)
+    {
+        isEchoOn = (args[0] == '1');
+        Reply(rule, NULL);
+    }
+    else if(strcasecmp(name, "+CPIN") == 0)
+    {
+        Reply(rule, "+CPIN: READY");
+    }
+    else if(strcasecmp(name, "+CGSN") == 0)
+    {
+        Reply(rule, "352753090000001");
+    }
+    else if(strcasecmp(name, "+ICCID") == 0)
+    {
+        Reply(rule, "ICCID: 89011703278100000001");
+    }
+    else if(strcasecmp(name, "+CSQ") == 0)
+    {
+        Reply(rule, "+CSQ: %d,99", (isRegistered == true) ? csqRssi : 99);
+    }
+    else if(strcasecmp(name, "+CREG") == 0)
+    {
+        if(args[0] == '?')
+        {
+            Reply(rule, "+CREG: 0,%d", (isRegistered == true) ? 1 : 2);
+        }
+        else
+        {
+            Reply(rule, NULL);
+        }
+    }
+    else if((strcasecmp(name, "+COPS") == 0) && (args[0] == '='))
+    {
+        // Selection restarts the registration, manual one answers when done
+        isManualSelection = (sscanf(args, "=1,2,\"%7[0-9]\"", manualPlmn) == 1);
+        radioOnMs = NowMs();
+        if(isRadioOn == true)
+        {
+            SelectRat();
+        }
+        if(isManualSelection == false)
+        {
+            Reply(rule, NULL);
+        }
+        else
+        {
+            manualSelections++;
+            rule->count++;
+            if(registeredRat >= 0)
+            {
+                ScheduleOutput(attachDelayMs, "\r\nOK\r\n", 6, false, MODE_COMMAND);
+            }
+            else
+            {
+                ScheduleOutput(ratScanMs, "\r\n+CME ERROR: no network service\r\n", 34, false, MODE_COMMAND);
+            }
+        }
+    }
+    else if(strcasecmp(name, "+COPS") == 0)
+    {
+        if(isRegistered == true)
+        {
+            // <AcT> 7 LTE, 9 NB-IoT, 0 GSM
+            Reply(rule, "+COPS: 0,0,\"%s\",%d", operatorName, (registeredRat == 0) ? 7 : ((registeredRat == 1) ? 9 : 0));
+        }
+        else
+        {
+            Reply(rule, "+COPS: 0");
+        }
+    }
+    else if((strcasecmp(name, "+UBANDMASK") == 0) && (args[0] == '='))
+    {
+        // Bands 65 and up are not simulated, the second mask is ignored
+        if((sscanf(args, "=%d,", &value) == 1) && ((value == 0) || (value == 1)) && (strchr(args, ',') != NULL))
+        {
+            bandMask[value] = strtoull(strchr(args, ',') + 1, NULL, 10);
+            Reply(rule, NULL);
+        }
+        else
+        {
+            Reply(rule, "+CME ERROR: operation not allowed");
+        }
+    }
+    else if(strcasecmp(name, "+UBANDMASK") == 0)
+    {
+        Reply(rule, "+UBANDMASK: 0,%llu,0,1,%llu,0", (unsigned long long)bandMask[0], (unsigned long long)bandMask[1]);
+    }
+    else if((strcasecmp(name, "+UCGED") == 0) && (args[0] == '?'))
+    {
+        if((isRegistered == true) && (registeredRat < 2))
+        {
+            // <rat> 6 LTE, then <EARFCN>,<band>,<cell id>,<tac>,<rsrp>,<rsrq>
+            Reply(rule, "+UCGED: 2\r\n6,4,%.3s,%s\r\n5110,%u,8a2f01,1f0a,%d,%d", networkPlmn, &networkPlmn[3],
+                  networkBand, 50 + csqRssi, 20);
+        }
+        else if(isRegistered == true)
+        {
+            Reply(rule, "+UCGED: 2\r\n2,4,%.3s,%s\r\n128,1f0a,8a2f,%d", networkPlmn, &networkPlmn[3], csqRssi);
+        }
+        else
+        {
+            Reply(rule, "+UCGED: 2\r\n255,0,000,00");
+        }
+    }
+    else if(strcasecmp(name, "+URAT") == 0)
+    {
+        // Taken at the next radio on, as after a deregistration on the module
+        index = 0;
+        while((args[0] == '=') || (args[0] == ','))
+        {
+            args++;
+            value = (int)strtol(args, &args, 10);
+            if((value >= SIM_URAT_BASE) && (value < (SIM_URAT_BASE + (int)SIM_RAT_COUNT)) && (index < SIM_RAT_COUNT))
+            {
+                ratOrder[index++] = value - SIM_URAT_BASE;
+            }
+        }
+        if(index > 0)
+        {
+            ratOrderCount = index;
+        }
+        Reply(rule, NULL);
+    }
+    else if(strcasecmp(name, "+CCLK") == 0)
+    {
+        if((isNitzReceived == true) && (isCtzuOn == true))
+        {
+            FormatLocalTime(text, sizeof(text));
+            Reply(rule, "+CCLK: \"%s%+03d\"", text, (int)timeZoneQuarters);
+        }
+        else
+        {
+            // Modem clock counts from its default date until network time
+            Reply(rule, "+CCLK: \"04/01/01,00:00:00+00\"");
+        }
+    }
+    else if(strcasecmp(name, "+CTZU") == 0)
+    {
+        if(sscanf(args, "=%d", &value) == 1)
+        {
+            isCtzuOn = (value != 0);
+        }
+        Reply(rule, NULL);
+    }
+    else if(strcasecmp(name, "+CTZR") == 0)
+    {
+        if(sscanf(args, "=%d", &value) == 1)
+        {
+            ctzrMode = value;
+        }
+        Reply(rule, NULL);
+    }
+    else if(strcasecmp(name, "+CGPADDR") == 0)
+    {
+        Reply(rule, "+CGPADDR: 1,10.170.12.34");
+    }
+    else if(strcasecmp(name, "+CFUN") == 0)
+    {
+        if(sscanf(args, "=%d", &value) == 1)
+        {
+            if((value != 0) && (isRadioOn == false))
+            {
+                radioOnMs = NowMs();
+                isNitzReceived = false;
+                SelectRat();
+            }
+            isRadioOn = (value != 0);
+        }
+        Reply(rule, NULL);
+    }
+    else if(strcasecmp(name, "+USECMNG") == 0)
+    {
+        if(sscanf(args, "=0,0,\"%255[^\"]\",%u", text, &length) == 2)
+        {
+            // Certificate bytes follow the prompt
+            certRemaining = length;
+            rule->count++;
+            ScheduleOutput(rule->latencyMs, "\r\n>", 3, true, MODE_CERT_INPUT);
+        }
+        else
+        {
+            Reply(rule, NULL);
+        }
+    }
+    else if(strcasecmp(name, "+CMGF") == 0)
+    {
+        (void)sscanf(args, "=%d", &smsFormat);
+        Reply(rule, NULL);
+    }
+    else if(strcasecmp(name, "+CMGS") == 0)
+    {
+        rule->count++;
+        rule->totalLatencyMs += rule->latencyMs;
+        if((smsFormat == 0) && (sscanf(args, "=%u", &length) == 1) && (length > 0u) && (length <= SIM_SMS_MAX_TPDU))
+        {
+            // PDU follows the prompt, ended by Ctrl-Z
+            smsTpduLength = length;
+            smsPduLength = 0;
+            ScheduleOutput(rule->latencyMs, "\r\n> ", 4, true, MODE_SMS_INPUT);
+        }
+        else
+        {
+            snprintf(text, sizeof(text), "\r\n+CMS ERROR: 304\r\n");
+            ScheduleOutput(rule->latencyMs, text, (uint32_t)strlen(text), false, MODE_COMMAND);
+        }
+    }
+    else if(strcasecmp(name, "+USOCR") == 0)
+    {
+        for(socketId = 0; socketId < (int)SIM_MAX_SOCKETS; socketId++)
+        {
+            if(sockets[socketId].isUsed == false)
+            {
+                break;
+            }
+        }
+        if(socketId < (int)SIM_MAX_SOCKETS)
+        {
+            sockets[socketId].isUsed = true;
+            sockets[socketId].isConnected = false;
+            sockets[socketId].isSecure = false;
+            sockets[socketId].bytesSent = 0;
+            sockets[socketId].bytesReceived = 0;
+            sockets[socketId].fd = -1;
+            Reply(rule, "+USOCR: %d", socketId);
+        }
+        else
+        {
+            rule->count++;
+            socketsRefused++;
+            snprintf(text, sizeof(text), "\r\n+CME ERROR: no more sockets available\r\n");
+            ScheduleOutput(rule->latencyMs, text, (uint32_t)strlen(text), false, MODE_COMMAND);
+        }
+    }
+    else if(strcasecmp(name, "+USOCO") == 0)
+    {
+        // A host name is looked up first, an address other than dns_address does not answer
+        text[0] = 0;
+        (void)sscanf(args, "=%*d,\"%255[^\"]\"", text);
+        isHostName = (strspn(text, "0123456789.") != strlen(text));
+        (void)sscanf(args, "=%*d,\"%*[^\"]\",%*d,%d", &asyncConnect);
+        isAsync = (asyncConnect == 1);
+        if(isHostName == true)
+        {
+            dnsConnectLookups++;
+        }
+        if((sscanf(args, "=%d", &socketId) != 1) || (socketId < 0) || (socketId >= (int)SIM_MAX_SOCKETS) ||
+           (isAsyncConnectSupported == false) || (sockets[socketId].isUsed == false) || (sockets[socketId].isConnectPending == true))
+        {
+            // Asynchronous connect needs an idle socket and firmware support
+            isAsync = false;
+        }
+        if((sscanf(args, "=%d", &socketId) == 1) && (socketId >= 0) && (socketId < (int)SIM_MAX_SOCKETS) &&
+           (sockets[socketId].isUsed == true) && (isRegistered == true) &&
+           ((isHostName == true) || (strcmp(text, dnsAddress) == 0)) && ((isAsync == true) || (asyncConnect != 1)))
+        {
+            sockets[socketId].isConnected = true;
+            if(forwardHost[0] != 0)
+            {
+                sockets[socketId].fd = OpenForwardConnection();
+                sockets[socketId].isConnected = (sockets[socketId].fd >= 0);
+            }
+            isConnected = sockets[socketId].isConnected;
+        }
+        value = (isHostName == true) ? (int)dnsLookupMs : 0;
+        if((isConnected == true) && (sockets[socketId].isSecure == true))
+        {
+            // Session of the last handshake is resumed when the profile allows it and it completed
+            index = ((isTlsResumptionOn == true) && (NowMs() >= tlsSessionMs)) ? SIM_TLS_RESUMED : SIM_TLS_FULL;
+            if((index == SIM_TLS_FULL) && (tlsSuite >= 0) && (tlsSuites[tlsSuite].isAccepted == false))
+            {
+                // Server answers the ClientHello with a handshake failure alert
+                tlsSuites[tlsSuite].rejects++;
+                tlsBytes += SIM_TLS_REJECT_BYTES;
+                value += (int)tlsHandshakeMs[SIM_TLS_RESUMED];
+                if(sockets[socketId].fd >= 0)
+                {
+                    close(sockets[socketId].fd);
+                    sockets[socketId].fd = -1;
+                }
+                sockets[socketId].isConnected = false;
+                isConnected = false;
+            }
+            else if((index == SIM_TLS_FULL) && (tlsSuite >= 0))
+            {
+                tlsHandshakes[index]++;
+                tlsSuites[tlsSuite].handshakes++;
+                handshakeBytes = tlsSuites[tlsSuite].handshakeBytes;
+                value += (int)tlsSuites[tlsSuite].handshakeMs;
+            }
+            else
+            {
+                tlsHandshakes[index]++;
+                handshakeBytes = tlsHandshakeBytes[index];
+                value += (int)tlsHandshakeMs[index];
+            }
+            tlsBytes += handshakeBytes;
+            if(isConnected == false)
+            {
+                tlsSessionMs = UINT64_MAX;
+            }
+            else if(tlsSessionMs > (NowMs() + rule->latencyMs + (uint32_t)value))
+            {
+                tlsSessionMs = NowMs() + rule->latencyMs + (uint32_t)value;
+            }
+            if(isConnected == true)
+            {
+                sockets[socketId].bytesSent += (tlsClientBytes[index] < handshakeBytes) ? tlsClientBytes[index] : handshakeBytes;
+                sockets[socketId].bytesReceived += (tlsClientBytes[index] < handshakeBytes) ? (handshakeBytes - tlsClientBytes[index]) : 0u;
+            }
+        }
+        if(isAsync == true)
+        {
+            // Outcome is known now, the socket counts as connected once +UUSOCO reported it
+            asyncConnects++;
+            sockets[socketId].isConnectPending = true;
+            sockets[socketId].isConnectOk = isConnected;
+            sockets[socketId].isConnected = false;
+            sockets[socketId].connectDueMs = NowMs() + rule->latencyMs + (uint32_t)value;
+            Reply(rule, NULL);
+        }
+        else if(isConnected == true)
+        {
+            rule->latencyMs += (uint32_t)value;
+            Reply(rule, NULL);
+            rule->latencyMs -= (uint32_t)value;
+        }
+        else
+        {
+            rule->count++;
+            rule->totalLatencyMs += rule->latencyMs + (uint32_t)value;
+            snprintf(text, sizeof(text), "\r\n+CME ERROR: operation not allowed\r\n");
+            ScheduleOutput(rule->latencyMs + (uint32_t)value, text, (uint32_t)strlen(text), false, MODE_COMMAND);
+        }
+    }
+    else if(strcasecmp(name, "+USOSEC") == 0)
+    {
+        if((sscanf(args, "=%d,%d", &socketId, &value) == 2) && (socketId >= 0) && (socketId < (int)SIM_MAX_SOCKETS))
+        {
+            sockets[socketId].isSecure = (value == 1);
+        }
+        Reply(rule, NULL);
+    }
+    else if((strcasecmp(name, "+USECPRF") == 0) && (sscanf(args, "=%*d,%d,%d", &value, &gpio) == 2) && ((value == 2) || (value == 13)))
+    {
+        if((value == 2) && (SetTlsSuite(gpio, args) == true))
+        {
+            Reply(rule, NULL);
+        }
+        else if((value == 13) && (isTlsResumptionSupported == true))
+        {
+            isTlsResumptionOn = (gpio == 1);
+            Reply(rule, NULL);
+        }
+        else
+        {
+            rule->count++;
+            snprintf(text, sizeof(text), "\r\n+CME ERROR: operation not supported\r\n");
+            ScheduleOutput(rule->latencyMs, text, (uint32_t)strlen(text), false, MODE_COMMAND);
+        }
+    }
+    else if(strcasecmp(name, "+UDNSRN") == 0)
+    {
+        dnsLookups++;
+        rule->latencyMs += dnsLookupMs;
+        if(isRegistered == true)
+        {
+            Reply(rule, "+UDNSRN: \"%s\"", dnsAddress);
+        }
+        else
+        {
+            rule->count++;
+            rule->totalLatencyMs += rule->latencyMs;
+            snprintf(text, sizeof(text), "\r\n+CME ERROR: operation not allowed\r\n");
+            ScheduleOutput(rule->latencyMs, text, (uint32_t)strlen(text), false, MODE_COMMAND);
+        }
+        rule->latencyMs -= dnsLookupMs;
+    }
+    else if(strcasecmp(name, "+USODL") == 0)
+    {
+        if((sscanf(args, "=%d", &socketId) == 1) && (socketId >= 0) && (socketId < (int)SIM_MAX_SOCKETS) &&
+           (sockets[socketId].isConnected == true))
+        {
+            linkSocket = socketId;
+            linkLength = 0;
+            rule->count++;
+            rule->totalLatencyMs += rule->latencyMs;
+            ScheduleOutput(rule->latencyMs, "\r\nCONNECT\r\n", 11, true, MODE_DIRECT_LINK);
+        }
+        else
+        {
+            rule->count++;
+            ScheduleOutput(rule->latencyMs, "\r\nERROR\r\n", 9, false, MODE_COMMAND);
+        }
+    }
+    else if(strcasecmp(name, "+USOCL") == 0)
+    {
+        if((sscanf(args, "=%d", &socketId) == 1) && (socketId >= 0) && (socketId < (int)SIM_MAX_SOCKETS))
+        {
+            if(sockets[socketId].fd >= 0)
+            {
+                close(sockets[socketId].fd);
+            }
+            memset(&sockets[socketId], 0, sizeof(SimSocket_t));
+            sockets[socketId].fd = -1;
+        }
+        Reply(rule, NULL);
+    }
+    else if(strcasecmp(name, "+USOCTL") == 0)
+    {
+        if((sscanf(args, "=%d,%d", &socketId, &value) == 2) && (socketId >= 0) && (socketId < (int)SIM_MAX_SOCKETS) &&
+           (sockets[socketId].isUsed == true) && ((value == 2) || (value == 3)))
+        {
+            Reply(rule, "+USOCTL: %d,%d,%u", socketId, value,
+                  (value == 2) ? sockets[socketId].bytesSent : sockets[socketId].bytesReceived);
+        }
+        else
+        {
+            rule->count++;
+            snprintf(text, sizeof(text), "\r\n+CME ERROR: operation not allowed\r\n");
+            ScheduleOutput(rule->latencyMs, text, (uint32_t)strlen(text), false, MODE_COMMAND);
+        }
+    }
+    else if(strcasecmp(name, "+USORD") == 0)
+    {
+        sscanf(args, "=%d", &socketId);
+        Reply(rule, "+USORD: %d,0,\"\"", socketId);
+    }
+    else if(strcasecmp(name, "+UGPS") == 0)
+    {
+        if(sscanf(args, "=%d", &value) == 1)
+        {
+            GnssPower(value != 0);
+        }
+        Reply(rule, NULL);
+    }
+    else if(strcasecmp(name, "+UGPIOC") == 0)
+    {
+        if((sscanf(args, "=%d,%d,%d", &gpio, &gpioMode, &value) == 3) && (gpio == SIM_GNSS_SUPPLY_GPIO) && (gpioMode == 0))
+        {
+            GnssPower(value != 0);
+        }
+        Reply(rule, NULL);
+    }
+    else if((strcasecmp(name, "+UI2CW") == 0) || (strcasecmp(name, "+UI2CR") == 0))
+    {
+        if(isGnssOn == false)
+        {
+            // Receiver without supply does not acknowledge its address
+            rule->count++;
+            snprintf(text, sizeof(text), "\r\n+CME ERROR: I2C nack\r\n");
+            ScheduleOutput(rule->latencyMs, text, (uint32_t)strlen(text), false, MODE_COMMAND);
+        }
+        else if((strcasecmp(name, "+UI2CW") == 0) && (sscanf(args, "=\"%1024[0-9A-Fa-f]\",%u", hex, &length) == 2))
+        {
+            ProcessUbxWrite(hex);
+            Reply(rule, NULL);
+        }
+        else if((strcasecmp(name, "+UI2CR") == 0) && (sscanf(args, "=%u", &length) == 1))
+        {
+            length = (length < SIM_UBX_MAX_READ) ? length : SIM_UBX_MAX_READ;
+            for(index = 0; index < length; index++)
+            {
+                snprintf(&hex[2u * index], 3, "%02X", (index < ubxStreamLength) ? ubxStream[index] : 0xFFu);
+            }
+            index = (length < ubxStreamLength) ? length : ubxStreamLength;
+            memmove(ubxStream, &ubxStream[index], ubxStreamLength - index);
+            ubxStreamLength -= index;
+            Reply(rule, "+UI2CR: \"%s\",%u", hex, length);
+        }
+        else
+        {
+            Reply(rule, NULL);
+        }
+    }
+    else if(strcasecmp(name, "+UGGGA") == 0)
+    {
+        if((args[0] == '?') && (GnssHasFix() == true))
+        {
+            Reply(rule, "+UGGGA: 1,%s", gnssGga);
+        }
+        else if(args[0] == '?')
+        {
+            Reply(rule, "+UGGGA: 1,$GPGGA,,,,,,0,00,99.99,,,,,,*48");
+        }
+        else
+        {
+            Reply(rule, NULL);
+        }
+    }
+    else if(strcasecmp(name, "+UGGSV") == 0)
+    {
+        Reply(rule, (args[0] == '?') ? "+UGGSV: 1,$GPGSV,1,1,01,05,,,25*7F" : NULL);
+    }
+    else if(strcasecmp(name, "+ULOC") == 0)
+    {
+        Reply(rule, NULL);
+        now = time(NULL);
+        utc = gmtime(&now);
+        snprintf(text, sizeof(text), "\r\n+UULOC: %02d/%02d/%04d,%02d:%02d:%02d.000,40.4381855,-79.9994220,0,1200,0,0,0,0,0,0,0\r\n",
+                 utc->tm_mday, utc->tm_mon + 1, utc->tm_year + 1900, utc->tm_hour, utc->tm_min, utc->tm_sec);
+        ScheduleOutput(1500u, text, (uint32_t)strlen(text), false, MODE_COMMAND);
+    }
+    else
+    {
+        // CMEE, CGDCONT, CGATT, CGACT, USECPRF, UDCONF, USOSEC,
+        // USOCLCFG, UI2CO, UCGED and other set commands simply succeed
+        Reply(rule, NULL);
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void ProcessSmsSubmit(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function check and decode the SMS-SUBMIT received after +CMGS and
+//!  answer +CMGS: <mr>, or +CMS ERROR 304 for a bad PDU and 331 without
+//!  network service
+//
+//------------------------------------------------------------------------------
+static void ProcessSmsSubmit(void)
+{
+    static uint32_t messageReference = 0;
+    uint8_t pdu[sizeof(smsPdu) / 2u];
+    char number[24] = "";
+    char out[64];
+    uint32_t octets = smsPduLength / 2u, index = 0, start = 0, digits = 0, septets = 0, bit = 0;
+    uint32_t validityPeriod = 0, numberLength = 0;
+    uint8_t firstOctet = 0, dataCoding = 0;
+    unsigned int octet = 0;
+    uint32_t delayMs = GetRule("+CMGS")->latencyMs;
+    int error = 0;
+
+    for(index = 0; (index < octets) && (sscanf(&smsPdu[2u * index], "%2x", &octet) == 1); index++)
+    {
+        pdu[index] = (uint8_t)octet;
+    }
+
+    // SMSC, first octet, TP-MR, TP-DA, TP-PID, TP-DCS, TP-VP, TP-UDL, TP-UD
+    start = (octets > 0u) ? (1u + pdu[0]) : 0u;
+    index = start;
+    if(((smsPduLength % 2u) != 0u) || ((index + 4u) > octets) || ((octets - start) != smsTpduLength))
+    {
+        error = 304;
+    }
+    else
+    {
+        firstOctet = pdu[index];
+        digits = pdu[index + 2u];
+        if(pdu[index + 3u] == 0x91u)
+        {
+            number[numberLength++] = '+';
+        }
+        index += 4u;
+        for(bit = 0; (bit < digits) && ((index + (bit / 2u)) < octets) && (numberLength < (sizeof(number) - 1u)); bit++)
+        {
+            number[numberLength++] = (char)('0' + ((pdu[index + (bit / 2u)] >> ((bit % 2u) * 4u)) & 0x0Fu));
+        }
+        number[numberLength] = 0;
+        index += (digits + 1u) / 2u;
+
+        // TP-VPF 2 is one octet of relative validity, 1 and 3 are seven octets
+        validityPeriod = (((firstOctet >> 3) & 0x03u) == 0x02u) ? 1u : ((((firstOctet >> 3) & 0x03u) == 0x00u) ? 0u : 7u);
+        dataCoding = ((index + 1u) < octets) ? pdu[index + 1u] : 0xFFu;
+        index += 2u + validityPeriod;
+        septets = (index < octets) ? pdu[index] : 0u;
+        index++;
+
+        // Only SMS-SUBMIT in the GSM 7 bit alphabet is decoded
+        if(((firstOctet & 0x03u) != 0x01u) || (dataCoding != 0x00u) || (index > octets) ||
+           ((octets - index) != (((septets * 7u) + 7u) / 8u)) || (septets >= SIM_SMS_TEXT_SIZE))
+        {
+            error = 304;
+        }
+        else
+        {
+            for(bit = 0; bit < septets; bit++)
+            {
+                octet = pdu[index + ((bit * 7u) / 8u)] >> ((bit * 7u) % 8u);
+                if(((bit * 7u) % 8u) > 1u)
+                {
+                    octet |= pdu[index + ((bit * 7u) / 8u) + 1u] << (8u - ((bit * 7u) % 8u));
+                }
+                smsLastText[bit] = (char)(octet & 0x7Fu);
+            }
+            smsLastText[septets] = 0;
+        }
+    }
+    if((error == 0) && ((isSmsServiceOn == false) || (isRadioOn == false) || (registeredRat < 0) || ((NowMs() - radioOnMs) < attachDelayMs)))
+    {
+        error = 331;
+    }
+
+    if(error == 0)
+    {
+        smsSent++;
+        messageReference = (messageReference + 1u) % 256u;
+        if(stallStartMs != 0u)
+        {
+            if(smsFirstStallMs == 0u)
+            {
+                smsFirstStallMs = NowMs() - stallStartMs;
+            }
+            printf("SMS to %s: %s (data path stalled for %llu ms, %u requests unanswered)\n", number, smsLastText,
+                   (unsigned long long)(NowMs() - stallStartMs), httpStalled);
+        }
+        else
+        {
+            printf("SMS to %s: %s\n", number, smsLastText);
+        }
+        fflush(stdout);
+        snprintf(out, sizeof(out), "\r\n+CMGS: %u\r\n\r\nOK\r\n", messageReference);
+        delayMs += smsSubmitMs;
+    }
+    else
+    {
+        smsRejected++;
+        snprintf(out, sizeof(out), "\r\n+CMS ERROR: %d\r\n", error);
+    }
+    ScheduleOutput(delayMs, out, (uint32_t)strlen(out), false, MODE_COMMAND);
+}
+
+//------------------------------------------------------------------------------
+//  static void ProcessLoopbackRequest(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function play iNet for a complete HTTP request in the link buffer
+//
+//------------------------------------------------------------------------------
+static void ProcessLoopbackRequest(void)
+{
+    char *headerEnd = NULL, *contentLength = NULL;
+    uint32_t bodyLength = 0, requestLength = 0;
+    char body[SIM_TEXT_SIZE], response[SIM_LINE_SIZE];
+    int length = 0;
+    int status = 404;
+
+    linkBuffer[linkLength] = 0;
+    headerEnd = strstr(linkBuffer, "\r\n\r\n");
+    if(headerEnd == NULL)
+    {
+        return;
+    }
+    contentLength = strcasestr(linkBuffer, "Content-Length:");
+    if((contentLength != NULL) && (contentLength < headerEnd))
+    {
+        bodyLength = (uint32_t)strtoul(&contentLength[15], NULL, 10);
+    }
+    requestLength = (uint32_t)(headerEnd - linkBuffer) + 4u + bodyLength;
+    if(linkLength < requestLength)
+    {
+        return;
+    }
+
+    httpRequests++;
+    if((isServerStalled == true) && (strncmp(linkBuffer, "POST /oauth2/endpoint/iNet/token", 32) != 0))
+    {
+        // Request taken and never answered, no error reaches the modem
+        httpStalled++;
+        if(stallStartMs == 0u)
+        {
+            stallStartMs = NowMs();
+        }
+        Log("   loopback %.*s stalled", (int)(strchr(linkBuffer, '\r') - linkBuffer), linkBuffer);
+        sockets[linkSocket].bytesSent += requestLength;
+        memmove(linkBuffer, &linkBuffer[requestLength], linkLength - requestLength);
+        linkLength -= requestLength;
+        return;
+    }
+    if(strncmp(linkBuffer, "POST /oauth2/endpoint/iNet/token", 32) == 0)
+    {
+        status = 200;
+        snprintf(body, sizeof(body), "{\"access_token\":\"sim%08u\",\"token_type\":\"Bearer\",\"expires_in\":3600,\"scope\":\"\"}", httpRequests);
+    }
+    else if(strncmp(linkBuffer, "POST /iNetAPI/v1/live/create", 28) == 0)
+    {
+        status = 201;
+        snprintf(body, sizeof(body), "{\"id\":\"5be9a1c2e4b0%012u\"}", httpRequests);
+    }
+    else if((strncmp(linkBuffer, "POST /iNetAPI/v1/live/", 22) == 0) && (strstr(linkBuffer, "/register") < headerEnd))
+    {
+        status = 200;
+        snprintf(body, sizeof(body), "{}");
+    }
+    else
+    {
+        snprintf(body, sizeof(body), "{\"error\":\"not found\"}");
+    }
+    Log("   loopback %.*s -> %d", (int)(strchr(linkBuffer, '\r') - linkBuffer), linkBuffer, status);
+
+    length = snprintf(response, sizeof(response), "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\nContent-Length: %u\r\nConnection: close\r\n\r\n%s",
+                      status, (status == 404) ? "Not Found" : ((status == 201) ? "Created" : "OK"), (unsigned int)strlen(body), body);
+    ScheduleOutput(serverLatencyMs, response, (uint32_t)length, false, MODE_DIRECT_LINK);
+    sockets[linkSocket].isRemoteClosed = true;
+    sockets[linkSocket].bytesSent += requestLength;
+    sockets[linkSocket].bytesReceived += (uint32_t)length;
+
+    // Drop the consumed request and the '$' trigger character if present
+    if((requestLength < linkLength) && (linkBuffer[requestLength] == '$'))
+    {
+        requestLength++;
+    }
+    memmove(linkBuffer, &linkBuffer[requestLength], linkLength - requestLength);
+    linkLength -= requestLength;
+}
+
+//------------------------------------------------------------------------------
+//  static void ProcessLinkData(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function handle bytes received while in direct link mode
+//
+//------------------------------------------------------------------------------
+static void ProcessLinkData(void)
+{
+    int fd = sockets[linkSocket].fd;
+
+    if(fd >= 0)
+    {
+        // Forward everything except a pending escape sequence
+        if((linkLength >= 3u) && (memcmp(&linkBuffer[linkLength - 3u], "+++", 3) == 0))
+        {
+            if(linkLength > 3u)
+            {
+                (void)write(fd, linkBuffer, linkLength - 3u);
+                sockets[linkSocket].bytesSent += linkLength - 3u;
+                memmove(linkBuffer, &linkBuffer[linkLength - 3u], 3u);
+                linkLength = 3u;
+            }
+        }
+        else if(linkLength > 0u)
+        {
+            (void)write(fd, linkBuffer, linkLength);
+            sockets[linkSocket].bytesSent += linkLength;
+            linkLength = 0;
+        }
+    }
+    else
+    {
+        ProcessLoopbackRequest();
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void FlushPendingOutput(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write all due output to the UART
+//
+//------------------------------------------------------------------------------
+static void FlushPendingOutput(void)
+{
+    uint64_t now = NowMs();
+
+    while((numberOfPending > 0) && (pending[0].dueMs <= now))
+    {
+        if(write(ptyMaster, pending[0].data, pending[0].length) > 0)
+        {
+            uartTxBytes += pending[0].length;
+        }
+        Log("-> %.*s", (int)pending[0].length, pending[0].data);
+        if(pending[0].changeMode == true)
+        {
+            mode = pending[0].nextMode;
+        }
+        free(pending[0].data);
+        memmove(&pending[0], &pending[1], (numberOfPending - 1u) * sizeof(SimOutput_t));
+        numberOfPending--;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void FireUrcs(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function emit scenario URCs whose time has come
+//
+//------------------------------------------------------------------------------
+static void FireUrcs(void)
+{
+    char out[SIM_TEXT_SIZE + 8];
+    int length = 0;
+    uint32_t index = 0;
+    uint64_t elapsed = NowMs() - startMs;
+
+    for(index = 0; index < numberOfUrcs; index++)
+    {
+        if((urcs[index].isSent == false) && (elapsed >= urcs[index].atMs) && (mode == MODE_COMMAND))
+        {
+            urcs[index].isSent = true;
+            length = snprintf(out, sizeof(out), "\r\n%s\r\n", urcs[index].text);
+            ScheduleOutput(0, out, (uint32_t)length, false, MODE_COMMAND);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void FireSocketConnects(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function report asynchronous connects whose time has come with
+//!  +UUSOCO, socket error 0 when connected
+//
+//------------------------------------------------------------------------------
+static void FireSocketConnects(void)
+{
+    char out[64];
+    int length = 0;
+    uint32_t index = 0;
+
+    for(index = 0; index < SIM_MAX_SOCKETS; index++)
+    {
+        if((sockets[index].isConnectPending == true) && (NowMs() >= sockets[index].connectDueMs) && (mode == MODE_COMMAND) &&
+           (isConnectUrcOn == true))
+        {
+            sockets[index].isConnectPending = false;
+            sockets[index].isConnected = sockets[index].isConnectOk;
+            length = snprintf(out, sizeof(out), "\r\n+UUSOCO: %u,%d\r\n", index, (sockets[index].isConnectOk == true) ? 0 : 111);
+            ScheduleOutput(0, out, (uint32_t)length, false, MODE_COMMAND);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void FireNitz(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function deliver network time once registered, as +CTZV for
+//!  +CTZR=1 and +CTZE for +CTZR=2
+//
+//------------------------------------------------------------------------------
+static void FireNitz(void)
+{
+    char localTime[32];
+    char out[SIM_TEXT_SIZE];
+    int length = 0;
+
+    if((isNitzEnabled == true) && (isNitzReceived == false) && (isRadioOn == true) &&
+       (registeredRat >= 0) && ((NowMs() - radioOnMs) >= attachDelayMs) && (mode == MODE_COMMAND))
+    {
+        isNitzReceived = true;
+        FormatLocalTime(localTime, sizeof(localTime));
+        if(ctzrMode == 1)
+        {
+            length = snprintf(out, sizeof(out), "\r\n+CTZV: \"%+03d\",\"%s\"\r\n", (int)timeZoneQuarters, localTime);
+        }
+        else if(ctzrMode == 2)
+        {
+            length = snprintf(out, sizeof(out), "\r\n+CTZE: \"%+03d\",0,\"%s\"\r\n", (int)timeZoneQuarters, localTime);
+        }
+        if(length > 0)
+        {
+            Log("NITZ %s", localTime);
+            ScheduleOutput(0, out, (uint32_t)length, false, MODE_COMMAND);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void FormatLocalTime(char buffer[], size_t size)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write network local time as "yy/MM/dd,hh:mm:ss"
+//
+//------------------------------------------------------------------------------
+static void FormatLocalTime(char buffer[], size_t size)
+{
+    time_t now = time(NULL) + (timeZoneQuarters * 900);
+    struct tm *local = gmtime(&now);
+
+    snprintf(buffer, size, "%02d/%02d/%02d,%02d:%02d:%02d", local->tm_year % 100, local->tm_mon + 1, local->tm_mday,
+             local->tm_hour, local->tm_min, local->tm_sec);
+}
+
+//------------------------------------------------------------------------------
+//  static void PrintStatistics(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function print command counts, latencies and UART byte counts
+//
+//------------------------------------------------------------------------------
+static void PrintStatistics(void)
+{
+    uint32_t index = 0, held = 0;
+    uint64_t elapsed = NowMs() - startMs;
+
+    printf("\n%-12s %8s %8s %10s\n", "command", "count", "errors", "avg ms");
+    for(index = 0; index < numberOfRules; index++)
+    {
+        if(rules[index].count > 0)
+        {
+            printf("%-12s %8u %8u %10.1f\n", rules[index].name, rules[index].count, rules[index].errors,
+                   (double)rules[index].totalLatencyMs / rules[index].count);
+        }
+    }
+    printf("\nHTTP requests: %u\n", httpRequests);
+    printf("GNSS starts: %u, MGA-INI frames: %u\n", gnssStarts, gnssAidingFrames);
+    printf("Attaches LTE-M: %u, NB-IoT: %u, GPRS: %u\n", ratAttaches[0], ratAttaches[1], ratAttaches[2]);
+    printf("Manual selections: %u\n", manualSelections);
+    printf("Asynchronous connects: %u\n", asyncConnects);
+    for(index = 0; index < SIM_MAX_SOCKETS; index++)
+    {
+        held += (sockets[index].isUsed == true) ? 1u : 0u;
+    }
+    printf("Sockets held: %u of %u, +USOCR refused: %u\n", held, SIM_MAX_SOCKETS, socketsRefused);
+    printf("SMS sent: %u, rejected: %u\n", smsSent, smsRejected);
+    if(isServerStalled == true)
+    {
+        printf("Uploads stalled: %u, first SMS %llu ms into the stall\n", httpStalled, (unsigned long long)smsFirstStallMs);
+    }
+    printf("DNS lookups by +UDNSRN: %u, within +USOCO: %u (%u ms each)\n", dnsLookups, dnsConnectLookups, dnsLookupMs);
+    printf("TLS handshakes full: %u (%u ms, %u bytes each on the default list), resumed: %u (%u ms, %u bytes each), %llu bytes in total\n",
+           tlsHandshakes[SIM_TLS_FULL], tlsHandshakeMs[SIM_TLS_FULL], tlsHandshakeBytes[SIM_TLS_FULL],
+           tlsHandshakes[SIM_TLS_RESUMED], tlsHandshakeMs[SIM_TLS_RESUMED], tlsHandshakeBytes[SIM_TLS_RESUMED],
+           (unsigned long long)tlsBytes);
+    for(index = 0; index < numberOfTlsSuites; index++)
+    {
+        if((tlsSuites[index].handshakes + tlsSuites[index].rejects) > 0u)
+        {
+            printf("TLS suite %04X full handshakes: %u (%u ms, %u bytes each), rejected: %u\n", tlsSuites[index].ianaId,
+                   tlsSuites[index].handshakes, tlsSuites[index].handshakeMs, tlsSuites[index].handshakeBytes, tlsSuites[index].rejects);
+        }
+    }
+    printf("UART rx %llu bytes, tx %llu bytes in %.1f s (%.1f B/s)\n", (unsigned long long)uartRxBytes, (unsigned long long)uartTxBytes,
+           elapsed / 1000.0, (elapsed > 0) ? ((uartRxBytes + uartTxBytes) * 1000.0 / elapsed) : 0.0);
+}
+
+//------------------------------------------------------------------------------
+//  static void SignalHandler(int sig)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function request clean exit
+//
+//------------------------------------------------------------------------------
+static void SignalHandler(int sig)
+{
+    (void)sig;
+    isExitRequested = 1;
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+int main(int argc, char *argv[])
+{
+    const char *linkPath = NULL;
+    char *port = NULL;
+    struct pollfd fds[2];
+    uint8_t rx[SIM_LINE_SIZE];
+    char reply[SIM_TEXT_SIZE];
+    ssize_t received = 0;
+    ssize_t index = 0;
+    int option = 0, timeout = 0, nfds = 0;
+    unsigned int seed = 1u;
+    char ch = 0;
+
+    while((option = getopt(argc, argv, "l:s:f:r:v")) != -1)
+    {
+        switch(option)
+        {
+        case 'l':
+            linkPath = optarg;
+            break;
+        case 's':
+            LoadScenario(optarg);
+            break;
+        case 'f':
+            port = strrchr(optarg, ':');
+            if(port == NULL)
+            {
+                fprintf(stderr, "-f expects host:port\n");
+                return 1;
+            }
+            snprintf(forwardHost, sizeof(forwardHost), "%.*s", (int)(port - optarg), optarg);
+            snprintf(forwardPort, sizeof(forwardPort), "%s", &port[1]);
+            break;
+        case 'r':
+            seed = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        case 'v':
+            isVerbose = true;
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-l link] [-s scenario] [-f host:port] [-r seed] [-v]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    srand(seed);
+    signal(SIGINT, SignalHandler);
+    signal(SIGTERM, SignalHandler);
+    signal(SIGPIPE, SIG_IGN);
+    for(index = 0; index < (ssize_t)SIM_MAX_SOCKETS; index++)
+    {
+        sockets[index].fd = -1;
+    }
+
+    OpenPty(linkPath);
+    startMs = NowMs();
+    radioOnMs = startMs;
+    SelectRat();
+
+    while(isExitRequested == 0)
+    {
+        FireUrcs();
+        FireSocketConnects();
+        FireNitz();
+        FlushPendingOutput();
+
+        // Escape sequence needs a quiet guard time after "+++"
+        if((mode == MODE_DIRECT_LINK) && (linkLength >= 3u) &&
+           (memcmp(&linkBuffer[linkLength - 3u], "+++", 3) == 0) && ((NowMs() - lastLinkByteMs) >= SIM_ESCAPE_GUARD_MS))
+        {
+            linkLength = 0;
+            GetRule("+++")->count++;
+            ScheduleOutput(0, "\r\nDISCONNECT\r\n\r\nOK\r\n", 20, true, MODE_COMMAND);
+            mode = MODE_COMMAND;
+
+            // Socket closed by server is released like the modem does with USOCLCFG=1
+            if(sockets[linkSocket].isRemoteClosed == true)
+            {
+                snprintf(reply, sizeof(reply), "\r\n+UUSOCL: %d\r\n", linkSocket);
+                ScheduleOutput(0, reply, (uint32_t)strlen(reply), false, MODE_COMMAND);
+                if(sockets[linkSocket].fd >= 0)
+                {
+                    close(sockets[linkSocket].fd);
+                }
+                memset(&sockets[linkSocket], 0, sizeof(SimSocket_t));
+                sockets[linkSocket].fd = -1;
+            }
+        }
+
+        timeout = 20;
+        if(numberOfPending > 0)
+        {
+            timeout = (int)((pending[0].dueMs > NowMs()) ? (pending[0].dueMs - NowMs()) : 0);
+        }
+
+        nfds = 1;
+        fds[0].fd = ptyMaster;
+        fds[0].events = POLLIN;
+        if((mode == MODE_DIRECT_LINK) && (linkSocket >= 0) && (sockets[linkSocket].fd >= 0))
+        {
+            fds[1].fd = sockets[linkSocket].fd;
+            fds[1].events = POLLIN;
+            nfds = 2;
+        }
+        if(poll(fds, (nfds_t)nfds, timeout) <= 0)
+        {
+            continue;
+        }
+
+        if((nfds == 2) && ((fds[1].revents & (POLLIN | POLLHUP)) != 0))
+        {
+            received = read(fds[1].fd, rx, sizeof(rx));
+            if(received > 0)
+            {
+                ScheduleOutput(0, (char *)rx, (uint32_t)received, false, MODE_DIRECT_LINK);
+                sockets[linkSocket].bytesReceived += (uint32_t)received;
+            }
+            else
+            {
+                close(sockets[linkSocket].fd);
+                sockets[linkSocket].fd = -1;
+                sockets[linkSocket].isRemoteClosed = true;
+            }
+        }
+
+        if((fds[0].revents & POLLIN) != 0)
+        {
+            received = read(ptyMaster, rx, sizeof(rx));
+            if(received <= 0)
+            {
+                continue;
+            }
+            uartRxBytes += (uint64_t)received;
+
+            for(index = 0; index < received; index++)
+            {
+                ch = (char)rx[index];
+                if(mode == MODE_CERT_INPUT)
+                {
+                    if(--certRemaining == 0u)
+                    {
+                        snprintf(reply, sizeof(reply), "\r\n+USECMNG: 0,0,\"iNetCert.der\",\"2c8e07a1b6c0ee6f4dd5bb9b1a2e3e34\"\r\n\r\nOK\r\n");
+                        ScheduleOutput(GetRule("+USECMNG")->latencyMs, reply, (uint32_t)strlen(reply), true, MODE_COMMAND);
+                        mode = MODE_COMMAND;
+                    }
+                }
+                else if(mode == MODE_SMS_INPUT)
+                {
+                    // Ctrl-Z sends, ESC cancels
+                    if(ch == 0x1A)
+                    {
+                        mode = MODE_COMMAND;
+                        ProcessSmsSubmit();
+                    }
+                    else if(ch == 0x1B)
+                    {
+                        mode = MODE_COMMAND;
+                        ScheduleOutput(0, "\r\nOK\r\n", 6, false, MODE_COMMAND);
+                    }
+                    else if((isxdigit((unsigned char)ch) != 0) && (smsPduLength < (sizeof(smsPdu) - 1u)))
+                    {
+                        smsPdu[smsPduLength++] = ch;
+                        smsPdu[smsPduLength] = 0;
+                    }
+                }
+                else if(mode == MODE_DIRECT_LINK)
+                {
+                    if(linkLength < (SIM_LINK_BUFFER_SIZE - 1u))
+                    {
+                        linkBuffer[linkLength++] = ch;
+                    }
+                    lastLinkByteMs = NowMs();
+                }
+                else if(ch == '\r')
+                {
+                    lineBuffer[lineLength] = 0;
+                    if(isEchoOn == true)
+                    {
+                        lineBuffer[lineLength] = '\r';
+                        ScheduleOutput(0, lineBuffer, lineLength + 1u, false, MODE_COMMAND);
+                        lineBuffer[lineLength] = 0;
+                    }
+                    if(lineLength > 0)
+                    {
+                        ProcessCommand(lineBuffer);
+                    }
+                    lineLength = 0;
+                }
+                else if((ch != '\n') && (lineLength < (SIM_LINE_SIZE - 1u)))
+                {
+                    lineBuffer[lineLength++] = ch;
+                }
+            }
+            if(mode == MODE_DIRECT_LINK)
+            {
+                ProcessLinkData();
+            }
+        }
+    }
+
+    PrintStatistics();
+    if(linkPath != NULL)
+    {
+        unlink(linkPath);
+    }
+    return 0;
+}
@@ -0,0 +1,377 @@
+//==============================================================================
+//
+//  NMEABench.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        NMEABench.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! Host benchmark of the firmware NMEA parser (System/src/NMEAParser.c) on
+//! recorded sentences. Every GGA/RMC fix is checked against a double precision
+//! reference and the parser is timed against the previous TokenizeString and
+//! atof based GGA handling.
+//!
+//! Build:  gcc -O2 -Wall -I../../Src/System/inc -o NMEABench NMEABench.c ../../Src/System/src/NMEAParser.c
+//! Run:    ./NMEABench [-n iterations] [recorded.nmea]
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "NMEAParser.h"
+
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+#define MAX_INPUT_SIZE          (256u * 1024u)
+#define MAX_SENTENCE_LENGTH     83u
+#define DEFAULT_ITERATIONS      20000u
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static uint8_t input[MAX_INPUT_SIZE];
+static uint32_t inputSize = 0;
+
+static volatile float legacySink = 0.0f;
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static uint64_t NowNs(void);
+static int32_t ReferenceMicroDegrees(char const *field, char hemisphere);
+static uint32_t CheckAccuracy(uint32_t *checkedFixes, uint32_t *checksumErrors);
+static uint8_t LegacyTokenizeString(uint8_t *srcString, uint8_t dstToken[][25], uint8_t c_Delimiter, uint8_t messageLength);
+static void LegacyParseGGA(uint8_t GPSData[], uint32_t Length);
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static uint64_t NowNs(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns monotonic time in nanoseconds
+//
+//------------------------------------------------------------------------------
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+//  static int32_t ReferenceMicroDegrees(char const *field, char hemisphere)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function convert (d)ddmm.mmmm with doubles, used as reference only
+//
+//------------------------------------------------------------------------------
+static int32_t ReferenceMicroDegrees(char const *field, char hemisphere)
+{
+    double value = strtod(field, NULL);
+    double degrees = (double)(int32_t)(value / 100.0);
+    double result = (degrees + ((value - (degrees * 100.0)) / 60.0)) * 1000000.0;
+    int32_t ret = (int32_t)(result + 0.5);
+
+    if((hemisphere == 'S') || (hemisphere == 'W'))
+    {
+        ret = -ret;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static uint32_t CheckAccuracy(uint32_t *checkedFixes, uint32_t *checksumErrors)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function parse the input once and compare every fix with the double
+//!  reference, returns the worst error in micro-degrees
+//
+//------------------------------------------------------------------------------
+static uint32_t CheckAccuracy(uint32_t *checkedFixes, uint32_t *checksumErrors)
+{
+    NMEAParser_t parser;
+    char sentence[MAX_SENTENCE_LENGTH + 16u];
+    char *fields[24];
+    uint32_t i = 0, length = 0, fieldCount = 0, worst = 0, error = 0, f = 0;
+    int32_t result = 0, expected = 0;
+    char *p = NULL;
+
+    NMEAParserInit(&parser);
+    for(i = 0; i < inputSize; i++)
+    {
+        if((input[i] == '$') || (length >= (sizeof(sentence) - 1u)))
+        {
+            length = 0;
+        }
+        sentence[length++] = (char)input[i];
+
+        result = NMEAParserFeed(&parser, input[i]);
+        if(result == ERR_NMEA_CHECKSUM_MISMATCH)
+        {
+            (*checksumErrors)++;
+        }
+        else if((result == NMEA_SENTENCE_GGA) || (result == NMEA_SENTENCE_RMC))
+        {
+            sentence[length] = '\0';
+            fieldCount = 0;
+            for(p = sentence; (p != NULL) && (fieldCount < 24u); )
+            {
+                fields[fieldCount++] = p;
+                p = strchr(p, ',');
+                if(p != NULL)
+                {
+                    *p++ = '\0';
+                }
+            }
+
+            // GGA lat is field 2, RMC lat is field 3
+            f = (result == NMEA_SENTENCE_GGA) ? 2u : 3u;
+            if((fieldCount > (f + 3u)) && (fields[f][0] != '\0'))
+            {
+                expected = ReferenceMicroDegrees(fields[f], fields[f + 1u][0]);
+                error = (uint32_t)abs(expected - parser.fix.latitude);
+                worst = (error > worst) ? error : worst;
+
+                expected = ReferenceMicroDegrees(fields[f + 2u], fields[f + 3u][0]);
+                error = (uint32_t)abs(expected - parser.fix.longitude);
+                worst = (error > worst) ? error : worst;
+                (*checkedFixes)++;
+            }
+        }
+    }
+
+    printf("last fix        : lat %ld lon %ld udeg, hdop %u.%02u, quality %u, sats %u/%u, alt %ld dm, %06lu %06lu\n",
+           (long)parser.fix.latitude, (long)parser.fix.longitude, parser.fix.hdop / 100u, parser.fix.hdop % 100u,
+           parser.fix.fixQuality, parser.fix.satellitesUsed, parser.fix.satellitesInView, (long)parser.fix.altitude,
+           (unsigned long)parser.fix.utcDate, (unsigned long)parser.fix.utcTime);
+
+    return worst;
+}
+
+//------------------------------------------------------------------------------
+//  static uint8_t LegacyTokenizeString(uint8_t *srcString, uint8_t dstToken[][25], uint8_t c_Delimiter, uint8_t messageLength)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function is the tokenizer previously used by CellularATCommands.c
+//
+//------------------------------------------------------------------------------
+static uint8_t LegacyTokenizeString(uint8_t *srcString, uint8_t dstToken[][25], uint8_t c_Delimiter, uint8_t messageLength)
+{
+    int j = 0;
+    unsigned int i_Offset = 0;
+    char b_Flag = 0;
+    int count = 0;
+
+    for(i_Offset = 0; i_Offset <= messageLength; i_Offset++)
+    {
+        if(((count + 1) >= 16) || ((j + 1) >= 25))
+        {
+            break;
+        }
+
+        if((srcString[i_Offset] != c_Delimiter) && (srcString[i_Offset] != '\t') && (srcString[i_Offset] != '\n') && (srcString[i_Offset] != '\0'))
+        {
+            dstToken[count][j] = srcString[i_Offset];
+            j++;
+            b_Flag = 1;
+            continue;
+        }
+        if(b_Flag)
+        {
+            dstToken[count][j] = '\0';
+            count++;
+            j = 0;
+            b_Flag = 0;
+        }
+    }
+
+    return (uint8_t)(count + 1);
+}
+
+//------------------------------------------------------------------------------
+//  static void LegacyParseGGA(uint8_t GPSData[], uint32_t Length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function repeats the previous scratch buffer, atof and float degree
+//!  conversion work done per GGA sentence
+//
+//------------------------------------------------------------------------------
+static void LegacyParseGGA(uint8_t GPSData[], uint32_t Length)
+{
+    uint8_t sToken[16][25];
+    float latitude = 0.0f, longitude = 0.0f, hdop = 0.0f, localF = 0.0f, localL = 0.0f;
+    int localLatitude = 0, localLongitude = 0;
+
+    memset(sToken, 0, sizeof(sToken));
+    LegacyTokenizeString(GPSData, sToken, ',', (uint8_t)Length);
+
+    latitude = (float)atof((char *)sToken[2u]);
+    longitude = (float)atof((char *)sToken[4u]);
+    hdop = (float)atof((char *)sToken[8u]);
+
+    localF = latitude / 100.0f;
+    localL = longitude / 100.0f;
+    localLatitude = (int)localF;
+    localLongitude = (int)localL;
+    latitude = (float)localLatitude + (100.0f * ((localF - (float)localLatitude) / 60.0f));
+    longitude = (float)localLongitude + (100.0f * ((localL - (float)localLongitude) / 60.0f));
+
+    legacySink += latitude + longitude + hdop;
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  int main(int argc, char *argv[])
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  Benchmark entry point
+//
+//------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    int ret = 0;
+    int opt = 0;
+    uint32_t iterations = DEFAULT_ITERATIONS, n = 0, i = 0, start = 0;
+    uint32_t sentences = 0, ggaSentences = 0, checkedFixes = 0, checksumErrors = 0, worst = 0;
+    uint64_t t0 = 0, parserNs = 0, legacyNs = 0;
+    char const *path = "recorded.nmea";
+    NMEAParser_t parser;
+    FILE *file = NULL;
+
+    while((opt = getopt(argc, argv, "n:")) != -1)
+    {
+        switch(opt)
+        {
+        case 'n':
+            iterations = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+        default:
+            fprintf(stderr, "usage: %s [-n iterations] [recorded.nmea]\n", argv[0]);
+            return 1;
+        }
+    }
+    if(optind < argc)
+    {
+        path = argv[optind];
+    }
+
+    file = fopen(path, "rb");
+    if(file == NULL)
+    {
+        perror(path);
+        return 1;
+    }
+    inputSize = (uint32_t)fread(input, 1, sizeof(input), file);
+    fclose(file);
+
+    for(i = 0; i < inputSize; i++)
+    {
+        if(input[i] == '$')
+        {
+            sentences++;
+            if((i + 6u < inputSize) && (memcmp(&input[i + 3u], "GGA", 3) == 0))
+            {
+                ggaSentences++;
+            }
+        }
+    }
+
+    worst = CheckAccuracy(&checkedFixes, &checksumErrors);
+
+    NMEAParserInit(&parser);
+    t0 = NowNs();
+    for(n = 0; n < iterations; n++)
+    {
+        NMEAParserFeedBuffer(&parser, input, inputSize);
+    }
+    parserNs = NowNs() - t0;
+
+    t0 = NowNs();
+    for(n = 0; n < iterations; n++)
+    {
+        for(i = 0; i < inputSize; i++)
+        {
+            if(input[i] == '$')
+            {
+                start = i;
+            }
+            else if((input[i] == '\n') && (memcmp(&input[start + 3u], "GGA", 3) == 0))
+            {
+                LegacyParseGGA(&input[start], (i - start));
+            }
+        }
+    }
+    legacyNs = NowNs() - t0;
+
+    printf("input           : %s, %u bytes, %u sentences (%u GGA)\n", path, inputSize, sentences, ggaSentences);
+    printf("fixes checked   : %u, worst error %u udeg, checksum errors %u\n", checkedFixes, worst, checksumErrors);
+    printf("streaming parser: %.1f ns/sentence (all sentences), %.2f ns/byte\n",
+           (double)parserNs / ((double)iterations * sentences), (double)parserNs / ((double)iterations * inputSize));
+    printf("legacy GGA path : %.1f ns/GGA sentence, 400 byte scratch buffer\n",
+           (double)legacyNs / ((double)iterations * ggaSentences));
+    printf("parser state    : %zu bytes\n", sizeof(NMEAParser_t));
+
+    if(worst > 1u)
+    {
+        ret = 1;
+    }
+
+    return ret;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
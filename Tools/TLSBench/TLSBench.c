@@ -0,0 +1,452 @@
+//==============================================================================
+//
+//  TLSBench.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        TLSBench.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! TLS handshake benchmark against Tools/iNetStandIn. Every cipher suite the
+//! firmware may put in the security profile (+USECPRF op code 2) is tried
+//! with TLS 1.2, as the module runs it: full handshakes, then handshakes
+//! resuming the session of the first. Bytes of each direction, flights and
+//! time are recorded per suite, TCP connect included as in +USOCO.
+//!
+//! Typical setup, the RSA key stands for the GoDaddy chain of iNet:
+//!   ./iNetStandIn -c cert.pem -k key.pem -C eccert.pem -K eckey.pem
+//!   ./TLSBench -n 50 -A cert.pem
+//!
+//! Build:  gcc -O2 -Wall -o TLSBench TLSBench.c -lssl -lcrypto
+//! Run:    ./TLSBench [-h host] [-p port] [-n handshakes] [-s suites] [-A root.pem]
+//!                    [-R rtt ms] [-b bit/s] [-v]
+//!
+//!   -h  stand-in address, default 127.0.0.1, -p port, default 8443
+//!   -n  full and resumed handshakes per suite, default 20
+//!   -s  comma separated OpenSSL suite lists, default the CellularTLS
+//!       preference list, "DEFAULT" standing for the module default list
+//!   -A  verify the server chain against this root, as the module does with
+//!       iNetCert.der (validation level 1)
+//!   -R  round trip time and -b link rate of the estimated air time, default
+//!       200 ms and 100000 bit/s, an LTE-M link at the cell edge
+//!   -v  print every handshake
+//!
+//! The air time adds one round trip for the TCP connect and one per pair of
+//! flights to the transfer time of the bytes and the local handshake time.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+#define MAX_SUITES              8u
+#define SUITE_NAME_SIZE         128u
+#define DEFAULT_SUITES          "ECDHE-ECDSA-AES128-GCM-SHA256,ECDHE-RSA-AES128-GCM-SHA256,DEFAULT"
+
+typedef enum
+{
+    HANDSHAKE_FULL = 0,
+    HANDSHAKE_RESUMED,
+    HANDSHAKE_LAST,
+}HANDSHAKE_t;
+
+//! Bytes and flights seen on the socket of one handshake
+typedef struct
+{
+    uint64_t bytesOut;
+    uint64_t bytesIn;
+    uint32_t flights;
+    int      lastDirection;
+}Counter_t;
+
+typedef struct
+{
+    uint32_t handshakes;
+    uint32_t failures;
+    uint64_t bytesOut;
+    uint64_t bytesIn;
+    uint32_t flights;
+    double   totalMs;
+    double   maxMs;
+}HandshakeStats_t;
+
+typedef struct
+{
+    char name[SUITE_NAME_SIZE];
+    char negotiated[SUITE_NAME_SIZE];
+    HandshakeStats_t stats[HANDSHAKE_LAST];
+}SuiteStats_t;
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static const char *handshakeNames[HANDSHAKE_LAST] = {"full", "resumed"};
+
+static bool isVerbose = false;
+static struct sockaddr_in serverAddress;
+static double rttMs = 200.0;
+static double linkBitRate = 100000.0;
+static SuiteStats_t suites[MAX_SUITES];
+static uint32_t numberOfSuites = 0;
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static double NowMs(void);
+static long CountBytes(BIO *bio, int oper, const char *argp, size_t len, int argi, long argl, int ret, size_t *processed);
+static int  ConnectTcp(void);
+static bool RunHandshake(SSL_CTX *context, SSL_SESSION **session, SuiteStats_t *suite, HANDSHAKE_t kind);
+static void PrintStatistics(void);
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static double NowMs(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns monotonic time in milliseconds
+//
+//------------------------------------------------------------------------------
+static double NowMs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000.0) + (ts.tv_nsec / 1000000.0);
+}
+
+//------------------------------------------------------------------------------
+//  static long CountBytes(BIO *bio, int oper, const char *argp, size_t len,
+//                         int argi, long argl, int ret, size_t *processed)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function count the bytes moved by the socket BIO, a change of
+//!  direction starts a new flight
+//
+//------------------------------------------------------------------------------
+static long CountBytes(BIO *bio, int oper, const char *argp, size_t len, int argi, long argl, int ret, size_t *processed)
+{
+    Counter_t *counter = (Counter_t *)BIO_get_callback_arg(bio);
+    int direction = 0;
+
+    (void)argp;
+    (void)len;
+    (void)argi;
+    (void)argl;
+    if((ret > 0) && (processed != NULL) && (*processed > 0u))
+    {
+        if(oper == (BIO_CB_WRITE | BIO_CB_RETURN))
+        {
+            direction = 1;
+            counter->bytesOut += *processed;
+        }
+        else if(oper == (BIO_CB_READ | BIO_CB_RETURN))
+        {
+            direction = 2;
+            counter->bytesIn += *processed;
+        }
+        if((direction != 0) && (direction != counter->lastDirection))
+        {
+            counter->flights++;
+            counter->lastDirection = direction;
+        }
+    }
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//  static int ConnectTcp(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function open a TCP connection to the stand-in, -1 on failure
+//
+//------------------------------------------------------------------------------
+static int ConnectTcp(void)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int enable = 1;
+
+    // Flights leave as written, as the module sends them
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    if((fd >= 0) && (connect(fd, (struct sockaddr *)&serverAddress, sizeof(serverAddress)) != 0))
+    {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+//------------------------------------------------------------------------------
+//  static bool RunHandshake(SSL_CTX *context, SSL_SESSION **session,
+//                           SuiteStats_t *suite, HANDSHAKE_t kind)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function connect, handshake and close once. A resumed handshake
+//!  offers *session, a full one stores its session there when none is held.
+//!  Returns true when the handshake completed as the kind asked.
+//
+//------------------------------------------------------------------------------
+static bool RunHandshake(SSL_CTX *context, SSL_SESSION **session, SuiteStats_t *suite, HANDSHAKE_t kind)
+{
+    Counter_t counter;
+    HandshakeStats_t *stats = &suite->stats[kind];
+    SSL *ssl = NULL;
+    BIO *bio = NULL;
+    double startMs = NowMs(), elapsedMs = 0;
+    bool isDone = false;
+    int fd = ConnectTcp();
+
+    memset(&counter, 0, sizeof(counter));
+    if(fd >= 0)
+    {
+        ssl = SSL_new(context);
+        bio = BIO_new_socket(fd, BIO_NOCLOSE);
+        BIO_set_callback_ex(bio, CountBytes);
+        BIO_set_callback_arg(bio, (char *)&counter);
+        SSL_set_bio(ssl, bio, bio);
+        if((kind == HANDSHAKE_RESUMED) && (*session != NULL))
+        {
+            SSL_set_session(ssl, *session);
+        }
+        isDone = (SSL_connect(ssl) == 1) && ((kind == HANDSHAKE_FULL) || (SSL_session_reused(ssl) == 1));
+    }
+    elapsedMs = NowMs() - startMs;
+
+    stats->handshakes++;
+    stats->bytesOut += counter.bytesOut;
+    stats->bytesIn += counter.bytesIn;
+    stats->flights += counter.flights;
+    if(isDone == true)
+    {
+        stats->totalMs += elapsedMs;
+        stats->maxMs = (elapsedMs > stats->maxMs) ? elapsedMs : stats->maxMs;
+        snprintf(suite->negotiated, sizeof(suite->negotiated), "%s", SSL_get_cipher_name(ssl));
+        if((kind == HANDSHAKE_FULL) && (*session == NULL))
+        {
+            *session = SSL_get1_session(ssl);
+        }
+    }
+    else
+    {
+        stats->failures++;
+        ERR_clear_error();
+    }
+    if(isVerbose == true)
+    {
+        printf("%-32s %-7s %s %7.2f ms, out %llu bytes, in %llu bytes, %u flights\n", suite->name, handshakeNames[kind],
+               (isDone == true) ? "ok  " : "fail", elapsedMs, (unsigned long long)counter.bytesOut,
+               (unsigned long long)counter.bytesIn, counter.flights);
+    }
+
+    if(ssl != NULL)
+    {
+        // close_notify is not part of the handshake cost
+        BIO_set_callback_ex(bio, NULL);
+        if(isDone == true)
+        {
+            (void)SSL_shutdown(ssl);
+        }
+        SSL_free(ssl);
+    }
+    if(fd >= 0)
+    {
+        close(fd);
+    }
+    return isDone;
+}
+
+//------------------------------------------------------------------------------
+//  static void PrintStatistics(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function print per suite and handshake kind averages and the
+//!  estimated air time
+//
+//------------------------------------------------------------------------------
+static void PrintStatistics(void)
+{
+    uint32_t index = 0, kind = 0, done = 0;
+    double bytesOut = 0, bytesIn = 0, flights = 0, airMs = 0;
+    HandshakeStats_t const *stats = NULL;
+
+    printf("\n%-32s %-7s %-30s %5s %5s %8s %8s %9s %8s %7s %8s\n", "suite", "kind", "negotiated", "ok", "fail",
+           "avg ms", "max ms", "bytes out", "bytes in", "flights", "air ms");
+    for(index = 0; index < numberOfSuites; index++)
+    {
+        for(kind = 0; kind < HANDSHAKE_LAST; kind++)
+        {
+            stats = &suites[index].stats[kind];
+            if(stats->handshakes == 0u)
+            {
+                continue;
+            }
+            done = stats->handshakes - stats->failures;
+            bytesOut = (double)stats->bytesOut / stats->handshakes;
+            bytesIn = (double)stats->bytesIn / stats->handshakes;
+            flights = (double)stats->flights / stats->handshakes;
+            airMs = ((1.0 + (double)((uint32_t)flights / 2u)) * rttMs) + (((bytesOut + bytesIn) * 8000.0) / linkBitRate) +
+                    ((done > 0u) ? (stats->totalMs / done) : 0.0);
+            printf("%-32s %-7s %-30s %5u %5u %8.2f %8.2f %9.0f %8.0f %7.1f %8.0f\n", suites[index].name, handshakeNames[kind],
+                   (done > 0u) ? suites[index].negotiated : "-", done, stats->failures,
+                   (done > 0u) ? (stats->totalMs / done) : 0.0, stats->maxMs, bytesOut, bytesIn, flights, airMs);
+        }
+    }
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+int main(int argc, char *argv[])
+{
+    const char *host = "127.0.0.1", *rootPath = NULL;
+    char suiteList[MAX_SUITES * SUITE_NAME_SIZE] = DEFAULT_SUITES;
+    char *name = NULL, *next = NULL;
+    int option = 0;
+    uint16_t port = 8443u;
+    uint32_t handshakes = 20u, index = 0, count = 0;
+    SSL_CTX *context = NULL;
+    SSL_SESSION *session = NULL;
+
+    while((option = getopt(argc, argv, "h:p:n:s:A:R:b:v")) != -1)
+    {
+        switch(option)
+        {
+        case 'h':
+            host = optarg;
+            break;
+        case 'p':
+            port = (uint16_t)atoi(optarg);
+            break;
+        case 'n':
+            handshakes = (uint32_t)atoi(optarg);
+            break;
+        case 's':
+            snprintf(suiteList, sizeof(suiteList), "%s", optarg);
+            break;
+        case 'A':
+            rootPath = optarg;
+            break;
+        case 'R':
+            rttMs = atof(optarg);
+            break;
+        case 'b':
+            linkBitRate = atof(optarg);
+            break;
+        case 'v':
+            isVerbose = true;
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-h host] [-p port] [-n handshakes] [-s suites] [-A root.pem] [-R rtt ms] [-b bit/s] [-v]\n", argv[0]);
+            return 1;
+        }
+    }
+    memset(&serverAddress, 0, sizeof(serverAddress));
+    serverAddress.sin_family = AF_INET;
+    serverAddress.sin_port = htons(port);
+    if((inet_pton(AF_INET, host, &serverAddress.sin_addr) != 1) || (linkBitRate <= 0))
+    {
+        fprintf(stderr, "host must be an IPv4 address and the link rate above 0\n");
+        return 1;
+    }
+
+    for(name = strtok_r(suiteList, ",", &next); (name != NULL) && (numberOfSuites < MAX_SUITES); name = strtok_r(NULL, ",", &next))
+    {
+        snprintf(suites[numberOfSuites++].name, SUITE_NAME_SIZE, "%s", name);
+    }
+
+    for(index = 0; index < numberOfSuites; index++)
+    {
+        // The module speaks TLS 1.2 at most
+        context = SSL_CTX_new(TLS_client_method());
+        if((context == NULL) || (SSL_CTX_set_min_proto_version(context, TLS1_2_VERSION) != 1) ||
+           (SSL_CTX_set_max_proto_version(context, TLS1_2_VERSION) != 1) ||
+           (SSL_CTX_set_cipher_list(context, suites[index].name) != 1))
+        {
+            fprintf(stderr, "suite %s not usable\n", suites[index].name);
+            ERR_print_errors_fp(stderr);
+            return 1;
+        }
+        if(rootPath != NULL)
+        {
+            if(SSL_CTX_load_verify_locations(context, rootPath, NULL) != 1)
+            {
+                ERR_print_errors_fp(stderr);
+                return 1;
+            }
+            SSL_CTX_set_verify(context, SSL_VERIFY_PEER, NULL);
+        }
+
+        session = NULL;
+        for(count = 0; count < handshakes; count++)
+        {
+            (void)RunHandshake(context, &session, &suites[index], HANDSHAKE_FULL);
+        }
+        // Nothing to resume when the server refused the suite
+        for(count = 0; (count < handshakes) && (session != NULL); count++)
+        {
+            (void)RunHandshake(context, &session, &suites[index], HANDSHAKE_RESUMED);
+        }
+        if(session != NULL)
+        {
+            SSL_SESSION_free(session);
+        }
+        SSL_CTX_free(context);
+    }
+
+    PrintStatistics();
+    return 0;
+}
+
+//==============================================================================
+//  End Of File
+//==============================================================================
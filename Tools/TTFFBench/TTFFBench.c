@@ -0,0 +1,652 @@
+//==============================================================================
+//
+//  TTFFBench.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        TTFFBench.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! GNSS time to first fix benchmark. The receiver supply is cycled with the
+//! same AT sequence as GPSConfigure (UGPIOC, UI2CO, CFG-PRT over UI2CW) and
+//! NAV-PVT is polled over the I2C passthrough until a 3D fix. Aided starts
+//! inject UBX-MGA-INI TIME_UTC and POS_LLH of the previous fix like
+//! GNSSAiding.c does, cold starts inject nothing.
+//!
+//! Typical setup:
+//!   ./ModemSim -l /tmp/ttyCell -s ttff.sim
+//!   ./TTFFBench -t /tmp/ttyCell -n 20 -m both
+//!
+//! Build:  gcc -O2 -Wall -o TTFFBench TTFFBench.c
+//! Run:    ./TTFFBench -t tty [-n starts] [-m cold|aided|both] [-o off ms] [-p poll ms] [-T timeout ms] [-v]
+//!
+//! Reports TTFF percentiles and a 5 s histogram per start type. Both modes
+//! alternate so they see the same sky (or the same simulator scenario).
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <strings.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <time.h>
+#include <termios.h>
+
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+#define RX_BUFFER_SIZE          4096u
+#define UBX_BUFFER_SIZE         128u
+
+#define AT_TIMEOUT_MS           5000u
+#define HISTOGRAM_BINS          13u
+#define BIN_WIDTH_MS            5000u
+#define DRIFT_MM_PER_SECOND     2000u
+
+#define UBX_NAV_PVT_PAYLOAD     92u
+
+typedef enum
+{
+    START_COLD = 0,
+    START_AIDED,
+
+    START_TYPES,
+}START_TYPE_t;
+
+typedef struct
+{
+    int32_t  latitude;          //!< 1e-7 degrees
+    int32_t  longitude;
+    int32_t  heightMSL;         //!< mm
+    uint32_t hAcc;              //!< mm
+    double   fixMs;
+    bool     isValid;
+}LastFix_t;
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static int tty = -1;
+static bool isVerbose = false;
+static char rxBuffer[RX_BUFFER_SIZE];
+static uint32_t rxLength = 0;
+static LastFix_t lastFix;
+
+static const char *startNames[START_TYPES] = {"cold", "aided"};
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static double NowMs(void);
+static void OpenTty(const char *path);
+static bool WaitFor(const char *expected, uint32_t timeoutMs);
+static bool Command(const char *cmd, const char *expected);
+static bool WriteUbx(uint8_t msgClass, uint8_t msgId, const uint8_t payload[], uint16_t length);
+static bool PollNavPvt(uint8_t payload[]);
+static void PutLittleEndian(uint8_t data[], uint32_t value, uint8_t size);
+static uint32_t GetLittleEndian(const uint8_t data[], uint8_t size);
+static double MeasureStart(START_TYPE_t startType, uint32_t offMs, uint32_t pollMs, uint32_t timeoutMs);
+static int  CompareDouble(const void *a, const void *b);
+static double Percentile(double sorted[], uint32_t count, double percent);
+static void PrintReport(START_TYPE_t startType, double samples[], uint32_t count, uint32_t timeouts);
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static double NowMs(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns monotonic time in milliseconds
+//
+//------------------------------------------------------------------------------
+static double NowMs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000.0) + (ts.tv_nsec / 1000000.0);
+}
+
+//------------------------------------------------------------------------------
+//  static void OpenTty(const char *path)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function open the modem tty in raw mode
+//
+//------------------------------------------------------------------------------
+static void OpenTty(const char *path)
+{
+    struct termios tio;
+
+    tty = open(path, O_RDWR | O_NOCTTY);
+    if(tty < 0)
+    {
+        perror(path);
+        exit(1);
+    }
+    tcgetattr(tty, &tio);
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, B115200);
+    cfsetospeed(&tio, B115200);
+    tcsetattr(tty, TCSANOW, &tio);
+}
+
+//------------------------------------------------------------------------------
+//  static bool WaitFor(const char *expected, uint32_t timeoutMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read until expected text or an error shows up
+//
+//------------------------------------------------------------------------------
+static bool WaitFor(const char *expected, uint32_t timeoutMs)
+{
+    struct pollfd fd = {tty, POLLIN, 0};
+    double deadline = NowMs() + timeoutMs;
+    ssize_t received = 0;
+
+    while(NowMs() < deadline)
+    {
+        if(strstr(rxBuffer, expected) != NULL)
+        {
+            return true;
+        }
+        if((strstr(rxBuffer, "ERROR") != NULL))
+        {
+            break;
+        }
+        if(poll(&fd, 1, (int)(deadline - NowMs())) > 0)
+        {
+            received = read(tty, &rxBuffer[rxLength], RX_BUFFER_SIZE - 1u - rxLength);
+            if(received > 0)
+            {
+                rxLength += (uint32_t)received;
+                rxBuffer[rxLength] = 0;
+            }
+        }
+    }
+    if(isVerbose == true)
+    {
+        printf("RX failed waiting for %s: %s\n", expected, rxBuffer);
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+//  static bool Command(const char *cmd, const char *expected)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function send AT command and wait for the expected response
+//
+//------------------------------------------------------------------------------
+static bool Command(const char *cmd, const char *expected)
+{
+    char line[512];
+    int length = snprintf(line, sizeof(line), "%s\r\n", cmd);
+
+    rxLength = 0;
+    rxBuffer[0] = 0;
+    if(write(tty, line, (size_t)length) != (ssize_t)length)
+    {
+        return false;
+    }
+    if(isVerbose == true)
+    {
+        printf("TX %.*s\n", (length > 60) ? 60 : (length - 2), line);
+    }
+    return WaitFor(expected, AT_TIMEOUT_MS);
+}
+
+//------------------------------------------------------------------------------
+//  static bool WriteUbx(uint8_t msgClass, uint8_t msgId, const uint8_t payload[], uint16_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function send a UBX frame with AT+UI2CW
+//
+//------------------------------------------------------------------------------
+static bool WriteUbx(uint8_t msgClass, uint8_t msgId, const uint8_t payload[], uint16_t length)
+{
+    uint8_t frame[UBX_BUFFER_SIZE];
+    char cmd[512];
+    uint8_t checksumA = 0, checksumB = 0;
+    uint32_t index = 0, frameSize = length + 8u;
+    int size = 0;
+
+    frame[0] = 0xB5;
+    frame[1] = 0x62;
+    frame[2] = msgClass;
+    frame[3] = msgId;
+    PutLittleEndian(&frame[4], length, 2);
+    memcpy(&frame[6], payload, length);
+    for(index = 2; index < (6u + length); index++)
+    {
+        checksumA += frame[index];
+        checksumB += checksumA;
+    }
+    frame[6u + length] = checksumA;
+    frame[7u + length] = checksumB;
+
+    size = snprintf(cmd, sizeof(cmd), "AT+UI2CW=\"");
+    for(index = 0; index < frameSize; index++)
+    {
+        size += snprintf(&cmd[size], sizeof(cmd) - (size_t)size, "%02X", frame[index]);
+    }
+    snprintf(&cmd[size], sizeof(cmd) - (size_t)size, "\",%u", frameSize);
+
+    return Command(cmd, "OK");
+}
+
+//------------------------------------------------------------------------------
+//  static bool PollNavPvt(uint8_t payload[])
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function poll NAV-PVT and read the stream until the frame is found,
+//!  0xFF filler is skipped like the receiver sends when it has no data
+//
+//------------------------------------------------------------------------------
+static bool PollNavPvt(uint8_t payload[])
+{
+    uint8_t stream[RX_BUFFER_SIZE / 2u];
+    uint32_t streamLength = 0, index = 0, attempt = 0;
+    unsigned int byte = 0;
+    char *hex = NULL;
+    bool isFound = false;
+
+    if(WriteUbx(0x01, 0x07, NULL, 0) == false)
+    {
+        return false;
+    }
+
+    for(attempt = 0; (attempt < 5u) && (isFound == false); attempt++)
+    {
+        if(Command("AT+UI2CR=100", "OK") == false)
+        {
+            break;
+        }
+        hex = strstr(rxBuffer, "+UI2CR:");
+        hex = (hex != NULL) ? strchr(hex, '"') : NULL;
+        while((hex != NULL) && (sscanf(&hex[1], "%2x", &byte) == 1) && (streamLength < sizeof(stream)))
+        {
+            if((byte != 0xFFu) || (streamLength > 0u))
+            {
+                stream[streamLength++] = (uint8_t)byte;
+            }
+            hex += 2;
+        }
+
+        for(index = 0; (index + 8u + UBX_NAV_PVT_PAYLOAD) <= streamLength; index++)
+        {
+            if((stream[index] == 0xB5) && (stream[index + 1u] == 0x62) && (stream[index + 2u] == 0x01) &&
+               (stream[index + 3u] == 0x07) && (GetLittleEndian(&stream[index + 4u], 2) == UBX_NAV_PVT_PAYLOAD))
+            {
+                memcpy(payload, &stream[index + 6u], UBX_NAV_PVT_PAYLOAD);
+                isFound = true;
+                break;
+            }
+        }
+    }
+
+    return isFound;
+}
+
+//------------------------------------------------------------------------------
+//  static void PutLittleEndian(uint8_t data[], uint32_t value, uint8_t size)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write a little endian UBX field
+//
+//------------------------------------------------------------------------------
+static void PutLittleEndian(uint8_t data[], uint32_t value, uint8_t size)
+{
+    uint8_t index = 0;
+
+    for(index = 0; index < size; index++)
+    {
+        data[index] = (uint8_t)(value & 0xFFu);
+        value >>= 8;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static uint32_t GetLittleEndian(const uint8_t data[], uint8_t size)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read a little endian UBX field
+//
+//------------------------------------------------------------------------------
+static uint32_t GetLittleEndian(const uint8_t data[], uint8_t size)
+{
+    uint32_t value = 0;
+
+    while(size > 0u)
+    {
+        size--;
+        value = (value << 8) | data[size];
+    }
+    return value;
+}
+
+//------------------------------------------------------------------------------
+//  static double MeasureStart(START_TYPE_t startType, uint32_t offMs, uint32_t pollMs, uint32_t timeoutMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function power cycle the receiver and returns milliseconds from
+//!  supply on to the first 3D fix, or -1 on timeout or modem failure
+//
+//------------------------------------------------------------------------------
+static double MeasureStart(START_TYPE_t startType, uint32_t offMs, uint32_t pollMs, uint32_t timeoutMs)
+{
+    // CFG-PRT DDC: address 0x42, UBX in/out as GPSCreateConfigPortCommand
+    const uint8_t configPort[20] = {0x00, 0x00, 0x3D, 0x08, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                    0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00};
+    uint8_t payload[UBX_NAV_PVT_PAYLOAD];
+    uint8_t aiding[24];
+    time_t now;
+    struct tm *utc;
+    double powerOnMs = 0, nextPollMs = 0, ttffMs = -1;
+    uint32_t ageSeconds = 0;
+
+    Command("AT+UGPIOC=23,0,0", "OK");
+    usleep(offMs * 1000u);
+    if(Command("AT+UGPIOC=23,0,1", "OK") == false)
+    {
+        return -1;
+    }
+    powerOnMs = NowMs();
+    Command("AT+UI2CO=1,0,0,0x42,0", "OK");
+    WriteUbx(0x06, 0x00, configPort, sizeof(configPort));
+
+    if((startType == START_AIDED) && (lastFix.isValid == true))
+    {
+        now = time(NULL);
+        utc = gmtime(&now);
+        memset(aiding, 0, sizeof(aiding));
+        aiding[0] = 0x10;                   // TIME_UTC
+        aiding[3] = 0x80;                   // Leap seconds unknown
+        PutLittleEndian(&aiding[4], (uint32_t)(utc->tm_year + 1900), 2);
+        aiding[6] = (uint8_t)(utc->tm_mon + 1);
+        aiding[7] = (uint8_t)utc->tm_mday;
+        aiding[8] = (uint8_t)utc->tm_hour;
+        aiding[9] = (uint8_t)utc->tm_min;
+        aiding[10] = (uint8_t)utc->tm_sec;
+        PutLittleEndian(&aiding[16], 2u, 2);
+        WriteUbx(0x13, 0x40, aiding, 24);
+
+        ageSeconds = (uint32_t)((NowMs() - lastFix.fixMs) / 1000.0);
+        memset(aiding, 0, sizeof(aiding));
+        aiding[0] = 0x01;                   // POS_LLH
+        PutLittleEndian(&aiding[4], (uint32_t)lastFix.latitude, 4);
+        PutLittleEndian(&aiding[8], (uint32_t)lastFix.longitude, 4);
+        PutLittleEndian(&aiding[12], (uint32_t)(lastFix.heightMSL / 10), 4);
+        PutLittleEndian(&aiding[16], (lastFix.hAcc + (ageSeconds * DRIFT_MM_PER_SECOND)) / 10u, 4);
+        WriteUbx(0x13, 0x40, aiding, 20);
+    }
+
+    nextPollMs = NowMs();
+    while((ttffMs < 0) && ((NowMs() - powerOnMs) < timeoutMs))
+    {
+        while(NowMs() < nextPollMs)
+        {
+            usleep(1000);
+        }
+        nextPollMs += pollMs;
+
+        // gnssFixOK and 3D fix
+        if((PollNavPvt(payload) == true) && ((payload[21] & 0x01u) != 0u) && (payload[20] == 3u))
+        {
+            ttffMs = NowMs() - powerOnMs;
+            lastFix.longitude = (int32_t)GetLittleEndian(&payload[24], 4);
+            lastFix.latitude = (int32_t)GetLittleEndian(&payload[28], 4);
+            lastFix.heightMSL = (int32_t)GetLittleEndian(&payload[36], 4);
+            lastFix.hAcc = GetLittleEndian(&payload[40], 4);
+            lastFix.fixMs = NowMs();
+            lastFix.isValid = true;
+        }
+    }
+
+    return ttffMs;
+}
+
+//------------------------------------------------------------------------------
+//  static int CompareDouble(const void *a, const void *b)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function compare for qsort
+//
+//------------------------------------------------------------------------------
+static int CompareDouble(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+//------------------------------------------------------------------------------
+//  static double Percentile(double sorted[], uint32_t count, double percent)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns nearest rank percentile of sorted samples
+//
+//------------------------------------------------------------------------------
+static double Percentile(double sorted[], uint32_t count, double percent)
+{
+    uint32_t rank = (uint32_t)((percent / 100.0) * count + 0.999999);
+    return sorted[(rank > 0u) ? (rank - 1u) : 0u];
+}
+
+//------------------------------------------------------------------------------
+//  static void PrintReport(START_TYPE_t startType, double samples[], uint32_t count, uint32_t timeouts)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function print percentiles and the histogram of one start type,
+//!  bins match GNSS_TTFF_BIN_WIDTH_MS of the firmware statistics
+//
+//------------------------------------------------------------------------------
+static void PrintReport(START_TYPE_t startType, double samples[], uint32_t count, uint32_t timeouts)
+{
+    uint32_t histogram[HISTOGRAM_BINS] = {0};
+    uint32_t index = 0, bin = 0, bar = 0;
+
+    printf("\n%s starts %u, timeouts %u\n", startNames[startType], count + timeouts, timeouts);
+    if(count == 0u)
+    {
+        return;
+    }
+
+    qsort(samples, count, sizeof(double), CompareDouble);
+    printf("TTFF ms: p50 %.0f  p90 %.0f  max %.0f\n", Percentile(samples, count, 50),
+           Percentile(samples, count, 90), samples[count - 1u]);
+
+    for(index = 0; index < count; index++)
+    {
+        bin = (uint32_t)(samples[index] / BIN_WIDTH_MS);
+        histogram[(bin < HISTOGRAM_BINS) ? bin : (HISTOGRAM_BINS - 1u)]++;
+    }
+    for(bin = 0; bin < HISTOGRAM_BINS; bin++)
+    {
+        if(histogram[bin] == 0u)
+        {
+            continue;
+        }
+        if(bin < (HISTOGRAM_BINS - 1u))
+        {
+            printf("  %3u-%3u s %4u ", (bin * BIN_WIDTH_MS) / 1000u, ((bin + 1u) * BIN_WIDTH_MS) / 1000u, histogram[bin]);
+        }
+        else
+        {
+            printf("  %3u+    s %4u ", (bin * BIN_WIDTH_MS) / 1000u, histogram[bin]);
+        }
+        for(bar = 0; bar < histogram[bin]; bar++)
+        {
+            putchar('#');
+        }
+        putchar('\n');
+    }
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+int main(int argc, char *argv[])
+{
+    const char *ttyPath = NULL;
+    const char *mode = "both";
+    uint32_t numberOfStarts = 10u, offMs = 1000u, pollMs = 1000u, timeoutMs = 120000u;
+    uint32_t index = 0, count[START_TYPES] = {0}, timeouts[START_TYPES] = {0};
+    double *samples[START_TYPES] = {NULL, NULL};
+    double ttffMs = 0;
+    START_TYPE_t startType = START_COLD;
+    int option = 0;
+
+    while((option = getopt(argc, argv, "t:n:m:o:p:T:v")) != -1)
+    {
+        switch(option)
+        {
+        case 't':
+            ttyPath = optarg;
+            break;
+        case 'n':
+            numberOfStarts = (uint32_t)atoi(optarg);
+            break;
+        case 'm':
+            mode = optarg;
+            break;
+        case 'o':
+            offMs = (uint32_t)atoi(optarg);
+            break;
+        case 'p':
+            pollMs = (uint32_t)atoi(optarg);
+            break;
+        case 'T':
+            timeoutMs = (uint32_t)atoi(optarg);
+            break;
+        case 'v':
+            isVerbose = true;
+            break;
+        default:
+            ttyPath = NULL;
+            optind = argc;
+            break;
+        }
+    }
+    if((ttyPath == NULL) || (numberOfStarts == 0u) || (pollMs == 0u) ||
+       ((strcmp(mode, "cold") != 0) && (strcmp(mode, "aided") != 0) && (strcmp(mode, "both") != 0)))
+    {
+        fprintf(stderr, "usage: %s -t tty [-n starts] [-m cold|aided|both] [-o off ms] [-p poll ms] [-T timeout ms] [-v]\n", argv[0]);
+        return 1;
+    }
+
+    OpenTty(ttyPath);
+    samples[START_COLD] = calloc(numberOfStarts, sizeof(double));
+    samples[START_AIDED] = calloc(numberOfStarts, sizeof(double));
+    Command("ATE0", "OK");
+
+    // Aided starts need a previous fix, the first start is always cold and
+    // only counted when cold starts are measured
+    ttffMs = MeasureStart(START_COLD, offMs, pollMs, timeoutMs);
+    if(strcmp(mode, "aided") != 0)
+    {
+        if(ttffMs >= 0)
+        {
+            samples[START_COLD][count[START_COLD]++] = ttffMs;
+        }
+        else
+        {
+            timeouts[START_COLD]++;
+        }
+        index = 1u;
+    }
+
+    for(; index < numberOfStarts; index++)
+    {
+        if(strcmp(mode, "both") == 0)
+        {
+            startType = ((index % 2u) == 0u) ? START_COLD : START_AIDED;
+        }
+        else
+        {
+            startType = (strcmp(mode, "cold") == 0) ? START_COLD : START_AIDED;
+        }
+
+        ttffMs = MeasureStart(startType, offMs, pollMs, timeoutMs);
+        if(ttffMs >= 0)
+        {
+            samples[startType][count[startType]++] = ttffMs;
+        }
+        else
+        {
+            timeouts[startType]++;
+        }
+        if(isVerbose == true)
+        {
+            printf("start %u %s: %.0f ms\n", index, startNames[startType], ttffMs);
+        }
+    }
+
+    for(startType = START_COLD; startType < START_TYPES; startType++)
+    {
+        if((count[startType] + timeouts[startType]) > 0u)
+        {
+            PrintReport(startType, samples[startType], count[startType], timeouts[startType]);
+        }
+    }
+
+    free(samples[START_COLD]);
+    free(samples[START_AIDED]);
+    Command("AT+UGPIOC=23,0,0", "OK");
+    close(tty);
+    return ((timeouts[START_COLD] + timeouts[START_AIDED]) == 0u) ? 0 : 2;
+}
@@ -0,0 +1,691 @@
+//==============================================================================
+//
+//  UARTReplay.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        UARTReplay.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! Host side reader for cellular UART captures written by UARTCapture.c. The
+//! input is the DataFlash image starting at UART_CAPTURE_HEADER_PAGE_NUMBER
+//! (header page followed by the records).
+//!
+//! Build:  gcc -O2 -Wall -o UARTReplay UARTReplay.c
+//! Run:    ./UARTReplay [-d] [-t policy] capture.bin
+//!         ./UARTReplay -p [-l /tmp/ttyCell] [-x speed] capture.bin
+//!
+//!   -d  dump the transcript with time stamps
+//!   -t  timeout policy file, one "<command> <ms>" per line, e.g. "AT+USOCO 2000".
+//!       Every exchange is checked against it and would-be timeouts are listed
+//!   -p  replay on a pseudo terminal: each write from the client consumes the
+//!       next TX record and the following RX records are played back with the
+//!       captured timing
+//!   -x  replay speed factor, 2 plays twice as fast, 0 plays without delays
+//!   -l  create a symlink to the pty slave
+//!
+//! Without -p a per command summary of response times (first TX byte to last
+//! RX byte before next TX) is printed.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <time.h>
+#include <termios.h>
+
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+#define CAPTURE_PAGE_SIZE           256u
+#define CAPTURE_MAGIC               0x50414355u
+#define CAPTURE_VERSION             1u
+#define CAPTURE_RECORD_HEADER_SIZE  8u
+
+#define CAPTURE_TX                  0u
+#define CAPTURE_RX                  1u
+
+#define MAX_COMMAND_NAME            24u
+#define MAX_COMMANDS                64u
+
+typedef struct
+{
+    uint32_t ticks;
+    uint16_t length;
+    uint8_t  direction;
+    uint8_t  atIndex;
+    const uint8_t *data;
+}Record_t;
+
+//! One command written and the responses read until the next command
+typedef struct
+{
+    uint32_t txIndex;
+    uint32_t firstRxIndex;
+    uint32_t rxCount;
+    double   responseMs;
+    char     name[MAX_COMMAND_NAME];
+}Exchange_t;
+
+typedef struct
+{
+    char     name[MAX_COMMAND_NAME];
+    uint32_t count;
+    double   totalMs;
+    double   minMs;
+    double   maxMs;
+    uint32_t exceeded;
+    double   policyMs;
+}CommandStats_t;
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static uint8_t *image = NULL;
+static Record_t *records = NULL;
+static uint32_t numberOfRecords = 0;
+static uint32_t ticksPerSecond = 1000u;
+
+static Exchange_t *exchanges = NULL;
+static uint32_t numberOfExchanges = 0;
+
+static CommandStats_t commands[MAX_COMMANDS];
+static uint32_t numberOfCommands = 0;
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static uint32_t GetU32(const uint8_t *p);
+static uint16_t GetU16(const uint8_t *p);
+static void LoadCapture(const char *path);
+static double TicksToMs(uint32_t from, uint32_t to);
+static void GetCommandName(const Record_t *record, char name[]);
+static void BuildExchanges(void);
+static CommandStats_t* GetCommand(const char *name);
+static void LoadPolicy(const char *path);
+static void PrintEscaped(const uint8_t *data, uint32_t length);
+static void PrintTranscript(void);
+static void PrintSummary(void);
+static void SleepMs(double ms);
+static void Replay(const char *linkPath, double speed);
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static uint32_t GetU32(const uint8_t *p)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read little endian 32 bit value from capture image
+//
+//------------------------------------------------------------------------------
+static uint32_t GetU32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+//------------------------------------------------------------------------------
+//  static uint16_t GetU16(const uint8_t *p)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read little endian 16 bit value from capture image
+//
+//------------------------------------------------------------------------------
+static uint16_t GetU16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+//------------------------------------------------------------------------------
+//  static void LoadCapture(const char *path)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read capture image and index its records
+//
+//------------------------------------------------------------------------------
+static void LoadCapture(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    long fileSize = 0;
+    uint32_t dataSize = 0, recordCount = 0, offset = 0;
+    const uint8_t *data = NULL;
+
+    if(file == NULL)
+    {
+        perror(path);
+        exit(1);
+    }
+    fseek(file, 0, SEEK_END);
+    fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    image = malloc((size_t)fileSize);
+    if((fileSize < (long)CAPTURE_PAGE_SIZE) || (fread(image, 1, (size_t)fileSize, file) != (size_t)fileSize))
+    {
+        fprintf(stderr, "%s: too short\n", path);
+        exit(1);
+    }
+    fclose(file);
+
+    if((GetU32(&image[0]) != CAPTURE_MAGIC) || (GetU16(&image[4]) != CAPTURE_VERSION) || (GetU16(&image[6]) != CAPTURE_RECORD_HEADER_SIZE))
+    {
+        fprintf(stderr, "%s: not a UART capture image\n", path);
+        exit(1);
+    }
+    ticksPerSecond = GetU32(&image[8]);
+    dataSize = GetU32(&image[12]);
+    recordCount = GetU32(&image[16]);
+    if((uint64_t)dataSize + CAPTURE_PAGE_SIZE > (uint64_t)fileSize)
+    {
+        fprintf(stderr, "%s: truncated, %u data bytes expected\n", path, dataSize);
+        exit(1);
+    }
+    printf("Capture: %u records, %u dropped before dump, %u ticks/s, dumped at %u\n",
+           recordCount, GetU32(&image[20]), ticksPerSecond, GetU32(&image[24]));
+
+    records = calloc(recordCount + 1u, sizeof(Record_t));
+    data = &image[CAPTURE_PAGE_SIZE];
+    while(((offset + CAPTURE_RECORD_HEADER_SIZE) <= dataSize) && (numberOfRecords < recordCount))
+    {
+        Record_t *record = &records[numberOfRecords];
+        record->ticks = GetU32(&data[offset]);
+        record->length = GetU16(&data[offset + 4u]);
+        record->direction = data[offset + 6u];
+        record->atIndex = data[offset + 7u];
+        record->data = &data[offset + CAPTURE_RECORD_HEADER_SIZE];
+        offset += CAPTURE_RECORD_HEADER_SIZE + record->length;
+        if(offset > dataSize)
+        {
+            break;
+        }
+        numberOfRecords++;
+    }
+    if(numberOfRecords != recordCount)
+    {
+        fprintf(stderr, "warning: %u of %u records readable\n", numberOfRecords, recordCount);
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static double TicksToMs(uint32_t from, uint32_t to)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function convert RTC tick difference to milliseconds
+//
+//------------------------------------------------------------------------------
+static double TicksToMs(uint32_t from, uint32_t to)
+{
+    // Unsigned difference handles the 32 bit tick wrap
+    return (double)(uint32_t)(to - from) * 1000.0 / ticksPerSecond;
+}
+
+//------------------------------------------------------------------------------
+//  static void GetCommandName(const Record_t *record, char name[])
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function derive command name from TX record, e.g. "AT+USOCO".
+//!  Non AT writes (direct link payload, certificate) are named by atIndex.
+//
+//------------------------------------------------------------------------------
+static void GetCommandName(const Record_t *record, char name[])
+{
+    uint32_t index = 0;
+
+    if((record->length >= 2u) && (strncasecmp((const char *)record->data, "AT", 2) == 0))
+    {
+        while((index < record->length) && (index < (MAX_COMMAND_NAME - 1u)) &&
+              (isalnum(record->data[index]) || (record->data[index] == '+') || (record->data[index] == '&')))
+        {
+            name[index] = (char)record->data[index];
+            index++;
+        }
+        name[index] = 0;
+    }
+    else if((record->length >= 3u) && (memcmp(record->data, "+++", 3) == 0))
+    {
+        snprintf(name, MAX_COMMAND_NAME, "+++");
+    }
+    else
+    {
+        snprintf(name, MAX_COMMAND_NAME, "DATA[%u]", record->atIndex);
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void BuildExchanges(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function group records into command/response exchanges
+//
+//------------------------------------------------------------------------------
+static void BuildExchanges(void)
+{
+    uint32_t index = 0;
+    Exchange_t *exchange = NULL;
+
+    exchanges = calloc(numberOfRecords + 1u, sizeof(Exchange_t));
+    for(index = 0; index < numberOfRecords; index++)
+    {
+        if(records[index].direction == CAPTURE_TX)
+        {
+            // Chunks of one long write (certificate, HTTP body) belong together
+            if((exchange != NULL) && (exchange->rxCount == 0u) && (records[exchange->txIndex].atIndex == records[index].atIndex) &&
+               (strncmp(exchange->name, "DATA", 4) == 0))
+            {
+                continue;
+            }
+            exchange = &exchanges[numberOfExchanges++];
+            exchange->txIndex = index;
+            GetCommandName(&records[index], exchange->name);
+        }
+        else if(exchange != NULL)
+        {
+            if(exchange->rxCount == 0u)
+            {
+                exchange->firstRxIndex = index;
+            }
+            exchange->rxCount++;
+            exchange->responseMs = TicksToMs(records[exchange->txIndex].ticks, records[index].ticks);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static CommandStats_t* GetCommand(const char *name)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns statistics entry of a command, created if new
+//
+//------------------------------------------------------------------------------
+static CommandStats_t* GetCommand(const char *name)
+{
+    uint32_t index = 0;
+    CommandStats_t *command = NULL;
+
+    for(index = 0; index < numberOfCommands; index++)
+    {
+        if(strcasecmp(commands[index].name, name) == 0)
+        {
+            return &commands[index];
+        }
+    }
+    if(numberOfCommands < MAX_COMMANDS)
+    {
+        command = &commands[numberOfCommands++];
+        memset(command, 0, sizeof(CommandStats_t));
+        snprintf(command->name, sizeof(command->name), "%s", name);
+        command->minMs = 1e12;
+    }
+    return command;
+}
+
+//------------------------------------------------------------------------------
+//  static void LoadPolicy(const char *path)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read "<command> <ms>" timeout policy lines
+//
+//------------------------------------------------------------------------------
+static void LoadPolicy(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    char line[256], name[MAX_COMMAND_NAME];
+    double timeout = 0;
+    CommandStats_t *command = NULL;
+
+    if(file == NULL)
+    {
+        perror(path);
+        exit(1);
+    }
+    while(fgets(line, sizeof(line), file) != NULL)
+    {
+        if((line[0] != '#') && (sscanf(line, "%23s %lf", name, &timeout) == 2))
+        {
+            command = GetCommand(name);
+            if(command != NULL)
+            {
+                command->policyMs = timeout;
+            }
+        }
+    }
+    fclose(file);
+}
+
+//------------------------------------------------------------------------------
+//  static void PrintEscaped(const uint8_t *data, uint32_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function print UART bytes with control characters escaped
+//
+//------------------------------------------------------------------------------
+static void PrintEscaped(const uint8_t *data, uint32_t length)
+{
+    uint32_t index = 0;
+
+    for(index = 0; index < length; index++)
+    {
+        if(data[index] == '\r')
+        {
+            printf("\\r");
+        }
+        else if(data[index] == '\n')
+        {
+            printf("\\n");
+        }
+        else if(isprint(data[index]))
+        {
+            putchar(data[index]);
+        }
+        else
+        {
+            printf("\\x%02X", data[index]);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void PrintTranscript(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function print all records with time from first record
+//
+//------------------------------------------------------------------------------
+static void PrintTranscript(void)
+{
+    uint32_t index = 0;
+
+    for(index = 0; index < numberOfRecords; index++)
+    {
+        printf("%10.1f %s [%3u] ", TicksToMs(records[0].ticks, records[index].ticks),
+               (records[index].direction == CAPTURE_TX) ? "TX" : "RX", records[index].atIndex);
+        PrintEscaped(records[index].data, records[index].length);
+        printf("\n");
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void PrintSummary(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function print response time per command and policy violations
+//
+//------------------------------------------------------------------------------
+static void PrintSummary(void)
+{
+    uint32_t index = 0;
+    CommandStats_t *command = NULL;
+    bool isPolicyGiven = false;
+
+    for(index = 0; index < numberOfCommands; index++)
+    {
+        isPolicyGiven |= (commands[index].policyMs > 0);
+    }
+
+    for(index = 0; index < numberOfExchanges; index++)
+    {
+        command = GetCommand(exchanges[index].name);
+        if((command == NULL) || (exchanges[index].rxCount == 0u))
+        {
+            continue;
+        }
+        command->count++;
+        command->totalMs += exchanges[index].responseMs;
+        command->minMs = (exchanges[index].responseMs < command->minMs) ? exchanges[index].responseMs : command->minMs;
+        command->maxMs = (exchanges[index].responseMs > command->maxMs) ? exchanges[index].responseMs : command->maxMs;
+        if((command->policyMs > 0) && (exchanges[index].responseMs > command->policyMs))
+        {
+            command->exceeded++;
+            printf("exceeds policy: %s took %.1f ms (limit %.0f ms) at record %u\n", command->name,
+                   exchanges[index].responseMs, command->policyMs, exchanges[index].txIndex);
+        }
+    }
+
+    printf("\n%-16s %6s %10s %10s %10s", "command", "count", "min ms", "avg ms", "max ms");
+    printf(isPolicyGiven ? " %10s %8s\n" : "\n", "policy ms", "exceeded");
+    for(index = 0; index < numberOfCommands; index++)
+    {
+        command = &commands[index];
+        if(command->count > 0u)
+        {
+            printf("%-16s %6u %10.1f %10.1f %10.1f", command->name, command->count, command->minMs,
+                   command->totalMs / command->count, command->maxMs);
+            if(isPolicyGiven == true)
+            {
+                printf(" %10.0f %8u", command->policyMs, command->exceeded);
+            }
+            printf("\n");
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void SleepMs(double ms)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function sleep for the given milliseconds
+//
+//------------------------------------------------------------------------------
+static void SleepMs(double ms)
+{
+    struct timespec ts;
+    if(ms > 0)
+    {
+        ts.tv_sec = (time_t)(ms / 1000.0);
+        ts.tv_nsec = (long)((ms - ts.tv_sec * 1000.0) * 1000000.0);
+        nanosleep(&ts, NULL);
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void Replay(const char *linkPath, double speed)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function play the capture as the modem on a pseudo terminal
+//
+//------------------------------------------------------------------------------
+static void Replay(const char *linkPath, double speed)
+{
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    int slave = -1;
+    struct termios tio;
+    struct pollfd fd;
+    uint8_t rx[4096];
+    uint32_t exchangeIndex = 0, recordIndex = 0;
+    uint32_t previousTicks = 0;
+    ssize_t received = 0;
+    struct timespec start, now;
+    Exchange_t *exchange = NULL;
+
+    if((master < 0) || (grantpt(master) != 0) || (unlockpt(master) != 0))
+    {
+        perror("pty");
+        exit(1);
+    }
+    slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+    if(linkPath != NULL)
+    {
+        unlink(linkPath);
+        if(symlink(ptsname(master), linkPath) != 0)
+        {
+            perror("symlink");
+        }
+    }
+    printf("Replaying %u exchanges on %s at x%.1f\n", numberOfExchanges, ptsname(master), speed);
+    fflush(stdout);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    fd.fd = master;
+    fd.events = POLLIN;
+    while(exchangeIndex < numberOfExchanges)
+    {
+        if(poll(&fd, 1, -1) <= 0)
+        {
+            continue;
+        }
+        received = read(master, rx, sizeof(rx));
+        if(received <= 0)
+        {
+            continue;
+        }
+
+        exchange = &exchanges[exchangeIndex++];
+        if((exchange->name[0] == 'A') && (strncasecmp((const char *)rx, exchange->name, strlen(exchange->name)) != 0))
+        {
+            printf("mismatch at exchange %u: expected %s, got ", exchangeIndex - 1u, exchange->name);
+            PrintEscaped(rx, (uint32_t)((received > 40) ? 40 : received));
+            printf("\n");
+        }
+
+        // Responses keep their spacing relative to the command
+        previousTicks = records[exchange->txIndex].ticks;
+        for(recordIndex = exchange->firstRxIndex; (exchange->rxCount > 0u) && (recordIndex < numberOfRecords) &&
+            (records[recordIndex].direction == CAPTURE_RX); recordIndex++)
+        {
+            if(speed > 0)
+            {
+                SleepMs(TicksToMs(previousTicks, records[recordIndex].ticks) / speed);
+            }
+            previousTicks = records[recordIndex].ticks;
+            (void)write(master, records[recordIndex].data, records[recordIndex].length);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    // Give the client time to read the last response before the pty goes away
+    fd.events = 0;
+    (void)poll(&fd, 1, 1000);
+
+    printf("Replay done in %.1f ms, captured session took %.1f ms\n",
+           (now.tv_sec - start.tv_sec) * 1000.0 + (now.tv_nsec - start.tv_nsec) / 1000000.0,
+           (numberOfRecords > 0u) ? TicksToMs(records[0].ticks, records[numberOfRecords - 1u].ticks) : 0.0);
+    if(linkPath != NULL)
+    {
+        unlink(linkPath);
+    }
+    close(slave);
+    close(master);
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+int main(int argc, char *argv[])
+{
+    const char *linkPath = NULL;
+    const char *policyPath = NULL;
+    bool isDump = false, isReplay = false;
+    double speed = 1.0;
+    int option = 0;
+
+    while((option = getopt(argc, argv, "dt:px:l:")) != -1)
+    {
+        switch(option)
+        {
+        case 'd':
+            isDump = true;
+            break;
+        case 't':
+            policyPath = optarg;
+            break;
+        case 'p':
+            isReplay = true;
+            break;
+        case 'x':
+            speed = atof(optarg);
+            break;
+        case 'l':
+            linkPath = optarg;
+            break;
+        default:
+            optind = argc;
+            break;
+        }
+    }
+    if(optind != (argc - 1))
+    {
+        fprintf(stderr, "usage: %s [-d] [-t policy] [-p [-l link] [-x speed]] capture.bin\n", argv[0]);
+        return 1;
+    }
+
+    LoadCapture(argv[optind]);
+    BuildExchanges();
+    if(policyPath != NULL)
+    {
+        LoadPolicy(policyPath);
+    }
+    if(isDump == true)
+    {
+        PrintTranscript();
+    }
+    if(isReplay == true)
+    {
+        Replay(linkPath, speed);
+    }
+    else
+    {
+        PrintSummary();
+    }
+    return 0;
+}
@@ -0,0 +1,638 @@
+//==============================================================================
+//
+//  UploadBench.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        UploadBench.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! End to end upload benchmark. Events are created at a fixed interval and
+//! sent with the same AT sequence as PostDataToiNet (USOCR, UDCONF, USOSEC,
+//! USOCLCFG, USOCO, USODL, header, body, +++, USORD), including the token
+//! request when no valid token is held and the retry on 401. The token socket
+//! is connected with <async_connect> while the data socket connects and the
+//! token is requested once +UUSOCO reports it; -S requests it serially on the
+//! data socket as firmware without asynchronous connect does.
+//!
+//! Typical setup:
+//!   ./iNetStandIn -n -p 8080 -L 300 -J 200 -a 0.05
+//!   ./ModemSim -l /tmp/ttyCell -s default.sim -f 127.0.0.1:8080
+//!   ./UploadBench -t /tmp/ttyCell -n 100 -i 2000
+//!
+//! Build:  gcc -O2 -Wall -o UploadBench UploadBench.c
+//! Run:    ./UploadBench -t tty [-n events] [-i interval ms] [-s sensors] [-S] [-v]
+//!
+//! Reports event creation to HTTP 2xx latency percentiles, failures and the
+//! UART bytes spent per delivered event (token requests included).
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <strings.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <time.h>
+#include <termios.h>
+
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+#define RX_BUFFER_SIZE          4096u
+#define BODY_BUFFER_SIZE        1024u
+#define HEADER_BUFFER_SIZE      512u
+#define TOKEN_BUFFER_SIZE       128u
+
+#define AT_TIMEOUT_MS           5000u
+#define HTTP_TIMEOUT_MS         20000u
+#define ESCAPE_GUARD_MS         150u
+#define MAX_ATTEMPTS            3u
+#define TOKEN_CONNECT_TIMEOUT_MS 40000u
+#define TOKEN_CONNECT_POLL_MS   100u
+
+#define INET_HOST               "inetuploadft.indsci.com"
+
+typedef enum
+{
+    REQUEST_TOKEN = 0,
+    REQUEST_CREATE,
+}REQUEST_t;
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static int tty = -1;
+static bool isVerbose = false;
+static char rxBuffer[RX_BUFFER_SIZE];
+static uint32_t rxLength = 0;
+static char token[TOKEN_BUFFER_SIZE] = "";
+static int tokenSocketId = -1;
+static int tokenConnect = 0;                //!< +UUSOCO of the token socket, 1 connected, -1 failed
+static bool isParallelToken = true;
+static uint32_t numberOfSensors = 4u;
+
+static uint64_t uartBytes = 0;
+static uint32_t tokenRequests = 0;
+static uint32_t retries = 0;
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static double NowMs(void);
+static void OpenTty(const char *path);
+static void SendBytes(const char *data, uint32_t length);
+static bool WaitFor(const char *expected, uint32_t timeoutMs);
+static bool Command(const char *cmd, const char *expected);
+static int  OpenSocket(bool isAsync);
+static bool WaitTokenSocket(void);
+static int  HttpExchange(REQUEST_t request, int socket, uint32_t sequence);
+static int  UploadEvent(uint32_t sequence);
+static int  CompareDouble(const void *a, const void *b);
+static double Percentile(double sorted[], uint32_t count, double percent);
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static double NowMs(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns monotonic time in milliseconds
+//
+//------------------------------------------------------------------------------
+static double NowMs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000.0) + (ts.tv_nsec / 1000000.0);
+}
+
+//------------------------------------------------------------------------------
+//  static void OpenTty(const char *path)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function open the modem tty in raw mode
+//
+//------------------------------------------------------------------------------
+static void OpenTty(const char *path)
+{
+    struct termios tio;
+
+    tty = open(path, O_RDWR | O_NOCTTY);
+    if(tty < 0)
+    {
+        perror(path);
+        exit(1);
+    }
+    tcgetattr(tty, &tio);
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, B115200);
+    cfsetospeed(&tio, B115200);
+    tcsetattr(tty, TCSANOW, &tio);
+}
+
+//------------------------------------------------------------------------------
+//  static void SendBytes(const char *data, uint32_t length)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write to modem and clear the receive buffer
+//
+//------------------------------------------------------------------------------
+static void SendBytes(const char *data, uint32_t length)
+{
+    rxLength = 0;
+    rxBuffer[0] = 0;
+    if(write(tty, data, length) == (ssize_t)length)
+    {
+        uartBytes += length;
+    }
+    if(isVerbose == true)
+    {
+        printf("TX %.*s\n", (int)((length > 60u) ? 60u : length), data);
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static bool WaitFor(const char *expected, uint32_t timeoutMs)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read until expected text or an error shows up
+//
+//------------------------------------------------------------------------------
+static bool WaitFor(const char *expected, uint32_t timeoutMs)
+{
+    struct pollfd fd = {tty, POLLIN, 0};
+    double deadline = NowMs() + timeoutMs;
+    ssize_t received = 0;
+    char *urc = NULL;
+    int urcSocket = 0, socketError = 0;
+
+    while(NowMs() < deadline)
+    {
+        // Token socket connect is reported within any response
+        for(urc = strstr(rxBuffer, "+UUSOCO: "); urc != NULL; urc = strstr(&urc[1], "+UUSOCO: "))
+        {
+            if((sscanf(urc, "+UUSOCO: %d,%d", &urcSocket, &socketError) == 2) && (urcSocket == tokenSocketId) && (tokenConnect == 0))
+            {
+                tokenConnect = (socketError == 0) ? 1 : -1;
+            }
+        }
+        if(strstr(rxBuffer, expected) != NULL)
+        {
+            return true;
+        }
+        if((strstr(rxBuffer, "ERROR") != NULL))
+        {
+            break;
+        }
+        if(poll(&fd, 1, (int)(deadline - NowMs())) > 0)
+        {
+            received = read(tty, &rxBuffer[rxLength], RX_BUFFER_SIZE - 1u - rxLength);
+            if(received > 0)
+            {
+                rxLength += (uint32_t)received;
+                rxBuffer[rxLength] = 0;
+                uartBytes += (uint64_t)received;
+            }
+        }
+    }
+    if(isVerbose == true)
+    {
+        printf("RX failed waiting for %s: %s\n", expected, rxBuffer);
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+//  static bool Command(const char *cmd, const char *expected)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function send AT command and wait for the expected response
+//
+//------------------------------------------------------------------------------
+static bool Command(const char *cmd, const char *expected)
+{
+    char line[256];
+    int length = snprintf(line, sizeof(line), "%s\r\n", cmd);
+
+    SendBytes(line, (uint32_t)length);
+    return WaitFor(expected, AT_TIMEOUT_MS);
+}
+
+//------------------------------------------------------------------------------
+//  static int OpenSocket(bool isAsync)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function create and connect a secure socket as PostDataToiNet does,
+//!  an asynchronous connect returns at once and +UUSOCO reports the result.
+//!  Returns the socket or -1 on modem failure.
+//
+//------------------------------------------------------------------------------
+static int OpenSocket(bool isAsync)
+{
+    char cmd[128];
+    int socket = -1;
+
+    if((Command("AT+USOCR=6", "OK") == false) || (sscanf(strstr(rxBuffer, "+USOCR:") ? strstr(rxBuffer, "+USOCR:") : "", "+USOCR: %d", &socket) != 1))
+    {
+        return -1;
+    }
+    snprintf(cmd, sizeof(cmd), "AT+UDCONF=7,%d,36", socket);
+    Command(cmd, "OK");
+    snprintf(cmd, sizeof(cmd), "AT+USOSEC=%d,1,0", socket);
+    Command(cmd, "OK");
+    Command("AT+USOCLCFG=1", "OK");
+    if(isAsync == true)
+    {
+        tokenSocketId = socket;
+        tokenConnect = 0;
+    }
+    snprintf(cmd, sizeof(cmd), "AT+USOCO=%d,\"%s\",443%s", socket, INET_HOST, (isAsync == true) ? ",1" : "");
+    if(Command(cmd, "OK") == false)
+    {
+        // Release the socket so failures do not exhaust the modem sockets
+        snprintf(cmd, sizeof(cmd), "AT+USOCL=%d", socket);
+        Command(cmd, "OK");
+        socket = -1;
+        if(isAsync == true)
+        {
+            // Firmware without <async_connect>, continue as -S
+            tokenSocketId = -1;
+            isParallelToken = false;
+        }
+    }
+    return socket;
+}
+
+//------------------------------------------------------------------------------
+//  static bool WaitTokenSocket(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function poll with plain AT until +UUSOCO reports the token socket,
+//!  as RequestTokenOnSocket does. Returns true when it connected.
+//
+//------------------------------------------------------------------------------
+static bool WaitTokenSocket(void)
+{
+    double deadline = NowMs() + TOKEN_CONNECT_TIMEOUT_MS;
+
+    while((tokenConnect == 0) && (NowMs() < deadline))
+    {
+        usleep(TOKEN_CONNECT_POLL_MS * 1000u);
+        Command("AT", "OK");
+    }
+    return (tokenConnect > 0);
+}
+
+//------------------------------------------------------------------------------
+//  static int HttpExchange(REQUEST_t request, int socket, uint32_t sequence)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function run one request on a connected socket as PostDataToiNet
+//!  does and returns the HTTP status, or -1 on modem failure
+//
+//------------------------------------------------------------------------------
+static int HttpExchange(REQUEST_t request, int socket, uint32_t sequence)
+{
+    char cmd[128];
+    char body[BODY_BUFFER_SIZE];
+    char header[HEADER_BUFFER_SIZE];
+    int bodyLength = 0, headerLength = 0, status = -1;
+    uint32_t index = 0, contentLength = 0;
+    char *text = NULL, *headerEnd = NULL;
+    double deadline = 0;
+    struct pollfd fd = {tty, POLLIN, 0};
+    ssize_t received = 0;
+    bool isLinkOpen = false;
+
+    snprintf(cmd, sizeof(cmd), "AT+USODL=%d", socket);
+    isLinkOpen = Command(cmd, "CONNECT");
+    if(isLinkOpen == false)
+    {
+        // Release the socket so failures do not exhaust the modem sockets
+        snprintf(cmd, sizeof(cmd), "AT+USOCL=%d", socket);
+        Command(cmd, "OK");
+        return -1;
+    }
+
+    if(request == REQUEST_TOKEN)
+    {
+        tokenRequests++;
+        bodyLength = snprintf(body, sizeof(body), "grant_type=password&client_id=bench&client_secret=bench&username=bench&password=bench$");
+        // Same shape as CreateHttpHeader, Content-Length last and no Accept
+        headerLength = snprintf(header, sizeof(header), "POST /oauth2/endpoint/iNet/token HTTP/1.1\r\nHost: %s\r\nConnection: close\r\n"
+                                "Content-Type: application/x-www-form-urlencoded\r\nContent-Length: %d\r\n\r\n",
+                                INET_HOST, bodyLength - 1);
+    }
+    else
+    {
+        // Same shape as JSONCreateInstrumentDataUpload
+        bodyLength = snprintf(body, sizeof(body), "{\"device\":\"cellular\",\"sn\":\"17040MN-001\",\"time\":\"2018-11-16T10:00:00.000+0000\","
+                              "\"sequence\":%u,\"status\":0,\"equipmentCode\": \"VPRO\",\"user\":\"Bench\",\"site\":\"Lab\",\"sensors\":[",
+                              sequence & 0xFFu);
+        for(index = 0; index < numberOfSensors; index++)
+        {
+            bodyLength += snprintf(&body[bodyLength], sizeof(body) - (size_t)bodyLength, "%s{\"gasCode\":\"G%04u\",\"uom\":%u,\"status\":0,\"gasReading\":%2.4f}",
+                                   (index > 0u) ? "," : "", index + 1u, 2u, 20.9 - index);
+        }
+        bodyLength += snprintf(&body[bodyLength], sizeof(body) - (size_t)bodyLength, "]}$");
+        headerLength = snprintf(header, sizeof(header), "POST /iNetAPI/v1/live/create HTTP/1.1\r\nHost: %s\r\nConnection: close\r\n"
+                                "Content-Type: application/json\r\nAuthorization: %s\r\nContent-Length: %d\r\n\r\n",
+                                INET_HOST, token, bodyLength - 1);
+    }
+    SendBytes(header, (uint32_t)headerLength);
+    SendBytes(body, (uint32_t)bodyLength);
+
+    // Response is complete once Content-Length bytes of body arrived
+    deadline = NowMs() + HTTP_TIMEOUT_MS;
+    while(NowMs() < deadline)
+    {
+        text = strstr(rxBuffer, "HTTP/1.1 ");
+        headerEnd = (text != NULL) ? strstr(text, "\r\n\r\n") : NULL;
+        if(headerEnd != NULL)
+        {
+            status = atoi(&text[9]);
+            text = strcasestr(text, "Content-Length:");
+            contentLength = (text != NULL) ? (uint32_t)strtoul(&text[15], NULL, 10) : 0u;
+            if(strlen(&headerEnd[4]) >= contentLength)
+            {
+                break;
+            }
+        }
+        if(poll(&fd, 1, (int)(deadline - NowMs())) > 0)
+        {
+            received = read(tty, &rxBuffer[rxLength], RX_BUFFER_SIZE - 1u - rxLength);
+            if(received > 0)
+            {
+                rxLength += (uint32_t)received;
+                rxBuffer[rxLength] = 0;
+                uartBytes += (uint64_t)received;
+            }
+        }
+    }
+    if((request == REQUEST_TOKEN) && (status == 200))
+    {
+        text = strstr(rxBuffer, "\"access_token\":\"");
+        if((text != NULL) && (strstr(rxBuffer, "expires_in") != NULL))
+        {
+            text += 16;
+            snprintf(token, sizeof(token), "Bearer %.*s", (int)(strchr(text, '"') - text), text);
+        }
+        else
+        {
+            status = -1;
+        }
+    }
+
+    // Leave direct link and read whatever is left
+    usleep(ESCAPE_GUARD_MS * 1000u);
+    SendBytes("+++", 3u);
+    WaitFor("OK", AT_TIMEOUT_MS);
+    snprintf(cmd, sizeof(cmd), "AT+USORD=%d,1024", socket);
+    Command(cmd, "OK");
+
+    return status;
+}
+
+//------------------------------------------------------------------------------
+//  static int UploadEvent(uint32_t sequence)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function deliver one event, fetching a token first when needed.
+//!  The token socket connects while the data socket does, unless -S.
+//
+//------------------------------------------------------------------------------
+static int UploadEvent(uint32_t sequence)
+{
+    char cmd[32];
+    int status = -1, socket = -1;
+    uint32_t attempt = 0;
+
+    for(attempt = 0; attempt < MAX_ATTEMPTS; attempt++)
+    {
+        if(attempt > 0u)
+        {
+            retries++;
+        }
+        if((token[0] == 0) && (isParallelToken == true))
+        {
+            (void)OpenSocket(true);
+        }
+        socket = OpenSocket(false);
+        if((token[0] == 0) && (tokenSocketId >= 0))
+        {
+            if(WaitTokenSocket() == true)
+            {
+                (void)HttpExchange(REQUEST_TOKEN, tokenSocketId, sequence);
+            }
+            else
+            {
+                // Not connected in time or failed, the modem holds it until closed
+                snprintf(cmd, sizeof(cmd), "AT+USOCL=%d", tokenSocketId);
+                Command(cmd, "OK");
+            }
+            tokenSocketId = -1;
+        }
+        if(socket < 0)
+        {
+            continue;
+        }
+        if(token[0] == 0)
+        {
+            // Token goes on the data socket, the event on the next one
+            if((HttpExchange(REQUEST_TOKEN, socket, sequence) != 200) || ((socket = OpenSocket(false)) < 0))
+            {
+                continue;
+            }
+        }
+        status = HttpExchange(REQUEST_CREATE, socket, sequence);
+        if((status == 200) || (status == 201))
+        {
+            break;
+        }
+        if(status == 401)
+        {
+            token[0] = 0;
+        }
+    }
+    return status;
+}
+
+//------------------------------------------------------------------------------
+//  static int CompareDouble(const void *a, const void *b)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function compare for qsort
+//
+//------------------------------------------------------------------------------
+static int CompareDouble(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+//------------------------------------------------------------------------------
+//  static double Percentile(double sorted[], uint32_t count, double percent)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns nearest rank percentile of sorted samples
+//
+//------------------------------------------------------------------------------
+static double Percentile(double sorted[], uint32_t count, double percent)
+{
+    uint32_t rank = (uint32_t)((percent / 100.0) * count + 0.999999);
+    return sorted[(rank > 0u) ? (rank - 1u) : 0u];
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+int main(int argc, char *argv[])
+{
+    const char *ttyPath = NULL;
+    uint32_t numberOfEvents = 20u, intervalMs = 2000u;
+    uint32_t index = 0, delivered = 0, failed = 0;
+    double *latencies = NULL;
+    double createdMs = 0, startMs = 0;
+    int option = 0, status = 0;
+
+    while((option = getopt(argc, argv, "t:n:i:s:Sv")) != -1)
+    {
+        switch(option)
+        {
+        case 't':
+            ttyPath = optarg;
+            break;
+        case 'n':
+            numberOfEvents = (uint32_t)atoi(optarg);
+            break;
+        case 'i':
+            intervalMs = (uint32_t)atoi(optarg);
+            break;
+        case 's':
+            numberOfSensors = (uint32_t)atoi(optarg);
+            break;
+        case 'S':
+            isParallelToken = false;
+            break;
+        case 'v':
+            isVerbose = true;
+            break;
+        default:
+            ttyPath = NULL;
+            optind = argc;
+            break;
+        }
+    }
+    if((ttyPath == NULL) || (numberOfEvents == 0u))
+    {
+        fprintf(stderr, "usage: %s -t tty [-n events] [-i interval ms] [-s sensors] [-S] [-v]\n", argv[0]);
+        return 1;
+    }
+
+    OpenTty(ttyPath);
+    latencies = calloc(numberOfEvents, sizeof(double));
+    Command("ATE0", "OK");
+
+    // Wait for network registration like CellularInit does
+    for(index = 0; index < 60u; index++)
+    {
+        if((Command("AT+CREG?", "OK") == true) && ((strstr(rxBuffer, "+CREG: 0,1") != NULL) || (strstr(rxBuffer, "+CREG: 0,5") != NULL)))
+        {
+            break;
+        }
+        sleep(1);
+    }
+
+    // Events are created on a fixed schedule, a slow upload delays the next
+    // one just like events waiting in the queue on the instrument
+    startMs = NowMs();
+    for(index = 0; index < numberOfEvents; index++)
+    {
+        createdMs = startMs + ((double)index * intervalMs);
+        while(NowMs() < createdMs)
+        {
+            usleep(1000);
+        }
+        status = UploadEvent(index);
+        if((status == 200) || (status == 201))
+        {
+            latencies[delivered++] = NowMs() - createdMs;
+        }
+        else
+        {
+            failed++;
+        }
+        if(isVerbose == true)
+        {
+            printf("event %u done after %.1f ms\n", index, NowMs() - createdMs);
+        }
+    }
+
+    qsort(latencies, delivered, sizeof(double), CompareDouble);
+    printf("events %u, delivered %u, failed %u, token requests %u, retries %u\n",
+           numberOfEvents, delivered, failed, tokenRequests, retries);
+    if(delivered > 0u)
+    {
+        printf("creation to HTTP 2xx ms: p50 %.1f  p90 %.1f  p99 %.1f  max %.1f\n",
+               Percentile(latencies, delivered, 50), Percentile(latencies, delivered, 90),
+               Percentile(latencies, delivered, 99), latencies[delivered - 1u]);
+        printf("UART bytes per delivered event: %.1f\n", (double)uartBytes / delivered);
+    }
+    free(latencies);
+    close(tty);
+    return (failed == 0u) ? 0 : 2;
+}
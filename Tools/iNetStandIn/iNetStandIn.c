@@ -0,0 +1,699 @@
+//==============================================================================
+//
+//  iNetStandIn.c
+//
+//  Copyright (C) 2018 by Industrial Scientific.
+//
+//  This document and all  contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE
+//==============================================================================
+//
+//  Source:        iNetStandIn.c
+//
+//  Project:       Frey
+//
+//  Author:        agent
+//
+//  Date:          2026/10/19
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! Local stand-in for the iNet upload server. It implements the three
+//! endpoints used by ExtCommunication.c with the response shapes that
+//! JParseGetToken and JParseInstrumentDataUpload expect:
+//!
+//!   POST /oauth2/endpoint/iNet/token          -> 200 {"access_token":..,"expires_in":..}
+//!   POST /iNetAPI/v1/live/create              -> 201 {"id":"<event id>"[,"geofences":<set>]}
+//!   POST /iNetAPI/v1/live/<sn>/register       -> 200 {}
+//!
+//! create and register need "Authorization: Bearer <issued token>", else 401.
+//!
+//! Build:  gcc -O2 -Wall -o iNetStandIn iNetStandIn.c -lssl -lcrypto
+//! Test certificate:
+//!         openssl req -x509 -newkey rsa:2048 -nodes -days 365 -subj "/CN=inetuploadft.indsci.com"
+//!                 -keyout key.pem -out cert.pem
+//!         openssl x509 -in cert.pem -outform der -out iNetCert.der   (for AT+USECMNG)
+//!         openssl req -x509 -newkey ec -pkeyopt ec_paramgen_curve:P-256 -nodes -days 365
+//!                 -subj "/CN=inetuploadft.indsci.com" -keyout eckey.pem -out eccert.pem
+//! Run:    ./iNetStandIn [-p port] [-c cert.pem -k key.pem [-C eccert.pem -K eckey.pem] | -n]
+//!                       [-L ms] [-J ms] [-e prob] [-a prob] [-d prob] [-x seconds] [-g set]
+//!                       [-r seed] [-v]
+//!
+//!   -p  listen port, default 8443
+//!   -c  certificate chain and -k private key for TLS, leaf first, the chain
+//!       sent is the one in the file
+//!   -C  ECDSA certificate chain and -K its key, served to clients that
+//!       offer ECDSA suites only, e.g. Tools/TLSBench
+//!   -n  plain TCP, e.g. behind Tools/ModemSim -f which does not terminate TLS
+//!   -L  server latency before each response in ms, -J adds uniform jitter
+//!   -e  probability of "500 Internal Server Error"
+//!   -a  probability of "401 Unauthorized" on create (forces a new token)
+//!   -d  probability of closing the connection without a response
+//!   -x  token lifetime reported in expires_in, default 3600
+//!   -g  geofence set in the download format of Geofence.h, e.g.
+//!       "[3,[1,0,150,40438185,-79999422]]", added to create responses
+//!       while the event reports another "geofenceSet" version
+//!   -v  print every request
+//!
+//! On SIGINT a summary of requests, status codes, bytes and server side
+//! handling time is printed, with the TLS handshakes per negotiated suite.
+//
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+
+//==============================================================================
+//  CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+#define REQUEST_BUFFER_SIZE     4096u
+#define RESPONSE_BUFFER_SIZE    1024u
+#define TOKEN_LENGTH            32u
+#define RECEIVE_TIMEOUT_SEC     10
+#define MAX_CIPHERS             16u
+
+typedef enum
+{
+    ENDPOINT_TOKEN = 0,
+    ENDPOINT_CREATE,
+    ENDPOINT_REGISTER,
+    ENDPOINT_UNKNOWN,
+    ENDPOINT_LAST,
+}ENDPOINT_t;
+
+typedef struct
+{
+    uint32_t requests;
+    uint32_t status2xx;
+    uint32_t status401;
+    uint32_t status5xx;
+    uint32_t dropped;
+    uint64_t bytesIn;
+    uint64_t bytesOut;
+    double   totalHandlingMs;
+}EndpointStats_t;
+
+typedef struct
+{
+    char     name[64];
+    uint32_t handshakes;
+    uint32_t resumed;
+}CipherStats_t;
+
+//! Connection abstraction so plain TCP and TLS share the request handling
+typedef struct
+{
+    int  fd;
+    SSL *ssl;
+}Connection_t;
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+static const char *endpointNames[ENDPOINT_LAST] = {"token", "create", "register", "other"};
+
+static volatile sig_atomic_t isExitRequested = 0;
+static bool isVerbose = false;
+static SSL_CTX *sslContext = NULL;
+
+static uint32_t latencyMs = 0;
+static uint32_t jitterMs = 0;
+static double errorProbability = 0;
+static double unauthorizedProbability = 0;
+static double dropProbability = 0;
+static uint32_t tokenLifetime = 3600u;
+static const char *geofenceSet = NULL;
+static uint32_t geofenceSetVersion = 0;
+
+static char issuedToken[TOKEN_LENGTH + 1u] = "";
+static uint32_t eventCounter = 0;
+static uint32_t geofenceSetsSent = 0;
+static EndpointStats_t stats[ENDPOINT_LAST];
+static CipherStats_t cipherStats[MAX_CIPHERS];
+static uint32_t handshakeFailures = 0;
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static double NowMs(void);
+static bool Chance(double probability);
+static int  ConnectionRead(Connection_t *conn, char buffer[], int size);
+static int  ConnectionWrite(Connection_t *conn, const char buffer[], int size);
+static int  ReceiveRequest(Connection_t *conn, char buffer[], uint32_t size);
+static ENDPOINT_t GetEndpoint(const char request[]);
+static bool IsAuthorized(const char request[]);
+static void HandleConnection(Connection_t *conn);
+static void RecordHandshake(SSL *ssl);
+static void PrintStatistics(void);
+static void SignalHandler(int sig);
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//------------------------------------------------------------------------------
+//  static double NowMs(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns monotonic time in milliseconds
+//
+//------------------------------------------------------------------------------
+static double NowMs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000.0) + (ts.tv_nsec / 1000000.0);
+}
+
+//------------------------------------------------------------------------------
+//  static bool Chance(double probability)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function returns true with the given probability
+//
+//------------------------------------------------------------------------------
+static bool Chance(double probability)
+{
+    return (probability > 0) && (((double)rand() / RAND_MAX) < probability);
+}
+
+//------------------------------------------------------------------------------
+//  static int ConnectionRead(Connection_t *conn, char buffer[], int size)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read from TLS or plain connection
+//
+//------------------------------------------------------------------------------
+static int ConnectionRead(Connection_t *conn, char buffer[], int size)
+{
+    return (conn->ssl != NULL) ? SSL_read(conn->ssl, buffer, size) : (int)read(conn->fd, buffer, (size_t)size);
+}
+
+//------------------------------------------------------------------------------
+//  static int ConnectionWrite(Connection_t *conn, const char buffer[], int size)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function write to TLS or plain connection
+//
+//------------------------------------------------------------------------------
+static int ConnectionWrite(Connection_t *conn, const char buffer[], int size)
+{
+    return (conn->ssl != NULL) ? SSL_write(conn->ssl, buffer, size) : (int)write(conn->fd, buffer, (size_t)size);
+}
+
+//------------------------------------------------------------------------------
+//  static int ReceiveRequest(Connection_t *conn, char buffer[], uint32_t size)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function read one HTTP request (headers and Content-Length body).
+//!  Returns request length or -1.
+//
+//------------------------------------------------------------------------------
+static int ReceiveRequest(Connection_t *conn, char buffer[], uint32_t size)
+{
+    uint32_t length = 0, required = 0;
+    char *headerEnd = NULL, *contentLength = NULL;
+    int received = 0;
+
+    while(length < (size - 1u))
+    {
+        received = ConnectionRead(conn, &buffer[length], (int)(size - 1u - length));
+        if(received <= 0)
+        {
+            return -1;
+        }
+        length += (uint32_t)received;
+        buffer[length] = 0;
+
+        headerEnd = strstr(buffer, "\r\n\r\n");
+        if(headerEnd != NULL)
+        {
+            required = (uint32_t)(headerEnd - buffer) + 4u;
+            contentLength = strcasestr(buffer, "Content-Length:");
+            if((contentLength != NULL) && (contentLength < headerEnd))
+            {
+                required += (uint32_t)strtoul(&contentLength[15], NULL, 10);
+            }
+            if(length >= required)
+            {
+                return (int)length;
+            }
+        }
+    }
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+//  static ENDPOINT_t GetEndpoint(const char request[])
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function classify request line
+//
+//------------------------------------------------------------------------------
+static ENDPOINT_t GetEndpoint(const char request[])
+{
+    ENDPOINT_t endpoint = ENDPOINT_UNKNOWN;
+    const char *lineEnd = strstr(request, "\r\n");
+    const char *registerPath = strstr(request, "/register ");
+
+    if(strncmp(request, "POST /oauth2/endpoint/iNet/token ", 33) == 0)
+    {
+        endpoint = ENDPOINT_TOKEN;
+    }
+    else if(strncmp(request, "POST /iNetAPI/v1/live/create ", 29) == 0)
+    {
+        endpoint = ENDPOINT_CREATE;
+    }
+    else if((strncmp(request, "POST /iNetAPI/v1/live/", 22) == 0) && (registerPath != NULL) && (registerPath < lineEnd))
+    {
+        endpoint = ENDPOINT_REGISTER;
+    }
+    return endpoint;
+}
+
+//------------------------------------------------------------------------------
+//  static bool IsAuthorized(const char request[])
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function check the bearer token against the issued one
+//
+//------------------------------------------------------------------------------
+static bool IsAuthorized(const char request[])
+{
+    const char *auth = strcasestr(request, "\r\nAuthorization: Bearer ");
+
+    return (auth != NULL) && (issuedToken[0] != 0) && (strncmp(&auth[24], issuedToken, TOKEN_LENGTH) == 0);
+}
+
+//------------------------------------------------------------------------------
+//  static void HandleConnection(Connection_t *conn)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function serve one request and close, as firmware sends
+//!  "Connection: close" on every request
+//
+//------------------------------------------------------------------------------
+static void HandleConnection(Connection_t *conn)
+{
+    char request[REQUEST_BUFFER_SIZE];
+    char body[RESPONSE_BUFFER_SIZE];
+    char response[RESPONSE_BUFFER_SIZE * 2u];
+    int requestLength = 0, responseLength = 0;
+    int status = 404;
+    double startMs = 0;
+    uint32_t index = 0;
+    ENDPOINT_t endpoint = ENDPOINT_UNKNOWN;
+    const char *reason = "Not Found";
+    const char *geofences = NULL;
+
+    requestLength = ReceiveRequest(conn, request, sizeof(request));
+    if(requestLength <= 0)
+    {
+        return;
+    }
+    startMs = NowMs();
+    endpoint = GetEndpoint(request);
+    stats[endpoint].requests++;
+    stats[endpoint].bytesIn += (uint64_t)requestLength;
+
+    snprintf(body, sizeof(body), "{\"error\":\"not found\"}");
+    if(Chance(dropProbability) == true)
+    {
+        stats[endpoint].dropped++;
+        if(isVerbose == true)
+        {
+            printf("%-8s dropped\n", endpointNames[endpoint]);
+        }
+        return;
+    }
+    else if(Chance(errorProbability) == true)
+    {
+        status = 500;
+        reason = "Internal Server Error";
+        snprintf(body, sizeof(body), "{\"error\":\"injected\"}");
+    }
+    else if(endpoint == ENDPOINT_TOKEN)
+    {
+        // New token on every request, older ones become invalid
+        for(index = 0; index < TOKEN_LENGTH; index++)
+        {
+            issuedToken[index] = "0123456789abcdef"[rand() & 0xF];
+        }
+        issuedToken[TOKEN_LENGTH] = 0;
+        status = 200;
+        reason = "OK";
+        snprintf(body, sizeof(body), "{\"access_token\":\"%s\",\"token_type\":\"Bearer\",\"expires_in\":%u,\"scope\":\"\"}",
+                 issuedToken, tokenLifetime);
+    }
+    else if((endpoint == ENDPOINT_CREATE) || (endpoint == ENDPOINT_REGISTER))
+    {
+        if((IsAuthorized(request) == false) || ((endpoint == ENDPOINT_CREATE) && (Chance(unauthorizedProbability) == true)))
+        {
+            status = 401;
+            reason = "Unauthorized";
+            snprintf(body, sizeof(body), "{\"error\":\"invalid_token\"}");
+        }
+        else if(endpoint == ENDPOINT_CREATE)
+        {
+            status = 201;
+            reason = "Created";
+            geofences = strstr(request, "\"geofenceSet\":");
+            if((geofenceSet != NULL) && ((geofences == NULL) || ((uint32_t)strtoul(&geofences[14], NULL, 10) != geofenceSetVersion)))
+            {
+                snprintf(body, sizeof(body), "{\"id\":\"5bee%020u\",\"geofences\":%s}", ++eventCounter, geofenceSet);
+                geofenceSetsSent++;
+            }
+            else
+            {
+                snprintf(body, sizeof(body), "{\"id\":\"5bee%020u\"}", ++eventCounter);
+            }
+        }
+        else
+        {
+            status = 200;
+            reason = "OK";
+            snprintf(body, sizeof(body), "{}");
+        }
+    }
+
+    if((latencyMs + jitterMs) > 0u)
+    {
+        usleep((useconds_t)(latencyMs + ((jitterMs > 0u) ? ((uint32_t)rand() % jitterMs) : 0u)) * 1000u);
+    }
+
+    responseLength = snprintf(response, sizeof(response), "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\nContent-Length: %u\r\nConnection: close\r\n\r\n%s",
+                              status, reason, (unsigned int)strlen(body), body);
+    if(ConnectionWrite(conn, response, responseLength) > 0)
+    {
+        stats[endpoint].bytesOut += (uint64_t)responseLength;
+    }
+
+    if((status >= 200) && (status < 300))
+    {
+        stats[endpoint].status2xx++;
+    }
+    else if(status == 401)
+    {
+        stats[endpoint].status401++;
+    }
+    else if(status >= 500)
+    {
+        stats[endpoint].status5xx++;
+    }
+    stats[endpoint].totalHandlingMs += NowMs() - startMs;
+
+    if(isVerbose == true)
+    {
+        printf("%-8s %d  in %d bytes, out %d bytes\n", endpointNames[endpoint], status, requestLength, responseLength);
+        fflush(stdout);
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void RecordHandshake(SSL *ssl)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function count a completed handshake under its negotiated suite
+//
+//------------------------------------------------------------------------------
+static void RecordHandshake(SSL *ssl)
+{
+    const char *name = SSL_get_cipher_name(ssl);
+    uint32_t index = 0;
+
+    while((index < (MAX_CIPHERS - 1u)) && (cipherStats[index].name[0] != 0) && (strcmp(cipherStats[index].name, name) != 0))
+    {
+        index++;
+    }
+    if(cipherStats[index].name[0] == 0)
+    {
+        snprintf(cipherStats[index].name, sizeof(cipherStats[index].name), "%s", name);
+    }
+    cipherStats[index].handshakes++;
+    if(SSL_session_reused(ssl) == 1)
+    {
+        cipherStats[index].resumed++;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void PrintStatistics(void)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function print per endpoint request summary
+//
+//------------------------------------------------------------------------------
+static void PrintStatistics(void)
+{
+    uint32_t index = 0;
+
+    printf("\n%-9s %8s %6s %6s %6s %7s %10s %10s %9s\n", "endpoint", "requests", "2xx", "401", "5xx", "dropped", "bytes in", "bytes out", "avg ms");
+    for(index = 0; index < ENDPOINT_LAST; index++)
+    {
+        if(stats[index].requests > 0u)
+        {
+            printf("%-9s %8u %6u %6u %6u %7u %10llu %10llu %9.1f\n", endpointNames[index], stats[index].requests,
+                   stats[index].status2xx, stats[index].status401, stats[index].status5xx, stats[index].dropped,
+                   (unsigned long long)stats[index].bytesIn, (unsigned long long)stats[index].bytesOut,
+                   stats[index].totalHandlingMs / stats[index].requests);
+        }
+    }
+    if(geofenceSet != NULL)
+    {
+        printf("geofence set %u sent %u times\n", geofenceSetVersion, geofenceSetsSent);
+    }
+    for(index = 0; (index < MAX_CIPHERS) && (cipherStats[index].name[0] != 0); index++)
+    {
+        printf("TLS %-32s %6u handshakes, %6u resumed\n", cipherStats[index].name, cipherStats[index].handshakes, cipherStats[index].resumed);
+    }
+    if(handshakeFailures > 0u)
+    {
+        printf("TLS handshake failures: %u\n", handshakeFailures);
+    }
+}
+
+//------------------------------------------------------------------------------
+//  static void SignalHandler(int sig)
+//
+//   Author:  agent
+//   Date:    2026/10/19
+//
+//!  This function request clean exit
+//
+//------------------------------------------------------------------------------
+static void SignalHandler(int sig)
+{
+    (void)sig;
+    isExitRequested = 1;
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+int main(int argc, char *argv[])
+{
+    const char *certPath = NULL, *keyPath = NULL;
+    const char *ecdsaCertPath = NULL, *ecdsaKeyPath = NULL;
+    bool isPlain = false;
+    int option = 0, listenFd = -1, enable = 1;
+    uint16_t port = 8443u;
+    unsigned int seed = 1u;
+    struct sockaddr_in address;
+    struct timeval timeout = {RECEIVE_TIMEOUT_SEC, 0};
+    struct sigaction action;
+    Connection_t conn;
+
+    while((option = getopt(argc, argv, "p:c:k:C:K:nL:J:e:a:d:x:g:r:v")) != -1)
+    {
+        switch(option)
+        {
+        case 'p':
+            port = (uint16_t)atoi(optarg);
+            break;
+        case 'c':
+            certPath = optarg;
+            break;
+        case 'k':
+            keyPath = optarg;
+            break;
+        case 'C':
+            ecdsaCertPath = optarg;
+            break;
+        case 'K':
+            ecdsaKeyPath = optarg;
+            break;
+        case 'n':
+            isPlain = true;
+            break;
+        case 'L':
+            latencyMs = (uint32_t)atoi(optarg);
+            break;
+        case 'J':
+            jitterMs = (uint32_t)atoi(optarg);
+            break;
+        case 'e':
+            errorProbability = atof(optarg);
+            break;
+        case 'a':
+            unauthorizedProbability = atof(optarg);
+            break;
+        case 'd':
+            dropProbability = atof(optarg);
+            break;
+        case 'x':
+            tokenLifetime = (uint32_t)atoi(optarg);
+            break;
+        case 'g':
+            geofenceSet = optarg;
+            geofenceSetVersion = (uint32_t)strtoul(&optarg[1], NULL, 10);
+            break;
+        case 'r':
+            seed = (unsigned int)atoi(optarg);
+            break;
+        case 'v':
+            isVerbose = true;
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-p port] [-c cert -k key [-C cert -K key] | -n] [-L ms] [-J ms] [-e p] [-a p] [-d p] [-x s] [-g set] [-r seed] [-v]\n", argv[0]);
+            return 1;
+        }
+    }
+    if((isPlain == false) && ((certPath == NULL) || (keyPath == NULL)))
+    {
+        fprintf(stderr, "TLS needs -c cert.pem -k key.pem, or use -n for plain TCP\n");
+        return 1;
+    }
+    srand(seed);
+
+    if(isPlain == false)
+    {
+        sslContext = SSL_CTX_new(TLS_server_method());
+        if((sslContext == NULL) || (SSL_CTX_use_certificate_chain_file(sslContext, certPath) != 1) ||
+           (SSL_CTX_use_PrivateKey_file(sslContext, keyPath, SSL_FILETYPE_PEM) != 1))
+        {
+            ERR_print_errors_fp(stderr);
+            return 1;
+        }
+        // OpenSSL picks the key that matches the suite negotiated
+        if((ecdsaCertPath != NULL) && (ecdsaKeyPath != NULL) &&
+           ((SSL_CTX_use_certificate_chain_file(sslContext, ecdsaCertPath) != 1) ||
+            (SSL_CTX_use_PrivateKey_file(sslContext, ecdsaKeyPath, SSL_FILETYPE_PEM) != 1)))
+        {
+            ERR_print_errors_fp(stderr);
+            return 1;
+        }
+    }
+
+    // No SA_RESTART so accept() returns on SIGINT
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = SignalHandler;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if((bind(listenFd, (struct sockaddr *)&address, sizeof(address)) != 0) || (listen(listenFd, 8) != 0))
+    {
+        perror("listen");
+        return 1;
+    }
+    printf("iNet stand-in on port %u (%s)\n", port, isPlain ? "plain TCP" : "TLS");
+    fflush(stdout);
+
+    while(isExitRequested == 0)
+    {
+        conn.fd = accept(listenFd, NULL, NULL);
+        if(conn.fd < 0)
+        {
+            continue;
+        }
+        setsockopt(conn.fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        conn.ssl = NULL;
+        if(sslContext != NULL)
+        {
+            conn.ssl = SSL_new(sslContext);
+            SSL_set_fd(conn.ssl, conn.fd);
+            if(SSL_accept(conn.ssl) != 1)
+            {
+                handshakeFailures++;
+                if(isVerbose == true)
+                {
+                    ERR_print_errors_fp(stderr);
+                }
+                ERR_clear_error();
+                SSL_free(conn.ssl);
+                close(conn.fd);
+                continue;
+            }
+            RecordHandshake(conn.ssl);
+        }
+
+        HandleConnection(&conn);
+
+        if(conn.ssl != NULL)
+        {
+            SSL_shutdown(conn.ssl);
+            SSL_free(conn.ssl);
+        }
+        close(conn.fd);
+    }
+
+    PrintStatistics();
+    close(listenFd);
+    if(sslContext != NULL)
+    {
+        SSL_CTX_free(sslContext);
+    }
+    return 0;
+}